@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+#include <ai/AIGraph.hpp>
+#include <ai/AIGraphNode.hpp>
+#include "bench_Synthetic.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+static void BM_AIGraphGatherExternalNodesNear(benchmark::State& state) {
+    const auto radius = static_cast<float>(state.range(0));
+    ai::AIGraph graph;
+    synthetic::addRoadPaths(graph, 2000);
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> coord(-1500.f, 1500.f);
+    std::vector<glm::vec3> centers(256);
+    for (auto& center : centers) {
+        center = {coord(random), coord(random), 0.f};
+    }
+
+    std::vector<ai::AIGraphNode*> nodes;
+    std::size_t query = 0;
+    for (auto _ : state) {
+        nodes.clear();
+        graph.gatherExternalNodesNear(centers[query++ % centers.size()],
+                                      radius, nodes, ai::NodeType::Vehicle);
+        benchmark::DoNotOptimize(nodes.data());
+    }
+}
+BENCHMARK(BM_AIGraphGatherExternalNodesNear)->Arg(50)->Arg(200);
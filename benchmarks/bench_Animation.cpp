@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include <data/Clump.hpp>
+#include <engine/Animator.hpp>
+#include <loaders/LoaderIFP.hpp>
+#include "bench_Synthetic.hpp"
+
+#include <cstdint>
+
+static void BM_AnimatorTick(benchmark::State& state) {
+    const auto bones = static_cast<std::uint32_t>(state.range(0));
+    Animator animator(synthetic::makeSkeleton(bones));
+    animator.playAnimation(0, synthetic::makeAnimation(bones, 30), 1.f, true);
+
+    for (auto _ : state) {
+        animator.tick(1.f / 60.f);
+    }
+    state.SetItemsProcessed(state.iterations() * bones);
+}
+BENCHMARK(BM_AnimatorTick)->Arg(16)->Arg(64);
@@ -0,0 +1,19 @@
+#ifndef _BENCHCONTEXT_HPP_
+#define _BENCHCONTEXT_HPP_
+
+#include <benchmark/benchmark.h>
+
+/// Whether main created a GL context, there is none without a display
+bool hasGLContext();
+
+/// Skips the benchmark when there is no GL context
+/// @return whether the benchmark can run
+inline bool requireGLContext(benchmark::State& state) {
+    if (!hasGLContext()) {
+        state.SkipWithError("needs a GL context");
+        return false;
+    }
+    return true;
+}
+
+#endif
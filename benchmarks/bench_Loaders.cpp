@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <data/Clump.hpp>
+#include <gl/TextureData.hpp>
+#include <loaders/LoaderDFF.hpp>
+#include <loaders/LoaderIFP.hpp>
+#include <loaders/LoaderIMG.hpp>
+#include <loaders/LoaderTXD.hpp>
+#include "bench_Context.hpp"
+#include "bench_Synthetic.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+std::int64_t bytes(const benchmark::State& state, std::size_t size) {
+    return state.iterations() * static_cast<std::int64_t>(size);
+}
+}  // namespace
+
+/// Includes uploading the geometry, as the loader does both
+static void BM_LoaderDFF(benchmark::State& state) {
+    if (!requireGLContext(state)) {
+        return;
+    }
+    const auto file = synthetic::makeClump(
+        static_cast<std::uint32_t>(state.range(0)), 16);
+    LoaderDFF loader;
+
+    for (auto _ : state) {
+        auto clump = loader.loadFromMemory(file);
+        benchmark::DoNotOptimize(clump);
+    }
+    state.SetBytesProcessed(bytes(state, file.length));
+}
+BENCHMARK(BM_LoaderDFF)->Arg(1)->Arg(16)->Arg(64);
+
+/// Palette expansion and texture creation
+static void BM_LoaderTXD(benchmark::State& state) {
+    if (!requireGLContext(state)) {
+        return;
+    }
+    const auto file = synthetic::makeTextureDictionary(
+        8, static_cast<std::uint16_t>(state.range(0)));
+    TextureLoader loader;
+
+    for (auto _ : state) {
+        TextureArchive textures;
+        loader.loadFromMemory(file, textures);
+        benchmark::DoNotOptimize(textures);
+    }
+    state.SetBytesProcessed(bytes(state, file.length));
+}
+BENCHMARK(BM_LoaderTXD)->Arg(64)->Arg(256);
+
+static void BM_LoaderIFP(benchmark::State& state) {
+    auto package = synthetic::makeAnimationPackage(
+        static_cast<std::uint32_t>(state.range(0)), 32, 30);
+
+    for (auto _ : state) {
+        LoaderIFP loader;
+        loader.loadFromMemory(package.data());
+        benchmark::DoNotOptimize(loader.animations);
+    }
+    state.SetBytesProcessed(bytes(state, package.size()));
+}
+BENCHMARK(BM_LoaderIFP)->Arg(16)->Arg(128);
+
+/// Looks up the last entry, the worst case for the archive's linear search
+static void BM_LoaderIMGFindAssetInfo(benchmark::State& state) {
+    const auto entries = static_cast<std::uint32_t>(state.range(0));
+    LoaderIMG archive;
+    if (!archive.load(synthetic::makeArchive(entries))) {
+        state.SkipWithError("Failed to load the archive");
+        return;
+    }
+    const auto name = "asset" + std::to_string(entries - 1) + ".dff";
+
+    for (auto _ : state) {
+        LoaderIMGFile info;
+        benchmark::DoNotOptimize(archive.findAssetInfo(name, info));
+    }
+}
+BENCHMARK(BM_LoaderIMGFindAssetInfo)->Arg(1000)->Arg(8000);
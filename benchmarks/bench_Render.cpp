@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <render/ObjectRenderer.hpp>
+#include <render/ViewCamera.hpp>
+#include <render/ViewFrustum.hpp>
+#include "bench_Synthetic.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr ModelID kModel = 1;
+constexpr float kSpacing = 10.f;
+
+ViewCamera makeCamera() {
+    ViewCamera camera;
+    camera.frustum.far = 1000.f;
+    camera.frustum.update(camera.frustum.projection() * camera.getView());
+    return camera;
+}
+}  // namespace
+
+static void BM_ViewFrustumIntersects(benchmark::State& state) {
+    const auto camera = makeCamera();
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> coord(-1000.f, 1000.f);
+    std::vector<glm::vec3> centers(static_cast<std::size_t>(state.range(0)));
+    for (auto& center : centers) {
+        center = {coord(random), coord(random), coord(random) * 0.1f};
+    }
+
+    for (auto _ : state) {
+        std::size_t visible = 0;
+        for (const auto& center : centers) {
+            visible += camera.frustum.intersects(center, 5.f) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(centers.size()));
+}
+BENCHMARK(BM_ViewFrustumIntersects)->Arg(1024)->Arg(16384);
+
+/// ObjectRenderer only fills the render list, nothing is drawn
+static void BM_ObjectRendererBuildRenderList(benchmark::State& state) {
+    const auto side = state.range(0);
+    synthetic::World world;
+    world.addSimpleModel(kModel, 300.f);
+    for (auto x = 0; x < side; ++x) {
+        for (auto y = 0; y < side; ++y) {
+            const glm::vec3 position((x - side / 2) * kSpacing,
+                                     (y - side / 2) * kSpacing, 0.f);
+            world.world.createInstance(kModel, position,
+                                       glm::quat{1.f, 0.f, 0.f, 0.f}, true);
+        }
+    }
+    const auto camera = makeCamera();
+    const auto& objects = world.world.allObjects;
+
+    RenderList renderList;
+    for (auto _ : state) {
+        renderList.clear();
+        ObjectRenderer objectRenderer(&world.world, camera, 1.f);
+        for (auto object : objects) {
+            objectRenderer.buildRenderList(object, renderList);
+        }
+        benchmark::DoNotOptimize(renderList.data());
+    }
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<std::int64_t>(objects.size()));
+    state.counters["drawn"] = static_cast<double>(renderList.size());
+}
+BENCHMARK(BM_ObjectRendererBuildRenderList)->Arg(32)->Arg(128);
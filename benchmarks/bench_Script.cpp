@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+#include <script/SCMFile.hpp>
+#include <script/ScriptMachine.hpp>
+#include <script/modules/GTA3Module.hpp>
+#include "bench_Synthetic.hpp"
+
+#include <cstdint>
+
+static void BM_ScriptMachineExecute(benchmark::State& state) {
+    const auto additions = static_cast<std::uint32_t>(state.range(0));
+    synthetic::World world;
+    auto data = synthetic::makeScript(additions);
+
+    SCMFile file;
+    file.loadFile(data.data(), data.size());
+    GTA3Module module;
+    ScriptMachine machine(&world.state, file, &module);
+    machine.startThread(file.getCodeSection());
+
+    // The script yields with wait 0, so every call runs the loop once
+    for (auto _ : state) {
+        machine.execute(0.f);
+    }
+    state.SetItemsProcessed(state.iterations() * (additions + 2));
+}
+BENCHMARK(BM_ScriptMachineExecute)->Arg(16)->Arg(256);
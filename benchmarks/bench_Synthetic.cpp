@@ -0,0 +1,490 @@
+#include "bench_Synthetic.hpp"
+
+#include <data/Clump.hpp>
+#include <data/ModelData.hpp>
+#include <data/PathData.hpp>
+#include <loaders/LoaderIFP.hpp>
+#include <loaders/LoaderIMG.hpp>
+#include <loaders/RWBinaryStream.hpp>
+#include <script/SCMFile.hpp>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace synthetic {
+namespace {
+constexpr std::uint32_t kStreamVersion = 0x1003FFFF;
+constexpr float kKeyframeTime = 1.f / 30.f;
+
+/**
+ * Appends values to a byte buffer, and fills in the sizes of RW chunks and
+ * IFP sections once their contents have been written
+ */
+class Writer {
+public:
+    std::vector<char> data;
+
+    template <class T>
+    void write(const T& value) {
+        writeBytes(&value, sizeof(T));
+    }
+
+    void writeBytes(const void* bytes, std::size_t size) {
+        const auto begin = static_cast<const char*>(bytes);
+        data.insert(data.end(), begin, begin + size);
+    }
+
+    template <class T>
+    void patch(std::size_t offset, const T& value) {
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    /// Null terminated and padded to 4 bytes, as IFP files store them
+    void writeString(const std::string& str) {
+        writeBytes(str.c_str(), str.size() + 1);
+        data.resize((data.size() + 3) & ~std::size_t{3}, 0);
+    }
+
+    void beginChunk(std::uint32_t id) {
+        write(id);
+        write(std::uint32_t{0});
+        write(kStreamVersion);
+        chunks.push_back(data.size());
+    }
+
+    void endChunk() {
+        const auto start = chunks.back();
+        chunks.pop_back();
+        patch(start - sizeof(std::uint32_t) * 2,
+              static_cast<std::uint32_t>(data.size() - start));
+    }
+
+    std::size_t beginSection(const char* magic) {
+        writeBytes(magic, 4);
+        write(std::uint32_t{0});
+        return data.size();
+    }
+
+    void endSection(std::size_t start) {
+        patch(start - sizeof(std::uint32_t),
+              static_cast<std::uint32_t>(data.size() - start));
+    }
+
+    FileContentsInfo finish() {
+        auto memory = std::make_unique<char[]>(data.size());
+        std::copy(data.begin(), data.end(), memory.get());
+        return {std::move(memory), data.size()};
+    }
+
+private:
+    std::vector<std::size_t> chunks;
+};
+
+std::string boneName(std::uint32_t bone) {
+    return "bone" + std::to_string(bone);
+}
+
+void writeGeometry(Writer& w, std::uint32_t gridSize) {
+    const auto side = gridSize + 1;
+    const auto numVerts = side * side;
+    const auto numTris = gridSize * gridSize * 2;
+    const auto extent = static_cast<float>(gridSize);
+
+    w.beginChunk(RW::SID_Geometry);
+
+    w.beginChunk(RW::SID_Struct);
+    w.write(std::uint16_t{0x2 | 0x4 | 0x10});  // positions, uvs, normals
+    w.write(std::uint8_t{1});
+    w.write(std::uint8_t{0});
+    w.write(numTris);
+    w.write(numVerts);
+    w.write(std::uint32_t{1});
+
+    for (auto v = 0u; v < numVerts; ++v) {
+        w.write(glm::vec2(v % side, v / side) / extent);
+    }
+
+    std::vector<std::uint32_t> indices;
+    indices.reserve(numTris * 3);
+    for (auto y = 0u; y < gridSize; ++y) {
+        for (auto x = 0u; x < gridSize; ++x) {
+            const auto i = static_cast<std::uint16_t>(y * side + x);
+            const auto right = static_cast<std::uint16_t>(i + 1);
+            const auto up = static_cast<std::uint16_t>(i + side);
+            const auto corner = static_cast<std::uint16_t>(up + 1);
+            w.write(RW::BSGeometryTriangle{i, right, 0, up});
+            w.write(RW::BSGeometryTriangle{right, corner, 0, up});
+            indices.insert(indices.end(), {i, right, up, right, corner, up});
+        }
+    }
+
+    w.write(RW::BSGeometryBounds{glm::vec3(extent / 2.f, extent / 2.f, 0.f),
+                                 extent * 0.75f, 1, 1});
+    for (auto v = 0u; v < numVerts; ++v) {
+        w.write(glm::vec3(v % side, v / side, 0.f));
+    }
+    for (auto v = 0u; v < numVerts; ++v) {
+        w.write(glm::vec3(0.f, 0.f, 1.f));
+    }
+    w.endChunk();
+
+    w.beginChunk(RW::SID_MaterialList);
+    w.beginChunk(RW::SID_Struct);
+    w.write(std::uint32_t{1});
+    w.write(std::int32_t{-1});
+    w.endChunk();
+    w.beginChunk(RW::SID_Material);
+    w.beginChunk(RW::SID_Struct);
+    w.write(RW::BSMaterial{0, RW::BSColor(255), 0, 0, 1.f, 1.f, 1.f});
+    w.endChunk();
+    w.endChunk();
+    w.endChunk();
+
+    w.beginChunk(RW::SID_Extension);
+    w.beginChunk(RW::SID_BinMeshPLG);
+    w.write(RW::BSBinMeshPLG{0, 1, numTris});
+    w.write(RW::BSMaterialSplit{static_cast<std::uint32_t>(indices.size()),
+                                0});
+    w.writeBytes(indices.data(), indices.size() * sizeof(std::uint32_t));
+    w.endChunk();
+    w.endChunk();
+
+    w.endChunk();
+}
+}  // namespace
+
+FileContentsInfo makeClump(std::uint32_t frames, std::uint32_t gridSize) {
+    Writer w;
+    w.beginChunk(RW::SID_Clump);
+
+    w.beginChunk(RW::SID_Struct);
+    w.write(RW::BSClump{frames});
+    w.endChunk();
+
+    w.beginChunk(RW::SID_FrameList);
+    w.beginChunk(RW::SID_Struct);
+    w.write(RW::BSFrameList{frames});
+    for (auto f = 0u; f < frames; ++f) {
+        w.write(glm::mat3(1.f));
+        w.write(glm::vec3(0.f, 0.f, f == 0 ? 0.f : 1.f));
+        w.write(static_cast<std::int32_t>(f) - 1);
+        w.write(std::uint32_t{0});
+    }
+    w.endChunk();
+    for (auto f = 0u; f < frames; ++f) {
+        const auto name = boneName(f);
+        w.beginChunk(RW::SID_Extension);
+        w.beginChunk(RW::SID_NodeName);
+        w.writeBytes(name.data(), name.size());
+        w.endChunk();
+        w.endChunk();
+    }
+    w.endChunk();
+
+    w.beginChunk(RW::SID_GeometryList);
+    w.beginChunk(RW::SID_Struct);
+    w.write(RW::BSGeometryList{frames});
+    w.endChunk();
+    for (auto f = 0u; f < frames; ++f) {
+        writeGeometry(w, gridSize);
+    }
+    w.endChunk();
+
+    for (auto f = 0u; f < frames; ++f) {
+        w.beginChunk(RW::SID_Atomic);
+        w.beginChunk(RW::SID_Struct);
+        w.write(f);
+        w.write(f);
+        w.write(std::uint32_t{Atomic::ATOMIC_RENDER});
+        w.write(std::uint32_t{0});
+        w.endChunk();
+        w.endChunk();
+    }
+
+    w.endChunk();
+    return w.finish();
+}
+
+FileContentsInfo makeTextureDictionary(std::uint32_t textures,
+                                       std::uint16_t size) {
+    const auto pixels = std::uint32_t{size} * size;
+
+    Writer w;
+    w.beginChunk(RW::SID_TextureDictionary);
+
+    w.beginChunk(RW::SID_Struct);
+    w.write(RW::BSTextureDictionary{static_cast<std::uint16_t>(textures), 0});
+    w.endChunk();
+
+    for (auto t = 0u; t < textures; ++t) {
+        RW::BSTextureNative native{};
+        native.platform = 8;
+        native.filterflags = RW::BSTextureNative::FILTER_LINEAR;
+        native.wrapU = RW::BSTextureNative::WRAP_WRAP;
+        native.wrapV = RW::BSTextureNative::WRAP_WRAP;
+        std::snprintf(native.diffuseName, sizeof(native.diffuseName),
+                      "texture%u", t);
+        native.rasterformat = RW::BSTextureNative::FORMAT_8888 |
+                              RW::BSTextureNative::FORMAT_EXT_PAL8;
+        native.width = size;
+        native.height = size;
+        native.bpp = 8;
+        native.nummipmaps = 1;
+        native.rastertype = 4;
+
+        w.beginChunk(RW::SID_TextureNative);
+        w.beginChunk(RW::SID_Struct);
+        // Palettised rasters store the palette where the data size would be
+        w.writeBytes(&native, offsetof(RW::BSTextureNative, datasize));
+        for (auto c = 0u; c < 256; ++c) {
+            w.write(0xFF000000u | (c * 0x010101u));
+        }
+        w.write(pixels);
+        for (auto p = 0u; p < pixels; ++p) {
+            w.write(static_cast<std::uint8_t>((p % size) ^ (p / size)));
+        }
+        w.endChunk();
+        w.beginChunk(RW::SID_Extension);
+        w.endChunk();
+        w.endChunk();
+    }
+
+    w.endChunk();
+    return w.finish();
+}
+
+std::vector<char> makeAnimationPackage(std::uint32_t animations,
+                                       std::uint32_t bones,
+                                       std::uint32_t keyframes) {
+    Writer w;
+    const auto package = w.beginSection("ANPK");
+    const auto packageInfo = w.beginSection("INFO");
+    w.write(animations);
+    w.writeString("synthetic");
+    w.endSection(packageInfo);
+
+    for (auto a = 0u; a < animations; ++a) {
+        const auto name = "anim" + std::to_string(a);
+
+        const auto nameSection = w.beginSection("NAME");
+        w.writeString(name);
+        w.endSection(nameSection);
+
+        const auto animation = w.beginSection("DGAN");
+        const auto animationInfo = w.beginSection("INFO");
+        w.write(bones);
+        w.writeString(name);
+        w.endSection(animationInfo);
+
+        for (auto b = 0u; b < bones; ++b) {
+            const auto bone = w.beginSection("CPAN");
+
+            const auto header = w.beginSection("ANIM");
+            char boneNameData[28] = {};
+            std::snprintf(boneNameData, sizeof(boneNameData), "bone%u", b);
+            w.writeBytes(boneNameData, sizeof(boneNameData));
+            w.write(keyframes);
+            w.write(std::int32_t{0});
+            w.write(static_cast<std::int32_t>(b) + 1);
+            w.write(static_cast<std::int32_t>(b) - 1);
+            w.endSection(header);
+
+            const auto frames = w.beginSection("KRT0");
+            for (auto k = 0u; k < keyframes; ++k) {
+                const auto time = k * kKeyframeTime;
+                w.write(glm::angleAxis(time, glm::vec3(0.f, 0.f, 1.f)));
+                w.write(glm::vec3(0.f, 0.f, time));
+                w.write(time);
+            }
+            w.endSection(frames);
+
+            w.endSection(bone);
+        }
+
+        w.endSection(animation);
+    }
+
+    w.endSection(package);
+    return std::move(w.data);
+}
+
+std::filesystem::path makeArchive(std::uint32_t entries) {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "openrw_bench";
+    std::filesystem::create_directories(directory);
+    const auto archive = directory / "synthetic";
+
+    std::ofstream dir(archive.string() + ".dir", std::ios::binary);
+    for (auto e = 0u; e < entries; ++e) {
+        LoaderIMGFile file{};
+        file.offset = e;
+        file.size = 1;
+        std::snprintf(file.name, sizeof(file.name), "asset%u.dff", e);
+        dir.write(reinterpret_cast<const char*>(&file), sizeof(file));
+    }
+    std::ofstream img(archive.string() + ".img", std::ios::binary);
+
+    return archive;
+}
+
+std::vector<SCMByte> makeScript(std::uint32_t additions) {
+    Writer w;
+    constexpr std::uint32_t kGlobalsSize = 64;
+    const auto writeJump = [&w](std::uint32_t target) {
+        w.write(std::uint16_t{0x0002});
+        w.write(std::uint8_t{TInt32});
+        w.write(target);
+    };
+    const auto writeLocal = [&w](std::uint16_t opcode, std::int8_t value) {
+        w.write(opcode);
+        w.write(std::uint8_t{TLocal});
+        w.write(std::uint16_t{0});
+        w.write(std::uint8_t{TInt8});
+        w.write(value);
+    };
+
+    // The header is three jumps over the global, model and mission
+    // sections, each followed by a segment byte
+    writeJump(0);
+    w.write(std::uint8_t{SCMFile::GTAIII});
+    w.data.resize(w.data.size() + kGlobalsSize, 0);
+
+    const auto modelJump = w.data.size();
+    w.patch(3, static_cast<std::uint32_t>(modelJump));
+    writeJump(0);
+    w.write(std::uint8_t{0});
+    w.write(std::uint32_t{0});
+
+    const auto missionJump = w.data.size();
+    w.patch(modelJump + 3, static_cast<std::uint32_t>(missionJump));
+    writeJump(0);
+    w.write(std::uint8_t{1});
+    const auto mainSizeOffset = w.data.size();
+    w.write(std::uint32_t{0});
+    w.write(std::uint32_t{0});
+    w.write(std::uint32_t{0});
+
+    const auto code = w.data.size();
+    w.patch(missionJump + 3, static_cast<std::uint32_t>(code));
+    writeLocal(0x0006, 0);
+    const auto loop = static_cast<std::uint32_t>(w.data.size());
+    for (auto a = 0u; a < additions; ++a) {
+        writeLocal(0x000A, 1);
+    }
+    w.write(std::uint16_t{0x0001});
+    w.write(std::uint8_t{TInt8});
+    w.write(std::int8_t{0});
+    writeJump(loop);
+    w.patch(mainSizeOffset, static_cast<std::uint32_t>(w.data.size()));
+
+    return std::move(w.data);
+}
+
+ClumpPtr makeSkeleton(std::uint32_t bones) {
+    auto clump = std::make_shared<Clump>();
+    auto root = std::make_shared<ModelFrame>(0);
+    root->setName("root");
+    clump->setFrame(root);
+
+    auto parent = root;
+    for (auto b = 0u; b < bones; ++b) {
+        auto frame = std::make_shared<ModelFrame>(b + 1, glm::mat3(1.f),
+                                                  glm::vec3(0.f, 0.f, 1.f));
+        frame->setName(boneName(b));
+        parent->addChild(frame);
+        parent = frame;
+    }
+    return clump;
+}
+
+AnimationPtr makeAnimation(std::uint32_t bones, std::uint32_t keyframes) {
+    auto animation = std::make_shared<Animation>();
+    animation->name = "synthetic";
+    animation->duration = (keyframes - 1) * kKeyframeTime;
+
+    for (auto b = 0u; b < bones; ++b) {
+        std::vector<AnimationKeyframe> frames;
+        frames.reserve(keyframes);
+        for (auto k = 0u; k < keyframes; ++k) {
+            const auto time = k * kKeyframeTime;
+            frames.emplace_back(glm::angleAxis(time, glm::vec3(0.f, 0.f, 1.f)),
+                                glm::vec3(0.f, 0.f, time), glm::vec3(1.f),
+                                time, static_cast<int>(k));
+        }
+        const auto name = boneName(b);
+        animation->bones.emplace(
+            name, AnimationBone(name, static_cast<std::int32_t>(b) - 1,
+                                static_cast<std::int32_t>(b) + 1,
+                                animation->duration, AnimationBone::RT0,
+                                frames));
+    }
+    return animation;
+}
+
+void addRoadPaths(ai::AIGraph& graph, std::uint32_t paths) {
+    std::mt19937 random(paths);
+    std::uniform_real_distribution<float> coord(-1500.f, 1500.f);
+
+    for (auto p = 0u; p < paths; ++p) {
+        PathData path;
+        path.type = PathData::PATH_CAR;
+        path.ID = static_cast<std::uint16_t>(p);
+        for (auto n = 0; n < 4; ++n) {
+            const bool end = n == 0 || n == 3;
+            path.nodes.push_back({end ? PathNode::EXTERNAL : PathNode::INTERNAL,
+                                  n < 3 ? n + 1 : -1,
+                                  glm::vec3(n * 8.f - 12.f, 0.f, 0.f), 1.f, 1,
+                                  1});
+        }
+        graph.createPathNodes(glm::vec3(coord(random), coord(random), 0.f),
+                              glm::quat{1.f, 0.f, 0.f, 0.f}, path);
+    }
+}
+
+World::World() : data(&log, std::filesystem::path()), world(&log, &data) {
+    world.state = &state;
+    state.world = &world;
+}
+
+void World::addSimpleModel(ModelID id, float drawDistance) {
+    Geometry::Material material{};
+    material.colour = {255, 255, 255, 255};
+    material.diffuseIntensity = 1.f;
+    material.ambientIntensity = 1.f;
+
+    SubGeometry subgeom;
+    subgeom.numIndices = 36;
+
+    auto geometry = std::make_shared<Geometry>();
+    geometry->geometryBounds = {glm::vec3(0.f), 5.f, 1, 1};
+    geometry->materials.push_back(material);
+    geometry->subgeom.push_back(subgeom);
+
+    auto atomic = std::make_shared<Atomic>();
+    atomic->setFrame(std::make_shared<ModelFrame>(0));
+    atomic->setGeometry(geometry);
+    atomic->setFlags(Atomic::ATOMIC_RENDER);
+
+    auto clump = std::make_shared<Clump>();
+    clump->addAtomic(atomic);
+    clump->setFrame(atomic->getFrame());
+
+    auto info = std::make_unique<SimpleModelInfo>();
+    info->setModelID(id);
+    info->name = "synthetic" + std::to_string(id);
+    info->flags = 0;
+    info->setNumAtomics(1);
+    info->setLodDistance(0, drawDistance);
+    info->setAtomic(clump, 0, atomic);
+    data.modelinfo[id] = std::move(info);
+}
+
+}  // namespace synthetic
@@ -0,0 +1,74 @@
+#ifndef _BENCHSYNTHETIC_HPP_
+#define _BENCHSYNTHETIC_HPP_
+
+#include <ai/AIGraph.hpp>
+#include <core/Logger.hpp>
+#include <engine/GameData.hpp>
+#include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
+#include <platform/FileHandle.hpp>
+#include <rw/forward.hpp>
+#include <script/ScriptTypes.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Generators for the data the benchmarks run on.
+ *
+ * Everything here is built in memory (or in a temporary directory) with
+ * the same layout as the retail files, so the benchmarks don't need the
+ * game data to be installed.
+ */
+namespace synthetic {
+
+/// Clump with a chain of frames, each with an atomic using a grid mesh of
+/// gridSize x gridSize quads
+FileContentsInfo makeClump(std::uint32_t frames, std::uint32_t gridSize);
+
+/// Texture dictionary of palettised size x size textures
+FileContentsInfo makeTextureDictionary(std::uint32_t textures,
+                                       std::uint16_t size);
+
+/// IFP animation package, each animation animating bones "bone0".."boneN"
+std::vector<char> makeAnimationPackage(std::uint32_t animations,
+                                       std::uint32_t bones,
+                                       std::uint32_t keyframes);
+
+/// Writes an IMG archive with the given number of entries named
+/// "asset<N>.dff", returns the archive path without an extension
+std::filesystem::path makeArchive(std::uint32_t entries);
+
+/// SCM file with a single thread that runs the given number of integer
+/// additions before yielding with wait 0, then loops
+std::vector<SCMByte> makeScript(std::uint32_t additions);
+
+/// Frame hierarchy matching the bones of makeAnimation
+ClumpPtr makeSkeleton(std::uint32_t bones);
+
+/// Animation moving bones "bone0".."boneN"
+AnimationPtr makeAnimation(std::uint32_t bones, std::uint32_t keyframes);
+
+/// Adds short road paths with an external node at each end, scattered
+/// over the middle of the world
+void addRoadPaths(ai::AIGraph& graph, std::uint32_t paths);
+
+/// A world without game data, for benchmarks that need objects to exist
+struct World {
+    Logger log;
+    GameData data;
+    GameState state;
+    GameWorld world;
+
+    World();
+
+    /// Registers a simple model with a single atomic, drawn up to
+    /// drawDistance units away
+    void addSimpleModel(ModelID id, float drawDistance);
+};
+
+}  // namespace synthetic
+
+#endif
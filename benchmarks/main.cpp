@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <SDL.h>
+#include <GameWindow.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+#include "bench_Context.hpp"
+
+namespace {
+bool glContext = false;
+}  // namespace
+
+bool hasGLContext() {
+    return glContext;
+}
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    // The model and texture loaders upload what they load, so they need a
+    // GL context even though nothing is drawn. Without a display they are
+    // skipped and everything else still runs.
+    GameWindow window;
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        std::cerr << "Failed to initialize SDL2, skipping GL benchmarks: "
+                  << SDL_GetError() << '\n';
+    } else {
+        try {
+            window.create("Benchmarks", 64, 64, false, false);
+            glContext = true;
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << ", skipping GL benchmarks\n";
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    if (glContext) {
+        window.close();
+    }
+    SDL_Quit();
+    return 0;
+}
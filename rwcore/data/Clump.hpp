@@ -3,14 +3,17 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <gl/DrawBuffer.hpp>
+#include <gl/GeometryArena.hpp>
 #include <gl/GeometryBuffer.hpp>
 #include <gl/TextureData.hpp>
 #include <loaders/RWBinaryStream.hpp>
 
+#include <rw/accounting.hpp>
 #include <rw/forward.hpp>
 
 /**
@@ -168,10 +171,13 @@ struct Geometry {
     };
 
     DrawBuffer dbuff;
+    /// Vertices and indices, unless loaded into a GeometryArena
     GeometryBuffer gbuff;
-
     GLuint EBO;
 
+    /// Range in the GeometryArena dbuff draws from, if any
+    GeometryArena::Allocation arenaAllocation;
+
     RW::BSGeometryBounds geometryBounds;
 
     uint32_t clumpNum;
@@ -183,6 +189,17 @@ struct Geometry {
     std::vector<Material> materials;
     std::vector<SubGeometry> subgeom;
 
+    /// Vertex positions, only kept for models used as occluders
+    std::vector<glm::vec3> positions;
+
+    /// Keeps the textures the materials point to loaded while set
+    std::shared_ptr<void> textureReference;
+
+    /// Materials and indices kept after uploading
+    MemoryAllocation memory{MemoryCategory::Models};
+    /// The element buffer
+    MemoryAllocation indexMemory{MemoryCategory::Geometry};
+
     Geometry();
     ~Geometry();
 };
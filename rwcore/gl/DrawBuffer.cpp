@@ -1,7 +1,5 @@
 #include "gl/DrawBuffer.hpp"
 
-#include <map>
-
 #include <gl/gl_core_3_3.h>
 #include <gl/GeometryBuffer.hpp>
 
@@ -14,18 +12,37 @@ DrawBuffer::~DrawBuffer() {
     }
 }
 
+void DrawBuffer::setSource(const DrawBuffer* source, const DrawRange* range) {
+    this->source = source;
+    this->range = range;
+}
+
 void DrawBuffer::addGeometry(GeometryBuffer* gbuff) {
+    setVertexBuffer(gbuff->getVBOName(), gbuff->getDataAttributes());
+}
+
+void DrawBuffer::setVertexBuffer(GLuint vbo, const AttributeList& attributes) {
     if (vao == 0) {
         glGenVertexArrays(1, &vao);
     }
 
     glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, gbuff->getVBOName());
-    // Iterate the attributes present in the gbuff
-    for (const AttributeIndex& at : gbuff->getDataAttributes()) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    // Iterate the attributes present in the buffer
+    for (const AttributeIndex& at : attributes) {
         auto vaoindex = static_cast<GLuint>(at.sem);
         glEnableVertexAttribArray(vaoindex);
         glVertexAttribPointer(vaoindex, static_cast<GLint>(at.size), at.type, GL_TRUE, at.stride,
                               reinterpret_cast<void*>(at.offset));
+        glVertexAttribDivisor(vaoindex, at.divisor);
+    }
+}
+
+void DrawBuffer::setIndexBuffer(GLuint ebo) {
+    if (vao == 0) {
+        glGenVertexArrays(1, &vao);
     }
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 }
@@ -1,23 +1,50 @@
 #ifndef _LIBRW_DRAWBUFFER_HPP_
 #define _LIBRW_DRAWBUFFER_HPP_
 
+#include <gl/GeometryBuffer.hpp>
 #include <gl/gl_core_3_3.h>
 
-class GeometryBuffer;
+/**
+ * Where a draw's vertices and indices start in shared buffers
+ */
+struct DrawRange {
+    GLint baseVertex = 0;
+    GLuint baseIndex = 0;
+};
 
 /**
  * DrawBuffer stores VAO state
+ *
+ * A DrawBuffer may also draw from another buffer's VAO, at the offsets in a
+ * DrawRange (see GeometryArena). Renderers only switch VAOs when the
+ * buffer returned by getVertexArray() changes.
  */
 class DrawBuffer {
     GLuint vao;
     GLenum facetype;
 
+    const DrawBuffer* source = nullptr;
+    const DrawRange* range = nullptr;
+
 public:
     DrawBuffer();
     ~DrawBuffer();
 
     GLuint getVAOName() const {
-        return vao;
+        return getVertexArray()->vao;
+    }
+
+    /// The buffer owning the VAO this one draws from
+    const DrawBuffer* getVertexArray() const {
+        return source ? source : this;
+    }
+
+    GLint getBaseVertex() const {
+        return range ? range->baseVertex : 0;
+    }
+
+    GLuint getBaseIndex() const {
+        return range ? range->baseIndex : 0;
     }
 
     void setFaceType(GLenum ft) {
@@ -28,10 +55,23 @@ public:
         return facetype;
     }
 
+    /**
+     * Draws from source's VAO, offset by range. Both must outlive this.
+     */
+    void setSource(const DrawBuffer* source, const DrawRange* range);
+
     /**
      * Adds a Geometry Buffer to the Draw Buffer.
      */
     void addGeometry(GeometryBuffer* gbuff);
+
+    /**
+     * Points the attributes at a vertex buffer, replacing any added before
+     * for the same semantics. Per instance data is added as a second buffer.
+     */
+    void setVertexBuffer(GLuint vbo, const AttributeList& attributes);
+
+    void setIndexBuffer(GLuint ebo);
 };
 
 #endif
@@ -0,0 +1,224 @@
+#include "gl/GeometryArena.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+void copyBuffer(GLuint from, GLuint to, std::size_t fromOffset,
+                std::size_t toOffset, std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, from);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, to);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                        static_cast<GLintptr>(fromOffset),
+                        static_cast<GLintptr>(toOffset),
+                        static_cast<GLsizeiptr>(size));
+}
+
+GLuint createBuffer(std::size_t size) {
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), nullptr,
+                 GL_STATIC_DRAW);
+    return buffer;
+}
+
+/// Doubles capacity until size more elements fit after the used region
+std::size_t grownCapacity(const SpanAllocator& allocator, std::size_t size) {
+    auto capacity = allocator.getCapacity();
+    while (capacity - allocator.getEnd() < size) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+}  // namespace
+
+GeometryArena::Allocation::Allocation(Allocation&& other) noexcept
+    : arena(std::move(other.arena))
+    , block(std::exchange(other.block, nullptr)) {
+}
+
+GeometryArena::Allocation& GeometryArena::Allocation::operator=(
+    Allocation&& other) noexcept {
+    if (this != &other) {
+        reset();
+        arena = std::move(other.arena);
+        block = std::exchange(other.block, nullptr);
+    }
+    return *this;
+}
+
+GeometryArena::Allocation::~Allocation() {
+    reset();
+}
+
+void GeometryArena::Allocation::reset() {
+    if (block) {
+        arena->release(block);
+        block = nullptr;
+    }
+    arena.reset();
+}
+
+GeometryArena::GeometryArena(GLsizei vertexSize, AttributeList attributes)
+    : vertexSize(vertexSize), attributes(std::move(attributes)) {
+}
+
+GeometryArena::~GeometryArena() {
+    if (vbo != 0) {
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+    }
+}
+
+GeometryArena::Allocation GeometryArena::allocate(std::size_t vertexCount,
+                                                  std::size_t indexCount) {
+    if (vbo == 0) {
+        reallocate(std::max(kInitialVertices, vertexCount),
+                   std::max(kInitialIndices, indexCount), false);
+    }
+
+    auto firstVertex = vertices.allocate(vertexCount);
+    auto firstIndex = indices.allocate(indexCount);
+    if (firstVertex == SpanAllocator::kInvalid ||
+        firstIndex == SpanAllocator::kInvalid) {
+        // Growing keeps every offset, so whatever did fit stays put
+        reallocate(grownCapacity(vertices, vertexCount),
+                   grownCapacity(indices, indexCount), false);
+        if (firstVertex == SpanAllocator::kInvalid) {
+            firstVertex = vertices.allocate(vertexCount);
+        }
+        if (firstIndex == SpanAllocator::kInvalid) {
+            firstIndex = indices.allocate(indexCount);
+        }
+    }
+
+    auto block = std::make_unique<Block>();
+    block->range.baseVertex = static_cast<GLint>(firstVertex);
+    block->range.baseIndex = static_cast<GLuint>(firstIndex);
+    block->vertexCount = vertexCount;
+    block->indexCount = indexCount;
+    block->slot = blocks.size();
+    blocks.push_back(std::move(block));
+
+    return Allocation(shared_from_this(), blocks.back().get());
+}
+
+void GeometryArena::uploadVertices(const Allocation& allocation,
+                                   const void* data) {
+    const auto& block = *allocation.block;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+    glBufferSubData(
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(block.range.baseVertex) * vertexSize,
+        static_cast<GLsizeiptr>(block.vertexCount) * vertexSize, data);
+}
+
+void GeometryArena::uploadIndices(const Allocation& allocation,
+                                  std::size_t first, std::size_t count,
+                                  const Index* data) {
+    const auto& block = *allocation.block;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferSubData(
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>((block.range.baseIndex + first) * sizeof(Index)),
+        static_cast<GLsizeiptr>(count * sizeof(Index)), data);
+}
+
+void GeometryArena::release(Block* block) {
+    vertices.release(static_cast<std::size_t>(block->range.baseVertex),
+                     block->vertexCount);
+    indices.release(block->range.baseIndex, block->indexCount);
+
+    const auto slot = block->slot;
+    std::swap(blocks[slot], blocks.back());
+    blocks[slot]->slot = slot;
+    blocks.pop_back();
+
+    if (shouldCompact()) {
+        compact();
+    }
+}
+
+bool GeometryArena::shouldCompact() const {
+    const auto wasted = vertices.getHoleSize() * vertexSize +
+                        indices.getHoleSize() * sizeof(Index);
+    const auto used = vertices.getEnd() * vertexSize +
+                      indices.getEnd() * sizeof(Index);
+    return wasted >= kCompactMinimumBytes && wasted * 4 > used;
+}
+
+void GeometryArena::compact() {
+    if (vbo == 0) {
+        return;
+    }
+    reallocate(vertices.getCapacity(), indices.getCapacity(), true);
+}
+
+void GeometryArena::reallocate(std::size_t vertexCapacity,
+                               std::size_t indexCapacity, bool pack) {
+    const auto newVbo = createBuffer(vertexCapacity * vertexSize);
+    const auto newEbo = createBuffer(indexCapacity * sizeof(Index));
+
+    if (vbo != 0) {
+        if (pack) {
+            std::vector<Block*> sorted;
+            sorted.reserve(blocks.size());
+            for (auto& block : blocks) {
+                sorted.push_back(block.get());
+            }
+
+            std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+                return a->range.baseVertex < b->range.baseVertex;
+            });
+            std::size_t packed = 0;
+            for (auto block : sorted) {
+                copyBuffer(vbo, newVbo,
+                           static_cast<std::size_t>(block->range.baseVertex) *
+                               vertexSize,
+                           packed * vertexSize,
+                           block->vertexCount * vertexSize);
+                block->range.baseVertex = static_cast<GLint>(packed);
+                packed += block->vertexCount;
+            }
+            vertices.reset(packed);
+
+            std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+                return a->range.baseIndex < b->range.baseIndex;
+            });
+            packed = 0;
+            for (auto block : sorted) {
+                copyBuffer(ebo, newEbo, block->range.baseIndex * sizeof(Index),
+                           packed * sizeof(Index),
+                           block->indexCount * sizeof(Index));
+                block->range.baseIndex = static_cast<GLuint>(packed);
+                packed += block->indexCount;
+            }
+            indices.reset(packed);
+        } else {
+            copyBuffer(vbo, newVbo, 0, 0, vertices.getEnd() * vertexSize);
+            copyBuffer(ebo, newEbo, 0, 0, indices.getEnd() * sizeof(Index));
+        }
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+    }
+
+    vbo = newVbo;
+    ebo = newEbo;
+    vertices.setCapacity(vertexCapacity);
+    indices.setCapacity(indexCapacity);
+
+    // Pointing the VAO at the new buffers binds it, put back whatever the
+    // renderer had bound since it only rebinds when its cached VAO changes.
+    // Growing is rare enough for the query not to matter.
+    GLint boundVao = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVao);
+    drawBuffer.setVertexBuffer(vbo, attributes);
+    drawBuffer.setIndexBuffer(ebo);
+    glBindVertexArray(static_cast<GLuint>(boundVao));
+
+    memory.set(vertexCapacity * vertexSize + indexCapacity * sizeof(Index));
+}
@@ -0,0 +1,143 @@
+#ifndef _LIBRW_GEOMETRYARENA_HPP_
+#define _LIBRW_GEOMETRYARENA_HPP_
+
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/SpanAllocator.hpp>
+#include <gl/gl_core_3_3.h>
+#include <rw/accounting.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Shared vertex and index buffers for model geometry
+ *
+ * Every geometry allocated here uses the same vertex format and lives in one
+ * vertex and one index buffer behind a single VAO, so drawing different
+ * models doesn't switch vertex arrays. Geometries draw from getDrawBuffer()
+ * at the base vertex and index of their allocation (DrawBuffer::setSource).
+ *
+ * Released ranges are reused. Once enough of the buffers are holes they are
+ * compacted, which moves allocations; their DrawRange is updated in place.
+ * The buffers grow when an allocation doesn't fit.
+ *
+ * Must be created with std::make_shared, allocations keep the arena alive.
+ * GL objects are only created by the first allocation.
+ */
+class GeometryArena : public std::enable_shared_from_this<GeometryArena> {
+    struct Block {
+        DrawRange range;
+        std::size_t vertexCount = 0;
+        std::size_t indexCount = 0;
+        /// Position in blocks
+        std::size_t slot = 0;
+    };
+
+public:
+    using Index = std::uint32_t;
+
+    static constexpr std::size_t kInitialVertices = 1u << 18;
+    static constexpr std::size_t kInitialIndices = 1u << 20;
+    /// Holes are only compacted once they waste at least this many bytes
+    static constexpr std::size_t kCompactMinimumBytes = 4u << 20;
+
+    /**
+     * Owns a vertex and index range in the arena, released on destruction
+     */
+    class Allocation {
+    public:
+        Allocation() = default;
+        Allocation(Allocation&& other) noexcept;
+        Allocation& operator=(Allocation&& other) noexcept;
+        ~Allocation();
+
+        void reset();
+
+        explicit operator bool() const {
+            return block != nullptr;
+        }
+
+        /// Stays valid, and current, while the allocation exists
+        const DrawRange* getRange() const {
+            return block ? &block->range : nullptr;
+        }
+
+        std::size_t getVertexCount() const {
+            return block ? block->vertexCount : 0;
+        }
+
+        std::size_t getIndexCount() const {
+            return block ? block->indexCount : 0;
+        }
+
+    private:
+        friend class GeometryArena;
+        Allocation(std::shared_ptr<GeometryArena> arena, Block* block)
+            : arena(std::move(arena)), block(block) {
+        }
+
+        std::shared_ptr<GeometryArena> arena;
+        Block* block = nullptr;
+    };
+
+    GeometryArena(GLsizei vertexSize, AttributeList attributes);
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    Allocation allocate(std::size_t vertexCount, std::size_t indexCount);
+
+    /// Uploads all of the allocation's vertices
+    void uploadVertices(const Allocation& allocation, const void* vertices);
+
+    /// Uploads count indices starting at first, relative to the allocation
+    void uploadIndices(const Allocation& allocation, std::size_t first,
+                       std::size_t count, const Index* indices);
+
+    const DrawBuffer& getDrawBuffer() const {
+        return drawBuffer;
+    }
+
+    /// Moves every allocation to the start of new buffers
+    void compact();
+
+    std::size_t getAllocationCount() const {
+        return blocks.size();
+    }
+
+    std::size_t getVertexCapacity() const {
+        return vertices.getCapacity();
+    }
+
+    std::size_t getIndexCapacity() const {
+        return indices.getCapacity();
+    }
+
+private:
+    void release(Block* block);
+
+    /// Replaces the buffers, either copying them whole or packing blocks
+    void reallocate(std::size_t vertexCapacity, std::size_t indexCapacity,
+                    bool pack);
+
+    bool shouldCompact() const;
+
+    const GLsizei vertexSize;
+    const AttributeList attributes;
+
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    DrawBuffer drawBuffer;
+
+    SpanAllocator vertices;
+    SpanAllocator indices;
+    std::vector<std::unique_ptr<Block>> blocks;
+
+    MemoryAllocation memory{MemoryCategory::Geometry};
+};
+
+#endif
@@ -14,4 +14,5 @@ void GeometryBuffer::uploadVertices(GLsizei num, GLsizeiptr size,
     this->num = num;
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, size, mem, GL_STATIC_DRAW);
+    memory.set(static_cast<std::size_t>(size));
 }
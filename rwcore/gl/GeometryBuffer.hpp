@@ -2,6 +2,7 @@
 #define _LIBRW_GEOMETRYBUFFER_HPP_
 
 #include <gl/gl_core_3_3.h>
+#include <rw/accounting.hpp>
 
 #include <vector>
 
@@ -12,7 +13,11 @@ enum AttributeSemantic {
     ATRS_Position = 0,
     ATRS_Normal = 1,
     ATRS_Colour = 2,
-    ATRS_TexCoord = 3
+    ATRS_TexCoord = 3,
+    /// Per instance inputs, their meaning is up to the shader
+    ATRS_Instance0 = 4,
+    ATRS_Instance1 = 5,
+    ATRS_Instance2 = 6
 };
 
 /**
@@ -24,10 +29,17 @@ struct AttributeIndex {
     GLsizei stride;
     size_t offset;
     GLenum type;
+    /// Instances drawn per element, 0 to advance per vertex
+    GLuint divisor;
 
     AttributeIndex(AttributeSemantic s, GLsizei sz, GLsizei strd, size_t offs,
-                   GLenum type = GL_FLOAT)
-        : sem(s), size(sz), stride(strd), offset(offs), type(type) {
+                   GLenum type = GL_FLOAT, GLuint divisor = 0)
+        : sem(s)
+        , size(sz)
+        , stride(strd)
+        , offset(offs)
+        , type(type)
+        , divisor(divisor) {
     }
 };
 
@@ -42,6 +54,8 @@ class GeometryBuffer {
 
     AttributeList attributes{};
 
+    MemoryAllocation memory{MemoryCategory::Geometry};
+
 public:
     GeometryBuffer() = default;
     template <class T>
@@ -59,6 +73,11 @@ public:
         return num;
     }
 
+    /// Bytes last uploaded to the buffer
+    std::size_t getMemorySize() const {
+        return memory.size();
+    }
+
     /**
      * Uploads Vertex Buffer data from an STL vector
      *
@@ -0,0 +1,126 @@
+#include "gl/NullContext.hpp"
+
+#include <atomic>
+
+#include <gl/gl_core_3_3.h>
+
+namespace {
+template <typename Function>
+struct Null;
+
+template <typename Result, typename... Args>
+struct Null<Result(CODEGEN_FUNCPTR*)(Args...)> {
+    static Result CODEGEN_FUNCPTR call(Args...) {
+        return Result();
+    }
+};
+
+template <typename Function>
+void stub(Function& function) {
+    function = &Null<Function>::call;
+}
+
+std::atomic<GLuint> lastName{0};
+
+void CODEGEN_FUNCPTR genNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; ++i) {
+        names[i] = ++lastName;
+    }
+}
+
+void CODEGEN_FUNCPTR getIntegerv(GLenum, GLint* data) {
+    *data = 0;
+}
+
+const GLubyte* CODEGEN_FUNCPTR getString(GLenum) {
+    return reinterpret_cast<const GLubyte*>("");
+}
+}  // namespace
+
+void loadNullGLFunctions() {
+    // Everything the engine calls, drawing included so that a stray call
+    // outside a context check does nothing rather than crash
+    stub(glActiveTexture);
+    stub(glAttachShader);
+    stub(glBindBuffer);
+    stub(glBindBufferBase);
+    stub(glBindBufferRange);
+    stub(glBindFramebuffer);
+    stub(glBindRenderbuffer);
+    stub(glBindTexture);
+    stub(glBindVertexArray);
+    stub(glBlendFunc);
+    stub(glBlendFuncSeparate);
+    stub(glBufferData);
+    stub(glBufferSubData);
+    stub(glClear);
+    stub(glClearColor);
+    stub(glClearStencil);
+    stub(glColorMask);
+    stub(glCompileShader);
+    stub(glCompressedTexImage2D);
+    stub(glCopyBufferSubData);
+    stub(glCreateProgram);
+    stub(glCreateShader);
+    stub(glDeleteBuffers);
+    stub(glDeleteFramebuffers);
+    stub(glDeleteProgram);
+    stub(glDeleteShader);
+    stub(glDeleteTextures);
+    stub(glDeleteVertexArrays);
+    stub(glDepthFunc);
+    stub(glDepthMask);
+    stub(glDetachShader);
+    stub(glDisable);
+    stub(glDrawArrays);
+    stub(glDrawArraysInstanced);
+    stub(glDrawBuffers);
+    stub(glDrawElements);
+    stub(glDrawElementsBaseVertex);
+    stub(glEnable);
+    stub(glEnableVertexAttribArray);
+    stub(glFramebufferRenderbuffer);
+    stub(glFramebufferTexture2D);
+    stub(glGenerateMipmap);
+    stub(glGetProgramInfoLog);
+    stub(glGetProgramiv);
+    stub(glGetQueryObjectui64v);
+    stub(glGetShaderInfoLog);
+    stub(glGetShaderSource);
+    stub(glGetShaderiv);
+    stub(glGetUniformBlockIndex);
+    stub(glGetUniformLocation);
+    stub(glLinkProgram);
+    stub(glMapBufferRange);
+    stub(glPopDebugGroup);
+    stub(glPushDebugGroup);
+    stub(glQueryCounter);
+    stub(glRenderbufferStorage);
+    stub(glShaderSource);
+    stub(glStencilFunc);
+    stub(glStencilMask);
+    stub(glStencilOp);
+    stub(glTexImage2D);
+    stub(glTexParameteri);
+    stub(glUniform1f);
+    stub(glUniform1i);
+    stub(glUniform2fv);
+    stub(glUniform3fv);
+    stub(glUniform4fv);
+    stub(glUniformBlockBinding);
+    stub(glUniformMatrix4fv);
+    stub(glUnmapBuffer);
+    stub(glUseProgram);
+    stub(glVertexAttribDivisor);
+    stub(glVertexAttribPointer);
+    stub(glViewport);
+
+    glGenBuffers = genNames;
+    glGenFramebuffers = genNames;
+    glGenQueries = genNames;
+    glGenRenderbuffers = genNames;
+    glGenTextures = genNames;
+    glGenVertexArrays = genNames;
+    glGetIntegerv = getIntegerv;
+    glGetString = getString;
+}
@@ -0,0 +1,18 @@
+#ifndef _LIBRW_NULLCONTEXT_HPP_
+#define _LIBRW_NULLCONTEXT_HPP_
+
+/**
+ * @brief Replace the GL entry points with ones that need no context.
+ *
+ * Loaders upload geometry and textures as they read them, so running without
+ * a context would otherwise crash in the first glGenBuffers. After this call
+ * glGen* hand out unique names, glGetIntegerv reports zero, glGetString an
+ * empty string, and every other function does nothing. Nothing is stored, so
+ * this is only useful together with a renderer that doesn't draw, such as
+ * NullRenderer.
+ *
+ * Must be called before anything touches GL and can't be undone.
+ */
+void loadNullGLFunctions();
+
+#endif
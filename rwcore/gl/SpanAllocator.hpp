@@ -0,0 +1,112 @@
+#ifndef _LIBRW_SPANALLOCATOR_HPP_
+#define _LIBRW_SPANALLOCATOR_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
+
+/**
+ * First-fit allocator for spans of elements in a buffer
+ *
+ * Only does the bookkeeping, the storage belongs to the caller. Spans are
+ * taken from the lowest hole that fits, or else from the end of the used
+ * region. Released spans are merged with neighbouring holes, and a hole
+ * reaching the end of the used region shrinks it instead.
+ */
+class SpanAllocator {
+public:
+    static constexpr std::size_t kInvalid =
+        std::numeric_limits<std::size_t>::max();
+
+    explicit SpanAllocator(std::size_t capacity = 0) : capacity(capacity) {
+    }
+
+    /// Returns the offset of the span, or kInvalid when nothing fits
+    std::size_t allocate(std::size_t size) {
+        if (size == 0) {
+            return 0;
+        }
+        for (auto it = holes.begin(); it != holes.end(); ++it) {
+            if (it->second < size) {
+                continue;
+            }
+            const auto offset = it->first;
+            const auto remaining = it->second - size;
+            holes.erase(it);
+            if (remaining > 0) {
+                holes.emplace(offset + size, remaining);
+            }
+            holeSize -= size;
+            return offset;
+        }
+        if (capacity - end < size) {
+            return kInvalid;
+        }
+        const auto offset = end;
+        end += size;
+        return offset;
+    }
+
+    void release(std::size_t offset, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        auto next = holes.lower_bound(offset);
+        if (next != holes.end() && offset + size == next->first) {
+            size += next->second;
+            holeSize -= next->second;
+            next = holes.erase(next);
+        }
+        if (next != holes.begin()) {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset) {
+                offset = prev->first;
+                size += prev->second;
+                holeSize -= prev->second;
+                holes.erase(prev);
+            }
+        }
+        if (offset + size == end) {
+            end = offset;
+        } else {
+            holes.emplace(offset, size);
+            holeSize += size;
+        }
+    }
+
+    /// The caller has moved the contents to a buffer of this size
+    void setCapacity(std::size_t newCapacity) {
+        capacity = newCapacity;
+    }
+
+    /// Forgets every span, leaving [0, used) allocated without holes
+    void reset(std::size_t used) {
+        holes.clear();
+        holeSize = 0;
+        end = used;
+    }
+
+    std::size_t getCapacity() const {
+        return capacity;
+    }
+
+    /// End of the used region
+    std::size_t getEnd() const {
+        return end;
+    }
+
+    /// Free elements before the end of the used region
+    std::size_t getHoleSize() const {
+        return holeSize;
+    }
+
+private:
+    std::size_t capacity;
+    std::size_t end = 0;
+    std::size_t holeSize = 0;
+    /// Offset to size of every free span before end
+    std::map<std::size_t, std::size_t> holes;
+};
+
+#endif
@@ -0,0 +1,297 @@
+#include "gl/TextureCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+
+namespace TextureCompression {
+
+namespace {
+using Block = std::array<std::array<std::uint8_t, 4>, 16>;
+using Colour = std::array<int, 3>;
+
+void readBlock(const std::uint8_t* rgba, int width, int height, int bx,
+               int by, Block& block) {
+    for (int y = 0; y < 4; ++y) {
+        const int sy = std::min(by * 4 + y, height - 1);
+        for (int x = 0; x < 4; ++x) {
+            const int sx = std::min(bx * 4 + x, width - 1);
+            const auto offset = static_cast<std::size_t>(sy) * width + sx;
+            std::copy(rgba + offset * 4, rgba + offset * 4 + 4,
+                      block[y * 4 + x].begin());
+        }
+    }
+}
+
+void writeBlock(const Block& block, int width, int height, int bx, int by,
+                std::uint8_t* rgba) {
+    for (int y = 0; y < 4 && by * 4 + y < height; ++y) {
+        for (int x = 0; x < 4 && bx * 4 + x < width; ++x) {
+            const auto offset =
+                static_cast<std::size_t>(by * 4 + y) * width + bx * 4 + x;
+            std::copy(block[y * 4 + x].begin(), block[y * 4 + x].end(),
+                      rgba + offset * 4);
+        }
+    }
+}
+
+std::uint16_t pack565(const Colour& c) {
+    return static_cast<std::uint16_t>(((c[0] >> 3) << 11) |
+                                      ((c[1] >> 2) << 5) | (c[2] >> 3));
+}
+
+Colour unpack565(std::uint16_t v) {
+    const int r = (v >> 11) & 0x1F;
+    const int g = (v >> 5) & 0x3F;
+    const int b = v & 0x1F;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+void write16(std::uint8_t* out, std::uint16_t v) {
+    out[0] = static_cast<std::uint8_t>(v & 0xFF);
+    out[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+std::uint16_t read16(const std::uint8_t* in) {
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+void compressColour(const Block& block, std::uint8_t* out) {
+    Colour lo{255, 255, 255};
+    Colour hi{0, 0, 0};
+    for (const auto& p : block) {
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::min<int>(lo[c], p[c]);
+            hi[c] = std::max<int>(hi[c], p[c]);
+        }
+    }
+
+    // Pull the endpoints in a little, the extremes are rarely the best fit
+    for (int c = 0; c < 3; ++c) {
+        const int inset = (hi[c] - lo[c]) >> 4;
+        lo[c] += inset;
+        hi[c] -= inset;
+    }
+
+    const auto c0 = pack565(hi);
+    const auto c1 = pack565(lo);
+    write16(out, c0);
+    write16(out + 2, c1);
+
+    std::uint32_t indices = 0;
+    if (c0 != c1) {
+        // c0 > c1 selects the four colour mode, which holds since every
+        // channel of hi is at least the one of lo
+        const auto e0 = unpack565(c0);
+        const auto e1 = unpack565(c1);
+        std::array<Colour, 4> palette{e0, e1, Colour{}, Colour{}};
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+            palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 0x7FFFFFFF;
+            for (int e = 0; e < 4; ++e) {
+                int error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int d = block[i][c] - palette[e][c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    best = e;
+                }
+            }
+            indices |= static_cast<std::uint32_t>(best) << (i * 2);
+        }
+    }
+
+    for (int b = 0; b < 4; ++b) {
+        out[4 + b] = static_cast<std::uint8_t>(indices >> (b * 8));
+    }
+}
+
+void compressAlpha(const Block& block, std::uint8_t* out) {
+    int lo = 255;
+    int hi = 0;
+    for (const auto& p : block) {
+        lo = std::min<int>(lo, p[3]);
+        hi = std::max<int>(hi, p[3]);
+    }
+
+    // a0 > a1 selects eight interpolated values
+    out[0] = static_cast<std::uint8_t>(hi);
+    out[1] = static_cast<std::uint8_t>(lo);
+
+    std::uint64_t indices = 0;
+    if (hi != lo) {
+        std::array<int, 8> palette{hi, lo};
+        for (int e = 2; e < 8; ++e) {
+            palette[e] = ((8 - e) * hi + (e - 1) * lo) / 7;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 256;
+            for (int e = 0; e < 8; ++e) {
+                const int error = std::abs(block[i][3] - palette[e]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = e;
+                }
+            }
+            indices |= static_cast<std::uint64_t>(best) << (i * 3);
+        }
+    }
+
+    for (int b = 0; b < 6; ++b) {
+        out[2 + b] = static_cast<std::uint8_t>(indices >> (b * 8));
+    }
+}
+
+void decompressColour(const std::uint8_t* in, bool allowTransparent,
+                      Block& block) {
+    const auto c0 = read16(in);
+    const auto c1 = read16(in + 2);
+    const auto e0 = unpack565(c0);
+    const auto e1 = unpack565(c1);
+
+    std::array<std::array<std::uint8_t, 4>, 4> palette{};
+    const bool fourColours = c0 > c1 || !allowTransparent;
+    for (int c = 0; c < 3; ++c) {
+        palette[0][c] = static_cast<std::uint8_t>(e0[c]);
+        palette[1][c] = static_cast<std::uint8_t>(e1[c]);
+        if (fourColours) {
+            palette[2][c] = static_cast<std::uint8_t>((2 * e0[c] + e1[c]) / 3);
+            palette[3][c] = static_cast<std::uint8_t>((e0[c] + 2 * e1[c]) / 3);
+        } else {
+            palette[2][c] = static_cast<std::uint8_t>((e0[c] + e1[c]) / 2);
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = fourColours ? 255 : 0;
+
+    const std::uint32_t indices = static_cast<std::uint32_t>(in[4]) |
+                                  static_cast<std::uint32_t>(in[5]) << 8 |
+                                  static_cast<std::uint32_t>(in[6]) << 16 |
+                                  static_cast<std::uint32_t>(in[7]) << 24;
+    for (int i = 0; i < 16; ++i) {
+        block[i] = palette[(indices >> (i * 2)) & 0x3];
+    }
+}
+
+void decompressAlpha(const std::uint8_t* in, Block& block) {
+    const int a0 = in[0];
+    const int a1 = in[1];
+    std::array<int, 8> palette{a0, a1};
+    if (a0 > a1) {
+        for (int e = 2; e < 8; ++e) {
+            palette[e] = ((8 - e) * a0 + (e - 1) * a1) / 7;
+        }
+    } else {
+        for (int e = 2; e < 6; ++e) {
+            palette[e] = ((6 - e) * a0 + (e - 1) * a1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    std::uint64_t indices = 0;
+    for (int b = 0; b < 6; ++b) {
+        indices |= static_cast<std::uint64_t>(in[2 + b]) << (b * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        const auto index = (indices >> (i * 3)) & 0x7;
+        block[i][3] = static_cast<std::uint8_t>(palette[index]);
+    }
+}
+
+int blockCount(int size) {
+    return std::max(1, (size + 3) / 4);
+}
+}  // namespace
+
+std::size_t blockSize(Format format) {
+    return format == Format::BC1 ? 8u : 16u;
+}
+
+std::size_t compressedSize(Format format, int width, int height) {
+    return static_cast<std::size_t>(blockCount(width)) *
+           static_cast<std::size_t>(blockCount(height)) * blockSize(format);
+}
+
+int mipCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+        levels++;
+    }
+    return levels;
+}
+
+void compress(Format format, const std::uint8_t* rgba, int width, int height,
+              std::uint8_t* out) {
+    Block block;
+    for (int by = 0; by < blockCount(height); ++by) {
+        for (int bx = 0; bx < blockCount(width); ++bx) {
+            readBlock(rgba, width, height, bx, by, block);
+            if (format == Format::BC3) {
+                compressAlpha(block, out);
+                out += 8;
+            }
+            compressColour(block, out);
+            out += 8;
+        }
+    }
+}
+
+void decompress(Format format, const std::uint8_t* blocks, int width,
+                int height, std::uint8_t* rgba) {
+    Block block;
+    for (int by = 0; by < blockCount(height); ++by) {
+        for (int bx = 0; bx < blockCount(width); ++bx) {
+            if (format == Format::BC3) {
+                decompressColour(blocks + 8, false, block);
+                decompressAlpha(blocks, block);
+                blocks += 16;
+            } else {
+                decompressColour(blocks, true, block);
+                blocks += 8;
+            }
+            writeBlock(block, width, height, bx, by, rgba);
+        }
+    }
+}
+
+void downsample(const std::uint8_t* rgba, int width, int height,
+                std::vector<std::uint8_t>& out) {
+    const int outWidth = std::max(1, width / 2);
+    const int outHeight = std::max(1, height / 2);
+    out.resize(static_cast<std::size_t>(outWidth) * outHeight * 4);
+
+    auto pixel = [&](int x, int y) {
+        x = std::min(x, width - 1);
+        y = std::min(y, height - 1);
+        return rgba + (static_cast<std::size_t>(y) * width + x) * 4;
+    };
+
+    for (int y = 0; y < outHeight; ++y) {
+        for (int x = 0; x < outWidth; ++x) {
+            const auto* p0 = pixel(x * 2, y * 2);
+            const auto* p1 = pixel(x * 2 + 1, y * 2);
+            const auto* p2 = pixel(x * 2, y * 2 + 1);
+            const auto* p3 = pixel(x * 2 + 1, y * 2 + 1);
+            auto* o = out.data() +
+                      (static_cast<std::size_t>(y) * outWidth + x) * 4;
+            for (int c = 0; c < 4; ++c) {
+                o[c] = static_cast<std::uint8_t>(
+                    (p0[c] + p1[c] + p2[c] + p3[c] + 2) / 4);
+            }
+        }
+    }
+}
+
+}  // namespace TextureCompression
@@ -0,0 +1,48 @@
+#ifndef _LIBRW_TEXTURECOMPRESSION_HPP_
+#define _LIBRW_TEXTURECOMPRESSION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Block compression of RGBA8 images to BC1 and BC3 (DXT1 and DXT5).
+ *
+ * Images are tightly packed RGBA8, four bytes per pixel. Both formats split
+ * the image into 4x4 blocks; partial blocks at the right and bottom edges
+ * repeat the last row and column. The encoder is a fast bounding box fit,
+ * meant for the offline texture cache rather than for best quality.
+ */
+namespace TextureCompression {
+
+enum class Format : std::uint32_t {
+    /// 8 bytes per block, opaque colour only
+    BC1 = 1,
+    /// 16 bytes per block, colour plus interpolated alpha
+    BC3 = 3,
+};
+
+std::size_t blockSize(Format format);
+
+/// Bytes used by a single level of the given size
+std::size_t compressedSize(Format format, int width, int height);
+
+/// Number of levels in a full mip chain, down to 1x1
+int mipCount(int width, int height);
+
+void compress(Format format, const std::uint8_t* rgba, int width, int height,
+              std::uint8_t* out);
+
+void decompress(Format format, const std::uint8_t* blocks, int width,
+                int height, std::uint8_t* rgba);
+
+/**
+ * Produces the next mip level with a box filter. Each dimension is halved
+ * and rounded down, but never below 1.
+ */
+void downsample(const std::uint8_t* rgba, int width, int height,
+                std::vector<std::uint8_t>& out);
+
+}  // namespace TextureCompression
+
+#endif
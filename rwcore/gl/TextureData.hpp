@@ -3,7 +3,9 @@
 
 #include <gl/gl_core_3_3.h>
 #include <glm/vec2.hpp>
+#include <rw/accounting.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -14,7 +16,16 @@
 class TextureData {
 public:
     TextureData(GLuint name, const glm::ivec2& dims, bool alpha)
-        : texName(name), size(dims), hasAlpha(alpha) {
+        : TextureData(name, dims, alpha, estimateSize(dims)) {
+    }
+
+    /// For textures estimateSize doesn't describe, e.g. compressed ones
+    TextureData(GLuint name, const glm::ivec2& dims, bool alpha,
+                std::size_t memorySize)
+        : texName(name)
+        , size(dims)
+        , hasAlpha(alpha)
+        , memory(MemoryCategory::Textures, memorySize) {
     }
 
     ~TextureData() {
@@ -33,15 +44,34 @@ public:
         return hasAlpha;
     }
 
+    /// Estimated video memory used by the texture
+    std::size_t getMemorySize() const {
+        return memory.size();
+    }
+
+    /// RGBA8 with a full mipmap chain, which adds a third to the base level
+    static std::size_t estimateSize(const glm::ivec2& dims) {
+        const auto base = static_cast<std::size_t>(dims.x) *
+                          static_cast<std::size_t>(dims.y) * 4u;
+        return base + base / 3u;
+    }
+
     static auto create(GLuint name, const glm::ivec2& size,
                          bool transparent) {
         return std::make_unique<TextureData>(name, size, transparent);
     }
 
+    static auto create(GLuint name, const glm::ivec2& size, bool transparent,
+                       std::size_t memorySize) {
+        return std::make_unique<TextureData>(name, size, transparent,
+                                             memorySize);
+    }
+
 private:
     GLuint texName;
     glm::ivec2 size;
     bool hasAlpha;
+    MemoryAllocation memory;
 };
 using TextureArchive = std::unordered_map<std::string, std::unique_ptr<TextureData>>;
 
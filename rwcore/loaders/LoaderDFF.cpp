@@ -252,23 +252,62 @@ GeometryPtr LoaderDFF::readGeometry(const RWBStream &stream) {
     geom->dbuff.setFaceType(geom->facetype == Geometry::Triangles
                                 ? GL_TRIANGLES
                                 : GL_TRIANGLE_STRIP);
-    geom->gbuff.uploadVertices(verts);
-    geom->dbuff.addGeometry(&geom->gbuff);
+    uploadGeometry(*geom, verts);
 
-    glGenBuffers(1, &geom->EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom->EBO);
+    if (keepPositions) {
+        geom->positions.reserve(verts.size());
+        for (const auto &v : verts) {
+            geom->positions.push_back(v.position);
+        }
+    }
+
+    size_t modelBytes =
+        sizeof(Geometry) +
+        geom->materials.capacity() * sizeof(Geometry::Material) +
+        geom->subgeom.capacity() * sizeof(SubGeometry) +
+        geom->positions.capacity() * sizeof(glm::vec3);
+    for (const auto &sg : geom->subgeom) {
+        modelBytes += sg.indices.capacity() * sizeof(uint32_t);
+    }
+    for (const auto &material : geom->materials) {
+        modelBytes += material.textures.capacity() * sizeof(Geometry::Texture);
+    }
+    geom->memory.set(modelBytes);
+
+    return geom;
+}
 
+void LoaderDFF::uploadGeometry(Geometry &geom,
+                               const std::vector<GeometryVertex> &verts) {
     size_t icount = std::accumulate(
-        geom->subgeom.begin(), geom->subgeom.end(), size_t{0u},
+        geom.subgeom.begin(), geom.subgeom.end(), size_t{0u},
         [](size_t a, const SubGeometry &b) { return a + b.numIndices; });
+
+    if (geometryArena) {
+        geom.arenaAllocation = geometryArena->allocate(verts.size(), icount);
+        geometryArena->uploadVertices(geom.arenaAllocation, verts.data());
+        for (auto &sg : geom.subgeom) {
+            geometryArena->uploadIndices(geom.arenaAllocation, sg.start,
+                                         sg.numIndices, sg.indices.data());
+        }
+        geom.dbuff.setSource(&geometryArena->getDrawBuffer(),
+                             geom.arenaAllocation.getRange());
+        return;
+    }
+
+    geom.gbuff.uploadVertices(verts);
+    geom.dbuff.addGeometry(&geom.gbuff);
+
+    glGenBuffers(1, &geom.EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geom.EBO);
+
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint32_t) * icount, nullptr,
                  GL_STATIC_DRAW);
-    for (auto &sg : geom->subgeom) {
+    for (auto &sg : geom.subgeom) {
         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sg.start * sizeof(uint32_t),
                         sizeof(uint32_t) * sg.numIndices, sg.indices.data());
     }
-
-    return geom;
+    geom.indexMemory.set(sizeof(uint32_t) * icount);
 }
 
 void LoaderDFF::readMaterialList(const GeometryPtr &geom, const RWBStream &stream) {
@@ -5,6 +5,7 @@
 #include <rw/forward.hpp>
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,8 +37,29 @@ public:
         textureLookup = tlc;
     }
 
+    /**
+     * Loads geometry into the arena instead of creating buffers for each.
+     * The arena must use the GeometryVertex format.
+     */
+    void setGeometryArena(std::shared_ptr<GeometryArena> arena) {
+        geometryArena = std::move(arena);
+    }
+
+    /**
+     * Keeps the vertex positions of the geometry loaded from now on, for
+     * models that are also used on the CPU
+     */
+    void setKeepPositions(bool keep) {
+        keepPositions = keep;
+    }
+
 private:
     TextureLookupCallback textureLookup;
+    std::shared_ptr<GeometryArena> geometryArena;
+    bool keepPositions = false;
+
+    void uploadGeometry(Geometry& geom,
+                        const std::vector<GeometryVertex>& verts);
 
     FrameList readFrameList(const RWBStream& stream);
 
@@ -4,11 +4,14 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
+#include "gl/TextureCompression.hpp"
 #include "gl/gl_core_3_3.h"
 #include "loaders/RWBinaryStream.hpp"
+#include "loaders/TextureCache.hpp"
 #include "platform/FileHandle.hpp"
 #include "rw/debug.hpp"
 
@@ -53,6 +56,39 @@ void processPalette(uint32_t* fullColor, RW::BinaryStreamSection& rootSection) {
     }
 }
 
+static GLenum getWrapMode(uint8_t wrap) {
+    switch (wrap) {
+        default:
+        case RW::BSTextureNative::WRAP_WRAP:
+            return GL_REPEAT;
+        case RW::BSTextureNative::WRAP_CLAMP:
+            return GL_CLAMP_TO_EDGE;
+        case RW::BSTextureNative::WRAP_MIRROR:
+            return GL_MIRRORED_REPEAT;
+    }
+}
+
+/// Applies the TXD filter and wrap modes to the bound texture
+static void setSamplerState(uint16_t filterflags, uint8_t wrapU,
+                            uint8_t wrapV) {
+    GLenum texFilter = GL_LINEAR;
+    switch (filterflags & 0xFF) {
+        default:
+        case RW::BSTextureNative::FILTER_LINEAR:
+            texFilter = GL_LINEAR;
+            break;
+        case RW::BSTextureNative::FILTER_NEAREST:
+            texFilter = GL_NEAREST;
+            break;
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, getWrapMode(wrapU));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, getWrapMode(wrapV));
+}
+
 static std::unique_ptr<TextureData> createTexture(
     RW::BSTextureNative& texNative, RW::BinaryStreamSection& rootSection) {
     // TODO: Exception handling.
@@ -123,58 +159,192 @@ static std::unique_ptr<TextureData> createTexture(
         return getErrorTexture();
     }
 
-    GLenum texFilter = GL_LINEAR;
-    switch (texNative.filterflags & 0xFF) {
-        default:
-        case RW::BSTextureNative::FILTER_LINEAR:
-            texFilter = GL_LINEAR;
-            break;
-        case RW::BSTextureNative::FILTER_NEAREST:
-            texFilter = GL_NEAREST;
-            break;
+    setSamplerState(texNative.filterflags, texNative.wrapU, texNative.wrapV);
+
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    return TextureData::create(textureName, {texNative.width, texNative.height},
+                               transparent);
+}
+
+/// Expands a raster to RGBA8 the same way createTexture uploads it
+static bool decodeRaster(const RW::BSTextureNative& texNative,
+                         RW::BinaryStreamSection& rootSection,
+                         std::vector<uint8_t>& rgba) {
+    if (texNative.platform != 8) {
+        return false;
     }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texFilter);
+    const auto pixels = static_cast<size_t>(texNative.width) * texNative.height;
+    rgba.resize(pixels * 4);
 
-    GLenum texwrap = GL_REPEAT;
-    switch (texNative.wrapU) {
-        default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
-            break;
+    if ((texNative.rasterformat & RW::BSTextureNative::FORMAT_EXT_PAL8) ==
+        RW::BSTextureNative::FORMAT_EXT_PAL8) {
+        std::vector<uint32_t> fullColor(pixels);
+        processPalette(fullColor.data(), rootSection);
+        std::memcpy(rgba.data(), fullColor.data(), rgba.size());
+        return true;
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texwrap);
 
-    switch (texNative.wrapV) {
+    auto coldata = reinterpret_cast<const uint8_t*>(
+        rootSection.raw() + sizeof(RW::BSTextureNative) + sizeof(uint32_t));
+    switch (texNative.rasterformat) {
+        case RW::BSTextureNative::FORMAT_1555:
+            for (size_t i = 0; i < pixels; ++i) {
+                uint16_t v;
+                std::memcpy(&v, coldata + i * 2, sizeof(v));
+                for (int c = 0; c < 3; ++c) {
+                    const auto bits = (v >> (c * 5)) & 0x1F;
+                    rgba[i * 4 + c] = static_cast<uint8_t>(bits * 255 / 31);
+                }
+                rgba[i * 4 + 3] = (v & 0x8000) ? 255 : 0;
+            }
+            return true;
+        case RW::BSTextureNative::FORMAT_8888:
+            coldata += 8;
+            [[fallthrough]];
+        case RW::BSTextureNative::FORMAT_888:
+            for (size_t i = 0; i < pixels; ++i) {
+                rgba[i * 4 + 0] = coldata[i * 4 + 2];
+                rgba[i * 4 + 1] = coldata[i * 4 + 1];
+                rgba[i * 4 + 2] = coldata[i * 4 + 0];
+                rgba[i * 4 + 3] = coldata[i * 4 + 3];
+            }
+            return true;
         default:
-        case RW::BSTextureNative::WRAP_WRAP:
-            texwrap = GL_REPEAT;
-            break;
-        case RW::BSTextureNative::WRAP_CLAMP:
-            texwrap = GL_CLAMP_TO_EDGE;
-            break;
-        case RW::BSTextureNative::WRAP_MIRROR:
-            texwrap = GL_MIRRORED_REPEAT;
-            break;
+            return false;
     }
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texwrap);
+}
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+/// Compresses a raster and its full mip chain for the texture cache
+static bool transcodeTexture(const RW::BSTextureNative& texNative,
+                             RW::BinaryStreamSection& rootSection,
+                             const std::string& name,
+                             TextureCache::Texture& texture) {
+    std::vector<uint8_t> level;
+    if (!decodeRaster(texNative, rootSection, level)) {
+        return false;
+    }
 
-    return TextureData::create(textureName, {texNative.width, texNative.height},
-                               transparent);
+    const bool transparent =
+        !((texNative.rasterformat & RW::BSTextureNative::FORMAT_888) ==
+          RW::BSTextureNative::FORMAT_888);
+    const auto format = transparent ? TextureCompression::Format::BC3
+                                    : TextureCompression::Format::BC1;
+
+    auto& header = texture.header;
+    std::strncpy(header.name, name.c_str(), sizeof(header.name) - 1);
+    header.format = format;
+    header.width = texNative.width;
+    header.height = texNative.height;
+    header.filterFlags = texNative.filterflags;
+    header.wrapU = texNative.wrapU;
+    header.wrapV = texNative.wrapV;
+    header.transparent = transparent;
+
+    int width = texNative.width;
+    int height = texNative.height;
+    const int levels = TextureCompression::mipCount(width, height);
+    header.mipCount = static_cast<uint8_t>(levels);
+
+    std::vector<uint8_t> next;
+    for (int l = 0; l < levels; ++l) {
+        const auto offset = texture.data.size();
+        texture.data.resize(
+            offset + TextureCompression::compressedSize(format, width, height));
+        TextureCompression::compress(format, level.data(), width, height,
+                                     texture.data.data() + offset);
+        if (l + 1 < levels) {
+            TextureCompression::downsample(level.data(), width, height, next);
+            std::swap(level, next);
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+    }
+    return true;
+}
+
+static std::unique_ptr<TextureData> createCompressedTexture(
+    const TextureCache::TextureView& texture) {
+    const auto& header = *texture.header;
+    const auto format = header.format;
+    if ((format != TextureCompression::Format::BC1 &&
+         format != TextureCompression::Format::BC3) ||
+        header.mipCount == 0) {
+        RW_ERROR("Invalid cached texture " << header.name);
+        return getErrorTexture();
+    }
+
+    // Validate the whole chain before handing anything to GL
+    size_t expected = 0;
+    for (int l = 0, w = header.width, h = header.height; l < header.mipCount;
+         ++l, w = std::max(1, w / 2), h = std::max(1, h / 2)) {
+        expected += TextureCompression::compressedSize(format, w, h);
+    }
+    if (expected != header.dataSize) {
+        RW_ERROR("Invalid cached texture " << header.name);
+        return getErrorTexture();
+    }
+
+    // Without S3TC support the blocks are decoded here instead
+    const bool upload = ogl_ext_EXT_texture_compression_s3tc != 0;
+    const GLenum internalFormat = format == TextureCompression::Format::BC1
+                                      ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                      : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+    GLuint textureName = 0;
+    glGenTextures(1, &textureName);
+    glBindTexture(GL_TEXTURE_2D, textureName);
+
+    std::vector<uint8_t> rgba;
+    const uint8_t* data = texture.data;
+    int width = header.width;
+    int height = header.height;
+    for (int l = 0; l < header.mipCount; ++l) {
+        const auto size =
+            TextureCompression::compressedSize(format, width, height);
+        if (upload) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, l, internalFormat, width,
+                                   height, 0, static_cast<GLsizei>(size),
+                                   data);
+        } else {
+            rgba.resize(static_cast<size_t>(width) * height * 4);
+            TextureCompression::decompress(format, data, width, height,
+                                           rgba.data());
+            glTexImage2D(GL_TEXTURE_2D, l, GL_RGBA, width, height, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, rgba.data());
+        }
+        data += size;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.mipCount - 1);
+    setSamplerState(header.filterFlags, header.wrapU, header.wrapV);
+
+    const glm::ivec2 dims{header.width, header.height};
+    return TextureData::create(
+        textureName, dims, header.transparent != 0,
+        upload ? header.dataSize : TextureData::estimateSize(dims));
 }
 
 bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
-                                   TextureArchive& inTextures) {
+                                   TextureArchive& inTextures,
+                                   std::optional<std::uint64_t> cacheKey) {
+    if (cache && cacheKey) {
+        auto entry = cache->open(*cacheKey);
+        if (entry) {
+            for (const auto& texture : entry->textures) {
+                // Not terminated if the name fills the whole field
+                const auto& name = texture.header->name;
+                inTextures[std::string(
+                    name, std::find(name, name + sizeof(name), '\0'))] =
+                    createCompressedTexture(texture);
+            }
+            return true;
+        }
+    }
+
     auto data = file.data.get();
     RW::BinaryStreamSection root(data);
     /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
@@ -197,3 +367,33 @@ bool TextureLoader::loadFromMemory(const FileContentsInfo& file,
 
     return true;
 }
+
+bool TextureLoader::transcode(const FileContentsInfo& file,
+                              std::uint64_t cacheKey,
+                              const TextureCache& cache) {
+    auto data = file.data.get();
+    RW::BinaryStreamSection root(data);
+    /*auto texDict =*/root.readStructure<RW::BSTextureDictionary>();
+
+    std::vector<TextureCache::Texture> textures;
+
+    size_t rootI = 0;
+    while (root.hasMoreData(rootI)) {
+        auto rootSection = root.getNextChildSection(rootI);
+
+        if (rootSection.header.id != RW::SID_TextureNative) continue;
+
+        RW::BSTextureNative texNative =
+            rootSection.readStructure<RW::BSTextureNative>();
+        std::string name = std::string(texNative.diffuseName);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+        // Archives with rasters we can't decode keep loading the slow way
+        textures.emplace_back();
+        if (!transcodeTexture(texNative, rootSection, name, textures.back())) {
+            return false;
+        }
+    }
+
+    return cache.store(cacheKey, textures);
+}
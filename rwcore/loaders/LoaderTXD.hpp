@@ -4,9 +4,39 @@
 #include <gl/TextureData.hpp>
 #include <rw/forward.hpp>
 
+#include <cstdint>
+#include <optional>
+
+class TextureCache;
+
 class TextureLoader {
 public:
-    bool loadFromMemory(const FileContentsInfo& file, TextureArchive& inTextures);
+    /**
+     * Loads every texture of the archive. Given a cache key (see
+     * TextureCache::key) an archive with an entry in the cache is loaded
+     * from that instead.
+     */
+    bool loadFromMemory(const FileContentsInfo& file,
+                        TextureArchive& inTextures,
+                        std::optional<std::uint64_t> cacheKey = std::nullopt);
+
+    /**
+     * Archives with an entry in the cache are loaded from it, as BC1/BC3
+     * textures when S3TC is supported and decoded to RGBA8 otherwise.
+     */
+    void setCache(const TextureCache* textureCache) {
+        cache = textureCache;
+    }
+
+    /**
+     * Compresses every texture of the archive and stores them in the cache.
+     * Fails if any raster format can't be decoded.
+     */
+    static bool transcode(const FileContentsInfo& file, std::uint64_t cacheKey,
+                          const TextureCache& cache);
+
+private:
+    const TextureCache* cache = nullptr;
 };
 
 #endif
@@ -0,0 +1,137 @@
+#include "loaders/TextureCache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "platform/CacheDirectory.hpp"
+#include "rw/debug.hpp"
+#include "rw/hash.hpp"
+
+namespace {
+constexpr char kMagic[4] = {'R', 'W', 'T', 'C'};
+}  // namespace
+
+TextureCache::TextureCache(std::filesystem::path directory)
+    : directory(std::move(directory)) {
+}
+
+std::filesystem::path TextureCache::defaultDirectory() {
+    return userCacheDirectory("textures");
+}
+
+std::uint64_t TextureCache::key(const std::string& source,
+                                std::uintmax_t size, std::int64_t modified) {
+    auto version = kVersion;
+    auto hash = RW::hashBytes(RW::kHashSeed, source.data(), source.size());
+    hash = RW::hashBytes(hash, &size, sizeof(size));
+    hash = RW::hashBytes(hash, &modified, sizeof(modified));
+    return RW::hashBytes(hash, &version, sizeof(version));
+}
+
+std::filesystem::path TextureCache::entryPath(std::uint64_t key) const {
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << key << ".rwtc";
+    return directory / oss.str();
+}
+
+std::optional<TextureCache::Entry> TextureCache::open(std::uint64_t key) const {
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+    auto path = entryPath(key);
+
+    Entry entry;
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec) || !entry.file.open(path) ||
+        entry.file.size() < sizeof(Header)) {
+        return std::nullopt;
+    }
+
+    const auto& header = *reinterpret_cast<const Header*>(entry.file.data());
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion) {
+        RW_MESSAGE("Ignoring invalid texture cache entry " << path);
+        return std::nullopt;
+    }
+
+    std::size_t offset = sizeof(Header);
+    entry.textures.reserve(header.textureCount);
+    for (std::uint32_t t = 0; t < header.textureCount; ++t) {
+        if (entry.file.size() - offset < sizeof(TextureHeader)) {
+            RW_MESSAGE("Truncated texture cache entry " << path);
+            return std::nullopt;
+        }
+        TextureView view;
+        view.header = reinterpret_cast<const TextureHeader*>(
+            entry.file.data() + offset);
+        offset += sizeof(TextureHeader);
+        if (entry.file.size() - offset < view.header->dataSize) {
+            RW_MESSAGE("Truncated texture cache entry " << path);
+            return std::nullopt;
+        }
+        view.data =
+            reinterpret_cast<const std::uint8_t*>(entry.file.data() + offset);
+        offset += view.header->dataSize;
+        entry.textures.push_back(view);
+    }
+
+    return entry;
+}
+
+bool TextureCache::store(std::uint64_t key,
+                         const std::vector<Texture>& textures) const {
+    if (!isEnabled()) {
+        return false;
+    }
+    auto path = entryPath(key);
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Write to a private name first so a reader never maps a partial file
+    auto tempPath = path;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>{}(
+                          std::this_thread::get_id())) +
+                ".tmp";
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.textureCount = static_cast<std::uint32_t>(textures.size());
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& texture : textures) {
+            auto textureHeader = texture.header;
+            textureHeader.dataSize =
+                static_cast<std::uint32_t>(texture.data.size());
+            out.write(reinterpret_cast<const char*>(&textureHeader),
+                      sizeof(textureHeader));
+            out.write(reinterpret_cast<const char*>(texture.data.data()),
+                      static_cast<std::streamsize>(texture.data.size()));
+        }
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Somebody else stored the same archive in the meantime
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path, ec);
+    }
+    return true;
+}
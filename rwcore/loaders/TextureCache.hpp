@@ -0,0 +1,91 @@
+#ifndef _LIBRW_TEXTURECACHE_HPP_
+#define _LIBRW_TEXTURECACHE_HPP_
+
+#include <gl/TextureCompression.hpp>
+#include <platform/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief On-disk cache of texture archives transcoded to BC1/BC3.
+ *
+ * Each TXD gets one entry holding all of its textures block compressed
+ * with a complete mip chain, so loading it needs neither palette expansion
+ * nor mipmap generation. Entries are named by a hash of where the TXD is
+ * stored, its size and modification time, so an edited archive misses
+ * without having to read it first.
+ */
+class TextureCache {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t textureCount;
+        std::uint32_t reserved;
+    };
+
+    /// Precedes the data of each texture, every mip level back to back
+    struct TextureHeader {
+        char name[32];
+        TextureCompression::Format format;
+        std::uint16_t width;
+        std::uint16_t height;
+        /// Sampler state copied from the TXD
+        std::uint16_t filterFlags;
+        std::uint8_t wrapU;
+        std::uint8_t wrapV;
+        std::uint8_t mipCount;
+        std::uint8_t transparent;
+        std::uint16_t reserved;
+        std::uint32_t dataSize;
+    };
+
+    struct Texture {
+        TextureHeader header{};
+        std::vector<std::uint8_t> data;
+    };
+
+    struct TextureView {
+        const TextureHeader* header = nullptr;
+        const std::uint8_t* data = nullptr;
+    };
+
+    struct Entry {
+        MappedFile file;
+        std::vector<TextureView> textures;
+    };
+
+    /// An empty directory disables the cache
+    explicit TextureCache(std::filesystem::path directory = defaultDirectory());
+
+    /// Per user cache directory, empty if there is none
+    static std::filesystem::path defaultDirectory();
+
+    bool isEnabled() const {
+        return !directory.empty();
+    }
+
+    /// Identifies the archive stored at source (see FileIndex::fileStamp)
+    static std::uint64_t key(const std::string& source, std::uintmax_t size,
+                             std::int64_t modified);
+
+    /// Map the entry for the archive, if there is a valid one
+    std::optional<Entry> open(std::uint64_t key) const;
+
+    /// Write the transcoded textures of the archive
+    bool store(std::uint64_t key, const std::vector<Texture>& textures) const;
+
+    std::filesystem::path entryPath(std::uint64_t key) const;
+
+private:
+    std::filesystem::path directory;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#include "platform/CacheDirectory.hpp"
+
+#include <cstdlib>
+#include <system_error>
+
+namespace {
+constexpr auto kCacheDirectoryName = "OpenRW";
+}  // namespace
+
+std::filesystem::path userCacheDirectory(const std::string& kind) {
+    std::filesystem::path base;
+#if defined(RW_WINDOWS)
+    std::error_code ec;
+    base = std::filesystem::temp_directory_path(ec);
+#elif defined(RW_OSX)
+    if (auto home = std::getenv("HOME")) {
+        base = std::filesystem::path(home) / "Library/Caches";
+    }
+#else
+    if (auto cacheHome = std::getenv("XDG_CACHE_HOME")) {
+        base = cacheHome;
+    } else if (auto home = std::getenv("HOME")) {
+        base = std::filesystem::path(home) / ".cache";
+    }
+#endif
+    if (base.empty()) {
+        return {};
+    }
+    return base / kCacheDirectoryName / kind;
+}
@@ -0,0 +1,15 @@
+#ifndef _LIBRW_CACHEDIRECTORY_HPP_
+#define _LIBRW_CACHEDIRECTORY_HPP_
+
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Per user directory for the given kind of cached data.
+ *
+ * Follows the platform conventions (XDG_CACHE_HOME, ~/Library/Caches or the
+ * temporary directory). Returns an empty path if there is none.
+ */
+std::filesystem::path userCacheDirectory(const std::string& kind);
+
+#endif
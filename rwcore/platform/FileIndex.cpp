@@ -31,6 +31,7 @@ void FileIndex::indexTree(const std::filesystem::path &path) {
         }
         auto relPath = path.lexically_relative(basePath);
         std::string relPathName = normalizeFilePath(relPath.string());
+        std::unique_lock lock(indexMutex_);
         indexedData_[relPathName] = {IndexedDataType::FILE, path.string(), ""};
 
         auto filename = normalizeFilePath(path.filename().string());
@@ -38,24 +39,25 @@ void FileIndex::indexTree(const std::filesystem::path &path) {
     }
 }
 
-const FileIndex::IndexedData *FileIndex::getIndexedDataAt(const std::string &filePath) const {
+FileIndex::IndexedData FileIndex::getIndexedDataAt(const std::string &filePath) const {
     auto normPath = normalizeFilePath(filePath);
-    return &indexedData_.at(normPath);
+    std::shared_lock lock(indexMutex_);
+    return indexedData_.at(normPath);
 }
 
 std::filesystem::path FileIndex::findFilePath(const std::string &filePath) const {
-    return getIndexedDataAt(filePath)->path;
+    return getIndexedDataAt(filePath).path;
 }
 
 FileContentsInfo FileIndex::openFileRaw(const std::string &filePath) const {
-    const auto *indexData = getIndexedDataAt(filePath);
-    std::ifstream dfile(indexData->path, std::ios::binary);
+    const auto indexData = getIndexedDataAt(filePath);
+    std::ifstream dfile(indexData.path, std::ios::binary);
     if (!dfile.is_open()) {
         throw std::runtime_error("Unable to open file: " + filePath);
     }
 
 #ifdef RW_DEBUG
-    if (indexData->type != IndexedDataType::FILE) {
+    if (indexData.type != IndexedDataType::FILE) {
         RW_MESSAGE("Reading raw data from archive \"" << filePath << "\"");
     }
 #endif
@@ -72,11 +74,12 @@ FileContentsInfo FileIndex::openFileRaw(const std::string &filePath) const {
 void FileIndex::indexArchive(const std::string &archive) {
     std::filesystem::path path = findFilePath(archive);
 
-    LoaderIMG& img = loaders_[path.string()];
+    LoaderIMG img;
     if (!img.load(path.string())) {
         throw std::runtime_error("Failed to load IMG archive: " + path.string());
     }
 
+    std::unique_lock lock(indexMutex_);
     for (size_t i = 0; i < img.getAssetCount(); ++i) {
         auto &asset = img.getAssetInfoByIndex(i);
 
@@ -86,33 +89,43 @@ void FileIndex::indexArchive(const std::string &archive) {
 
         indexedData_[assetName] = {IndexedDataType::ARCHIVE, path.string(), asset.name};
     }
+    // Readers may hold on to a loader, one indexed before is kept as it is
+    loaders_.try_emplace(path.string(), std::move(img));
 }
 
 FileContentsInfo FileIndex::openFile(const std::string &filePath) {
     auto cleanFilePath = normalizeFilePath(filePath);
-    auto indexedDataPos = indexedData_.find(cleanFilePath);
 
-    if (indexedDataPos == indexedData_.end()) {
-        return {nullptr, 0};
+    // Copied so that indexing can carry on while the file is read
+    IndexedData indexedData;
+    LoaderIMG* loader = nullptr;
+    {
+        std::shared_lock lock(indexMutex_);
+        auto indexedDataPos = indexedData_.find(cleanFilePath);
+        if (indexedDataPos == indexedData_.end()) {
+            return {nullptr, 0};
+        }
+        indexedData = indexedDataPos->second;
+
+        if (indexedData.type == IndexedDataType::ARCHIVE) {
+            auto loaderPos = loaders_.find(indexedData.path);
+            if (loaderPos == loaders_.end()) {
+                throw std::runtime_error("IMG archive not indexed: " + indexedData.path);
+            }
+            loader = &loaderPos->second;
+        }
     }
 
-    const auto &indexedData = indexedDataPos->second;
-
     std::unique_ptr<char[]> data = nullptr;
     size_t length = 0;
 
-    if (indexedData.type == IndexedDataType::ARCHIVE) {
-        auto loaderPos = loaders_.find(indexedData.path);
-        if (loaderPos == loaders_.end()) {
-            throw std::runtime_error("IMG archive not indexed: " + indexedData.path);
-        }
-
-        auto& loader = loaderPos->second;
+    if (loader) {
         LoaderIMGFile file;
         auto filename = std::filesystem::path(indexedData.assetData).filename().string();
-        if (loader.findAssetInfo(filename, file)) {
+        std::lock_guard<std::mutex> lock(archiveMutex_);
+        if (loader->findAssetInfo(filename, file)) {
             length = file.size * 2048;
-            data = loader.loadToMemory(filename);
+            data = loader->loadToMemory(filename);
         }
     } else {
         std::ifstream dfile(indexedData.path, std::ios::binary);
@@ -129,3 +142,53 @@ FileContentsInfo FileIndex::openFile(const std::string &filePath) {
 
     return {std::move(data), length};
 }
+
+std::vector<std::string> FileIndex::findFilesWithExtension(
+    const std::string &extension) const {
+    std::vector<std::string> files;
+    std::shared_lock lock(indexMutex_);
+    for (const auto &[name, data] : indexedData_) {
+        // Files on disk are indexed by both relative path and file name
+        if (name.find('/') != std::string::npos ||
+            name.size() < extension.size() ||
+            name.compare(name.size() - extension.size(), extension.size(),
+                         extension) != 0) {
+            continue;
+        }
+        files.push_back(name);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::optional<FileIndex::FileStamp> FileIndex::fileStamp(
+    const std::string &filePath) const {
+    IndexedData indexedData;
+    {
+        std::shared_lock lock(indexMutex_);
+        auto indexedDataPos = indexedData_.find(normalizeFilePath(filePath));
+        if (indexedDataPos == indexedData_.end()) {
+            return std::nullopt;
+        }
+        indexedData = indexedDataPos->second;
+    }
+
+    FileStamp stamp;
+    stamp.source = indexedData.path;
+    if (indexedData.type == IndexedDataType::ARCHIVE) {
+        stamp.source += ":" + indexedData.assetData;
+    }
+
+    std::error_code ec;
+    stamp.size = std::filesystem::file_size(indexedData.path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto mtime = std::filesystem::last_write_time(indexedData.path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    stamp.modified =
+        static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    return stamp;
+}
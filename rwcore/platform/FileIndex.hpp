@@ -1,9 +1,15 @@
 #ifndef _LIBRW_FILEINDEX_HPP_
 #define _LIBRW_FILEINDEX_HPP_
 
+#include <cstdint>
 #include <filesystem>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
 
 #include <loaders/LoaderIMG.hpp>
 #include <rw/forward.hpp>
@@ -11,6 +17,17 @@
 
 class FileIndex {
 public:
+    /**
+     * @brief Identifies the current contents of an indexed file
+     */
+    struct FileStamp {
+        /// Path on disk, followed by the member name for archived files
+        std::string source;
+        /// Size and modification time of the file on disk
+        std::uintmax_t size;
+        std::int64_t modified;
+    };
+
     /**
      * @brief normalizeString Normalize a file path
      * @param filePath the path to normalize
@@ -54,11 +71,31 @@ public:
     /**
      * Returns a FileHandle for the file if it can be found in the
      * file index, otherwise an empty FileHandle is returned.
+     *
+     * This may be called from several threads, also while other threads
+     * are still indexing.
      * @param filePath name of the file to open
      * @return FileHandle to the file, nullptr if this FileINdexed has not indexed the path
      */
     FileContentsInfo openFile(const std::string &filePath);
 
+    /**
+     * @brief findFilesWithExtension lists the indexed files of a type
+     * @param extension lower case extension including the dot, e.g. ".txd"
+     * @return sorted file names that can be passed to openFile, each file
+     * is listed once even if it is indexed under several paths
+     */
+    std::vector<std::string> findFilesWithExtension(
+        const std::string &extension) const;
+
+    /**
+     * @brief fileStamp identifies a file without reading it
+     * @param filePath the file to identify
+     * @return the stamp, which changes whenever the file on disk holding it
+     * is written, nothing if the file isn't indexed or can't be found
+     */
+    std::optional<FileStamp> fileStamp(const std::string &filePath) const;
+
 private:
     /**
      * @brief Type of the indexed data.
@@ -90,15 +127,27 @@ private:
     /**
      * @brief getIndexedDataAt Get IndexedData for filePath
      * @param filePath the file path to get the IndexedData for
-     * @return IndexedData pointer if this FileIndex has indexed the filePath
+     * @return copy of the IndexedData if this FileIndex has indexed the
+     * filePath, indexing may replace the entry afterwards
      * @throws If this FileIndex has not indexed filePath
      */
-    const IndexedData *getIndexedDataAt(const std::string &filePath) const;
+    IndexedData getIndexedDataAt(const std::string &filePath) const;
 
     /**
      * @brief loaders_ Maps .img filepaths to its respective loader
      */
     std::unordered_map<std::string, LoaderIMG> loaders_;
+
+    /**
+     * @brief indexMutex_ Guards indexedData_ and loaders_, lookups share it
+     * and indexing takes it exclusively
+     */
+    mutable std::shared_mutex indexMutex_;
+
+    /**
+     * @brief archiveMutex_ Serialises reads through the archive streams
+     */
+    std::mutex archiveMutex_;
 };
 
 #endif
@@ -0,0 +1,122 @@
+#include "platform/MappedFile.hpp"
+
+#include <utility>
+
+#ifdef RW_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    open(path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(mapping, other.mapping);
+        std::swap(length, other.length);
+#ifdef RW_WINDOWS
+        std::swap(fileHandle, other.fileHandle);
+        std::swap(mappingHandle, other.mappingHandle);
+#endif
+    }
+    return *this;
+}
+
+#ifdef RW_WINDOWS
+bool MappedFile::open(const std::filesystem::path& path) {
+    close();
+
+    auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ,
+                            FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto map = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (map == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    auto view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(map);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = map;
+    mapping = view;
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping) {
+        UnmapViewOfFile(mapping);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    mapping = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+}
+#else
+bool MappedFile::open(const std::filesystem::path& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    auto size = static_cast<std::size_t>(info.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    mapping = view;
+    length = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapping) {
+        munmap(mapping, length);
+    }
+    mapping = nullptr;
+    length = 0;
+}
+#endif
@@ -0,0 +1,49 @@
+#ifndef _LIBRW_MAPPEDFILE_HPP_
+#define _LIBRW_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Pages are loaded by the OS on first access, so opening a large file is
+ * cheap and only the parts that are read end up resident.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    bool isOpen() const {
+        return mapping != nullptr;
+    }
+
+    const char* data() const {
+        return static_cast<const char*>(mapping);
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    void* mapping = nullptr;
+    std::size_t length = 0;
+#ifdef RW_WINDOWS
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "rw/accounting.hpp"
+
+#include <atomic>
+
+namespace {
+struct Counters {
+    std::atomic<std::int64_t> live{0};
+    std::atomic<std::int64_t> peak{0};
+    std::atomic<std::int64_t> allocations{0};
+};
+
+std::array<Counters, MemoryAccounting::kCategoryCount>& counters() {
+    static std::array<Counters, MemoryAccounting::kCategoryCount> counters;
+    return counters;
+}
+
+Counters& countersFor(MemoryCategory category) {
+    return counters()[static_cast<std::size_t>(category)];
+}
+}  // namespace
+
+namespace MemoryAccounting {
+
+const std::array<char const*, kCategoryCount> kCategoryNames{
+    {"models", "geometry", "textures", "sounds", "audioBuffers", "collision",
+     "objects", "animations"}};
+
+void add(MemoryCategory category, std::int64_t bytes,
+         std::int64_t allocations) {
+    auto& c = countersFor(category);
+    c.allocations.fetch_add(allocations, std::memory_order_relaxed);
+    const auto live =
+        c.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = c.peak.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !c.peak.compare_exchange_weak(peak, live,
+                                         std::memory_order_relaxed)) {
+    }
+}
+
+Totals get(MemoryCategory category) {
+    const auto& c = countersFor(category);
+    Totals totals;
+    totals.live = c.live.load(std::memory_order_relaxed);
+    totals.peak = c.peak.load(std::memory_order_relaxed);
+    totals.allocations = c.allocations.load(std::memory_order_relaxed);
+    return totals;
+}
+
+std::int64_t live() {
+    std::int64_t total = 0;
+    for (const auto& c : counters()) {
+        total += c.live.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void resetPeaks() {
+    for (auto& c : counters()) {
+        c.peak.store(c.live.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    }
+}
+
+}  // namespace MemoryAccounting
+
+void MemoryAllocation::set(std::size_t size) {
+    if (size == bytes) {
+        return;
+    }
+    const auto delta =
+        static_cast<std::int64_t>(size) - static_cast<std::int64_t>(bytes);
+    const std::int64_t allocations = (bytes == 0) - (size == 0);
+    bytes = size;
+    MemoryAccounting::add(category, delta, allocations);
+}
@@ -0,0 +1,111 @@
+#ifndef _LIBRW_ACCOUNTING_HPP_
+#define _LIBRW_ACCOUNTING_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Kinds of memory tracked by MemoryAccounting
+ */
+enum class MemoryCategory : std::size_t {
+    /// Model data kept in system memory
+    Models,
+    /// GL vertex and index buffers
+    Geometry,
+    /// GL textures, estimated from their size and format
+    Textures,
+    /// Decoded sound samples
+    Sounds,
+    /// OpenAL buffers
+    AudioBuffers,
+    /// Collision models and physics shapes
+    Collision,
+    /// Game objects in the world's pools
+    Objects,
+    /// Compiled animation clips
+    Animations,
+    Count
+};
+
+/**
+ * Live totals of tracked memory, in bytes
+ *
+ * These are sums of what each owner reports through a MemoryAllocation, not
+ * hooks into the allocator, so they leave out small bookkeeping overhead.
+ * Every function is thread safe.
+ */
+namespace MemoryAccounting {
+
+struct Totals {
+    std::int64_t live = 0;
+    std::int64_t peak = 0;
+    /// Number of owners currently holding memory
+    std::int64_t allocations = 0;
+};
+
+constexpr std::size_t kCategoryCount =
+    static_cast<std::size_t>(MemoryCategory::Count);
+
+extern const std::array<char const*, kCategoryCount> kCategoryNames;
+
+void add(MemoryCategory category, std::int64_t bytes,
+         std::int64_t allocations);
+
+Totals get(MemoryCategory category);
+
+/// Live bytes over every category
+std::int64_t live();
+
+/// Sets every peak to the current live total
+void resetPeaks();
+
+}  // namespace MemoryAccounting
+
+/**
+ * Reports the memory held by its owner to MemoryAccounting
+ *
+ * Declared as a member next to the memory it describes and updated with
+ * set() whenever that memory changes size. Destroying it releases whatever
+ * it reported; copying it reports the same size again for the copy.
+ */
+class MemoryAllocation {
+public:
+    explicit MemoryAllocation(MemoryCategory category, std::size_t bytes = 0)
+        : category(category) {
+        set(bytes);
+    }
+
+    MemoryAllocation(const MemoryAllocation& other)
+        : MemoryAllocation(other.category, other.bytes) {
+    }
+
+    MemoryAllocation& operator=(const MemoryAllocation& other) {
+        if (this != &other) {
+            set(0);
+            category = other.category;
+            set(other.bytes);
+        }
+        return *this;
+    }
+
+    ~MemoryAllocation() {
+        set(0);
+    }
+
+    void set(std::size_t size);
+
+    std::size_t size() const {
+        return bytes;
+    }
+
+    MemoryCategory getCategory() const {
+        return category;
+    }
+
+private:
+    MemoryCategory category;
+    std::size_t bytes = 0;
+};
+
+#endif
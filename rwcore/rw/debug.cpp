@@ -1,9 +1,11 @@
 //
 // Created by jason.lu on 2024/12/23.
 //
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include "types.hpp"
 #include "debug.hpp"
 
@@ -17,6 +19,13 @@ const char *RW_State_currently_in = RW_COMPONENT_NAMES[RW_COMPONENT::RWC_ENGINE_
 static RW_TRACE_KIND Current_Cmd_Opt = TRACE_ERROR;
 static RW_TRACE_KIND Trace_opts[RW_COMPONENT_MAX];
 
+static_assert((RW_TRACE_RING_LINES & (RW_TRACE_RING_LINES - 1)) == 0,
+              "Trace ring size must be a power of two");
+// Static storage so the ring is still intact when we are quitting on a fault
+static char Trace_ring[RW_TRACE_RING_LINES][RW_TRACE_LINE_LENGTH];
+static std::atomic<UINT64> Trace_ring_head{0};
+static std::function<void(const char *)> Trace_sink;
+
 void RW_Assertion_Failure_Print ( const char *fmt, ... )
 {
     va_list vp;
@@ -51,10 +60,52 @@ void RW_Failure_print ( const char *fmt, ... )
     exit(EXIT_COMP_ERR);
 }
 
+/***
+ *  Record a trace line in the ring and pass it on
+ **/
+void RW_Trace_print(FILE *file, const char *fmt, ...) {
+    const UINT64 index = Trace_ring_head.fetch_add(1, std::memory_order_relaxed);
+    char *msg = Trace_ring[index & (RW_TRACE_RING_LINES - 1)];
+
+    va_list vp;
+    va_start(vp, fmt);
+    vsnprintf(msg, RW_TRACE_LINE_LENGTH, fmt, vp);
+    va_end(vp);
+
+    if (Trace_sink) {
+        Trace_sink(msg);
+    } else {
+        fputs(msg, file);
+    }
+}
+
+void RW_set_trace_sink(std::function<void(const char *)> sink) {
+    Trace_sink = std::move(sink);
+}
+
+/***
+ *  Write out the most recent trace lines, oldest first
+ **/
+void RW_dump_trace_ring(FILE *file) {
+    const UINT64 head = Trace_ring_head.load(std::memory_order_acquire);
+    const UINT64 count = head < RW_TRACE_RING_LINES ? head : RW_TRACE_RING_LINES;
+    fprintf(file, "### Last %llu trace lines:\n", count);
+    for (UINT64 i = head - count; i < head; i++) {
+        const char *msg = Trace_ring[i & (RW_TRACE_RING_LINES - 1)];
+        const size_t len = strnlen(msg, RW_TRACE_LINE_LENGTH);
+        fwrite(msg, 1, len, file);
+        if (len == 0 || msg[len - 1] != '\n') {
+            fputc('\n', file);
+        }
+    }
+    fflush(file);
+}
+
 /***
  *  Quit the processing with trace
  **/
 void RW_Quit_with_tracing(const char * file, UINT32 line) {
+    RW_dump_trace_ring(stderr);
     // In case we don't want to expose the source code,
     // we could remove it compile-time by specify OCC_NO_TRACE_LINENO
     // we could remove it run-time by specify TRACE_OPT_NOLINENO
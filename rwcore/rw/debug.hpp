@@ -1,9 +1,11 @@
 #ifndef _LIBRW_DEBUG_HPP_
 #define _LIBRW_DEBUG_HPP_
 
+#include <cstdio>
+#include <functional>
+
 #ifdef RW_DEBUG
 #include <cstdlib>
-#include <functional>
 
 extern std::function<void()> _rw_abort_cb[2];
 #define SET_RW_ABORT_CB(cb0, cb1) do { _rw_abort_cb[0] = cb0; _rw_abort_cb[1] = cb1;} while (0)
@@ -96,8 +98,8 @@ typedef unsigned long long UINT64;
 
 #define TFile stderr
 #define RW_TFile stderr
-#define Is_Trace(cond, printval) { if ((cond)) { fprintf printval; fflush(stderr); } }
-#define RW_TRACE(cond, printval) { if ((cond)) { fprintf printval; fflush(stderr); } }
+#define Is_Trace(cond, printval) { if ((cond)) { RW_Trace_print printval; } }
+#define RW_TRACE(cond, printval) { if ((cond)) { RW_Trace_print printval; } }
 #define RWT Tracing
 
 extern void RW_Quit_with_tracing(const char *, unsigned int); // Quiting
@@ -105,6 +107,23 @@ extern void RW_Assertion_Failure_Print ( const char *fmt, ... ); // Printf-like
 extern const char * RW_State_currently_in; // Compilation Phase currently in
 extern void RW_Failure_print ( const char *fmt, ... ); // Compilation Failure message printing
 
+#if defined(__GNUC__)
+#define RW_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define RW_PRINTF_FORMAT(fmt, args)
+#endif
+
+// Trace ring
+// RW_TRACE formats into a fixed in-memory ring of recent lines, which
+// RW_Quit_with_tracing dumps. Lines are then passed to the trace sink, or
+// written to the given file when no sink is set.
+#define RW_TRACE_RING_LINES 1024
+#define RW_TRACE_LINE_LENGTH 256
+extern void RW_Trace_print(FILE *file, const char *fmt, ...) RW_PRINTF_FORMAT(2, 3);
+// Set once at startup, before any thread traces. Pass nullptr to reset.
+extern void RW_set_trace_sink(std::function<void(const char *)> sink);
+extern void RW_dump_trace_ring(FILE *file);
+
 typedef enum {
     EXIT_NORMAL = 0,
     EXIT_UNKNOWN = 1,
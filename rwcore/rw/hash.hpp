@@ -0,0 +1,24 @@
+#ifndef _LIBRW_HASH_HPP_
+#define _LIBRW_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RW {
+
+constexpr std::uint64_t kHashSeed = 14695981039346656037ull;
+
+/// FNV-1a, stable across runs and platforms unlike std::hash
+inline std::uint64_t hashBytes(std::uint64_t hash, const void* data,
+                               std::size_t size) {
+    auto bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace RW
+
+#endif
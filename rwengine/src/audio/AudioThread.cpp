@@ -0,0 +1,143 @@
+#include "audio/AudioThread.hpp"
+
+#include <algorithm>
+
+#include <al.h>
+
+#include "audio/SoundBuffer.hpp"
+#include "audio/alCheck.hpp"
+#include "core/Profiler.hpp"
+
+AudioThread::~AudioThread() {
+    stop();
+}
+
+void AudioThread::start() {
+    if (running) {
+        return;
+    }
+    running = true;
+    thread = std::thread(&AudioThread::run, this);
+}
+
+void AudioThread::stop() {
+    if (!running) {
+        return;
+    }
+    running = false;
+    wake.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void AudioThread::push(AudioCommand&& command) {
+    if (command.buffer) {
+        command.buffer->pendingCommands++;
+    }
+
+    // Without a thread (e.g. OpenAL failed to initialise) apply in place
+    if (!running) {
+        execute(command);
+        return;
+    }
+
+    while (!commands.push(std::move(command))) {
+        // Only reached if the audio thread falls kQueueSize commands behind
+        wake.notify_one();
+        std::this_thread::yield();
+    }
+    wake.notify_one();
+}
+
+void AudioThread::run() {
+    RW_PROFILE_THREAD("Audio");
+
+    AudioCommand command;
+    while (running) {
+        while (commands.pop(command)) {
+            execute(command);
+            command.buffer.reset();
+        }
+
+        update();
+
+        // A notify racing with this wait is only seen after kRefillPeriod,
+        // which is fine: the producer never waits on us.
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, kRefillPeriod,
+                      [this] { return !commands.empty() || !running; });
+    }
+
+    while (commands.pop(command)) {
+        execute(command);
+        command.buffer.reset();
+    }
+    active.clear();
+}
+
+void AudioThread::execute(AudioCommand& command) {
+    auto& buffer = command.buffer;
+
+    switch (command.type) {
+        case AudioCommand::Type::Play:
+            buffer->play();
+            if (std::find(active.begin(), active.end(), buffer) ==
+                active.end()) {
+                active.push_back(buffer);
+            }
+            break;
+        case AudioCommand::Type::Pause:
+            buffer->pause();
+            break;
+        case AudioCommand::Type::Stop:
+            buffer->stop();
+            break;
+        case AudioCommand::Type::Position:
+            buffer->setPosition(command.position);
+            break;
+        case AudioCommand::Type::Gain:
+            buffer->setGain(command.value);
+            break;
+        case AudioCommand::Type::Pitch:
+            buffer->setPitch(command.value);
+            break;
+        case AudioCommand::Type::Looping:
+            buffer->setLooping(command.value != 0.f);
+            break;
+        case AudioCommand::Type::MaxDistance:
+            buffer->setMaxDistance(command.value);
+            break;
+        case AudioCommand::Type::Listener: {
+            const auto& at = command.at;
+            const auto& up = command.up;
+            const auto& pos = command.position;
+            float orientation[6] = {at.x, at.y, at.z, up.x, up.y, up.z};
+            float position[3] = {pos.x, pos.y, pos.z};
+            alCheck(alListenerfv(AL_ORIENTATION, orientation));
+            alCheck(alListenerfv(AL_POSITION, position));
+        } break;
+    }
+
+    if (buffer) {
+        buffer->updateObservedState();
+        buffer->pendingCommands--;
+    }
+}
+
+void AudioThread::update() {
+    RW_PROFILE_SCOPE(__func__);
+
+    for (auto it = active.begin(); it != active.end();) {
+        auto& buffer = *it;
+        bool streaming = buffer->refill();
+        buffer->updateObservedState();
+
+        ALint state = buffer->observedState;
+        if (!streaming && state != AL_PLAYING && state != AL_PAUSED) {
+            it = active.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef _RWENGINE_AUDIOTHREAD_HPP_
+#define _RWENGINE_AUDIOTHREAD_HPP_
+
+#include <core/SPSCQueue.hpp>
+
+#include <glm/vec3.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SoundBuffer;
+
+/// Request for the audio thread, pushed by the game thread.
+struct AudioCommand {
+    enum class Type : std::uint8_t {
+        Play,
+        Pause,
+        Stop,
+        Position,
+        Gain,
+        Pitch,
+        Looping,
+        MaxDistance,
+        Listener,
+    };
+
+    Type type = Type::Play;
+    /// Target buffer, unused for Listener
+    std::shared_ptr<SoundBuffer> buffer;
+    /// Source position, or listener position
+    glm::vec3 position{};
+    /// Listener orientation
+    glm::vec3 at{};
+    glm::vec3 up{};
+    /// Gain, pitch, max distance or looping (non zero)
+    float value = 0.f;
+};
+
+/// Thread that owns OpenAL playback.
+///
+/// The game thread only pushes AudioCommands to a lock-free queue, the audio
+/// thread applies them, refills streamed buffers and publishes the state of
+/// every source it plays in SoundBuffer::observedState.
+class AudioThread {
+public:
+    static constexpr std::size_t kQueueSize = 1024;
+    /// Upper bound of time between two refills of streamed buffers
+    static constexpr std::chrono::milliseconds kRefillPeriod =
+        std::chrono::milliseconds(10);
+
+    AudioThread() = default;
+    ~AudioThread();
+
+    AudioThread(const AudioThread&) = delete;
+    AudioThread& operator=(const AudioThread&) = delete;
+
+    void start();
+    /// Stop the thread, applying commands still in the queue first
+    void stop();
+
+    bool isRunning() const {
+        return running;
+    }
+
+    /// Queue a command, must be called from a single (game) thread.
+    void push(AudioCommand&& command);
+
+private:
+    void run();
+    void execute(AudioCommand& command);
+    void update();
+
+    SPSCQueue<AudioCommand, kQueueSize> commands;
+
+    /// Buffers that have been played and are not stopped yet.
+    /// Only touched by the audio thread.
+    std::vector<std::shared_ptr<SoundBuffer>> active;
+
+    std::atomic<bool> running{false};
+    std::thread thread;
+
+    /// Used only to sleep until the next command or refill
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+};
+
+#endif
@@ -0,0 +1,188 @@
+#include "audio/PCMCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <platform/CacheDirectory.hpp>
+#include <rw/debug.hpp>
+#include <rw/hash.hpp>
+
+namespace {
+constexpr char kMagic[4] = {'R', 'W', 'P', 'C'};
+}  // namespace
+
+PCMCache::PCMCache(std::filesystem::path directory, std::uintmax_t maxBytes)
+    : directory(std::move(directory)), maxBytes(maxBytes) {
+}
+
+std::filesystem::path PCMCache::defaultDirectory() {
+    return userCacheDirectory("audio");
+}
+
+std::filesystem::path PCMCache::entryPath(
+    const std::filesystem::path& source) const {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(source, ec);
+    if (ec) {
+        return {};
+    }
+    auto mtime = std::filesystem::last_write_time(source, ec);
+    if (ec) {
+        return {};
+    }
+
+    auto name = source.generic_string();
+    auto ticks = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    auto version = kVersion;
+
+    auto hash = RW::hashBytes(RW::kHashSeed, name.data(), name.size());
+    hash = RW::hashBytes(hash, &size, sizeof(size));
+    hash = RW::hashBytes(hash, &ticks, sizeof(ticks));
+    hash = RW::hashBytes(hash, &version, sizeof(version));
+
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash << ".pcm";
+    return directory / oss.str();
+}
+
+std::optional<PCMCache::Entry> PCMCache::open(
+    const std::filesystem::path& source) const {
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+    auto path = entryPath(source);
+    if (path.empty()) {
+        return std::nullopt;
+    }
+
+    Entry entry;
+    if (!entry.file.open(path) || entry.file.size() < sizeof(Header)) {
+        return std::nullopt;
+    }
+
+    entry.header = reinterpret_cast<const Header*>(entry.file.data());
+    const auto& header = *entry.header;
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kVersion || header.channels == 0 ||
+        entry.file.size() - sizeof(Header) !=
+            header.sampleCount * sizeof(std::int16_t)) {
+        RW_MESSAGE("Ignoring invalid audio cache entry " << path);
+        return std::nullopt;
+    }
+
+    entry.samples = reinterpret_cast<const std::int16_t*>(entry.file.data() +
+                                                          sizeof(Header));
+
+    // The modification time doubles as the last use for eviction
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), ec);
+    return entry;
+}
+
+bool PCMCache::store(const std::filesystem::path& source,
+                     std::uint32_t channels, std::uint32_t sampleRate,
+                     std::uint32_t decodedFrames, const std::int16_t* samples,
+                     std::size_t sampleCount) const {
+    if (!isEnabled() || sampleCount == 0) {
+        return false;
+    }
+    auto path = entryPath(source);
+    if (path.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // Write to a private name first so a reader never maps a partial file
+    auto tempPath = path;
+    tempPath += "." + std::to_string(std::hash<std::thread::id>{}(
+                          std::this_thread::get_id())) +
+                ".tmp";
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.channels = channels;
+    header.sampleRate = sampleRate;
+    header.sampleCount = sampleCount;
+    header.decodedFrames = decodedFrames;
+
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(samples),
+                  static_cast<std::streamsize>(sampleCount *
+                                               sizeof(std::int16_t)));
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        // Somebody else stored the same source in the meantime
+        std::filesystem::remove(tempPath, ec);
+        return std::filesystem::exists(path, ec);
+    }
+    evict(path);
+    return true;
+}
+
+void PCMCache::evict(const std::filesystem::path& keep) const {
+    struct Stored {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type used;
+    };
+    std::vector<Stored> stored;
+    std::uintmax_t total = 0;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ".pcm") {
+            continue;
+        }
+        std::error_code entryEc;
+        const auto size = it->file_size(entryEc);
+        const auto used = it->last_write_time(entryEc);
+        if (entryEc) {
+            // Removed by another thread since it was listed
+            continue;
+        }
+        total += size;
+        if (it->path() != keep) {
+            stored.push_back({it->path(), size, used});
+        }
+    }
+    if (total <= maxBytes) {
+        return;
+    }
+
+    std::sort(stored.begin(), stored.end(),
+              [](const Stored& a, const Stored& b) { return a.used < b.used; });
+    for (const auto& entry : stored) {
+        if (total <= maxBytes) {
+            break;
+        }
+        // Entries still mapped elsewhere stay readable until unmapped
+        if (std::filesystem::remove(entry.path, ec)) {
+            total -= entry.size;
+        }
+    }
+}
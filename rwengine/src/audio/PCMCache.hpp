@@ -0,0 +1,76 @@
+#ifndef _RWENGINE_PCMCACHE_HPP_
+#define _RWENGINE_PCMCACHE_HPP_
+
+#include <platform/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+/// On-disk cache of decoded and resampled audio.
+///
+/// Compressed sources (mp3 music, radio, cutscene audio) are decoded once,
+/// written as raw interleaved 16 bit PCM and memory mapped on later loads,
+/// so neither the decoder nor a decode buffer is needed again. Once the
+/// entries take more than the size limit, the least recently used ones are
+/// removed as new ones are stored.
+class PCMCache {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+    /// About the decoded music and cutscene audio of one game
+    static constexpr std::uintmax_t kDefaultMaxBytes = 1024ull << 20;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t channels;
+        std::uint32_t sampleRate;
+        std::uint64_t sampleCount;
+        /// Number of packets the decoder read to produce the samples
+        std::uint32_t decodedFrames;
+        std::uint32_t reserved;
+    };
+
+    struct Entry {
+        MappedFile file;
+        const Header* header = nullptr;
+        const std::int16_t* samples = nullptr;
+    };
+
+    /// An empty directory disables the cache
+    explicit PCMCache(std::filesystem::path directory = defaultDirectory(),
+                      std::uintmax_t maxBytes = kDefaultMaxBytes);
+
+    /// Per user cache directory, empty if there is none
+    static std::filesystem::path defaultDirectory();
+
+    bool isEnabled() const {
+        return !directory.empty();
+    }
+
+    /// Map the entry for the source, if there is a valid one, and mark it
+    /// as recently used
+    std::optional<Entry> open(const std::filesystem::path& source) const;
+
+    /// Write the decoded samples of the source, removing the least recently
+    /// used entries if the cache grows too large. Safe to call from any
+    /// thread.
+    bool store(const std::filesystem::path& source, std::uint32_t channels,
+               std::uint32_t sampleRate, std::uint32_t decodedFrames,
+               const std::int16_t* samples, std::size_t sampleCount) const;
+
+    /// Location of the entry for the source. The name is a hash of the
+    /// source path, size and modification time, so edited files miss.
+    std::filesystem::path entryPath(const std::filesystem::path& source) const;
+
+private:
+    std::filesystem::path directory;
+    std::uintmax_t maxBytes;
+
+    /// Removes the least recently used entries other than keep until the
+    /// cache fits in maxBytes
+    void evict(const std::filesystem::path& keep) const;
+};
+
+#endif
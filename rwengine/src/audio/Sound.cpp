@@ -3,7 +3,16 @@
 #include "audio/SoundBuffer.hpp"
 
 Sound::~Sound() {
-    if (buffer && buffer->state == SoundBuffer::State::Playing) {
+    // Otherwise the audio thread may be using the buffer right now,
+    // SoundManager queues a stop before releasing such sounds
+    if (!buffer || buffer.use_count() != 1) {
+        return;
+    }
+    // state belongs to the audio thread, go by what it last published
+    const ALint sourceState = buffer->pendingCommands > 0
+                                  ? buffer->requestedState
+                                  : buffer->observedState.load();
+    if (sourceState == AL_PLAYING) {
         stop();
     }
 }
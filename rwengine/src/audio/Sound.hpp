@@ -16,7 +16,8 @@ struct Sound {
     bool isLoaded = false;
 
     std::shared_ptr<SoundSource> source;
-    std::unique_ptr<SoundBuffer> buffer;
+    /// Shared with the audio thread while it has commands for it
+    std::shared_ptr<SoundBuffer> buffer;
 
     Sound() = default;
     ~Sound();
@@ -25,10 +25,11 @@ bool SoundBuffer::bufferData(SoundSource& soundSource) {
     alCheck(alBufferData(
         buffer,
         soundSource.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
-        &soundSource.data.front(),
-        static_cast<ALsizei>(soundSource.data.size() * sizeof(int16_t)),
+        soundSource.samples(),
+        static_cast<ALsizei>(soundSource.sampleCount() * sizeof(int16_t)),
         soundSource.sampleRate));
     alCheck(alSourcei(source, AL_BUFFER, buffer));
+    memory.set(soundSource.sampleCount() * sizeof(int16_t));
     return true;
 }
 
@@ -65,6 +66,16 @@ void SoundBuffer::stop() {
 
 }
 
+bool SoundBuffer::refill() {
+    return false;
+}
+
+void SoundBuffer::updateObservedState() {
+    ALint sourceState;
+    alCheck(alGetSourcei(source, AL_SOURCE_STATE, &sourceState));
+    observedState = sourceState;
+}
+
 void SoundBuffer::setPosition(const glm::vec3& position) {
     alCheck(
         alSource3f(source, AL_POSITION, position.x, position.y, position.z));
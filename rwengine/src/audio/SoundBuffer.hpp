@@ -3,6 +3,9 @@
 
 #include <al.h>
 #include <glm/vec3.hpp>
+#include <rw/accounting.hpp>
+
+#include <atomic>
 
 class SoundSource;
 
@@ -21,6 +24,13 @@ struct SoundBuffer {
     virtual void pause();
     virtual void stop();
 
+    /// Queue more data to OpenAL if the buffer streams its source.
+    /// Returns true while there is still data left to stream.
+    virtual bool refill();
+
+    /// Query OpenAL and publish the result in observedState.
+    void updateObservedState();
+
     void setPosition(const glm::vec3& position);
     void setLooping(bool looping);
     void setPitch(float pitch);
@@ -35,6 +45,19 @@ struct SoundBuffer {
 
     ALuint source;
     State state = State::Created;
+
+    /// Source state as last seen by the audio thread (AL_INITIAL,
+    /// AL_PLAYING, ...). Safe to read from any thread.
+    std::atomic<ALint> observedState{AL_INITIAL};
+    /// Commands pushed for this buffer which the audio thread has not
+    /// executed yet. While non-zero observedState may be stale.
+    std::atomic<unsigned int> pendingCommands{0};
+    /// State the last pushed command will leave the source in.
+    /// Game thread only.
+    ALint requestedState = AL_INITIAL;
+protected:
+    /// Sample data held by OpenAL for this buffer
+    MemoryAllocation memory{MemoryCategory::AudioBuffers};
 private:
     ALuint buffer;
 };
@@ -1,153 +1,122 @@
-﻿#include <thread>
-
 #include "audio/SoundBufferStreamed.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 #include <rw/types.hpp>
 
 #include "audio/SoundSource.hpp"
 #include "audio/alCheck.hpp"
 
-SoundBufferStreamed::SoundBufferStreamed() {
-    alCheck(alGenSources(1, &source));
-
+SoundBufferStreamed::SoundBufferStreamed(unsigned int chunkSize)
+    : sizeOfChunk(chunkSize) {
+    // The source itself is created and set up by SoundBuffer
     alCheck(alGenBuffers(kNrBuffersStreaming, buffers.data()));
-
-    alCheck(alSourcef(source, AL_PITCH, 1));
-    alCheck(alSourcef(source, AL_GAIN, 1));
-    alCheck(alSource3f(source, AL_POSITION, 0, 0, 0));
-    alCheck(alSource3f(source, AL_VELOCITY, 0, 0, 0));
-    alCheck(alSourcei(source, AL_LOOPING, AL_FALSE));
+    memory.set(kNrBuffersStreaming * sizeOfChunk * sizeof(int16_t));
 }
 
 SoundBufferStreamed::~SoundBufferStreamed() {
-    std::lock_guard<std::mutex> lock(soundSource->mutex);
+    // Detaching the queue is only valid on a stopped source
+    alCheck(alSourceStop(source));
+    alCheck(alSourcei(source, AL_BUFFER, 0));
+
+    alCheck(alDeleteBuffers(kNrBuffersStreaming, buffers.data()));
+}
 
-    if (state == State::Created) {  // We should only clear queue
-        alSourcei(source, AL_BUFFER, 0);
-    } else {
-        auto nrBuffersToUnqueue = std::min(kNrBuffersStreaming, buffersUsed);
-        alCheck(
-            alSourceUnqueueBuffers(source, nrBuffersToUnqueue, buffers.data()));
+bool SoundBufferStreamed::queueChunk(ALuint bufid, bool allowPartial) {
+    const auto available = soundSource->sampleCount();
+    if (streamedData >= available) {
+        return false;
     }
 
-    alCheck(alDeleteBuffers(kNrBuffersStreaming, buffers.data()));
+    auto sizeOfNextChunk = std::min(static_cast<std::size_t>(sizeOfChunk),
+                                    available - streamedData);
+    // While the decoder is still running a short tail would be followed
+    // by more samples, wait for a full chunk instead
+    if (sizeOfNextChunk < sizeOfChunk && !allowPartial) {
+        return false;
+    }
+
+    alCheck(alBufferData(
+        bufid, soundSource->channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
+        soundSource->samples() + streamedData,
+        static_cast<ALsizei>(sizeOfNextChunk * sizeof(int16_t)),
+        static_cast<ALsizei>(soundSource->sampleRate)));
+    alCheck(alSourceQueueBuffers(source, 1, &bufid));
+    streamedData += sizeOfNextChunk;
+    return true;
 }
 
-bool SoundBufferStreamed::bufferData(SoundSource &soundSource) {
+bool SoundBufferStreamed::queueFreeBuffers(bool allowPartial) {
+    bool bufferedData = false;
+    while (!freeBuffers.empty() &&
+           queueChunk(freeBuffers.back(), allowPartial)) {
+        freeBuffers.pop_back();
+        bufferedData = true;
+    }
+    return bufferedData;
+}
+
+bool SoundBufferStreamed::bufferData(SoundSource& soundSource) {
+    this->soundSource = soundSource.shared_from_this();
+
     std::lock_guard<std::mutex> lock(soundSource.mutex);
 
     /* Rewind the source position and clear the buffer queue */
     alCheck(alSourceRewind(source));
     alCheck(alSourcei(source, AL_BUFFER, 0));
+    streamedData = 0;
+    freeBuffers.assign(buffers.begin(), buffers.end());
 
     /* Fill the buffer queue */
-    for (auto i = 0u; i < buffers.size() &&
-                      streamedData * kSizeOfChunk < soundSource.data.size();
-         i++) {
-        auto sizeOfNextChunk = std::min(static_cast<size_t>(kSizeOfChunk),
-                                        soundSource.data.size());
-
-        alCheck(alBufferData(
-            buffers[i],
-            soundSource.channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16,
-            &soundSource.data[streamedData * kSizeOfChunk],
-            static_cast<ALsizei>(sizeOfNextChunk * sizeof(int16_t)),
-            soundSource.sampleRate));
-        streamedData++;
-        buffersUsed++;
-    }
-
-    alCheck(alSourceQueueBuffers(source, buffersUsed, buffers.data()));
-
-    this->soundSource = &soundSource;
+    queueFreeBuffers(!soundSource.isDecoding());
 
     return true;
 }
 
 void SoundBufferStreamed::play() {
-    {
-        std::lock_guard<std::mutex> lock(soundSource->mutex);
-        alSourcePlay(source);
-
-        // Maybe another thread is running, we should tell him to stop
-        if (state == State::Playing) {
-            state = State::Stopped;
-        }
+    state = State::Playing;
+    alCheck(alSourcePlay(source));
+}
+
+bool SoundBufferStreamed::refill() {
+    if (!soundSource || state != State::Playing) {
+        return false;
     }
-    // Use preloaded data (and give another thread time to stop)
-    std::this_thread::sleep_for(kTickFreqMs);
 
-    // Not we should be able start thread
-    bufferingThread = std::async(std::launch::async,
-                               &SoundBufferStreamed::updateBuffers, this);
-}
+    std::lock_guard<std::mutex> lock(soundSource->mutex);
 
-void SoundBufferStreamed::updateBuffers() {
-    state = State::Playing;
-    while (true) {
-        {
-            std::lock_guard<std::mutex> lock(soundSource->mutex);
-            if (state == State::Stopped) {
-                return;
-            }
-
-            ALint processed, state;
-
-            /* Get relevant source info */
-            alCheck(alGetSourcei(source, AL_SOURCE_STATE, &state));
-            alCheck(alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed));
-
-            bool bufferedData = false;
-
-            /* Unqueue and handle each processed buffer */
-            while (processed > 0 &&
-                   streamedData * kSizeOfChunk < soundSource->data.size()) {
-                bufferedData = true;
-                ALuint bufid{};
-                auto sizeOfNextChunk = std::min(
-                    static_cast<size_t>(kSizeOfChunk),
-                    soundSource->data.size() -
-                        static_cast<size_t>(kSizeOfChunk) * streamedData);
-
-                alCheck(alSourceUnqueueBuffers(source, 1, &bufid));
-                processed--;
-
-                if (sizeOfNextChunk > 0) {
-                    alCheck(alBufferData(
-                        bufid,
-                        soundSource->channels == 1 ? AL_FORMAT_MONO16
-                                                   : AL_FORMAT_STEREO16,
-                        &soundSource->data[streamedData * kSizeOfChunk],
-                        sizeOfNextChunk * sizeof(int16_t),
-                        soundSource->sampleRate));
-                    streamedData++;
-                    buffersUsed++;
-                    alCheck(alSourceQueueBuffers(source, 1, &bufid));
-                }
-            }
-
-            /* Make sure the source hasn't underrun */
-            if (bufferedData && state != AL_PLAYING && state != AL_PAUSED) {
-                ALint queued;
-
-                /* If no buffers are queued, playback is finished */
-                alCheck(alGetSourcei(source, AL_BUFFERS_QUEUED, &queued));
-                if (queued == 0) return;
-
-                alCheck(alSourcePlay(source));
-            }
-        }
-        std::this_thread::sleep_for(kTickFreqMs);
+    const bool decodingDone = !soundSource->isDecoding();
+    ALint processed, sourceState;
+
+    /* Get relevant source info */
+    alCheck(alGetSourcei(source, AL_SOURCE_STATE, &sourceState));
+    alCheck(alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed));
+
+    /* Unqueue each processed buffer, then refill whatever is free */
+    while (processed > 0) {
+        ALuint bufid{};
+        alCheck(alSourceUnqueueBuffers(source, 1, &bufid));
+        freeBuffers.push_back(bufid);
+        processed--;
+    }
+    bool bufferedData = queueFreeBuffers(decodingDone);
+
+    /* Make sure the source hasn't underrun */
+    if (bufferedData && sourceState != AL_PLAYING &&
+        sourceState != AL_PAUSED) {
+        alCheck(alSourcePlay(source));
     }
+
+    return !decodingDone || streamedData < soundSource->sampleCount();
 }
 
 void SoundBufferStreamed::pause() {
-    std::lock_guard<std::mutex> lock(soundSource->mutex);
     state = State::Stopped;
     alCheck(alSourcePause(source));
 }
+
 void SoundBufferStreamed::stop() {
-    std::lock_guard<std::mutex> lock(soundSource->mutex);
     state = State::Stopped;
     alCheck(alSourceStop(source));
 }
@@ -4,15 +4,19 @@
 #include "audio/SoundBuffer.hpp"
 
 #include <array>
-#include <future>
+#include <cstddef>
+#include <memory>
+#include <vector>
 
+/// Sound buffer which queues its source to OpenAL in small chunks.
+/// Chunks are refilled by the audio thread (see AudioThread), so
+/// nothing here blocks the caller.
 struct SoundBufferStreamed : public SoundBuffer {
     static constexpr unsigned int kNrBuffersStreaming = 4;
+    /// Default number of samples per queued chunk
     static constexpr unsigned int kSizeOfChunk = 4096;
-    static constexpr std::chrono::milliseconds kTickFreqMs =
-        std::chrono::milliseconds(100);
 
-    SoundBufferStreamed();
+    explicit SoundBufferStreamed(unsigned int chunkSize = kSizeOfChunk);
     ~SoundBufferStreamed() override;
     bool bufferData(SoundSource& soundSource) final;
 
@@ -20,13 +24,19 @@ struct SoundBufferStreamed : public SoundBuffer {
     void pause() final;
     void stop() final;
 
+    bool refill() final;
+
 private:
-    SoundSource* soundSource = nullptr;
-    void updateBuffers();
-    unsigned int streamedData = 0;
-    unsigned int buffersUsed = 0;
+    bool queueChunk(ALuint bufid, bool allowPartial);
+    bool queueFreeBuffers(bool allowPartial);
+
+    const unsigned int sizeOfChunk;
+    std::shared_ptr<SoundSource> soundSource;
+    /// Number of samples already handed to OpenAL
+    std::size_t streamedData = 0;
     std::array<ALuint, kNrBuffersStreaming> buffers;
-    std::future<void> bufferingThread;
+    /// Buffers which are not queued on the source at the moment
+    std::vector<ALuint> freeBuffers;
 };
 
 #endif
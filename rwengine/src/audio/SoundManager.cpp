@@ -11,13 +11,14 @@ extern "C" {
 #include "audio/SoundBuffer.hpp"
 #include "audio/SoundBufferStreamed.hpp"
 #include "audio/SoundSource.hpp"
-#include "audio/alCheck.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameWorld.hpp"
 #include "render/ViewCamera.hpp"
 
 #include <rw/types.hpp>
 
+#include <algorithm>
+
 Sound& SoundManager::getSfxBufferRef(size_t name) {
     auto ref = buffers.find(name);
     if (ref != buffers.end()) {
@@ -37,7 +38,9 @@ Sound& SoundManager::getSoundRef(const std::string& name) {
 }
 
 SoundManager::SoundManager() {
-    initializeOpenAL();
+    if (initializeOpenAL()) {
+        audioThread.start();
+    }
     initializeAVCodec();
 }
 
@@ -46,7 +49,9 @@ SoundManager::SoundManager(GameWorld* engine) : _engine(engine) {
     auto rawPath = _engine->data->index.findFilePath("audio/sfx.RAW");
     sdt.load(sdtPath, rawPath);
 
-    initializeOpenAL();
+    if (initializeOpenAL()) {
+        audioThread.start();
+    }
     initializeAVCodec();
 }
 
@@ -93,8 +98,12 @@ void SoundManager::initializeAVCodec() {
 }
 
 void SoundManager::deinitializeOpenAL() {
+    // The audio thread drops its references to buffers when it stops
+    audioThread.stop();
+
     // Buffers have to been removed before openAL is deinitialized
     sounds.clear();
+    sfx.clear();
     buffers.clear();
 
     // De-initialize OpenAL
@@ -124,9 +133,14 @@ bool SoundManager::loadSound(const std::string& name,
         sound = &it->second;
 
         sound->source = std::make_shared<SoundSource>();
-        sound->buffer = streamed ? std::make_unique<SoundBufferStreamed>() : std::make_unique<SoundBuffer>();
+        if (streamed) {
+            sound->buffer =
+                std::make_shared<SoundBufferStreamed>(streamingChunkSize);
+        } else {
+            sound->buffer = std::make_shared<SoundBuffer>();
+        }
 
-        sound->source->loadFromFile(fileName, streamed);
+        sound->source->loadFromFile(fileName, streamed, &pcmCache);
         sound->isLoaded = sound->buffer->bufferData(*sound->source);
     }
 
@@ -160,9 +174,9 @@ size_t SoundManager::createSfxInstance(size_t index) {
     // Try to reuse first available buffer
     // (aka with stopped state)
     for (auto& [id, sound] : buffers) {
-        if (sound.buffer && sound.isStopped()) {
+        if (sound.buffer && getState(sound) == AL_STOPPED) {
             // Let's use this buffer
-            sound.buffer = std::make_unique<SoundBuffer>();
+            sound.buffer = std::make_shared<SoundBuffer>();
             sound.source = soundRef->second.source;
             sound.isLoaded = sound.buffer->bufferData(*sound.source);
             return id;
@@ -176,7 +190,7 @@ size_t SoundManager::createSfxInstance(size_t index) {
     sound = &it->second;
 
     sound->id = bufferNr;
-    sound->buffer = std::make_unique<SoundBuffer>();
+    sound->buffer = std::make_shared<SoundBuffer>();
     sound->source = soundRef->second.source;
     sound->isLoaded = sound->buffer->bufferData(*sound->source);
     bufferNr++;
@@ -195,7 +209,7 @@ bool SoundManager::isLoaded(const std::string& name) {
 bool SoundManager::isPlaying(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
-        return sound->second.isPlaying();
+        return getState(sound->second) == AL_PLAYING;
     }
     return false;
 }
@@ -203,7 +217,7 @@ bool SoundManager::isPlaying(const std::string& name) {
 bool SoundManager::isStopped(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
-        return sound->second.isStopped();
+        return getState(sound->second) == AL_STOPPED;
     }
     return false;
 }
@@ -211,7 +225,7 @@ bool SoundManager::isStopped(const std::string& name) {
 bool SoundManager::isPaused(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
-        return sound->second.isPaused();
+        return getState(sound->second) == AL_PAUSED;
     }
     return false;
 }
@@ -220,60 +234,68 @@ void SoundManager::playSound(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
         auto vol = getCalculatedVolumeOfMusic();
-        sound->second.setGain(vol);
-        sound->second.play();
+        push(sound->second, AudioCommand::Type::Gain, vol);
+        push(sound->second, AudioCommand::Type::Play);
     }
 }
 
 void SoundManager::eraseSound(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
+        // The audio thread keeps the buffer alive until it has stopped
+        push(sound->second, AudioCommand::Type::Stop);
         sounds.erase(sound);
     } else {
         RW_MESSAGE("Tried to erase no existing sound " << name);
     }
 }
 
+void SoundManager::stopSound(Sound& sound) {
+    push(sound, AudioCommand::Type::Stop);
+}
+
 void SoundManager::playSfx(size_t name, const glm::vec3& position, bool looping,
                            int maxDist) {
     auto buffer = buffers.find(name);
     if (buffer != buffers.end()) {
-        buffer->second.setPosition(position);
+        auto& sound = buffer->second;
+        pushPosition(sound, position);
         if (looping) {
-            buffer->second.setLooping(looping);
+            push(sound, AudioCommand::Type::Looping, 1.f);
         }
 
-        buffer->second.setPitch(1.f);
-        buffer->second.setGain(getCalculatedVolumeOfEffects());
+        push(sound, AudioCommand::Type::Pitch, 1.f);
+        push(sound, AudioCommand::Type::Gain, getCalculatedVolumeOfEffects());
         if (maxDist != -1) {
-            buffer->second.setMaxDistance(static_cast<float>(maxDist));
+            push(sound, AudioCommand::Type::MaxDistance,
+                 static_cast<float>(maxDist));
         }
-        buffer->second.play();
+        push(sound, AudioCommand::Type::Play);
     }
 }
 
 void SoundManager::pauseAllSounds() {
     for (auto& sound : sounds) {
-        if (sound.second.isPlaying()) {
-            sound.second.pause();
+        if (getState(sound.second) == AL_PLAYING) {
+            push(sound.second, AudioCommand::Type::Pause);
         }
     }
     for (auto& sound : buffers) {
-        if (sound.second.isPlaying()) {
-            sound.second.pause();
+        if (getState(sound.second) == AL_PLAYING) {
+            push(sound.second, AudioCommand::Type::Pause);
         }
     }
 }
 
 void SoundManager::resumeAllSounds() {
     for (auto& sound : sounds) {
-        if (sound.second.isPaused()) {
-            sound.second.play();
+        if (getState(sound.second) == AL_PAUSED) {
+            push(sound.second, AudioCommand::Type::Play);
         }
     }
     for (auto& sound : buffers) {
-        if (sound.second.isPaused()) {
-            sound.second.play();
+        if (getState(sound.second) == AL_PAUSED) {
+            push(sound.second, AudioCommand::Type::Play);
         }
     }
 }
@@ -281,8 +303,7 @@ void SoundManager::resumeAllSounds() {
 bool SoundManager::playBackground(const std::string& fileName) {
     if (this->loadSound(fileName, fileName)) {
         backgroundNoise = fileName;
-        auto& sound = getSoundRef(fileName);
-        sound.play();
+        push(getSoundRef(fileName), AudioCommand::Type::Play);
         return true;
     }
 
@@ -294,17 +315,34 @@ bool SoundManager::loadMusic(const std::string& name,
     return loadSound(name, fileName);
 }
 
+bool SoundManager::adoptMusic(const std::string& name,
+                              std::shared_ptr<SoundSource> source) {
+    auto [it, emplaced] = sounds.emplace(std::piecewise_construct,
+                                         std::forward_as_tuple(name),
+                                         std::forward_as_tuple());
+    auto& sound = it->second;
+
+    if (emplaced) {
+        sound.source = std::move(source);
+        sound.buffer =
+            std::make_shared<SoundBufferStreamed>(streamingChunkSize);
+        sound.isLoaded = sound.buffer->bufferData(*sound.source);
+    }
+
+    return sound.isLoaded;
+}
+
 void SoundManager::playMusic(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
-        sound->second.play();
+        push(sound->second, AudioCommand::Type::Play);
     }
 }
 
 void SoundManager::stopMusic(const std::string& name) {
     auto sound = sounds.find(name);
     if (sound != sounds.end()) {
-        sound->second.stop();
+        push(sound->second, AudioCommand::Type::Stop);
     }
 }
 
@@ -320,14 +358,14 @@ void SoundManager::pause(bool p) {
 
 void SoundManager::updateListenerTransform(const ViewCamera& cam) {
     // Orientation
-    auto up = cam.rotation * glm::vec3(0.f, 0.f, 1.f);
-    auto at = cam.rotation * glm::vec3(1.f, 0.f, 0.f);
-    float orientation[6] = {at.x, at.y, at.z, up.x, up.y, up.z};
-    alListenerfv(AL_ORIENTATION, orientation);
+    AudioCommand command;
+    command.type = AudioCommand::Type::Listener;
+    command.up = cam.rotation * glm::vec3(0.f, 0.f, 1.f);
+    command.at = cam.rotation * glm::vec3(1.f, 0.f, 0.f);
 
     // Position
-    float position[3] = {cam.position.x, cam.position.y, cam.position.z};
-    alListenerfv(AL_POSITION, position);
+    command.position = cam.position;
+    audioThread.push(std::move(command));
 
     // @todo ShFil119 it should be implemented
     // Velocity
@@ -337,12 +375,73 @@ void SoundManager::updateListenerTransform(const ViewCamera& cam) {
 
 void SoundManager::setSoundPosition(const std::string& name,
                                     const glm::vec3& position) {
-    if (sounds.find(name) != sounds.end()) {
-        alCheck(alSource3f(sounds[name].buffer->source, AL_POSITION, position.x,
-                           position.y, position.z));
+    auto sound = sounds.find(name);
+    if (sound != sounds.end()) {
+        pushPosition(sound->second, position);
     }
 }
 
+void SoundManager::push(Sound& sound, AudioCommand::Type type, float value) {
+    AudioCommand command;
+    command.type = type;
+    command.value = value;
+    queueCommand(sound, std::move(command));
+}
+
+void SoundManager::pushPosition(Sound& sound, const glm::vec3& position) {
+    AudioCommand command;
+    command.type = AudioCommand::Type::Position;
+    command.position = position;
+    queueCommand(sound, std::move(command));
+}
+
+void SoundManager::queueCommand(Sound& sound, AudioCommand&& command) {
+    if (!sound.buffer) {
+        return;
+    }
+
+    // Track what the source will be doing once the command is applied,
+    // getState() reports it until the audio thread catches up
+    const auto current = getState(sound);
+    auto& requested = sound.buffer->requestedState;
+    requested = current;
+    switch (command.type) {
+        case AudioCommand::Type::Play:
+            requested = AL_PLAYING;
+            break;
+        case AudioCommand::Type::Pause:
+            if (current == AL_PLAYING) {
+                requested = AL_PAUSED;
+            }
+            break;
+        case AudioCommand::Type::Stop:
+            requested = AL_STOPPED;
+            break;
+        default:
+            break;
+    }
+
+    command.buffer = sound.buffer;
+    audioThread.push(std::move(command));
+}
+
+ALint SoundManager::getState(const Sound& sound) const {
+    const auto& buffer = sound.buffer;
+    if (!buffer) {
+        return AL_INITIAL;
+    }
+    if (buffer->pendingCommands > 0) {
+        return buffer->requestedState;
+    }
+    return buffer->observedState;
+}
+
+void SoundManager::setStreamingChunkSize(unsigned int samples) {
+    // Keep stereo frames whole and avoid degenerate tiny chunks
+    constexpr unsigned int kMinChunkSize = 256;
+    streamingChunkSize = std::max(kMinChunkSize, samples & ~1u);
+}
+
 void SoundManager::setVolume(float vol) {
     _volume = vol;
 }
@@ -1,14 +1,19 @@
 #ifndef _RWENGINE_SOUNDMANAGER_HPP_
 #define _RWENGINE_SOUNDMANAGER_HPP_
 
+#include "audio/AudioThread.hpp"
+#include "audio/PCMCache.hpp"
 #include "audio/Sound.hpp"
+#include "audio/SoundBufferStreamed.hpp"
 
+#include <al.h>
 #include <alc.h>
 
 #include <glm/vec3.hpp>
 
 #include <loaders/LoaderSDT.hpp>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -21,6 +26,9 @@ class ViewCamera;
 /// these containg raw source and openAL buffer for playing (only one instance
 /// simultaneously), these containg only source or buffer. (It allows multiple
 /// instances simultaneously without duplicating raw source).
+///
+/// Playback requests are not applied here, they are queued to the
+/// AudioThread so the game loop never waits on OpenAL.
 class SoundManager {
 public:
     SoundManager();
@@ -57,6 +65,9 @@ public:
     /// Erase sound with selected name
     void eraseSound(const std::string& name);
 
+    /// Stop a sound returned by getSfxBufferRef / getSoundRef
+    void stopSound(Sound& sound);
+
     /// Effect same as playSound with one parametr,
     /// but this function works for sfx and
     /// allows also for setting position,
@@ -72,6 +83,10 @@ public:
     bool playBackground(const std::string& fileName);
 
     bool loadMusic(const std::string& name, const std::string& fileName);
+    /// Store a source already loading as streamed music, e.g. one decoded
+    /// ahead of time
+    bool adoptMusic(const std::string& name,
+                    std::shared_ptr<SoundSource> source);
     void playMusic(const std::string& name);
     void stopMusic(const std::string& name);
 
@@ -83,11 +98,31 @@ public:
 
     void pause(bool p);
 
+    /// Samples per chunk for sounds loaded as streamed from now on.
+    /// Larger chunks mean fewer refills, smaller ones less latency.
+    void setStreamingChunkSize(unsigned int samples);
+    unsigned int getStreamingChunkSize() const {
+        return streamingChunkSize;
+    }
+
+    const PCMCache& getPCMCache() const {
+        return pcmCache;
+    }
+
     void setVolume(float vol);
     float getCalculatedVolumeOfEffects() const;
     float getCalculatedVolumeOfMusic() const;
 
 private:
+    /// Queue a command for the buffer of the sound
+    void push(Sound& sound, AudioCommand::Type type, float value = 0.f);
+    void pushPosition(Sound& sound, const glm::vec3& position);
+    void queueCommand(Sound& sound, AudioCommand&& command);
+
+    /// Playback state of the sound as far as the game thread knows,
+    /// without asking OpenAL.
+    ALint getState(const Sound& sound) const;
+
     bool initializeOpenAL();
     void initializeAVCodec();
 
@@ -96,6 +131,8 @@ private:
     ALCcontext* alContext = nullptr;
     ALCdevice* alDevice = nullptr;
 
+    AudioThread audioThread;
+
     /// Containers for sounds
     std::unordered_map<std::string, Sound> sounds;
     std::unordered_map<size_t, Sound> sfx;
@@ -109,6 +146,10 @@ private:
     GameWorld* _engine;
     LoaderSDT sdt{};
 
+    /// Decoded music and streams, mapped instead of decoded again
+    PCMCache pcmCache;
+    unsigned int streamingChunkSize = SoundBufferStreamed::kSizeOfChunk;
+
     /// Sound volume
     float _volume = 1.f;
 
@@ -1,5 +1,7 @@
 ﻿#include "audio/SoundSource.hpp"
 
+#include "audio/PCMCache.hpp"
+
 #include <loaders/LoaderSDT.hpp>
 #include <rw/types.hpp>
 
@@ -430,6 +432,7 @@ void SoundSource::decodeAndResampleFrames(const std::filesystem::path& filePath,
                     RW_CHECK(frame != nullptr, "Frame pointer is null");
                     if (frame == nullptr) {
                         RW_ERROR("Frame pointer is null in SoundSource.cpp");
+                        decodeFailed = true;
                         return;
                     }
                     // Ensure mono streams carry a valid channel layout
@@ -449,6 +452,7 @@ void SoundSource::decodeAndResampleFrames(const std::filesystem::path& filePath,
                     if (err < 0) {
                         RW_ERROR(
                             "Resampler has not been successfully allocated.");
+                        decodeFailed = true;
                         return;
                     }
 #else
@@ -470,6 +474,7 @@ void SoundSource::decodeAndResampleFrames(const std::filesystem::path& filePath,
                     if (!swr) {
                         RW_ERROR(
                             "Resampler has not been successfully allocated.");
+                        decodeFailed = true;
                         return;
                     }
                     assert(swr != nullptr);
@@ -477,6 +482,7 @@ void SoundSource::decodeAndResampleFrames(const std::filesystem::path& filePath,
                     if (!swr_is_initialized(swr)) {
                         RW_ERROR(
                             "Resampler has not been properly initialized.");
+                        decodeFailed = true;
                         return;
                     }
                 }
@@ -496,6 +502,7 @@ void SoundSource::decodeAndResampleFrames(const std::filesystem::path& filePath,
 
                     if (swr_convert_frame(swr, resampled, frame) < 0) {
                         RW_ERROR("Error resampling " << filePath << '\n');
+                        decodeFailed = true;
                     }
 
                     std::lock_guard<std::mutex> lock(mutex);
@@ -561,7 +568,8 @@ void SoundSource::exposeSfxMetadata(LoaderSDT& sdt) {
     sampleRate = sdt.assetInfo.sampleRate;
 }
 
-void SoundSource::decodeRestSoundFramesAndCleanup(const std::filesystem::path& filePath) {
+void SoundSource::decodeRestSoundFramesAndCleanup(const std::filesystem::path& filePath,
+                                                  bool streaming) {
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 37, 100)
     decodeFramesLegacy(0);
 #else
@@ -569,6 +577,70 @@ void SoundSource::decodeRestSoundFramesAndCleanup(const std::filesystem::path& f
 #endif
 
     cleanupAfterSoundLoading();
+
+    if (pcmCache && !decodeFailed) {
+        if (streaming) {
+            storeInCache(filePath);
+        } else {
+            storeInCacheAsync(filePath);
+        }
+    }
+    updateMemory();
+    decoding.store(false, std::memory_order_release);
+}
+
+bool SoundSource::loadFromCache(const PCMCache& cache,
+                                const std::filesystem::path& filePath) {
+    auto entry = cache.open(filePath);
+    if (!entry) {
+        return false;
+    }
+
+    channels = entry->header->channels;
+    sampleRate = entry->header->sampleRate;
+    decodedFrames = entry->header->decodedFrames;
+    cachedSamples = entry->samples;
+    cachedSampleCount = static_cast<std::size_t>(entry->header->sampleCount);
+    cachedFile = std::move(entry->file);
+    return true;
+}
+
+void SoundSource::storeInCache(const std::filesystem::path& filePath) {
+    // Decoding is over, so data is only read from here on and does not
+    // need the lock while it is written out.
+    if (!pcmCache->store(filePath, channels, sampleRate, decodedFrames,
+                         data.data(), data.size())) {
+        return;
+    }
+
+    auto entry = pcmCache->open(filePath);
+    if (!entry) {
+        return;
+    }
+
+    // Switch over to the mapping and drop the decode buffer
+    std::lock_guard<std::mutex> lock(mutex);
+    cachedSamples = entry->samples;
+    cachedSampleCount = static_cast<std::size_t>(entry->header->sampleCount);
+    cachedFile = std::move(entry->file);
+    std::vector<int16_t>().swap(data);
+}
+
+void SoundSource::storeInCacheAsync(const std::filesystem::path& filePath) {
+    // Callers read the decode buffer without the lock once a load that
+    // doesn't stream returns, so it is only written out and kept
+    storingThread = std::async(std::launch::async, [this, filePath]() {
+        pcmCache->store(filePath, channels, sampleRate, decodedFrames,
+                        data.data(), data.size());
+    });
+}
+
+const int16_t* SoundSource::samples() const {
+    return cachedSamples ? cachedSamples : data.data();
+}
+
+std::size_t SoundSource::sampleCount() const {
+    return cachedSamples ? cachedSampleCount : data.size();
 }
 
 void SoundSource::decodeRestSfxFramesAndCleanup() {
@@ -579,12 +651,26 @@ void SoundSource::decodeRestSfxFramesAndCleanup() {
 #endif
 
     cleanupAfterSfxLoading();
+    updateMemory();
+    decoding.store(false, std::memory_order_release);
 }
 
-void SoundSource::loadFromFile(const std::filesystem::path& filePath, bool streaming) {
+void SoundSource::updateMemory() {
+    // Samples mapped from the PCM cache are backed by the file
+    memory.set(data.capacity() * sizeof(int16_t));
+}
+
+void SoundSource::loadFromFile(const std::filesystem::path& filePath,
+                               bool streaming, const PCMCache* cache) {
     RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG),
              (TFile, "SoundSource::loadFromFile (%s) streaming = %d ....\n",
               filePath.c_str(), (INT32) streaming));
+    if (cache && loadFromCache(*cache, filePath)) {
+        RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG), (TFile, "mapped from PCM cache\n"));
+        return;
+    }
+    pcmCache = cache;
+
     if (allocateAudioFrame() && allocateFormatContext(filePath) &&
         findAudioStream(filePath) && prepareCodecContextWrap()) {
         exposeSoundMetadata();
@@ -596,11 +682,13 @@ void SoundSource::loadFromFile(const std::filesystem::path& filePath, bool strea
         RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG), (TFile, "done decodeFrames\n"));
         if (streaming) {
             RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG), (TFile, "creating async to load file, return for now\n"));
+            decoding.store(true, std::memory_order_relaxed);
             loadingThread = std::async(
                 std::launch::async,
-                &SoundSource::decodeRestSoundFramesAndCleanup, this, filePath);
+                &SoundSource::decodeRestSoundFramesAndCleanup, this, filePath,
+                true);
         } else {
-            decodeRestSoundFramesAndCleanup(filePath);
+            decodeRestSoundFramesAndCleanup(filePath, false);
             RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG), (TFile, "load file successful, returning\n"));
         }
     } else {
@@ -626,6 +714,7 @@ void SoundSource::loadSfx(LoaderSDT& sdt, size_t index, bool asWave,
         RW_TRACE(Tracing(RWC_SOUNDMAN, TRACE_DEBUG), (TFile, "decodeFramesSfx finished\n"));
 
         if (streaming) {
+            decoding.store(true, std::memory_order_relaxed);
             loadingThread =
                 std::async(std::launch::async,
                            &SoundSource::decodeRestSfxFramesAndCleanup, this);
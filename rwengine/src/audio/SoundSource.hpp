@@ -6,9 +6,15 @@ extern "C" {
 #include <libavutil/avutil.h>
 }
 
+#include <platform/MappedFile.hpp>
+#include <rw/accounting.hpp>
+
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -23,11 +29,12 @@ class AVFormatContext;
 class AVStream;
 class AVIOContext;
 class LoaderSDT;
+class PCMCache;
 
 /// Opaque for raw sound,
 /// cooperate with ffmpeg
 /// (loading and decoding sound)
-class SoundSource {
+class SoundSource : public std::enable_shared_from_this<SoundSource> {
     friend class SoundManager;
     friend struct SoundBuffer;
     friend struct SoundBufferStreamed;
@@ -68,21 +75,55 @@ public:
     void exposeSoundMetadata();
     void exposeSfxMetadata(LoaderSDT& sdt);
 
-    void decodeRestSoundFramesAndCleanup(const std::filesystem::path& filePath);
+    void decodeRestSoundFramesAndCleanup(const std::filesystem::path& filePath,
+                                         bool streaming);
     void decodeRestSfxFramesAndCleanup();
 
-    /// Load sound from mp3/wav file
-    void loadFromFile(const std::filesystem::path& filePath, bool streaming = false);
+    /// Load sound from mp3/wav file.
+    /// With a cache, previously decoded files are mapped instead of decoded
+    /// and newly decoded ones are stored in it.
+    void loadFromFile(const std::filesystem::path& filePath,
+                      bool streaming = false,
+                      const PCMCache* cache = nullptr);
 
     /// Load sound from sdt file
     void loadSfx(LoaderSDT& sdt, std::size_t index, bool asWave = true,
                  bool streaming = false);
 
+    /// True while a streaming load is still decoding in the background.
+    /// Never blocks, the audio thread checks it on every refill.
+    bool isDecoding() const {
+        return decoding.load(std::memory_order_acquire);
+    }
+
+    /// Decoded samples, interleaved. While decoding in the background
+    /// the caller must hold mutex.
+    const int16_t* samples() const;
+    std::size_t sampleCount() const;
+
     unsigned int decodedFrames = 0u;
 
 private:
-    /// Raw data
+    bool loadFromCache(const PCMCache& cache,
+                       const std::filesystem::path& filePath);
+    void storeInCache(const std::filesystem::path& filePath);
+    /// Stores the decode buffer in the cache in the background, without
+    /// switching over to the mapping
+    void storeInCacheAsync(const std::filesystem::path& filePath);
+    /// Reports the decode buffer once decoding is done
+    void updateMemory();
+
+    /// Raw data, while it is not backed by the cache
     std::vector<int16_t> data;
+    MemoryAllocation memory{MemoryCategory::Sounds};
+
+    /// Raw data mapped from the PCM cache
+    MappedFile cachedFile;
+    const int16_t* cachedSamples = nullptr;
+    std::size_t cachedSampleCount = 0;
+    const PCMCache* pcmCache = nullptr;
+    /// Set when decoding stopped early, the result must not be cached
+    bool decodeFailed = false;
 
     std::uint32_t channels;
     std::uint32_t sampleRate;
@@ -101,7 +142,12 @@ private:
     InputData input{};
 
     std::mutex mutex;
+    /// Cleared by the loading thread once every sample is written
+    std::atomic<bool> decoding{false};
     std::future<void> loadingThread;
+    /// Writing a load that didn't stream to the cache, destroyed first so
+    /// that it is done with the decode buffer
+    std::future<void> storingThread;
 };
 
 #endif
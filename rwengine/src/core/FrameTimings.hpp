@@ -0,0 +1,91 @@
+#ifndef _RWENGINE_FRAMETIMINGS_HPP_
+#define _RWENGINE_FRAMETIMINGS_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * CPU time spent in each part of a frame, in milliseconds.
+ *
+ * Sections are exclusive: when a Scope is opened inside another, its time
+ * is taken out of the enclosing section, so script time is not also counted
+ * as simulation and sorting is not counted as draw submission.
+ */
+struct FrameTimings {
+    enum Section : std::size_t {
+        Simulation,
+        Script,
+        RenderList,
+        Sort,
+        Submit,
+        SectionCount,
+        None = SectionCount
+    };
+
+    static constexpr std::array<char const*, SectionCount> kSectionNames{
+        {"simulation", "script", "renderList", "sort", "submit"}};
+
+    std::array<double, SectionCount> ms{};
+    /// Wall time from the start of the frame to the buffer swap
+    double frameMs = 0.0;
+
+    /// Draw calls issued for the frame
+    std::size_t draws = 0;
+    /// Static instances left out because an occluder hides them
+    std::size_t occluded = 0;
+
+    void reset() {
+        ms.fill(0.0);
+        frameMs = 0.0;
+        draws = 0;
+        occluded = 0;
+        active = None;
+    }
+
+    /**
+     * Times the enclosing block into a section, does nothing if the
+     * timings are null
+     */
+    class Scope {
+    public:
+        Scope(FrameTimings* timings, Section section)
+            : timings(timings), section(section) {
+            if (timings) {
+                parent = timings->active;
+                timings->active = section;
+                start = Clock::now();
+            }
+        }
+
+        ~Scope() {
+            if (!timings) {
+                return;
+            }
+            const auto elapsed =
+                std::chrono::duration<double, std::milli>(Clock::now() - start)
+                    .count();
+            timings->ms[section] += elapsed;
+            if (parent != None) {
+                timings->ms[parent] -= elapsed;
+            }
+            timings->active = parent;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        FrameTimings* timings;
+        Section section;
+        Section parent = None;
+        Clock::time_point start;
+    };
+
+private:
+    Section active = None;
+};
+
+#endif
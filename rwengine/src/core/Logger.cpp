@@ -1,40 +1,188 @@
 #include <core/Logger.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <map>
 
-void Logger::log(const std::string& component, Logger::MessageSeverity severity,
-                 const std::string& message) {
-    LogMessage m{component, severity, message};
+#include <core/MPSCQueue.hpp>
+#include <core/Profiler.hpp>
 
+namespace {
+std::int64_t steadyMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// How long the delivery thread sleeps when there is nothing to deliver
+constexpr auto kIdleWait = std::chrono::milliseconds(2);
+
+/// The logger whose receivers the current thread is calling
+thread_local const Logger* deliveringLogger = nullptr;
+}  // namespace
+
+class Logger::Queue : public MPSCQueue<Logger::Record, Logger::kQueueCapacity> {
+};
+
+Logger::Logger(std::initializer_list<MessageReceiver*> initial)
+    : receivers(initial), epoch(steadyMicroseconds()) {
+}
+
+Logger::~Logger() {
+    setAsync(false);
+}
+
+std::uint64_t Logger::now() const {
+    return static_cast<std::uint64_t>(steadyMicroseconds() - epoch);
+}
+
+void Logger::log(std::string_view component, Logger::MessageSeverity severity,
+                 std::string_view message) {
+    // A receiver logging must not wait on the queue it is being fed from,
+    // nor on the thread delivering to it
+    if (deliveringLogger == this) {
+        LogMessage m{component, severity, message};
+        m.timestamp = now();
+        deliver(m);
+        return;
+    }
+
+    // Registered before checking running, so that setAsync(false) either
+    // sees us and waits for the message or we see it stopped
+    producers.fetch_add(1, std::memory_order_seq_cst);
+    if (!running.load(std::memory_order_seq_cst)) {
+        producers.fetch_sub(1, std::memory_order_release);
+        LogMessage m{component, severity, message};
+        m.timestamp = now();
+        deliver(m);
+        return;
+    }
+
+    Record record;
+    record.timestamp = now();
+    record.severity = severity;
+    record.componentLength = static_cast<std::uint16_t>(
+        std::min(component.size(), kMaxComponentLength));
+    record.messageLength = static_cast<std::uint16_t>(
+        std::min(message.size(), kMaxMessageLength));
+    std::memcpy(record.component, component.data(), record.componentLength);
+    std::memcpy(record.message, message.data(), record.messageLength);
+
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    while (!queue->push(record)) {
+        // Errors are worth waiting for, anything else is dropped
+        if (severity != Error) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            delivered.fetch_add(1, std::memory_order_release);
+            break;
+        }
+        std::this_thread::yield();
+    }
+    producers.fetch_sub(1, std::memory_order_release);
+}
+
+void Logger::deliver(const LogMessage& message) {
+    std::lock_guard<std::recursive_mutex> lock(receiversMutex);
+    const auto outer = deliveringLogger;
+    deliveringLogger = this;
     for (MessageReceiver* r : receivers) {
-        r->messageReceived(m);
+        r->messageReceived(message);
+    }
+    deliveringLogger = outer;
+}
+
+void Logger::drain() {
+    Record record;
+    while (queue->pop(record)) {
+        LogMessage m{std::string_view(record.component, record.componentLength),
+                     record.severity,
+                     std::string_view(record.message, record.messageLength)};
+        m.timestamp = record.timestamp;
+        deliver(m);
+        delivered.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void Logger::run() {
+    RW_PROFILE_THREAD("Log");
+    std::uint64_t reportedDrops = 0;
+    while (running.load(std::memory_order_acquire)) {
+        drain();
+
+        const auto drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            LogMessage m{"Logger", Warning,
+                         std::to_string(drops - reportedDrops) +
+                             " messages dropped, queue full"};
+            m.timestamp = now();
+            deliver(m);
+            reportedDrops = drops;
+        }
+
+        std::this_thread::sleep_for(kIdleWait);
+    }
+    drain();
+}
+
+void Logger::setAsync(bool async) {
+    if (async == isAsync()) {
+        return;
+    }
+    if (async) {
+        if (!queue) {
+            queue = std::make_unique<Queue>();
+        }
+        running.store(true, std::memory_order_release);
+        worker = std::thread([this] { run(); });
+    } else {
+        running.store(false, std::memory_order_seq_cst);
+        worker.join();
+        // Producers that saw the logger running may still be queueing, and
+        // an error waits for room that only draining here makes
+        while (producers.load(std::memory_order_seq_cst) != 0) {
+            drain();
+            std::this_thread::yield();
+        }
+        drain();
+    }
+}
+
+void Logger::flush() {
+    if (!isAsync()) {
+        return;
+    }
+    const auto target = submitted.load(std::memory_order_relaxed);
+    while (delivered.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
     }
 }
 
 void Logger::addReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::recursive_mutex> lock(receiversMutex);
     receivers.push_back(out);
 }
 
 void Logger::removeReceiver(Logger::MessageReceiver* out) {
+    std::lock_guard<std::recursive_mutex> lock(receiversMutex);
     receivers.erase(std::remove(receivers.begin(), receivers.end(), out),
                     receivers.end());
 }
 
-void Logger::error(const std::string& component, const std::string& message) {
+void Logger::error(std::string_view component, std::string_view message) {
     log(component, Logger::Error, message);
 }
 
-void Logger::info(const std::string& component, const std::string& message) {
+void Logger::info(std::string_view component, std::string_view message) {
     log(component, Logger::Info, message);
 }
 
-void Logger::warning(const std::string& component, const std::string& message) {
+void Logger::warning(std::string_view component, std::string_view message) {
     log(component, Logger::Warning, message);
 }
 
-void Logger::verbose(const std::string& component, const std::string& message) {
+void Logger::verbose(std::string_view component, std::string_view message) {
     log(component, Logger::Verbose, message);
 }
 
@@ -2,15 +2,25 @@
 #define _RWENGINE_LOGGER_HPP_
 
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
 /**
  * Handles and stores messages from different components
  *
- * Dispatches received messages to logger outputs.
+ * Dispatches received messages to logger outputs. By default messages are
+ * delivered on the calling thread before log() returns. With setAsync(true)
+ * log() only copies the message into a lock-free queue and a background
+ * thread delivers it, so logging from hot paths doesn't wait on the outputs.
  */
 class Logger {
 public:
@@ -24,6 +34,8 @@ public:
         MessageSeverity severity;
         /// Logged message
         std::string message;
+        /// Microseconds since the logger was created
+        std::uint64_t timestamp = 0;
 
         template <class String1, class String2>
         LogMessage(String1&& cc, MessageSeverity ss,
@@ -38,28 +50,86 @@ public:
      * Interface for handling logged messages.
      *
      * The Logger class will not clean up allocated MessageReceivers.
+     * Receivers of an asynchronous logger are called on its delivery thread.
+     * Whatever a receiver logs is delivered straight away, before log()
+     * returns.
      */
     struct MessageReceiver {
         virtual void messageReceived(const LogMessage&) = 0;
     };
 
-    Logger(std::initializer_list<MessageReceiver*> initial = {})
-        : receivers(initial) {
-    }
+    /// Messages held by an asynchronous logger before they are dropped
+    static constexpr std::size_t kQueueCapacity = 1024;
+    /// Longer components and messages are truncated when queued
+    static constexpr std::size_t kMaxComponentLength = 31;
+    static constexpr std::size_t kMaxMessageLength = 463;
+
+    Logger(std::initializer_list<MessageReceiver*> initial = {});
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
 
     void addReceiver(MessageReceiver* out);
     void removeReceiver(MessageReceiver* out);
 
-    void log(const std::string& component, Logger::MessageSeverity severity,
-             const std::string& message);
+    /**
+     * Starts or stops delivering messages on a background thread. Stopping
+     * delivers everything queued first.
+     */
+    void setAsync(bool async);
 
-    void verbose(const std::string& component, const std::string& message);
-    void info(const std::string& component, const std::string& message);
-    void warning(const std::string& component, const std::string& message);
-    void error(const std::string& component, const std::string& message);
+    bool isAsync() const {
+        return worker.joinable();
+    }
+
+    /// Waits until every message logged so far has been delivered
+    void flush();
+
+    /// Messages an asynchronous logger dropped because its queue was full
+    std::uint64_t getDroppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    void log(std::string_view component, Logger::MessageSeverity severity,
+             std::string_view message);
+
+    void verbose(std::string_view component, std::string_view message);
+    void info(std::string_view component, std::string_view message);
+    void warning(std::string_view component, std::string_view message);
+    void error(std::string_view component, std::string_view message);
 
 private:
+    /// Fixed size copy of a message, so queueing never allocates
+    struct Record {
+        std::uint64_t timestamp;
+        MessageSeverity severity;
+        std::uint16_t componentLength;
+        std::uint16_t messageLength;
+        char component[kMaxComponentLength];
+        char message[kMaxMessageLength];
+    };
+
+    class Queue;
+
+    std::uint64_t now() const;
+    void deliver(const LogMessage& message);
+    void drain();
+    void run();
+
+    /// Recursive, receivers may log themselves
+    std::recursive_mutex receiversMutex;
     std::vector<MessageReceiver*> receivers;
+
+    std::unique_ptr<Queue> queue;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    /// Threads between checking running and queueing their message
+    std::atomic<std::uint32_t> producers{0};
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> delivered{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::int64_t epoch;
 };
 
 class StdOutReceiver final : public Logger::MessageReceiver {
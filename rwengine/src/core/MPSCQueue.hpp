@@ -0,0 +1,88 @@
+#ifndef _RWENGINE_MPSCQUEUE_HPP_
+#define _RWENGINE_MPSCQUEUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Bounded lock-free queue for any number of producer threads and exactly one
+ * consumer thread.
+ *
+ * Each slot carries a sequence number telling producers and the consumer
+ * whose turn it is, so producers only contend on the head index. pop() must
+ * only be called from the consumer thread. Neither call ever blocks; push()
+ * returns false when the queue is full and pop() returns false when it is
+ * empty.
+ */
+template <class T, std::size_t Capacity>
+class MPSCQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "MPSCQueue capacity must be a power of two");
+
+public:
+    MPSCQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    bool push(const T& value) {
+        auto h = head.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[h & (Capacity - 1)];
+            const auto seq = slot->sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(h);
+            if (diff == 0) {
+                // Our turn, claim the slot unless another producer beat us
+                if (head.compare_exchange_weak(h, h + 1,
+                                               std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The consumer hasn't released this slot yet
+                return false;
+            } else {
+                h = head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = value;
+        slot->sequence.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        Slot& slot = slots[tail & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            return false;
+        }
+        value = std::move(slot.value);
+        slot.sequence.store(tail + Capacity, std::memory_order_release);
+        tail++;
+        return true;
+    }
+
+    static constexpr std::size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::array<Slot, Capacity> slots{};
+    /// Claimed by producers
+    alignas(64) std::atomic<std::size_t> head{0};
+    /// Only touched by the consumer
+    alignas(64) std::size_t tail = 0;
+};
+
+#endif
@@ -1,21 +1,29 @@
 #ifndef _RWENGINE_PROFILER_HPP_
 #define _RWENGINE_PROFILER_HPP_
 
+#include <core/Telemetry.hpp>
+
+// Threads, frames and scopes are always recorded by Telemetry, microprofile
+// only adds to that when enabled
 #ifdef RW_PROFILER
 #include <microprofile.h>
-#define RW_PROFILE_THREAD(name) MicroProfileOnThreadCreate(name)
-#define RW_PROFILE_FRAME_BOUNDARY() MicroProfileFlip(nullptr)
-#define RW_PROFILE_SCOPE(label) MICROPROFILE_SCOPEI("Default", label, MP_YELLOW)
-#define RW_PROFILE_SCOPEC(label, colour) MICROPROFILE_SCOPEI("Default", label, colour)
+#define RW_PROFILE_THREAD(name) \
+    do { MicroProfileOnThreadCreate(name); Telemetry::get().setThreadName(name); } while (0)
+#define RW_PROFILE_FRAME_BOUNDARY() \
+    do { MicroProfileFlip(nullptr); Telemetry::get().frameBoundary(); } while (0)
+#define RW_PROFILE_SCOPE(label) \
+    MICROPROFILE_SCOPEI("Default", label, MP_YELLOW); RW_TELEMETRY_SCOPE(label)
+#define RW_PROFILE_SCOPEC(label, colour) \
+    MICROPROFILE_SCOPEI("Default", label, colour); RW_TELEMETRY_SCOPE(label)
 #define RW_PROFILE_COUNTER_ADD(name, qty) MICROPROFILE_COUNTER_ADD(name, qty)
 #define RW_PROFILE_COUNTER_SET(name, qty) MICROPROFILE_COUNTER_SET(name, qty)
 #define RW_TIMELINE_ENTER(name, color) MICROPROFILE_TIMELINE_ENTER_STATIC(color, name)
 #define RW_TIMELINE_LEAVE(name) MICROPROFILE_TIMELINE_LEAVE_STATIC(name)
 #else
-#define RW_PROFILE_THREAD(name) do {} while (0)
-#define RW_PROFILE_FRAME_BOUNDARY() do {} while (0)
-#define RW_PROFILE_SCOPE(label) do {} while (0)
-#define RW_PROFILE_SCOPEC(label, colour)  do {} while (0)
+#define RW_PROFILE_THREAD(name) Telemetry::get().setThreadName(name)
+#define RW_PROFILE_FRAME_BOUNDARY() Telemetry::get().frameBoundary()
+#define RW_PROFILE_SCOPE(label) RW_TELEMETRY_SCOPE(label)
+#define RW_PROFILE_SCOPEC(label, colour) RW_TELEMETRY_SCOPE(label)
 #define RW_PROFILE_COUNTER_ADD(name, qty) do {} while (0)
 #define RW_PROFILE_COUNTER_SET(name, qty) do {} while (0)
 #define RW_TIMELINE_ENTER(name, color) do {} while (0)
@@ -0,0 +1,61 @@
+#ifndef _RWENGINE_SPSCQUEUE_HPP_
+#define _RWENGINE_SPSCQUEUE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * push() must only be called from the producer thread and pop() only from
+ * the consumer thread. Neither call ever blocks; push() returns false when
+ * the queue is full and pop() returns false when it is empty.
+ */
+template <class T, std::size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SPSCQueue capacity must be a power of two");
+
+public:
+    bool push(T&& value) {
+        const auto h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[h & (Capacity - 1)] = std::move(value);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value) {
+        const auto t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // Moving out leaves the slot empty, so resources held by the
+        // element are released on the consumer side.
+        value = std::move(slots[t & (Capacity - 1)]);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) ==
+               tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    std::array<T, Capacity> slots{};
+    /// Written by the producer only
+    alignas(64) std::atomic<std::size_t> head{0};
+    /// Written by the consumer only
+    alignas(64) std::atomic<std::size_t> tail{0};
+};
+
+#endif
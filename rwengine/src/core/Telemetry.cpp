@@ -0,0 +1,237 @@
+#include "core/Telemetry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+std::uint64_t steadyNanoseconds() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+void writeJsonString(std::ostream& out, const std::string& str) {
+    out << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    out << c;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+/// Trace timestamps are in microseconds
+double micros(std::uint64_t ns) {
+    return static_cast<double>(ns) / 1e3;
+}
+
+/// Frame spans are drawn on their own track
+constexpr std::uint32_t kFrameTrack = 0;
+}  // namespace
+
+Telemetry& Telemetry::get() {
+    static Telemetry telemetry;
+    return telemetry;
+}
+
+Telemetry::Telemetry() : frames(kFrameCapacity), epoch(steadyNanoseconds()) {
+}
+
+std::uint64_t Telemetry::now() const {
+    return steadyNanoseconds() - epoch;
+}
+
+Telemetry::ThreadBuffer& Telemetry::threadBuffer() {
+    // Hands the buffer back when the thread exits, so that threads started
+    // for a single task don't each keep one for the rest of the run
+    struct Owner {
+        ThreadBuffer* buffer = nullptr;
+
+        ~Owner() {
+            if (buffer != nullptr) {
+                Telemetry::get().releaseThreadBuffer(*buffer);
+            }
+        }
+    };
+    thread_local Owner owner;
+
+    if (owner.buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeThreads.empty() && threads.size() >= kThreadCapacity) {
+            // The thread that exited longest ago is the least interesting,
+            // what it recorded goes with it
+            owner.buffer = freeThreads.front();
+            freeThreads.erase(freeThreads.begin());
+            owner.buffer->tail =
+                owner.buffer->head.load(std::memory_order_relaxed);
+        } else {
+            threads.push_back(std::make_unique<ThreadBuffer>());
+            owner.buffer = threads.back().get();
+            owner.buffer->id = static_cast<std::uint32_t>(threads.size());
+        }
+        owner.buffer->name = "Thread " + std::to_string(owner.buffer->id);
+    }
+    return *owner.buffer;
+}
+
+void Telemetry::releaseThreadBuffer(ThreadBuffer& buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    freeThreads.push_back(&buffer);
+}
+
+void Telemetry::setThreadName(const std::string& name) {
+    auto& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(mutex);
+    buffer.name = name;
+}
+
+void Telemetry::record(char const* name, std::uint64_t start,
+                       std::uint64_t end) {
+    auto& buffer = threadBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& slot = buffer.events[head % kEventCapacity];
+    // A seqlock, a reader that sees the same sequence before and after its
+    // copy knows none of these stores came in between
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.sequence.store(head + 1, std::memory_order_release);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Telemetry::frameBoundary() {
+    const auto time = now();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frameStarted) {
+        Frame& frame = frames[frameCount % kFrameCapacity];
+        frame.start = frameStart;
+        frame.end = time;
+        for (std::size_t c = 0; c < CounterCount; ++c) {
+            frame.counters[c] =
+                counters[c].exchange(0, std::memory_order_relaxed);
+        }
+        frameCount++;
+    } else {
+        // Whatever was counted before the first frame is startup work
+        for (auto& counter : counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        frameStarted = true;
+    }
+    frameStart = time;
+}
+
+std::vector<Telemetry::Frame> Telemetry::getFrames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto count = std::min(frameCount, kFrameCapacity);
+    std::vector<Frame> out;
+    out.reserve(count);
+    for (auto f = frameCount - count; f < frameCount; ++f) {
+        out.push_back(frames[f % kFrameCapacity]);
+    }
+    return out;
+}
+
+void Telemetry::copyEvents(const ThreadBuffer& buffer,
+                           std::vector<Event>& out) {
+    const auto end = buffer.head.load(std::memory_order_acquire);
+    auto begin = end > kEventCapacity ? end - kEventCapacity : 0;
+    begin = std::max(begin, buffer.tail);
+    out.clear();
+    out.reserve(end - begin);
+    for (auto e = begin; e < end; ++e) {
+        const auto& slot = buffer.events[e % kEventCapacity];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        Event event{slot.name.load(std::memory_order_relaxed),
+                    slot.start.load(std::memory_order_relaxed),
+                    slot.end.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // The owning thread keeps recording while we copy, skip anything it
+        // has overwritten or is still writing
+        if (sequence != e + 1 ||
+            slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        out.push_back(event);
+    }
+}
+
+void Telemetry::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& thread : threads) {
+        thread->tail = thread->head.load(std::memory_order_acquire);
+    }
+    frameCount = 0;
+}
+
+void Telemetry::writeChromeTrace(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+        << kFrameTrack << ", \"args\": {\"name\": \"Frames\"}}";
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<Event> events;
+    for (const auto& thread : threads) {
+        out << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+            << "\"tid\": " << thread->id << ", \"args\": {\"name\": ";
+        writeJsonString(out, thread->name);
+        out << "}}";
+
+        copyEvents(*thread, events);
+        for (const auto& event : events) {
+            out << ",\n{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << thread->id
+                << ", \"ts\": " << micros(event.start)
+                << ", \"dur\": " << micros(event.end - event.start) << "}";
+        }
+    }
+
+    const auto count = std::min(frameCount, kFrameCapacity);
+    for (auto f = frameCount - count; f < frameCount; ++f) {
+        const auto& frame = frames[f % kFrameCapacity];
+        out << ",\n{\"name\": \"Frame\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+            << kFrameTrack << ", \"ts\": " << micros(frame.start)
+            << ", \"dur\": " << micros(frame.end - frame.start) << "}";
+        for (std::size_t c = 0; c < CounterCount; ++c) {
+            out << ",\n{\"name\": \"" << kCounterNames[c]
+                << "\", \"ph\": \"C\", \"pid\": 1, \"ts\": "
+                << micros(frame.start) << ", \"args\": {\"value\": "
+                << frame.counters[c] << "}}";
+        }
+    }
+
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool Telemetry::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        return false;
+    }
+    writeChromeTrace(out);
+    return out.good();
+}
@@ -0,0 +1,188 @@
+#ifndef _RWENGINE_TELEMETRY_HPP_
+#define _RWENGINE_TELEMETRY_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Always-on frame telemetry
+ *
+ * Records scope timings into a ring buffer owned by the recording thread,
+ * so recording never takes a lock, and sums counters for each frame. Only
+ * the most recent events and frames are kept; older ones are overwritten.
+ * Once kThreadCapacity buffers exist, new threads reuse the buffers of
+ * threads that exited, so short lived threads don't add up.
+ *
+ * Unlike microprofile this is built into every configuration, scopes opened
+ * with RW_PROFILE_SCOPE are recorded here as well. The recording can be
+ * written out in the Chrome trace event format (chrome://tracing, Perfetto).
+ */
+class Telemetry {
+public:
+    enum Counter : std::size_t {
+        ObjectsTicked,
+        ObjectsCulled,
+        Draws,
+        Loads,
+        ScriptOps,
+        CounterCount
+    };
+
+    static constexpr std::array<char const*, CounterCount> kCounterNames{
+        {"objectsTicked", "objectsCulled", "draws", "loads", "scriptOps"}};
+
+    /// Scope events kept for each thread
+    static constexpr std::size_t kEventCapacity = 16384;
+    /// Thread buffers allocated before those of exited threads are reused
+    static constexpr std::size_t kThreadCapacity = 8;
+    /// Frames of counters kept
+    static constexpr std::size_t kFrameCapacity = 600;
+
+    /// Times are nanoseconds since the telemetry was created
+    struct Event {
+        /// Must outlive the telemetry, string literals and __func__ do
+        char const* name;
+        std::uint64_t start;
+        std::uint64_t end;
+    };
+
+    struct Frame {
+        std::uint64_t start = 0;
+        std::uint64_t end = 0;
+        std::array<std::int64_t, CounterCount> counters{};
+
+        double ms() const {
+            return static_cast<double>(end - start) / 1e6;
+        }
+    };
+
+    static Telemetry& get();
+
+    void setEnabled(bool enable) {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+    bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Names the calling thread in exported traces
+    void setThreadName(const std::string& name);
+
+    void add(Counter counter, std::int64_t qty) {
+        counters[counter].fetch_add(qty, std::memory_order_relaxed);
+    }
+
+    /**
+     * Ends the current frame, storing its counters and resetting them for
+     * the next one. Called once per frame from the main loop.
+     */
+    void frameBoundary();
+
+    /// Completed frames, oldest first
+    std::vector<Frame> getFrames() const;
+
+    /// Writes every recorded event and frame as a Chrome trace JSON object
+    void writeChromeTrace(std::ostream& out) const;
+    bool writeChromeTrace(const std::string& path) const;
+
+    /// Discards recorded events and frames
+    void clear();
+
+    /// Nanoseconds since the telemetry was created
+    std::uint64_t now() const;
+
+    void record(char const* name, std::uint64_t start, std::uint64_t end);
+
+    /**
+     * Records the time spent in the enclosing block
+     */
+    class Scope {
+    public:
+        explicit Scope(char const* name) : name(name) {
+            auto& telemetry = Telemetry::get();
+            if (telemetry.isEnabled()) {
+                start = telemetry.now();
+                active = true;
+            }
+        }
+
+        ~Scope() {
+            if (active) {
+                auto& telemetry = Telemetry::get();
+                telemetry.record(name, start, telemetry.now());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        char const* name;
+        std::uint64_t start = 0;
+        bool active = false;
+    };
+
+private:
+    /**
+     * An event as it sits in the ring buffer. The owning thread may be
+     * overwriting it while another copies it out, so every field is atomic
+     * and sequence says which event the slot holds, it is 0 while the slot
+     * is being written.
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<char const*> name{nullptr};
+        std::atomic<std::uint64_t> start{0};
+        std::atomic<std::uint64_t> end{0};
+    };
+
+    struct ThreadBuffer {
+        std::string name;
+        std::uint32_t id = 0;
+        std::unique_ptr<Slot[]> events =
+            std::make_unique<Slot[]>(kEventCapacity);
+        /// Events written so far, only advanced by the owning thread
+        std::atomic<std::uint64_t> head{0};
+        /// Events before this were discarded by clear(), guarded by mutex
+        std::uint64_t tail = 0;
+    };
+
+    Telemetry();
+
+    ThreadBuffer& threadBuffer();
+    /// Called as the owning thread exits
+    void releaseThreadBuffer(ThreadBuffer& buffer);
+
+    /// Copies the events still held by the buffer, oldest first
+    static void copyEvents(const ThreadBuffer& buffer,
+                           std::vector<Event>& out);
+
+    std::atomic<bool> enabled{true};
+    std::array<std::atomic<std::int64_t>, CounterCount> counters{};
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    /// Buffers of exited threads, their events are kept until reused
+    std::vector<ThreadBuffer*> freeThreads;
+    std::vector<Frame> frames;
+    std::size_t frameCount = 0;
+    bool frameStarted = false;
+    std::uint64_t frameStart = 0;
+    std::uint64_t epoch = 0;
+};
+
+#define RW_TELEMETRY_CONCAT_(a, b) a##b
+#define RW_TELEMETRY_CONCAT(a, b) RW_TELEMETRY_CONCAT_(a, b)
+#define RW_TELEMETRY_SCOPE(label) \
+    Telemetry::Scope RW_TELEMETRY_CONCAT(rwTelemetryScope, __LINE__)(label)
+#define RW_TELEMETRY_COUNT(counter, qty) \
+    Telemetry::get().add(Telemetry::counter, static_cast<std::int64_t>(qty))
+
+#endif
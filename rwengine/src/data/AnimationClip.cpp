@@ -0,0 +1,230 @@
+#include "data/AnimationClip.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace {
+constexpr std::uint32_t kRotationBits = 20;
+constexpr float kRotationMax = static_cast<float>((1u << kRotationBits) - 1);
+/// The smallest three components of a unit quaternion lie within this
+constexpr float kRotationRange = 0.70710678118654752f;
+
+constexpr float kPositionMax = 65535.f;
+
+/// Offset of the positions or scales a channel leaves out
+constexpr std::uint32_t kAbsent = ~0u;
+
+std::uint64_t quantizeComponent(float v) {
+    const auto unit = (v / kRotationRange + 1.f) * 0.5f;
+    return static_cast<std::uint64_t>(
+        std::lround(glm::clamp(unit, 0.f, 1.f) * kRotationMax));
+}
+
+float dequantizeComponent(std::uint64_t q) {
+    return (static_cast<float>(q) / kRotationMax * 2.f - 1.f) *
+           kRotationRange;
+}
+}  // namespace
+
+AnimationClip::AnimationClip() : memory(MemoryCategory::Animations) {
+}
+
+std::uint64_t AnimationClip::packRotation(const glm::quat& rotation) {
+    std::array<float, 4> c{{rotation.x, rotation.y, rotation.z, rotation.w}};
+    std::uint64_t largest = 0;
+    for (auto i = 1u; i < c.size(); ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) {
+            largest = i;
+        }
+    }
+    // q and -q are the same rotation, keep the one that makes the largest
+    // component positive so it can be rebuilt from the others
+    const auto sign = c[largest] < 0.f ? -1.f : 1.f;
+
+    std::uint64_t packed = largest;
+    auto shift = 2u;
+    for (auto i = 0u; i < c.size(); ++i) {
+        if (i == largest) {
+            continue;
+        }
+        packed |= quantizeComponent(c[i] * sign) << shift;
+        shift += kRotationBits;
+    }
+    return packed;
+}
+
+glm::quat AnimationClip::unpackRotation(std::uint64_t packed) {
+    const auto largest = packed & 3u;
+    const auto mask = (std::uint64_t{1} << kRotationBits) - 1;
+
+    std::array<float, 4> c{};
+    float sum = 0.f;
+    auto shift = 2u;
+    for (auto i = 0u; i < c.size(); ++i) {
+        if (i == largest) {
+            continue;
+        }
+        c[i] = dequantizeComponent((packed >> shift) & mask);
+        sum += c[i] * c[i];
+        shift += kRotationBits;
+    }
+    c[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+    return glm::quat{c[3], c[0], c[1], c[2]};
+}
+
+void AnimationClip::addChannel(const std::string& name,
+                               AnimationBone::Data type,
+                               const std::vector<AnimationKeyframe>& frames) {
+    if (frames.empty()) {
+        return;
+    }
+
+    Channel channel{};
+    channel.name = name;
+    channel.type = type;
+    channel.count = static_cast<std::uint32_t>(frames.size());
+
+    std::vector<float> keyTimes;
+    keyTimes.reserve(frames.size());
+    for (const auto& frame : frames) {
+        keyTimes.push_back(frame.starttime);
+    }
+    channel.times = addTimes(keyTimes);
+
+    channel.rotations = static_cast<std::uint32_t>(rotations.size());
+    for (const auto& frame : frames) {
+        rotations.push_back(packRotation(frame.rotation));
+    }
+
+    // Positions and scales are left out where they're all 0 and 1
+    auto min = frames[0].position;
+    auto max = frames[0].position;
+    bool scaled = false;
+    for (const auto& frame : frames) {
+        min = glm::min(min, frame.position);
+        max = glm::max(max, frame.position);
+        scaled |= frame.scale != glm::vec3(1.f);
+    }
+
+    channel.positions = kAbsent;
+    if (min != glm::vec3(0.f) || max != glm::vec3(0.f)) {
+        channel.positions = static_cast<std::uint32_t>(positions.size());
+        channel.positionMin = min;
+        channel.positionStep = (max - min) / kPositionMax;
+        const auto quantize = [&](float v, float lo, float step) {
+            if (step == 0.f) {
+                return std::uint16_t{0};
+            }
+            return static_cast<std::uint16_t>(std::lround(
+                glm::clamp((v - lo) / step, 0.f, kPositionMax)));
+        };
+        for (const auto& frame : frames) {
+            positions.push_back(
+                {quantize(frame.position.x, min.x, channel.positionStep.x),
+                 quantize(frame.position.y, min.y, channel.positionStep.y),
+                 quantize(frame.position.z, min.z, channel.positionStep.z)});
+        }
+    }
+
+    channel.scales = kAbsent;
+    if (scaled) {
+        channel.scales = static_cast<std::uint32_t>(scales.size());
+        for (const auto& frame : frames) {
+            scales.push_back(frame.scale);
+        }
+    }
+
+    channels.push_back(std::move(channel));
+    updateMemory();
+}
+
+std::uint32_t AnimationClip::addTimes(const std::vector<float>& keyTimes) {
+    for (const auto& channel : channels) {
+        if (channel.count == keyTimes.size() &&
+            std::equal(keyTimes.begin(), keyTimes.end(),
+                       times.begin() + channel.times)) {
+            return channel.times;
+        }
+    }
+    const auto first = static_cast<std::uint32_t>(times.size());
+    times.insert(times.end(), keyTimes.begin(), keyTimes.end());
+    return first;
+}
+
+void AnimationClip::updateMemory() {
+    memory.set(channels.capacity() * sizeof(Channel) +
+               times.capacity() * sizeof(float) +
+               rotations.capacity() * sizeof(std::uint64_t) +
+               positions.capacity() * sizeof(PackedPosition) +
+               scales.capacity() * sizeof(glm::vec3));
+}
+
+std::uint32_t AnimationClip::findChannel(const std::string& name) const {
+    for (auto c = 0u; c < channels.size(); ++c) {
+        if (channels[c].name == name) {
+            return c;
+        }
+    }
+    return kNoChannel;
+}
+
+AnimationKeyframe AnimationClip::getKeyframe(std::uint32_t c,
+                                             std::uint32_t key) const {
+    const auto& channel = channels[c];
+    AnimationKeyframe frame;
+    frame.rotation = unpackRotation(rotations[channel.rotations + key]);
+    if (channel.positions != kAbsent) {
+        const auto& p = positions[channel.positions + key];
+        frame.position = channel.positionMin +
+                         glm::vec3(p.x, p.y, p.z) * channel.positionStep;
+    }
+    if (channel.scales != kAbsent) {
+        frame.scale = scales[channel.scales + key];
+    }
+    frame.starttime = times[channel.times + key];
+    frame.id = static_cast<int>(key);
+    return frame;
+}
+
+AnimationKeyframe AnimationClip::sample(std::uint32_t c, float time,
+                                        std::uint32_t& cursor) const {
+    const auto& channel = channels[c];
+    const auto* keyTimes = times.data() + channel.times;
+
+    // Find the first key at or after time, walking on from the last one
+    // found while time moves forward
+    auto key = cursor;
+    if (key >= channel.count || (key > 0 && !(keyTimes[key - 1] < time))) {
+        key = static_cast<std::uint32_t>(
+            std::lower_bound(keyTimes, keyTimes + channel.count, time) -
+            keyTimes);
+    } else {
+        while (key < channel.count && !(time <= keyTimes[key])) {
+            key++;
+        }
+    }
+    cursor = key;
+
+    if (key >= channel.count) {
+        return getKeyframe(c, channel.count - 1);
+    }
+
+    const auto f2 = getKeyframe(c, key);
+    // Like AnimationBone, times before the first key blend from the last
+    const auto f1 =
+        key > 0 ? getKeyframe(c, key - 1)
+                : (channel.count != 1 ? getKeyframe(c, channel.count - 1) : f2);
+
+    const float tdiff = f2.starttime - f1.starttime;
+    const float alpha =
+        tdiff == 0.f ? 1.f
+                     : glm::clamp((time - f1.starttime) / tdiff, 0.f, 1.f);
+
+    return {glm::normalize(glm::slerp(f1.rotation, f2.rotation, alpha)),
+            glm::mix(f1.position, f2.position, alpha),
+            glm::mix(f1.scale, f2.scale, alpha), time, std::max(f1.id, f2.id)};
+}
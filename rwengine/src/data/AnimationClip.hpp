@@ -0,0 +1,131 @@
+#ifndef _RWENGINE_DATA_ANIMATIONCLIP_HPP_
+#define _RWENGINE_DATA_ANIMATIONCLIP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <rw/accounting.hpp>
+
+#include "loaders/LoaderIFP.hpp"
+
+/**
+ * @brief Compact, sampling friendly form of an animation's keyframes
+ *
+ * Channels are kept in the order they were added, which for IFP files is
+ * the order of the bones in the file. Their keyframes are stored per
+ * attribute in arrays shared by the whole clip:
+ *
+ *  - key times, with channels whose keys fall at the same times sharing
+ *    one run of them
+ *  - rotations, as the three smallest components quantized to 20 bits each
+ *    plus the index of the largest, in 8 bytes
+ *  - positions, as 16 bit offsets into the box they span in their channel
+ *  - scales, kept as they are for the few RTS channels
+ *
+ * which makes a keyframe of a typical ped animation take 14 bytes rather
+ * than the 48 of an AnimationKeyframe.
+ *
+ * Sampling goes through a cursor that remembers the last key found, so
+ * playing an animation forward finds each key without searching.
+ */
+class AnimationClip {
+public:
+    static constexpr std::uint32_t kNoChannel = ~0u;
+
+    AnimationClip();
+
+    /**
+     * Appends a channel holding frames, which must be sorted by time.
+     * Channels without frames are left out.
+     */
+    void addChannel(const std::string& name, AnimationBone::Data type,
+                    const std::vector<AnimationKeyframe>& frames);
+
+    std::size_t getChannelCount() const {
+        return channels.size();
+    }
+
+    const std::string& getChannelName(std::uint32_t channel) const {
+        return channels[channel].name;
+    }
+
+    AnimationBone::Data getChannelType(std::uint32_t channel) const {
+        return channels[channel].type;
+    }
+
+    std::uint32_t getKeyCount(std::uint32_t channel) const {
+        return channels[channel].count;
+    }
+
+    /// @return the channel animating the named frame, or kNoChannel
+    std::uint32_t findChannel(const std::string& name) const;
+
+    /**
+     * Interpolates the channel's keyframes at time, in the same way as
+     * AnimationBone::getInterpolatedKeyframe
+     * @param cursor key found by the last call for this channel, start it at
+     * 0
+     */
+    AnimationKeyframe sample(std::uint32_t channel, float time,
+                             std::uint32_t& cursor) const;
+
+    AnimationKeyframe sample(std::uint32_t channel, float time) const {
+        std::uint32_t cursor = 0;
+        return sample(channel, time, cursor);
+    }
+
+    /// The decoded keyframe at key
+    AnimationKeyframe getKeyframe(std::uint32_t channel,
+                                  std::uint32_t key) const;
+
+    /// Bytes held by the clip's arrays
+    std::size_t getMemorySize() const {
+        return memory.size();
+    }
+
+    /// Quaternion as stored in a clip, exposed for testing
+    static std::uint64_t packRotation(const glm::quat& rotation);
+    static glm::quat unpackRotation(std::uint64_t packed);
+
+private:
+    struct Channel {
+        std::string name;
+        AnimationBone::Data type;
+        std::uint32_t count;
+        /// First entry in times
+        std::uint32_t times;
+        /// First entry in rotations, positions and scales, ~0u for the
+        /// positions and scales a channel leaves out
+        std::uint32_t rotations;
+        std::uint32_t positions;
+        std::uint32_t scales;
+        /// Positions are positionMin + quantized * positionStep
+        glm::vec3 positionMin;
+        glm::vec3 positionStep;
+    };
+
+    struct PackedPosition {
+        std::uint16_t x;
+        std::uint16_t y;
+        std::uint16_t z;
+    };
+
+    /// @return the first entry of a run in times equal to keyTimes
+    std::uint32_t addTimes(const std::vector<float>& keyTimes);
+
+    void updateMemory();
+
+    std::vector<Channel> channels;
+    std::vector<float> times;
+    std::vector<std::uint64_t> rotations;
+    std::vector<PackedPosition> positions;
+    std::vector<glm::vec3> scales;
+
+    MemoryAllocation memory;
+};
+
+#endif
@@ -2,7 +2,9 @@
 #define _RWENGINE_COLLISIONMODEL_HPP_
 
 #include <glm/vec3.hpp>
+#include <rw/accounting.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -48,6 +50,17 @@ struct CollisionModel {
     std::vector<Box> boxes;
     std::vector<glm::vec3> vertices;
     std::vector<Triangle> faces;
+
+    MemoryAllocation memory{MemoryCategory::Collision};
+
+    /// Bytes used by the model and its shapes
+    std::size_t calculateMemorySize() const {
+        return sizeof(CollisionModel) + name.capacity() +
+               spheres.capacity() * sizeof(Sphere) +
+               boxes.capacity() * sizeof(Box) +
+               vertices.capacity() * sizeof(glm::vec3) +
+               faces.capacity() * sizeof(Triangle);
+    }
 };
 
 #endif
@@ -109,6 +109,18 @@ bool CollisionInstance::createPhysicsBody(GameObject* object,
 
     m_collisionHeight = colMax - colMin;
 
+    // The mesh shape builds a BVH over the model's triangles, which holds
+    // about two quantized nodes per triangle
+    m_memory.set(sizeof(btRigidBody) + sizeof(btCompoundShape) +
+                 sizeof(GameObjectMotionState) +
+                 collision->boxes.size() * sizeof(btBoxShape) +
+                 collision->spheres.size() * sizeof(btSphereShape) +
+                 (m_vertArray ? sizeof(btTriangleIndexVertexArray) +
+                                    sizeof(btBvhTriangleMeshShape) +
+                                    faces.size() * 2 *
+                                        sizeof(btQuantizedBvhNode)
+                              : 0));
+
     if (dynamics) {
         if (dynamics->uprootForce > 0.f) {
             info.m_mass = 0.f;
@@ -6,6 +6,8 @@
 
 #include <btBulletDynamicsCommon.h>
 
+#include <rw/accounting.hpp>
+
 class btCollisionShape;
 class btCompoundShape;
 class btTriangleIndexVertexArray;
@@ -60,6 +62,8 @@ private:
 
     std::unique_ptr<btMotionState> m_motionState;
 
+    MemoryAllocation m_memory{MemoryCategory::Collision};
+
     float m_collisionHeight{0.f};
 };
 
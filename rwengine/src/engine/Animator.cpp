@@ -6,6 +6,7 @@
 
 #include <data/Clump.hpp>
 
+#include "data/AnimationClip.hpp"
 #include "loaders/LoaderIFP.hpp"
 
 #include <algorithm>
@@ -27,13 +28,14 @@ void Animator::tick(float dt) {
     for (AnimationState& state : animations) {
         if (state.animation == nullptr) continue;
 
+        const auto& clip = state.animation->getClip();
         if (state.boneInstances.empty()) {
-            for (auto& [name, bone] : state.animation->bones) {
-                auto frame = model->findFrame(name);
+            for (auto c = 0u; c < clip.getChannelCount(); ++c) {
+                auto frame = model->findFrame(clip.getChannelName(c));
                 if (!frame) {
                     continue;
                 }
-                state.boneInstances.emplace(&bone, frame);
+                state.boneInstances.push_back({c, frame, 0});
             }
         }
 
@@ -46,13 +48,12 @@ void Animator::tick(float dt) {
             animTime = std::fmod(animTime, state.animation->duration);
         }
 
-        for (auto& [bonePtr, frame] : state.boneInstances) {
-            if (bonePtr->frames.empty()) continue;
-            auto kf = bonePtr->getInterpolatedKeyframe(animTime);
+        for (auto& [channel, frame, cursor] : state.boneInstances) {
+            auto kf = clip.sample(channel, animTime, cursor);
 
             BoneTransform xform;
             xform.rotation = kf.rotation;
-            if (bonePtr->type != AnimationBone::R00) {
+            if (clip.getChannelType(channel) != AnimationBone::R00) {
                 xform.translation = kf.position;
             }
             frame->setTranslation(frame->getDefaultTranslation() +
@@ -4,10 +4,9 @@
 #include <rw/debug.hpp>
 #include <rw/forward.hpp>
 
-#include <map>
+#include <cstdint>
 #include <vector>
 
-struct AnimationBone;
 class ModelFrame;
 
 /**
@@ -21,6 +20,13 @@ class ModelFrame;
  * The Animator will blend all active animations together.
  */
 class Animator {
+    struct ChannelInstance {
+        std::uint32_t channel;
+        ModelFrame* frame;
+        /// Key found by the last sample, playback mostly moves forward
+        std::uint32_t cursor;
+    };
+
     /**
      * @brief The AnimationState struct stores information about playing
      * animations
@@ -33,7 +39,8 @@ class Animator {
         float speed;
         /// Automatically restart
         bool repeat;
-        std::map<AnimationBone*, ModelFrame*> boneInstances;
+        /// The clip's channels that have a frame in the model
+        std::vector<ChannelInstance> boneInstances;
     };
 
     /**
@@ -0,0 +1,112 @@
+#include "engine/CutscenePrefetch.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include <platform/FileIndex.hpp>
+
+#include "audio/SoundSource.hpp"
+#include "core/Profiler.hpp"
+#include "loaders/LoaderCutsceneDAT.hpp"
+#include "loaders/LoaderIFP.hpp"
+
+CutscenePrefetch::CutscenePrefetch(FileIndex& index) : index(index) {
+}
+
+CutscenePrefetch::~CutscenePrefetch() {
+    clear();
+}
+
+void CutscenePrefetch::prefetchCutscene(const std::string& name,
+                                        const PCMCache* cache) {
+    auto key = FileIndex::normalizeFilePath(name);
+    if (cutscene.valid() && cutsceneName == key) {
+        return;
+    }
+
+    cutsceneName = std::move(key);
+    cutscene = std::async(std::launch::async, [this, name, cache]() {
+        RW_PROFILE_THREAD("Prefetch");
+        return readCutscene(name, cache);
+    });
+}
+
+std::optional<CutscenePrefetch::Cutscene> CutscenePrefetch::takeCutscene(
+    const std::string& name) {
+    if (!cutscene.valid() ||
+        cutsceneName != FileIndex::normalizeFilePath(name)) {
+        return std::nullopt;
+    }
+    cutsceneName.clear();
+    return cutscene.get();
+}
+
+void CutscenePrefetch::prefetchFile(const std::string& name) {
+    auto key = FileIndex::normalizeFilePath(name);
+    if (files.find(key) != files.end()) {
+        return;
+    }
+
+    files.emplace(std::move(key),
+                  std::async(std::launch::async, [this, name]() {
+                      RW_PROFILE_THREAD("Prefetch");
+                      return index.openFile(name);
+                  }));
+}
+
+FileContentsInfo CutscenePrefetch::takeFile(const std::string& name) {
+    auto it = files.find(FileIndex::normalizeFilePath(name));
+    if (it == files.end()) {
+        return {nullptr, 0};
+    }
+    auto file = std::move(it->second);
+    files.erase(it);
+    return file.get();
+}
+
+void CutscenePrefetch::dropFile(const std::string& name) {
+    files.erase(FileIndex::normalizeFilePath(name));
+}
+
+void CutscenePrefetch::clear() {
+    // Dropping the futures waits for their threads
+    cutscene = {};
+    cutsceneName.clear();
+    files.clear();
+}
+
+CutscenePrefetch::Cutscene CutscenePrefetch::readCutscene(
+    std::string name, const PCMCache* cache) const {
+    RW_PROFILE_SCOPE(__func__);
+
+    Cutscene result;
+    result.name = std::move(name);
+
+    auto datfile = index.openFile(result.name + ".dat");
+    if (datfile.data) {
+        LoaderCutsceneDAT loaderdat;
+        loaderdat.load(result.tracks, datfile);
+    }
+
+    auto ifpfile = index.openFile(result.name + ".ifp");
+    if (ifpfile.data) {
+        if (LoaderIFP loader{}; loader.loadFromMemory(ifpfile.data.get())) {
+            result.animations = std::move(loader.animations);
+        }
+    }
+
+    for (const auto extension : {".mp3", ".wav"}) {
+        std::filesystem::path path;
+        try {
+            path = index.findFilePath("audio/" + result.name + extension);
+        } catch (const std::out_of_range&) {
+            continue;
+        }
+        result.audioName = result.name + extension;
+        result.audio = std::make_shared<SoundSource>();
+        result.audio->loadFromFile(path, true, cache);
+        break;
+    }
+
+    return result;
+}
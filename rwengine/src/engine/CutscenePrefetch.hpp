@@ -0,0 +1,97 @@
+#ifndef _RWENGINE_CUTSCENEPREFETCH_HPP_
+#define _RWENGINE_CUTSCENEPREFETCH_HPP_
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <platform/FileHandle.hpp>
+#include <rw/forward.hpp>
+
+#include <data/CutsceneData.hpp>
+
+class FileIndex;
+class PCMCache;
+class SoundSource;
+
+/**
+ * @brief Reads the files of a cutscene before it is needed
+ *
+ * Loading a cutscene used to read its track data and animations and start
+ * decoding its audio on the game thread, when the script asks for it. The
+ * prefetcher does that work on a background thread as soon as the cutscene
+ * or the special actors and models it uses are known, so that by the time
+ * the script animates and starts the cutscene only the results have to be
+ * handed over.
+ *
+ * Only reading, parsing and decoding happen in the background: uploading
+ * models and textures and creating the OpenAL buffers stays with the game
+ * thread. The workers don't log, the caller reports what is missing.
+ *
+ * The FileIndex must be fully indexed before anything is prefetched.
+ */
+class CutscenePrefetch {
+public:
+    /// What loading a cutscene needs, read and parsed
+    struct Cutscene {
+        std::string name;
+        /// Default tracks if the cutscene has no track data
+        CutsceneTracks tracks;
+        AnimationSet animations;
+        /// Name of the audio file, empty if there is none
+        std::string audioName;
+        /// Decoding, or decoded if the file was cached
+        std::shared_ptr<SoundSource> audio;
+    };
+
+    CutscenePrefetch(FileIndex& index);
+    ~CutscenePrefetch();
+
+    CutscenePrefetch(const CutscenePrefetch&) = delete;
+    CutscenePrefetch& operator=(const CutscenePrefetch&) = delete;
+
+    /**
+     * Starts reading the named cutscene in the background, replacing any
+     * other cutscene being prefetched
+     * @param cache decoded audio to map instead of decoding it again, it must
+     * outlive the prefetch
+     */
+    void prefetchCutscene(const std::string& name, const PCMCache* cache);
+
+    /**
+     * Returns the cutscene read by prefetchCutscene, waiting for it if it is
+     * still being read
+     * @return std::nullopt if name wasn't prefetched
+     */
+    std::optional<Cutscene> takeCutscene(const std::string& name);
+
+    /// Starts reading the named file from the index in the background
+    void prefetchFile(const std::string& name);
+
+    /**
+     * Returns the contents of a file started by prefetchFile, waiting for it
+     * if it is still being read
+     * @return empty contents if name wasn't prefetched
+     */
+    FileContentsInfo takeFile(const std::string& name);
+
+    /// Drops a file started by prefetchFile that is no longer wanted,
+    /// waiting for it if it is still being read
+    void dropFile(const std::string& name);
+
+    /// Waits for and drops whatever hasn't been taken
+    void clear();
+
+private:
+    Cutscene readCutscene(std::string name, const PCMCache* cache) const;
+
+    FileIndex& index;
+
+    std::string cutsceneName;
+    std::future<Cutscene> cutscene;
+    std::unordered_map<std::string, std::future<FileContentsInfo>> files;
+};
+
+#endif
@@ -22,6 +22,7 @@
 #include "data/CollisionModel.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "engine/WaterWaves.hpp"
 #include "loaders/LoaderCOL.hpp"
 #include "loaders/LoaderIDE.hpp"
 #include "loaders/LoaderIFP.hpp"
@@ -34,10 +35,21 @@
 #include "platform/FileIndex.hpp"
 
 GameData::GameData(Logger* log, const std::filesystem::path& path)
-    : datpath(path), logger(log) {
+    : datpath(path)
+    , logger(log)
+    , geometryArena(std::make_shared<GeometryArena>(
+          static_cast<GLsizei>(sizeof(GeometryVertex)),
+          GeometryVertex::vertex_attributes())) {
+    dffLoader.setGeometryArena(geometryArena);
     dffLoader.setTextureLookupCallback(
         [&](const std::string& texture, const std::string&) {
-            return findSlotTexture(currenttextureslot, texture);
+            const auto slot = textureSlots.findSlot(currenttextureslot);
+            auto found =
+                textureSlots.find(slot, textureSlots.findTexture(texture));
+            if (found) {
+                resolvedSlot = slot;
+            }
+            return found;
         });
 }
 
@@ -52,12 +64,15 @@ bool GameData::load() {
     /// @todo cuts.img files should be loaded differently to gta3.img
     loadIMG("anim/cuts.img");
 
-    textureSlots["particle"] = loadTextureArchive("particle.txd");
-    textureSlots["icons"] = loadTextureArchive("icons.txd");
-    textureSlots["hud"] = loadTextureArchive("hud.txd");
-    textureSlots["fonts"] = loadTextureArchive("fonts.txd");
-    textureSlots["generic"] = loadTextureArchive("generic.txd");
-    loadToTextureArchive("misc.txd", textureSlots["generic"]);
+    // Looked up by name all game long, so they are never evicted
+    for (const std::string name : {"particle", "icons", "hud", "fonts",
+                                   "generic"}) {
+        auto slot = textureSlots.internSlot(name);
+        textureSlots.insert(slot, loadTextureArchive(name + ".txd"));
+        textureSlots.setPinned(slot, true);
+    }
+    textureSlots.insert(textureSlots.findSlot("generic"),
+                        loadTextureArchive("misc.txd"));
 
     loadCarcols("data/carcols.dat");
     loadWeather("data/timecyc.dat");
@@ -367,18 +382,37 @@ void GameData::loadTXD(const std::string& name) {
     currenttextureslot = slot;
 
     // Check if this texture slot is loaded already
-    auto slotit = textureSlots.find(slot);
-    if (slotit != textureSlots.end()) {
+    auto id = textureSlots.internSlot(slot);
+    if (textureSlots.isResident(id)) {
+        textureSlots.touch(id);
         return;
     }
 
-    textureSlots[slot] = loadTextureArchive(name);
+    textureSlots.insert(id, loadTextureArchive(name));
+    textureSlots.enforceBudget(id);
+}
+
+ClumpPtr GameData::loadDFF(const FileContentsInfo& file) {
+    resolvedSlot = TextureResidency::kInvalid;
+    auto model = dffLoader.loadFromMemory(file);
+    // Models whose materials found nothing don't depend on any slot
+    if (!model || resolvedSlot == TextureResidency::kInvalid) {
+        return model;
+    }
+    auto reference = textureSlots.acquire(resolvedSlot);
+    for (const auto& atomic : model->getAtomics()) {
+        if (const auto& geometry = atomic->getGeometry()) {
+            geometry->textureReference = reference;
+        }
+    }
+    return model;
 }
 
 TextureArchive GameData::loadTextureArchive(const std::string& name) {
     RW_PROFILE_COUNTER_ADD("loadTextureArchive", 1);
+    RW_TELEMETRY_COUNT(Loads, 1);
     /// @todo refactor loadTXD to use correct file locations
-    auto file = index.openFile(name);
+    auto file = openDataFile(name);
     if (!file.data) {
         logger->error("Data", "Failed to open txd: " + name);
         return {};
@@ -386,8 +420,7 @@ TextureArchive GameData::loadTextureArchive(const std::string& name) {
 
     TextureArchive textures;
 
-    TextureLoader l;
-    if (!l.loadFromMemory(file, textures)) {
+    if (!textureLoader.loadFromMemory(file, textures, textureCacheKey(name))) {
         logger->error("Data", "Error loading txd: " + name);
         return {};
     }
@@ -398,18 +431,57 @@ TextureArchive GameData::loadTextureArchive(const std::string& name) {
 void GameData::loadToTextureArchive(const std::string& name,
                                   TextureArchive& archive) {
     RW_PROFILE_COUNTER_ADD("loadTextureArchive", 1);
+    RW_TELEMETRY_COUNT(Loads, 1);
     /// @todo refactor loadTXD to use correct file locations
     auto file = index.openFile(name);
     if (!file.data) {
         logger->error("Data", "Failed to open txd: " + name);
     }
 
-    TextureLoader l;
-    if (!l.loadFromMemory(file, archive)) {
+    if (!textureLoader.loadFromMemory(file, archive, textureCacheKey(name))) {
         logger->error("Data", "Error loading txd: " + name);
     }
 }
 
+void GameData::setTextureCacheDirectory(
+    const std::filesystem::path& directory) {
+    textureCache = TextureCache(directory);
+    textureLoader.setCache(&textureCache);
+}
+
+std::size_t GameData::transcodeTextures() {
+    if (!textureCache.isEnabled()) {
+        return 0;
+    }
+
+    std::size_t stored = 0;
+    for (const auto& name : index.findFilesWithExtension(".txd")) {
+        auto key = textureCacheKey(name);
+        auto file = index.openFile(name);
+        if (!key || !file.data) {
+            continue;
+        }
+        if (TextureLoader::transcode(file, *key, textureCache)) {
+            stored++;
+        } else {
+            logger->warning("Data", "Failed to transcode txd: " + name);
+        }
+    }
+    return stored;
+}
+
+std::optional<std::uint64_t> GameData::textureCacheKey(
+    const std::string& name) const {
+    if (!textureCache.isEnabled()) {
+        return std::nullopt;
+    }
+    auto stamp = index.fileStamp(name);
+    if (!stamp) {
+        return std::nullopt;
+    }
+    return TextureCache::key(stamp->source, stamp->size, stamp->modified);
+}
+
 void GameData::getNameAndLod(std::string& name, int& lod) {
     auto lodpos = name.rfind("_l");
     if (lodpos != std::string::npos) {
@@ -419,12 +491,13 @@ void GameData::getNameAndLod(std::string& name, int& lod) {
 }
 
 ClumpPtr GameData::loadClump(const std::string& name) {
+    RW_TELEMETRY_COUNT(Loads, 1);
     auto file = index.openFile(name);
     if (!file.data) {
         logger->error("Data", "Failed to load model " + name);
         return nullptr;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = loadDFF(file);
     if (!m) {
         logger->error("Data", "Error loading model file " + name);
         return nullptr;
@@ -434,20 +507,29 @@ ClumpPtr GameData::loadClump(const std::string& name) {
 
 ClumpPtr GameData::loadClump(const std::string& name, const std::string& textureSlot) {
     std::string currentSlot = currenttextureslot;
-    if (!textureSlot.empty())
+    if (!textureSlot.empty()) {
         currenttextureslot = textureSlot;
+        auto id = textureSlots.internSlot(textureSlot);
+        if (textureSlots.isResident(id)) {
+            textureSlots.touch(id);
+        } else {
+            textureSlots.insert(id, loadTextureArchive(textureSlot + ".txd"));
+            textureSlots.enforceBudget(id);
+        }
+    }
     ClumpPtr result = loadClump(name);
     currenttextureslot = currentSlot;
     return result;
 }
 
 void GameData::loadModelFile(const std::string& name) {
+    RW_TELEMETRY_COUNT(Loads, 1);
     auto file = index.openFileRaw(name);
     if (!file.data) {
         logger->log("Data", Logger::Error, "Failed to load model file " + name);
         return;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    auto m = loadDFF(file);
     if (!m) {
         logger->log("Data", Logger::Error, "Error loading model file " + name);
         return;
@@ -508,13 +590,19 @@ bool GameData::loadModel(ModelID model) {
     /// @todo remove this from here
     loadTXD(slotname + ".txd");
 
-    auto file = index.openFile(name + ".dff");
+    auto file = openDataFile(name + ".dff");
     if (!file.data) {
         logger->error("Data", "Failed to load model for " +
                                   std::to_string(model) + " [" + name + "]");
         return false;
     }
-    auto m = dffLoader.loadFromMemory(file);
+    // Big buildings are drawn into the occlusion buffer on the CPU
+    const bool occluder =
+        info->type() == ModelDataType::SimpleInfo &&
+        static_cast<SimpleModelInfo*>(info)->isBigBuilding();
+    dffLoader.setKeepPositions(occluder);
+    auto m = loadDFF(file);
+    dffLoader.setKeepPositions(false);
     if (!m) {
         logger->error("Data",
                       "Error loading model file for " + std::to_string(model));
@@ -543,6 +631,14 @@ bool GameData::loadModel(ModelID model) {
     return true;
 }
 
+FileContentsInfo GameData::openDataFile(const std::string& name) {
+    auto file = prefetch.takeFile(name);
+    if (file.data) {
+        return file;
+    }
+    return index.openFile(name);
+}
+
 void GameData::loadIFP(const std::string& name, bool cutsceneAnimation) {
     auto f = index.openFile(name);
 
@@ -691,6 +787,20 @@ bool GameData::loadAudioStream(const std::string& name) {
     return false;
 }
 
+bool GameData::loadAudioStream(const std::string& name,
+                               std::shared_ptr<SoundSource> source) {
+    if (engine->cutsceneAudio.length() > 0) {
+        engine->sound.stopMusic(engine->cutsceneAudio);
+    }
+
+    if (engine->sound.adoptMusic(name, std::move(source))) {
+        engine->cutsceneAudio = name;
+        return true;
+    }
+
+    return false;
+}
+
 bool GameData::loadAudioClip(const std::string& name,
                              const std::string& fileName) {
     auto systempath = index.findFilePath("audio/" + fileName).string();
@@ -716,21 +826,15 @@ void GameData::loadSplash(const std::string& name) {
     std::string lower(name);
     std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
 
-    textureSlots[lower + ".txd"] = loadTextureArchive(lower + ".txd");
+    textureSlots.insert(textureSlots.internSlot(lower + ".txd"),
+                        loadTextureArchive(lower + ".txd"));
 
     engine->state->currentSplash = lower;
 }
 
 TextureData* GameData::findSlotTexture(const std::string &slot, const std::string &texture) const {
-    auto slotIt = textureSlots.find(slot);
-    if (slotIt == textureSlots.end()) {
-        return nullptr;
-    }
-    auto textureIt = slotIt->second.find(texture);
-    if (textureIt == slotIt->second.end()) {
-        return nullptr;
-    }
-    return textureIt->second.get();
+    return textureSlots.find(textureSlots.findSlot(slot),
+                             textureSlots.findTexture(texture));
 }
 
 ZoneData *GameData::findZone(const std::string &name) {
@@ -761,8 +865,12 @@ int GameData::getWaterIndexAt(const glm::vec3& ws) const {
 }
 
 float GameData::getWaveHeightAt(const glm::vec3& ws) const {
-    return (1 + std::sin(engine->getGameTime() + (ws.x + ws.y) * WATER_SCALE)) *
-           WATER_HEIGHT;
+    return WaterWaves::heightAt(engine->getGameTime(), ws.x, ws.y);
+}
+
+void GameData::getWaveHeightsAt(const float* x, const float* y,
+                                std::size_t count, float* heights) const {
+    WaterWaves::heightsAt(engine->getGameTime(), x, y, count, heights);
 }
 
 bool GameData::isValidGameDirectory() const {
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,10 +22,13 @@
 #include <data/WeaponData.hpp>
 #include <data/Weather.hpp>
 #include <data/ZoneData.hpp>
+#include <engine/CutscenePrefetch.hpp>
+#include <engine/TextureResidency.hpp>
 #include <fonts/GameTexts.hpp>
 #include <loaders/LoaderDFF.hpp>
 #include <loaders/LoaderIMG.hpp>
 #include <loaders/LoaderTXD.hpp>
+#include <loaders/TextureCache.hpp>
 #include <objects/VehicleInfo.hpp>
 
 class Logger;
@@ -32,6 +36,7 @@ struct WeaponData;
 class GameWorld;
 class TextureAtlas;
 class SCMFile;
+class SoundSource;
 
 /**
  * @brief Loads and stores all "static" data such as loaded models, handling
@@ -48,7 +53,17 @@ private:
     std::string currenttextureslot;
 
     Logger* logger;
+    /// Vertex and index storage shared by every loaded model
+    std::shared_ptr<GeometryArena> geometryArena;
     LoaderDFF dffLoader;
+    /// Slot the texture lookup bound materials from during the current load
+    TextureResidency::SlotID resolvedSlot = TextureResidency::kInvalid;
+
+    /**
+     * Loads a DFF, making the model hold a reference to the texture slot
+     * its materials were resolved from
+     */
+    ClumpPtr loadDFF(const FileContentsInfo& file);
 
 public:
     /**
@@ -135,6 +150,24 @@ public:
      */
     void loadToTextureArchive(const std::string& name, TextureArchive& archive);
 
+    /**
+     * Loads texture archives from the compressed texture cache in directory
+     * when they have an entry there
+     */
+    void setTextureCacheDirectory(const std::filesystem::path& directory);
+
+    /**
+     * Compresses every indexed texture archive into the texture cache
+     * @return the number of archives stored
+     */
+    std::size_t transcodeTextures();
+
+    /**
+     * Names the texture cache entry of a texture archive, from where it is
+     * stored rather than its contents. Nothing if the cache is disabled.
+     */
+    std::optional<std::uint64_t> textureCacheKey(const std::string& name) const;
+
     /**
      * Converts combined {name}_l{LOD} into name and lod.
      */
@@ -191,6 +224,9 @@ public:
     void loadPedGroups(const std::string& path);
 
     bool loadAudioStream(const std::string& name);
+    /// Plays source, already loading from the file name, as the stream
+    bool loadAudioStream(const std::string& name,
+                         std::shared_ptr<SoundSource> source);
     bool loadAudioClip(const std::string& name, const std::string& fileName);
 
     void loadSplash(const std::string& name);
@@ -198,8 +234,25 @@ public:
     TextureData* findSlotTexture(const std::string& slot,
                                         const std::string& texture) const;
 
+    /// Lookup with names interned through textureSlots
+    TextureData* findSlotTexture(TextureResidency::SlotID slot,
+                                 TextureResidency::TextureID texture) const {
+        return textureSlots.find(slot, texture);
+    }
+
     FileIndex index;
 
+    /**
+     * Cutscenes and special models read ahead of loading them
+     */
+    CutscenePrefetch prefetch{index};
+
+    /**
+     * Opens a file from the index, or takes it from prefetch if it was
+     * prefetched
+     */
+    FileContentsInfo openDataFile(const std::string& name);
+
     /**
      * Files that have been loaded previously
      */
@@ -257,6 +310,11 @@ public:
      */
     TextureLoader textureLoader;
 
+    /**
+     * Compressed texture archives, disabled unless a directory is set
+     */
+    TextureCache textureCache{{}};
+
     /**
      * Weather Data
      */
@@ -265,7 +323,7 @@ public:
     /**
      * Texture slots, containing loaded textures.
      */
-    std::unordered_map<std::string, TextureArchive> textureSlots;
+    TextureResidency textureSlots;
 
     /**
      * Texture atlases.
@@ -356,6 +414,10 @@ public:
 
     int getWaterIndexAt(const glm::vec3& ws) const;
     float getWaveHeightAt(const glm::vec3& ws) const;
+    /// Wave heights at the count points x[i], y[i], for several queries at
+    /// once
+    void getWaveHeightsAt(const float* x, const float* y, std::size_t count,
+                          float* heights) const;
 
     GameTexts texts;
 
@@ -329,6 +329,9 @@ public:
 
     std::string lastMissionName;
 
+    /** Set when the script reaches a save point, the game then autosaves */
+    bool saveRequested = false;
+
     /// Stores the "special" character and cutscene model indices.
     std::map<unsigned short, std::string> specialCharacters;
     std::map<unsigned short, std::string> specialModels;
@@ -362,6 +365,12 @@ public:
 
     std::map<int, BlipData> radarBlips;
 
+    /**
+     * Contents of the save blocks the game has no state for yet, by block
+     * number, kept as loaded so that saving writes them back
+     */
+    std::map<int, std::vector<uint8_t>> unparsedSaveBlocks;
+
     /**
      * Bitsets for the car import / export list mission
      */
@@ -32,7 +32,6 @@
 
 #include "items/Weapon.hpp"
 
-#include "loaders/LoaderCutsceneDAT.hpp"
 #include "loaders/LoaderIFP.hpp"
 #include "loaders/LoaderIPL.hpp"
 
@@ -40,6 +39,7 @@
 #include "objects/CutsceneObject.hpp"
 #include "objects/InstanceObject.hpp"
 #include "objects/PickupObject.hpp"
+#include "objects/ProjectileObject.hpp"
 #include "objects/VehicleObject.hpp"
 
 #include "platform/FileHandle.hpp"
@@ -98,10 +98,20 @@ GameWorld::GameWorld(Logger* log, GameData* dat)
     gContactProcessedCallback = ContactProcessedCallback;
     dynamicsWorld->setInternalTickCallback(PhysicsTickCallback, this);
     dynamicsWorld->setForceUpdateAllAabbs(false);
+
+    pedestrianPool.objectSize = sizeof(CharacterObject);
+    instancePool.objectSize = sizeof(InstanceObject);
+    vehiclePool.objectSize = sizeof(VehicleObject);
+    pickupPool.objectSize = sizeof(PickupObject);
+    cutscenePool.objectSize = sizeof(CutsceneObject);
+    projectilePool.objectSize = sizeof(ProjectileObject);
 }
 
 GameWorld::~GameWorld() {
+    // Prefetched audio is decoded through the sound manager's cache
+    data->prefetch.clear();
     // Bullet requires to remove each object before all physic world
+    instanceIndex.clear();
     pedestrianPool.clear();
     instancePool.clear();
     vehiclePool.clear();
@@ -116,7 +126,7 @@ bool GameWorld::placeItems(const std::string& name) {
     if (ipll.load(name)) {
         // Find the object.
         for (const auto& inst : ipll.m_instances) {
-            if (!createInstance(inst.id, inst.pos, inst.rot)) {
+            if (!createInstance(inst.id, inst.pos, inst.rot, true)) {
                 logger->error("World", "No object data for instance " +
                                            std::to_string(inst.id) + " in " +
                                            name);
@@ -134,7 +144,8 @@ bool GameWorld::placeItems(const std::string& name) {
 
 InstanceObject* GameWorld::createInstance(const uint16_t id,
                                           const glm::vec3& pos,
-                                          const glm::quat& rot) {
+                                          const glm::quat& rot,
+                                          bool isStatic) {
     auto oi = data->findModelInfo<SimpleModelInfo>(id);
     if (oi) {
         // Request loading of the model if it isn't loaded already.
@@ -165,7 +176,7 @@ InstanceObject* GameWorld::createInstance(const uint16_t id,
         instancePool.insert(std::move(instance));
         allObjects.push_back(ptr);
 
-        modelInstances.emplace(oi->name, ptr);
+        instanceIndex.insert(ptr, isStatic && dydata == nullptr);
 
         return ptr;
     }
@@ -377,7 +388,8 @@ CharacterObject* GameWorld::createPlayer(const glm::vec3& pos,
     return ptr;
 }
 
-PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
+PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type,
+                                      GameObjectID gid) {
     auto modelInfo = data->modelinfo[id].get();
 
     RW_CHECK(modelInfo != nullptr, "Pickup Object Data is not found");
@@ -424,6 +436,7 @@ PickupObject* GameWorld::createPickup(const glm::vec3& pos, int id, int type) {
     }
 
     auto ptr = pickup.get();
+    ptr->setGameObjectID(gid);
 
     pickupPool.insert(std::move(pickup));
     allObjects.push_back(ptr);
@@ -455,6 +468,7 @@ void GameWorld::ObjectPool::insert(std::unique_ptr<GameObject> object) {
         object->setGameObjectID(availID);
     }
     objects[object->getGameObjectID()] = std::move(object);
+    memory.set(objects.size() * objectSize);
 }
 
 GameObject* GameWorld::ObjectPool::find(GameObjectID id) const {
@@ -469,10 +483,12 @@ void GameWorld::ObjectPool::remove(GameObject* object) {
             it = objects.erase(it);
         }
     }
+    memory.set(objects.size() * objectSize);
 }
 
 void GameWorld::ObjectPool::clear() {
     objects.clear();
+    memory.set(0);
 }
 
 GameWorld::ObjectPool& GameWorld::getTypeObjectPool(GameObject* object) {
@@ -511,6 +527,10 @@ GameObject* GameWorld::getBlipTarget(const BlipData& blip) const {
 }
 
 void GameWorld::destroyObject(GameObject* object) {
+    if (object->type() == GameObject::Instance) {
+        instanceIndex.remove(static_cast<InstanceObject*>(object));
+    }
+
     auto& pool = getTypeObjectPool(object);
     pool.remove(object);
 
@@ -527,6 +547,22 @@ void GameWorld::destroyObject(GameObject* object) {
     }
 }
 
+void GameWorld::gatherObjectsNear(const glm::vec3& center, float radius,
+                                  std::vector<GameObject*>& objects) const {
+    std::vector<InstanceObject*> instances;
+    instanceIndex.gatherNear(center, radius, instances);
+    objects.insert(objects.end(), instances.begin(), instances.end());
+
+    const float radius2 = radius * radius;
+    for (const auto* pool : {&vehiclePool, &pedestrianPool}) {
+        for (const auto& p : pool->objects) {
+            if (glm::distance2(center, p.second->getPosition()) <= radius2) {
+                objects.push_back(p.second.get());
+            }
+        }
+    }
+}
+
 void GameWorld::destroyObjectQueued(GameObject* object) {
     RW_CHECK(object != nullptr, "destroying a null object?");
     if (object) deletionQueue.insert(object);
@@ -819,14 +855,12 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
 
     RW_PROFILE_COUNTER_SET("physicsTick/vehiclePool", world->vehiclePool.objects.size());
     for (auto& p : world->vehiclePool.objects) {
-        RW_PROFILE_SCOPEC("VehicleObject", MP_THISTLE1);
         auto object = static_cast<VehicleObject*>(p.second.get());
         object->tickPhysics(timeStep);
     }
 
     RW_PROFILE_COUNTER_SET("physicsTick/pedestrianPool", world->pedestrianPool.objects.size());
     for (auto& p : world->pedestrianPool.objects) {
-        RW_PROFILE_SCOPEC("CharacterObject", MP_THISTLE1);
         auto object = static_cast<CharacterObject*>(p.second.get());
         object->tickPhysics(timeStep);
     }
@@ -838,32 +872,57 @@ void GameWorld::PhysicsTickCallback(btDynamicsWorld* physWorld,
     }
 }
 
+void GameWorld::prefetchCutscene(const std::string& name) {
+    data->prefetch.prefetchCutscene(name, &sound.getPCMCache());
+}
+
 void GameWorld::loadCutscene(const std::string& name) {
-    auto datfile = data->index.openFile(name + ".dat");
+    // The data is handed over once the script needs it, so the cutscene is
+    // read while the script loads the models and objects it uses
+    prefetchCutscene(name);
+    cutsceneLoading = true;
 
     state->currentCutscene = CutsceneData();
+    state->currentCutscene->meta.name = name;
+}
 
-    if (datfile.data) {
-        LoaderCutsceneDAT loaderdat;
-        loaderdat.load(state->currentCutscene->tracks, datfile);
+void GameWorld::finishLoadingCutscene() {
+    if (!cutsceneLoading || !state->currentCutscene) {
+        return;
+    }
+    cutsceneLoading = false;
+
+    const auto name = state->currentCutscene->meta.name;
+    auto cutscene = data->prefetch.takeCutscene(name);
+    if (!cutscene) {
+        // Something else was prefetched in between, read it now
+        prefetchCutscene(name);
+        cutscene = data->prefetch.takeCutscene(name);
+    }
+    if (!cutscene) {
+        logger->error("World", "Failed to load cutscene: " + name);
+        return;
     }
 
-    data->loadIFP(name + ".ifp", true);
-    cutsceneAudioLoaded = data->loadAudioStream(name + ".mp3");
+    state->currentCutscene->tracks = std::move(cutscene->tracks);
 
-    if (!cutsceneAudioLoaded) {
-        cutsceneAudioLoaded = data->loadAudioStream(name + ".wav");
-    }
+    data->animationsCutscene.insert(cutscene->animations.begin(),
+                                    cutscene->animations.end());
+
+    cutsceneAudioLoaded =
+        cutscene->audio &&
+        data->loadAudioStream(cutscene->audioName, std::move(cutscene->audio));
 
     if (!cutsceneAudioLoaded) {
         logger->warning("Data", "Failed to load cutscene audio: " + name);
     }
 
-    state->currentCutscene->meta.name = name;
     logger->info("World", "Loaded cutscene: " + name);
 }
 
 void GameWorld::startCutscene() {
+    finishLoadingCutscene();
+
     state->cutsceneStartTime = getGameTime();
     state->skipCutscene = false;
 
@@ -878,6 +937,9 @@ void GameWorld::clearCutscene() {
     eraseCutsceneSound();
     eraseCutsceneAnimations();
 
+    data->prefetch.clear();
+    cutsceneLoading = false;
+
     state->currentCutscene = std::nullopt;
     state->isCinematic = false;
     state->cutsceneStartTime = -1.f;
@@ -920,13 +982,18 @@ void GameWorld::loadSpecialCharacter(const unsigned short index,
                              std::to_string(index));
     auto modelid = kFirstSpecialActor + index - 1;
     auto model = data->findModelInfo<PedModelInfo>(modelid);
-    if (model && model->isLoaded()) {
-        model->unload();
-    }
     std::string lowerName(name);
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
-    state->specialCharacters[index] = lowerName;
+    auto& special = state->specialCharacters[index];
+    if (model && model->isLoaded()) {
+        if (special == lowerName) {
+            return;
+        }
+        model->unload();
+    }
+    prefetchSpecial(special, lowerName);
+    special = lowerName;
 }
 
 void GameWorld::loadSpecialModel(const unsigned short index,
@@ -935,13 +1002,34 @@ void GameWorld::loadSpecialModel(const unsigned short index,
                              std::to_string(index));
     // Tell the HIER model to discard the currently loaded model
     auto model = data->findModelInfo<ClumpModelInfo>(index);
-    if (model && model->isLoaded()) {
-        model->unload();
-    }
     std::string lowerName(name);
     std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(),
                    ::tolower);
-    state->specialModels[index] = lowerName;
+    auto& special = state->specialModels[index];
+    if (model && model->isLoaded()) {
+        if (special == lowerName) {
+            return;
+        }
+        model->unload();
+    }
+    prefetchSpecial(special, lowerName);
+    special = lowerName;
+}
+
+void GameWorld::prefetchSpecial(const std::string& previous,
+                                const std::string& name) {
+    // The slot's previous model won't be loaded from it anymore
+    if (!previous.empty() && previous != name) {
+        data->prefetch.dropFile(previous + ".txd");
+        data->prefetch.dropFile(previous + ".dff");
+    }
+    // Loading the model only reads its textures if they aren't resident
+    const auto slot = data->textureSlots.findSlot(name);
+    if (slot == TextureResidency::kInvalid ||
+        !data->textureSlots.isResident(slot)) {
+        data->prefetch.prefetchFile(name + ".txd");
+    }
+    data->prefetch.prefetchFile(name + ".dff");
 }
 
 void GameWorld::disableAIPaths(ai::NodeType type, const glm::vec3& min,
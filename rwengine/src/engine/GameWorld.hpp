@@ -21,7 +21,9 @@
 #include <audio/SoundManager.hpp>
 #include <data/Chase.hpp>
 #include <engine/Garage.hpp>
+#include <engine/InstanceIndex.hpp>
 #include <objects/ObjectTypes.hpp>
+#include <rw/accounting.hpp>
 
 class btCollisionDispatcher;
 class btDefaultCollisionConfiguration;
@@ -111,10 +113,13 @@ public:
 
     /**
      * Creates an instance
+     * @param isStatic the instance will never be moved, only set for map
+     * placements. Objects with dynamic data are never treated as static.
      */
     InstanceObject* createInstance(const uint16_t id, const glm::vec3& pos,
                                    const glm::quat& rot = glm::quat{
-                                       1.0f, 0.0f, 0.0f, 0.0f});
+                                       1.0f, 0.0f, 0.0f, 0.0f},
+                                   bool isStatic = false);
 
     /**
      * @brief Creates an InstanceObject for use in the current Cutscene.
@@ -151,7 +156,8 @@ public:
     /**
      * Creates a pickup
      */
-    PickupObject* createPickup(const glm::vec3& pos, int id, int type);
+    PickupObject* createPickup(const glm::vec3& pos, int id, int type,
+                               GameObjectID gid = 0);
 
     /**
      * Creates a garage
@@ -254,6 +260,11 @@ public:
     struct ObjectPool {
         std::map<GameObjectID, std::unique_ptr<GameObject>> objects;
 
+        /// Size of the pool's object type, set by GameWorld
+        std::size_t objectSize = 0;
+        /// The objects themselves, not what they allocate
+        MemoryAllocation memory{MemoryCategory::Objects};
+
         /**
          * Allocates the game object a GameObjectID and inserts it into
          * the pool
@@ -304,9 +315,16 @@ public:
     GameObject* getBlipTarget(const BlipData& blip) const;
 
     /**
-     * Map of Model Names to Instances
+     * Spatial and model ID lookups for instancePool
+     */
+    InstanceIndex instanceIndex;
+
+    /**
+     * Appends the instances, vehicles and characters within radius of center
+     * to objects
      */
-    std::map<std::string, InstanceObject*> modelInstances;
+    void gatherObjectsNear(const glm::vec3& center, float radius,
+                           std::vector<GameObject*>& objects) const;
 
     /**
      * AI Graph
@@ -344,10 +362,28 @@ public:
                                     btScalar timeStep);
 
     /**
-     * @brief Loads and starts the named cutscene.
+     * @brief Starts reading the named cutscene in the background, so that
+     * loading it later doesn't wait on the disk or the audio decoder.
+     * @param name
+     */
+    void prefetchCutscene(const std::string& name);
+
+    /**
+     * @brief Starts loading the named cutscene.
+     *
+     * Its data is read in the background and handed over by
+     * finishLoadingCutscene.
      * @param name
      */
     void loadCutscene(const std::string& name);
+    /**
+     * @brief Hands over the tracks, animations and audio of the cutscene
+     * being loaded, waiting for them if they are still being read.
+     *
+     * Called when the script first needs them, it does nothing once they
+     * have been handed over.
+     */
+    void finishLoadingCutscene();
     void startCutscene();
     void clearCutscene();
     bool isCutsceneDone();
@@ -358,10 +394,15 @@ public:
 
     std::string cutsceneAudio;
     bool cutsceneAudioLoaded;
+    /// Whether the current cutscene's data hasn't been handed over yet
+    bool cutsceneLoading = false;
     std::string missionAudio;
 
     /**
      * @brief loads a model into a special character slot.
+     *
+     * The model's files are prefetched, they are read when the slot is
+     * loaded.
      */
     void loadSpecialCharacter(const unsigned short index,
                               const std::string& name);
@@ -435,6 +476,12 @@ private:
      */
     bool paused = false;
 
+    /**
+     * Prefetches the files of a special model slot's new model and drops
+     * what was prefetched for its previous one
+     */
+    void prefetchSpecial(const std::string& previous, const std::string& name);
+
     /**
      * Private data
      */
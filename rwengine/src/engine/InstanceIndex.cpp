@@ -0,0 +1,165 @@
+#include "engine/InstanceIndex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <rw/types.hpp>
+
+#include "objects/InstanceObject.hpp"
+
+namespace {
+constexpr float kLowerCoord = -WORLD_GRID_SIZE / 2.f;
+
+std::atomic<std::uint64_t> lastGeneration{0};
+
+std::uint64_t nextGeneration() {
+    return ++lastGeneration;
+}
+
+ModelID modelOf(const InstanceObject* object) {
+    return object->getModelInfo<BaseModelInfo>()->id();
+}
+
+void eraseFrom(std::vector<InstanceObject*>& list, InstanceObject* object) {
+    auto it = std::find(list.begin(), list.end(), object);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+}  // namespace
+
+InstanceIndex::InstanceIndex()
+    : gridWidth(static_cast<std::int32_t>(
+          std::ceil(WORLD_GRID_SIZE / kCellSize)))
+    , cells(static_cast<std::size_t>(gridWidth * gridWidth))
+    , generation(nextGeneration()) {
+}
+
+std::int32_t InstanceIndex::cellIndex(const glm::vec3& position) const {
+    const auto x =
+        static_cast<std::int32_t>(std::floor((position.x - kLowerCoord) /
+                                             kCellSize));
+    const auto y =
+        static_cast<std::int32_t>(std::floor((position.y - kLowerCoord) /
+                                             kCellSize));
+    if (x < 0 || y < 0 || x >= gridWidth || y >= gridWidth) {
+        return kMovable;
+    }
+    return x * gridWidth + y;
+}
+
+void InstanceIndex::insert(InstanceObject* object, bool isStatic) {
+    // Static instances outside the grid are searched with the movable ones
+    const auto cell = isStatic ? cellIndex(object->getPosition()) : kMovable;
+    if (cell == kMovable) {
+        movable.push_back(object);
+    } else {
+        cells[static_cast<std::size_t>(cell)].push_back(object);
+        staticCount++;
+    }
+    cellOf[object] = cell;
+    byModel.emplace(modelOf(object), object);
+    generation = nextGeneration();
+}
+
+void InstanceIndex::remove(InstanceObject* object) {
+    auto it = cellOf.find(object);
+    if (it == cellOf.end()) {
+        return;
+    }
+
+    if (it->second == kMovable) {
+        eraseFrom(movable, object);
+    } else {
+        eraseFrom(cells[static_cast<std::size_t>(it->second)], object);
+        staticCount--;
+    }
+    cellOf.erase(it);
+    generation = nextGeneration();
+
+    auto range = byModel.equal_range(modelOf(object));
+    for (auto m = range.first; m != range.second; ++m) {
+        if (m->second == object) {
+            byModel.erase(m);
+            break;
+        }
+    }
+}
+
+void InstanceIndex::updateModel(InstanceObject* object, ModelID previous) {
+    const auto current = modelOf(object);
+    if (current == previous || cellOf.find(object) == cellOf.end()) {
+        return;
+    }
+
+    auto range = byModel.equal_range(previous);
+    for (auto m = range.first; m != range.second; ++m) {
+        if (m->second == object) {
+            byModel.erase(m);
+            break;
+        }
+    }
+    byModel.emplace(current, object);
+    generation = nextGeneration();
+}
+
+void InstanceIndex::clear() {
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+    movable.clear();
+    staticCount = 0;
+    cellOf.clear();
+    byModel.clear();
+    generation = nextGeneration();
+}
+
+void InstanceIndex::gatherNear(const glm::vec3& center, float radius,
+                               std::vector<InstanceObject*>& objects) const {
+    const float radius2 = radius * radius;
+    const auto inRange = [&](const InstanceObject* object) {
+        return glm::distance2(center, object->getPosition()) <= radius2;
+    };
+
+    const auto lo = glm::floor((glm::vec2(center) - radius - kLowerCoord) /
+                               kCellSize);
+    const auto hi = glm::floor((glm::vec2(center) + radius - kLowerCoord) /
+                               kCellSize);
+    const auto minX = std::max(static_cast<std::int32_t>(lo.x), 0);
+    const auto minY = std::max(static_cast<std::int32_t>(lo.y), 0);
+    const auto maxX = std::min(static_cast<std::int32_t>(hi.x), gridWidth - 1);
+    const auto maxY = std::min(static_cast<std::int32_t>(hi.y), gridWidth - 1);
+
+    for (auto x = minX; x <= maxX; ++x) {
+        for (auto y = minY; y <= maxY; ++y) {
+            const auto& cell =
+                cells[static_cast<std::size_t>(x * gridWidth + y)];
+            std::copy_if(cell.begin(), cell.end(), std::back_inserter(objects),
+                         inRange);
+        }
+    }
+
+    std::copy_if(movable.begin(), movable.end(), std::back_inserter(objects),
+                 inRange);
+}
+
+void InstanceIndex::gatherModel(ModelID model,
+                                std::vector<InstanceObject*>& objects) const {
+    auto range = byModel.equal_range(model);
+    for (auto m = range.first; m != range.second; ++m) {
+        objects.push_back(m->second);
+    }
+}
+
+void InstanceIndex::gatherStatic(std::vector<InstanceObject*>& objects) const {
+    objects.reserve(objects.size() + staticCount);
+    for (const auto& cell : cells) {
+        objects.insert(objects.end(), cell.begin(), cell.end());
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef _RWENGINE_INSTANCEINDEX_HPP_
+#define _RWENGINE_INSTANCEINDEX_HPP_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include <data/ModelData.hpp>
+
+class InstanceObject;
+
+/**
+ * @brief Spatial and model lookups for the world's InstanceObjects
+ *
+ * Instances placed from the IPL files that can't move are bucketed into a
+ * uniform grid over the world. Anything that may move (dynamic objects and
+ * script created objects) is kept in a separate list that is always
+ * searched, so area queries only touch a handful of cells plus the movable
+ * objects instead of every instance in the map.
+ *
+ * Every instance is also keyed by its model ID.
+ */
+class InstanceIndex {
+public:
+    /// Width of a grid cell in world units
+    static constexpr float kCellSize = 25.f;
+
+    InstanceIndex();
+
+    /**
+     * Adds an instance, static instances must never be moved
+     */
+    void insert(InstanceObject* object, bool isStatic);
+
+    void remove(InstanceObject* object);
+
+    /**
+     * Re-keys an instance whose model changed from previous
+     */
+    void updateModel(InstanceObject* object, ModelID previous);
+
+    void clear();
+
+    /**
+     * Appends the instances within radius of center to objects
+     */
+    void gatherNear(const glm::vec3& center, float radius,
+                    std::vector<InstanceObject*>& objects) const;
+
+    /**
+     * Appends the instances using the given model to objects
+     */
+    void gatherModel(ModelID model,
+                     std::vector<InstanceObject*>& objects) const;
+
+    /**
+     * Appends the static instances in the grid to objects
+     */
+    void gatherStatic(std::vector<InstanceObject*>& objects) const;
+
+    /// Instances that may move, including static ones outside the grid
+    const std::vector<InstanceObject*>& getMovable() const {
+        return movable;
+    }
+
+    /**
+     * Changes whenever an instance is added, removed or changes model. No
+     * two indices ever share a generation, so caches built from one index
+     * can't be mistaken for another's.
+     */
+    std::uint64_t getGeneration() const {
+        return generation;
+    }
+
+    std::size_t getStaticCount() const {
+        return staticCount;
+    }
+
+    std::size_t getMovableCount() const {
+        return movable.size();
+    }
+
+private:
+    static constexpr std::int32_t kMovable = -1;
+
+    std::int32_t gridWidth;
+    std::vector<std::vector<InstanceObject*>> cells;
+    std::vector<InstanceObject*> movable;
+    std::size_t staticCount = 0;
+    std::uint64_t generation;
+
+    /// Cell each instance is stored in, or kMovable
+    std::unordered_map<InstanceObject*, std::int32_t> cellOf;
+    std::unordered_multimap<ModelID, InstanceObject*> byModel;
+
+    std::int32_t cellIndex(const glm::vec3& position) const;
+};
+
+#endif
@@ -39,6 +39,10 @@ public:
     Payphone(GameWorld* engine_, size_t id_, const glm::vec2& coord);
     ~Payphone() = default;
 
+    const glm::vec3& getPosition() const {
+        return position;
+    }
+
     // Makes a payphone ring
     void enable();
     // Disables ringing
@@ -1,26 +1,37 @@
 #include "engine/SaveGame.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <ctime>
 #include <filesystem>
 #include <iostream>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <platform/MappedFile.hpp>
 #include <rw/debug.hpp>
 
+#include "core/Profiler.hpp"
 #include "data/ZoneData.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "engine/Garage.hpp"
+#include "engine/Payphone.hpp"
+#include "engine/SaveGameIndex.hpp"
 #include "objects/CharacterObject.hpp"
 #include "objects/GameObject.hpp"
 #include "objects/InstanceObject.hpp"
+#include "objects/PickupObject.hpp"
 #include "objects/VehicleObject.hpp"
 #include "script/SCMFile.hpp"
+#include "script/ScriptFunctions.hpp"
 #include "script/ScriptMachine.hpp"
 #include "script/ScriptTypes.hpp"
 
@@ -233,7 +244,8 @@ struct Block3VehicleState {
 struct Block3Vehicle {
     BlockDword unknown1;
     BlockWord modelId;
-    BlockDword unknown2;
+    /// The vehicle's script handle
+    BlockDword handle;
     Block3VehicleState state;
 };
 
@@ -246,7 +258,8 @@ struct Block3BoatState {
 struct Block3Boat {
     BlockDword unknown1;
     BlockWord modelId;
-    BlockDword unknown2;
+    /// The vehicle's script handle
+    BlockDword handle;
     Block3BoatState state;
 };
 
@@ -495,15 +508,906 @@ struct Block19Data {
     std::array<Block19PedType, kNrOfPedTypes> types;
 };
 
-void SaveGame::writeGame(GameState& state, const std::string& file) {
-    RW_UNUSED(state);
-    RW_UNUSED(file);
-    RW_UNIMPLEMENTED("Saving the game is not implemented yet.");
-}
+// Fields of the blocks that are stored without padding, shared by the reader
+// and the writer so the two can't drift apart.
+#define PLAYER_INFO_FIELDS(X)   \
+    X(money)                    \
+    X(unknown1)                 \
+    X(unknown2)                 \
+    X(unknown3)                 \
+    X(unknown4)                 \
+    X(displayedMoney)           \
+    X(hiddenPackagesCollected)  \
+    X(hiddenPackageCount)       \
+    X(neverTired)               \
+    X(fastReload)               \
+    X(thaneOfLibertyCity)       \
+    X(singlePayerHealthcare)    \
+    X(unknown5)
+
+#define GAME_STATS_FIELDS(X)                \
+    X(playerKills)                          \
+    X(otherKills)                           \
+    X(carsExploded)                         \
+    X(shotsHit)                             \
+    X(pedTypesKilled)                       \
+    X(helicoptersDestroyed)                 \
+    X(playerProgress)                       \
+    X(explosiveKgsUsed)                     \
+    X(bulletsFired)                         \
+    X(bulletsHit)                           \
+    X(carsCrushed)                          \
+    X(headshots)                            \
+    X(timesBusted)                          \
+    X(timesHospital)                        \
+    X(daysPassed)                           \
+    X(mmRainfall)                           \
+    X(insaneJumpMaxDistance)                \
+    X(insaneJumpMaxHeight)                  \
+    X(insaneJumpMaxFlips)                   \
+    X(insaneJumpMaxRotation)                \
+    X(bestStunt)                            \
+    X(uniqueStuntsFound)                    \
+    X(uniqueStuntsTotal)                    \
+    X(missionAttempts)                      \
+    X(missionsPassed)                       \
+    X(passengersDroppedOff)                 \
+    X(taxiRevenue)                          \
+    X(portlandPassed)                       \
+    X(stauntonPassed)                       \
+    X(shoresidePassed)                      \
+    X(bestTurismoTime)                      \
+    X(distanceWalked)                       \
+    X(distanceDriven)                       \
+    X(patriotPlaygroundTime)                \
+    X(aRideInTheParkTime)                   \
+    X(grippedTime)                          \
+    X(multistoryMayhemTime)                 \
+    X(peopleSaved)                          \
+    X(criminalsKilled)                      \
+    X(highestParamedicLevel)                \
+    X(firesExtinguished)                    \
+    X(longestDodoFlight)                    \
+    X(bombDefusalTime)                      \
+    X(rampagesPassed)                       \
+    X(totalRampages)                        \
+    X(totalMissions)                        \
+    X(fastestTime)                          \
+    X(highestScore)                         \
+    X(peopleKilledSinceCheckpoint)          \
+    X(peopleKilledSinceLastBustedOrWasted)  \
+    X(lastMissionGXT)
+
+#define VEHICLE_FIELDS(X) \
+    X(unknown1)           \
+    X(modelId)            \
+    X(handle)             \
+    X(state)
+
+#define OBJECT_FIELDS(X) \
+    X(modelId)           \
+    X(reference)         \
+    X(position)          \
+    X(rotation)          \
+    X(unknown1)          \
+    X(unknown2)          \
+    X(unknown3)          \
+    X(unknown4)          \
+    X(unknown5)          \
+    X(unknown6)          \
+    X(unknown7)          \
+    X(unknown8)          \
+    X(unknown9)          \
+    X(unknown10)
+
+#define ZONE_FIELDS(X) \
+    X(name)            \
+    X(coordA)          \
+    X(coordB)          \
+    X(type)            \
+    X(level)           \
+    X(dayZoneInfo)     \
+    X(nightZoneInfo)   \
+    X(childZone)       \
+    X(parentZone)      \
+    X(siblingZone)
+
+#define ZONE_INFO_FIELDS(X) \
+    X(density)              \
+    X(unknown1)             \
+    X(peddensity)           \
+    X(copdensity)           \
+    X(gangpeddensity)       \
+    X(pedgroup)
+
+namespace {
+
+static_assert(sizeof(Block0ScriptData) == 0x03C8,
+              "Block0ScriptData is not the right size");
+
+/// Appends save data to a buffer
+class BlockWriter {
+public:
+    explicit BlockWriter(std::vector<std::uint8_t>& out) : out(out) {
+    }
+
+    template <class T>
+    void write(const T& value) {
+        writeBytes(&value, sizeof(value));
+    }
+
+    void writeBytes(const void* mem, std::size_t size) {
+        const auto bytes = static_cast<const std::uint8_t*>(mem);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    void writeSignature(const char (&signature)[4]) {
+        writeBytes(signature, sizeof(signature));
+    }
+
+    /// Reserves a size field, returning its offset for endSize()
+    std::size_t beginSize() {
+        const auto offset = out.size();
+        write(BlockSize{0});
+        return offset;
+    }
+
+    /// Fills in a size field with the number of bytes written after it
+    void endSize(std::size_t offset) {
+        const auto size =
+            static_cast<BlockSize>(out.size() - offset - sizeof(BlockSize));
+        std::memcpy(out.data() + offset, &size, sizeof(size));
+    }
+
+private:
+    std::vector<std::uint8_t>& out;
+};
+
+/// Reads save data out of a buffer that holds the whole file
+class BlockReader {
+public:
+    BlockReader(const char* data, std::size_t size) : data(data), size(size) {
+    }
+
+    bool read(void* out, std::size_t length) {
+        if (length > size - offset) {
+            return false;
+        }
+        std::memcpy(out, data + offset, length);
+        offset += length;
+        return true;
+    }
+
+    /// Copies the next length bytes without moving past them
+    bool peek(void* out, std::size_t length) const {
+        if (length > size - offset) {
+            return false;
+        }
+        std::memcpy(out, data + offset, length);
+        return true;
+    }
+
+    bool seek(std::size_t position) {
+        if (position > size) {
+            return false;
+        }
+        offset = position;
+        return true;
+    }
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t offset = 0;
+};
 
 template <class T>
-bool readBlock(std::FILE* str, T& out) {
-    return std::fread(&out, sizeof(out), 1, str) == 1;
+bool readBlock(BlockReader& reader, T& out) {
+    return reader.read(&out, sizeof(out));
+}
+
+SystemTime currentSystemTime() {
+    const auto now = std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::now());
+    std::tm local{};
+#ifdef RW_WINDOWS
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    SystemTime time{};
+    time.year = static_cast<uint16_t>(local.tm_year + 1900);
+    time.month = static_cast<uint16_t>(local.tm_mon + 1);
+    time.dayOfWeek = static_cast<uint16_t>(local.tm_wday);
+    time.day = static_cast<uint16_t>(local.tm_mday);
+    time.hour = static_cast<uint16_t>(local.tm_hour);
+    time.minute = static_cast<uint16_t>(local.tm_min);
+    time.second = static_cast<uint16_t>(local.tm_sec);
+    return time;
+}
+
+Block11Zone makeZone(const ZoneData& zone, BlockWord index) {
+    Block11Zone out{};
+    // Leave room for the terminator, the loader reads the name as a C string
+    std::strncpy(out.name, zone.name.c_str(), sizeof(out.name) - 1);
+    out.coordA = zone.min;
+    out.coordB = zone.max;
+    out.type = static_cast<BlockDword>(zone.type);
+    out.level = static_cast<BlockDword>(zone.island);
+    out.dayZoneInfo = static_cast<BlockWord>(index * 2);
+    out.nightZoneInfo = static_cast<BlockWord>(index * 2 + 1);
+    return out;
+}
+
+Block9Restart makeRestart(const glm::vec4& location) {
+    return {glm::vec3(location), location.w};
+}
+
+// A vehicle's placement matrix precedes its position, these are the offsets
+// of its right, forward and up columns
+constexpr std::size_t kVehicleMatrixColumns[] = {4, 20, 36};
+
+template <class VehicleState>
+void setVehicleRotation(VehicleState& out, const glm::quat& rotation) {
+    const auto m = glm::mat3_cast(rotation);
+    for (int c = 0; c < 3; ++c) {
+        std::memcpy(out.unknown1 + kVehicleMatrixColumns[c], &m[c],
+                    sizeof(glm::vec3));
+    }
+}
+
+template <class VehicleState>
+glm::quat getVehicleRotation(const VehicleState& in) {
+    glm::mat3 m;
+    for (int c = 0; c < 3; ++c) {
+        std::memcpy(&m[c], in.unknown1 + kVehicleMatrixColumns[c],
+                    sizeof(glm::vec3));
+        if (glm::length(m[c]) < 0.5f) {
+            return glm::quat{1.f, 0.f, 0.f, 0.f};
+        }
+    }
+    return glm::normalize(glm::quat_cast(m));
+}
+
+/// Objects store their right, forward and down axes scaled to int8
+void setObjectRotation(Block4Object& out, const glm::quat& rotation) {
+    const auto m = glm::mat3_cast(rotation);
+    const glm::vec3 axes[3] = {m[0], m[1], -m[2]};
+    for (int a = 0; a < 3; ++a) {
+        for (int c = 0; c < 3; ++c) {
+            out.rotation[a * 3 + c] = static_cast<int8_t>(
+                std::lround(glm::clamp(axes[a][c], -1.f, 1.f) * 127.f));
+        }
+    }
+}
+
+/// Writes back a block loadGame kept, false if it kept none
+bool writeUnparsedBlock(BlockWriter& writer, const GameState& state,
+                        int block) {
+    const auto it = state.unparsedSaveBlocks.find(block);
+    if (it == state.unparsedSaveBlocks.end()) {
+        return false;
+    }
+    writer.writeBytes(it->second.data(), it->second.size());
+    return true;
+}
+
+}  // namespace
+
+std::vector<std::uint8_t> SaveGame::snapshotGame(GameState& state) {
+    RW_PROFILE_SCOPE(__func__);
+
+    std::vector<std::uint8_t> data;
+    // Roughly the size of a GTA III save, to avoid regrowing the buffer
+    data.reserve(0x20000);
+    BlockWriter writer(data);
+
+    // BLOCK 0
+    auto block = writer.beginSize();
+
+    BasicState basic = state.basic;
+    basic.saveTime = currentSystemTime();
+    basic.timeMS = static_cast<uint32_t>(state.gameTime * 1000.f);
+    writer.write(basic);
+
+    auto scriptBlock = writer.beginSize();
+    writer.writeSignature("SCR");
+    auto scriptData = writer.beginSize();
+
+    Block0ScriptData scriptInfo{};
+    std::vector<Block0RunningScript> scripts;
+    if (state.script) {
+        const auto& scm = state.script->getFile();
+        SCMByte* globals = state.script->getGlobals();
+        writer.write(BlockDword{scm.getGlobalsSize()});
+        writer.writeBytes(globals, scm.getGlobalsSize());
+
+        if (state.scriptOnMissionFlag) {
+            scriptInfo.onMissionOffset = static_cast<BlockDword>(
+                reinterpret_cast<SCMByte*>(state.scriptOnMissionFlag) -
+                globals);
+        }
+        scriptInfo.mainSize = scm.getMainSize();
+        scriptInfo.largestMissionSize = scm.getLargestMissionSize();
+        scriptInfo.missionCount =
+            static_cast<BlockWord>(scm.getMissionOffsets().size());
+
+        for (const auto& thread : state.script->getThreads()) {
+            Block0RunningScript script{};
+            std::strncpy(script.name, thread.name, sizeof(script.name));
+            script.programCounter = thread.programCounter;
+            for (int i = 0; i < SCM_STACK_DEPTH; ++i) {
+                script.stack[i] = thread.calls[i];
+            }
+            script.stackCounter = static_cast<BlockWord>(thread.stackDepth);
+            std::memcpy(script.variables, thread.locals.data(),
+                        sizeof(script.variables));
+            // Timers are the two locals following the saved variables
+            std::memcpy(&script.timerA,
+                        thread.locals.data() + sizeof(script.variables),
+                        sizeof(script.timerA));
+            std::memcpy(&script.timerB,
+                        thread.locals.data() + sizeof(script.variables) +
+                            sizeof(script.timerA),
+                        sizeof(script.timerB));
+            script.ifFlag = thread.conditionResult;
+            script.wakeTimer =
+                basic.lastTick +
+                static_cast<BlockDword>(std::max(thread.wakeCounter, 0));
+            script.ifNumber = static_cast<BlockWord>(thread.conditionCount);
+            scripts.push_back(script);
+        }
+        scriptInfo.scriptRunning = scripts.empty() ? 0 : 1;
+    } else {
+        writer.write(BlockDword{0});
+    }
+    for (size_t c = 0; c < state.scriptContacts.size(); ++c) {
+        scriptInfo.contactInfo[c].missionFlag =
+            state.scriptContacts[c].onMissionOffset;
+        scriptInfo.contactInfo[c].baseBrief =
+            state.scriptContacts[c].baseBrief;
+    }
+
+    writer.write(BlockDword{sizeof(Block0ScriptData)});
+    writer.write(scriptInfo);
+    writer.write(static_cast<BlockDword>(scripts.size()));
+    for (const auto& script : scripts) {
+        writer.write(script);
+    }
+
+    writer.endSize(scriptData);
+    writer.endSize(scriptBlock);
+    writer.endSize(block);
+
+    // BLOCK 1
+    block = writer.beginSize();
+    auto blockData = writer.beginSize();
+
+    CharacterObject* player = nullptr;
+    if (state.world) {
+        player = static_cast<CharacterObject*>(
+            state.world->pedestrianPool.find(state.playerObject));
+    }
+    writer.write(BlockDword{player ? 1u : 0u});
+    if (player) {
+        Block1PlayerPed ped{};
+        const auto& cs = player->getCurrentState();
+        ped.reference = player->getGameObjectID();
+        ped.info.position = player->getPosition();
+        ped.info.health = cs.health;
+        ped.info.armour = cs.armour;
+        for (int w = 0; w < kNrOfWeapons; ++w) {
+            auto& wep = ped.info.weapons[w];
+            wep.weaponId = cs.weapons[w].weaponId;
+            wep.inClip = cs.weapons[w].bulletsClip;
+            wep.totalBullets = cs.weapons[w].bulletsTotal;
+        }
+        ped.maxWantedLevel = state.maxWantedLevel;
+
+        writer.write(ped.unknown0);
+        writer.write(ped.unknown1);
+        writer.write(ped.reference);
+        writer.write(ped.info);
+        writer.write(ped.maxWantedLevel);
+        writer.write(ped.maxChaosLevel);
+        writer.write(ped.modelName);
+        writer.write(ped.align);
+    }
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // BLOCK 2
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+
+    Block2GarageData garageData{};
+    if (state.world) {
+        garageData.garageCount =
+            static_cast<BlockDword>(state.world->garages.size());
+    }
+    garageData.bfImportExportPortland =
+        static_cast<BlockDword>(state.importExportPortland.to_ulong());
+    garageData.bfImportExportShoreside =
+        static_cast<BlockDword>(state.importExportShoreside.to_ulong());
+    garageData.bfImportExportUnused =
+        static_cast<BlockDword>(state.importExportUnused.to_ulong());
+    writer.write(garageData.garageCount);
+    writer.write(garageData.freeBombs);
+    writer.write(garageData.freeResprays);
+    writer.write(garageData.unknown0);
+    writer.write(garageData.unknown1);
+    writer.write(garageData.unknown2);
+    writer.write(garageData.bfImportExportPortland);
+    writer.write(garageData.bfImportExportShoreside);
+    writer.write(garageData.bfImportExportUnused);
+    writer.write(garageData.GA_21lastTime);
+    writer.write(garageData.cars);
+
+    if (state.world) {
+        for (const auto& garage : state.world->garages) {
+            StructGarage out{};
+            out.type = static_cast<uint8_t>(garage->type);
+            out.x1 = garage->min.x;
+            out.y1 = garage->min.y;
+            out.z1 = garage->min.z;
+            out.x2 = garage->max.x;
+            out.y2 = garage->max.y;
+            out.z2 = garage->max.z;
+            writer.write(out);
+        }
+    }
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 3
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+
+    // Vehicles created by the scripts, the rest is traffic
+    std::vector<Block3Vehicle> vehicles;
+    std::vector<Block3Boat> boats;
+    if (state.world) {
+        for (const auto& p : state.world->vehiclePool.objects) {
+            const auto vehicle = static_cast<VehicleObject*>(p.second.get());
+            if (vehicle->getLifetime() != GameObject::MissionLifetime) {
+                continue;
+            }
+            const auto info = vehicle->getVehicle();
+            if (info->vehicletype_ == VehicleModelInfo::BOAT) {
+                Block3Boat out{};
+                out.modelId = static_cast<BlockWord>(info->id());
+                out.handle = vehicle->getGameObjectID();
+                out.state.position = vehicle->getPosition();
+                setVehicleRotation(out.state, vehicle->getRotation());
+                boats.push_back(out);
+            } else {
+                Block3Vehicle out{};
+                out.modelId = static_cast<BlockWord>(info->id());
+                out.handle = vehicle->getGameObjectID();
+                out.state.position = vehicle->getPosition();
+                setVehicleRotation(out.state, vehicle->getRotation());
+                vehicles.push_back(out);
+            }
+        }
+    }
+
+#define WRITE_VEHICLE_FIELD(field) writer.write(vehicle.field);
+    writer.write(static_cast<BlockDword>(vehicles.size()));
+    writer.write(static_cast<BlockDword>(boats.size()));
+    for (const auto& vehicle : vehicles) {
+        VEHICLE_FIELDS(WRITE_VEHICLE_FIELD)
+    }
+    for (const auto& vehicle : boats) {
+        VEHICLE_FIELDS(WRITE_VEHICLE_FIELD)
+    }
+#undef WRITE_VEHICLE_FIELD
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 4
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+
+    std::vector<Block4Object> objects;
+    if (state.world) {
+        for (const auto& p : state.world->instancePool.objects) {
+            const auto instance = p.second.get();
+            if (instance->getLifetime() != GameObject::MissionLifetime) {
+                continue;
+            }
+            Block4Object out{};
+            out.modelId = static_cast<BlockWord>(
+                instance->getModelInfo<BaseModelInfo>()->id());
+            out.reference = instance->getGameObjectID();
+            out.position = instance->getPosition();
+            setObjectRotation(out, instance->getRotation());
+            objects.push_back(out);
+        }
+    }
+
+#define WRITE_OBJECT_FIELD(field) writer.write(object.field);
+    writer.write(static_cast<BlockDword>(objects.size()));
+    for (const auto& object : objects) {
+        OBJECT_FIELDS(WRITE_OBJECT_FIELD)
+    }
+#undef WRITE_OBJECT_FIELD
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 5
+    block = writer.beginSize();
+    if (!writeUnparsedBlock(writer, state, 5)) {
+        blockData = writer.beginSize();
+        writer.write(BlockDword{0});
+        writer.endSize(blockData);
+    }
+    writer.endSize(block);
+
+    // Block 6
+    block = writer.beginSize();
+    if (!writeUnparsedBlock(writer, state, 6)) {
+        blockData = writer.beginSize();
+        writer.write(BlockDword{0});
+        writer.write(BlockDword{0});
+        writer.endSize(blockData);
+    }
+    writer.endSize(block);
+
+    // Block 7
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+
+    Block7Data pickupData{};
+    if (state.world) {
+        size_t count = 0;
+        for (const auto& p : state.world->pickupPool.objects) {
+            const auto pickup = static_cast<PickupObject*>(p.second.get());
+            if (count == pickupData.pickups.size()) {
+                break;
+            }
+            if (pickup->isCollected() && !pickup->doesRespawn()) {
+                continue;
+            }
+            auto& out = pickupData.pickups[count++];
+            out.type = static_cast<uint8_t>(pickup->getPickupType());
+            out.objectRef = pickup->getGameObjectID();
+            out.modelId = static_cast<BlockWord>(
+                pickup->getModelInfo<BaseModelInfo>()->id());
+            out.position = pickup->getPosition();
+        }
+    }
+    writer.write(pickupData);
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 8
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+
+    Block8Data payphoneData{};
+    std::vector<Block8Payphone> payphones;
+    if (state.world) {
+        for (const auto& payphone : state.world->payphones) {
+            Block8Payphone out{};
+            out.position = payphone->getPosition();
+            out.state = static_cast<BlockDword>(payphone->state);
+            out.staticIndex = static_cast<BlockDword>(payphone->id);
+            if (payphone->state != Payphone::State::Idle) {
+                payphoneData.numActivePayphones++;
+            }
+            payphones.push_back(out);
+        }
+    }
+    payphoneData.numPayphones = static_cast<BlockDword>(payphones.size());
+    writer.write(payphoneData);
+    for (const auto& payphone : payphones) {
+        writer.write(payphone);
+    }
+
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 9
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("RST");
+    auto signedData = writer.beginSize();
+
+    Block9Data restartData{};
+    restartData.numHospitals = static_cast<BlockWord>(
+        std::min<size_t>(state.hospitalRestarts.size(), 8));
+    for (int r = 0; r < restartData.numHospitals; ++r) {
+        restartData.hospitalRestarts[r] =
+            makeRestart(state.hospitalRestarts[r]);
+    }
+    restartData.numPolice = static_cast<BlockWord>(
+        std::min<size_t>(state.policeRestarts.size(), 8));
+    for (int r = 0; r < restartData.numPolice; ++r) {
+        restartData.policeRestarts[r] = makeRestart(state.policeRestarts[r]);
+    }
+    restartData.overrideFlag = state.overrideNextRestart ? 1 : 0;
+    restartData.overrideRestart = makeRestart(state.nextRestartLocation);
+    restartData.hospitalLevelOverride =
+        static_cast<uint8_t>(state.hospitalIslandOverride);
+    restartData.policeLevelOverride =
+        static_cast<uint8_t>(state.policeIslandOverride);
+    writer.write(restartData);
+
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 10
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("RDR");
+    signedData = writer.beginSize();
+
+    // Blips are stored in the slot of their id, which scripts hold on to
+    Block10Data radarData{};
+    for (const auto& [id, blip] : state.radarBlips) {
+        if (id < 0 || id >= kNrOfBlips) {
+            continue;
+        }
+        auto& out = radarData.blips[id];
+        out.color = blip.colour;
+        out.type = static_cast<BlockDword>(blip.type);
+        out.entityHandle = static_cast<BlockDword>(blip.target);
+        out.position = blip.coord;
+        out.brightness = blip.brightness;
+        out.scale = blip.size;
+        out.display = static_cast<BlockWord>(blip.display);
+        out.sprite =
+            static_cast<BlockWord>(script::findBlipSprite(blip.texture));
+    }
+    writer.write(radarData);
+
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 11
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("ZNS");
+    signedData = writer.beginSize();
+
+    Block11Data zoneData{};
+    if (state.world) {
+        const auto& gamezones = state.world->data->gamezones;
+        const auto numZones = std::min<size_t>(gamezones.size(), kNrOfNavZones);
+        for (size_t z = 0; z < numZones; ++z) {
+            const auto& zone = gamezones[z];
+            zoneData.navZones[z] = makeZone(zone, static_cast<BlockWord>(z));
+            auto& day = zoneData.dayNightInfo[z * 2];
+            auto& night = zoneData.dayNightInfo[z * 2 + 1];
+            day.pedgroup = static_cast<BlockWord>(zone.pedGroupDay);
+            night.pedgroup = static_cast<BlockWord>(zone.pedGroupNight);
+            for (int g = 0; g < kNrOfGangs; ++g) {
+                day.gangpeddensity[g] =
+                    static_cast<BlockWord>(zone.gangDensityDay[g]);
+                night.gangpeddensity[g] =
+                    static_cast<BlockWord>(zone.gangDensityNight[g]);
+            }
+        }
+        zoneData.numNavZones = static_cast<BlockWord>(numZones);
+        zoneData.numZoneInfos = static_cast<BlockWord>(numZones * 2);
+    }
+
+#define WRITE_ZONE_FIELD(field) writer.write(zone.field);
+#define WRITE_ZONE_INFO_FIELD(field) writer.write(info.field);
+    writer.write(zoneData.currentZone);
+    writer.write(zoneData.currentLevel);
+    writer.write(zoneData.findIndex);
+    writer.write(zoneData.align);
+    for (const auto& zone : zoneData.navZones) {
+        ZONE_FIELDS(WRITE_ZONE_FIELD)
+    }
+    for (const auto& info : zoneData.dayNightInfo) {
+        ZONE_INFO_FIELDS(WRITE_ZONE_INFO_FIELD)
+    }
+    writer.write(zoneData.numNavZones);
+    writer.write(zoneData.numZoneInfos);
+    for (const auto& zone : zoneData.mapZones) {
+        ZONE_FIELDS(WRITE_ZONE_FIELD)
+    }
+    for (const auto& audioZone : zoneData.audioZones) {
+        writer.write(audioZone);
+    }
+    writer.write(zoneData.numMapZones);
+    writer.write(zoneData.numAudioZones);
+#undef WRITE_ZONE_INFO_FIELD
+#undef WRITE_ZONE_FIELD
+
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 12
+    block = writer.beginSize();
+    if (!writeUnparsedBlock(writer, state, 12)) {
+        blockData = writer.beginSize();
+        writer.writeSignature("GNG");
+        signedData = writer.beginSize();
+        writer.write(Block12Data{});
+        writer.endSize(signedData);
+        writer.endSize(blockData);
+    }
+    writer.endSize(block);
+
+    // Block 13
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("CGN");
+    signedData = writer.beginSize();
+
+    Block13Data carGeneratorData{};
+    carGeneratorData.generatorCount =
+        static_cast<BlockDword>(state.vehicleGenerators.size());
+    carGeneratorData.generatorSize = sizeof(Block13CarGenerator);
+    carGeneratorData.blockSize =
+        carGeneratorData.generatorCount * carGeneratorData.generatorSize;
+    for (const auto& gen : state.vehicleGenerators) {
+        if (gen.remainingSpawns > 0) {
+            carGeneratorData.activeGenerators++;
+        }
+    }
+    writer.write(carGeneratorData);
+    for (const auto& gen : state.vehicleGenerators) {
+        Block13CarGenerator out{};
+        out.modelId = static_cast<BlockDword>(gen.vehicleID);
+        out.position = gen.position;
+        out.angle = gen.heading;
+        out.colourFG = static_cast<BlockWord>(gen.colourFG);
+        out.colourBG = static_cast<BlockWord>(gen.colourBG);
+        out.force = gen.alwaysSpawn ? 1 : 0;
+        out.alarmChance = static_cast<uint8_t>(gen.alarmThreshold);
+        out.lockedChance = static_cast<uint8_t>(gen.lockedThreshold);
+        out.minDelay = static_cast<BlockWord>(gen.minDelay);
+        out.maxDelay = static_cast<BlockWord>(gen.maxDelay);
+        out.timestamp = static_cast<BlockDword>(gen.lastSpawnTime);
+        writer.write(out);
+    }
+
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 14
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.write(BlockDword{0});
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 15
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("AUD");
+    signedData = writer.beginSize();
+    writer.write(BlockDword{0});
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 16
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+#define WRITE_PLAYER_INFO_FIELD(field) writer.write(state.playerInfo.field);
+    PLAYER_INFO_FIELDS(WRITE_PLAYER_INFO_FIELD)
+#undef WRITE_PLAYER_INFO_FIELD
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 17
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+#define WRITE_GAME_STATS_FIELD(field) writer.write(state.gameStats.field);
+    GAME_STATS_FIELDS(WRITE_GAME_STATS_FIELD)
+#undef WRITE_GAME_STATS_FIELD
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    // Block 18
+    block = writer.beginSize();
+    if (!writeUnparsedBlock(writer, state, 18)) {
+        blockData = writer.beginSize();
+        writer.write(Block18Data{});
+        writer.endSize(blockData);
+    }
+    writer.endSize(block);
+
+    // Block 19
+    block = writer.beginSize();
+    blockData = writer.beginSize();
+    writer.writeSignature("PTP");
+    signedData = writer.beginSize();
+
+    Block19Data pedTypeData{};
+    if (state.world) {
+        const auto& pedrels = state.world->data->pedrels;
+        const auto numTypes =
+            std::min<size_t>(pedrels.size(), pedTypeData.types.size());
+        for (size_t t = 0; t < numTypes; ++t) {
+            auto& out = pedTypeData.types[t];
+            out.bitstring_ = pedrels[t].id_;
+            out.unknown2 = pedrels[t].a_;
+            out.unknown3 = pedrels[t].b_;
+            out.unknown4 = pedrels[t].c_;
+            out.fleedistance = pedrels[t].d_;
+            out.headingchangerate = pedrels[t].e_;
+            out.threatflags_ = pedrels[t].threatflags_;
+            out.avoidflags_ = pedrels[t].avoidflags_;
+        }
+    }
+    writer.write(pedTypeData);
+
+    writer.endSize(signedData);
+    writer.endSize(blockData);
+    writer.endSize(block);
+
+    return data;
+}
+
+bool SaveGame::writeSnapshot(std::vector<std::uint8_t> snapshot,
+                             const std::string& file) {
+    RW_PROFILE_SCOPE(__func__);
+
+    // The file ends with a sum of all of the bytes before it
+    BlockDword checksum = 0;
+    for (const auto byte : snapshot) {
+        checksum += byte;
+    }
+    BlockWriter(snapshot).write(checksum);
+
+    const std::filesystem::path path(file);
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    // Write next to the target and swap it in, so a failed write never
+    // leaves a truncated save behind.
+    auto tempPath = path;
+    tempPath += ".tmp";
+    std::FILE* saveFile = std::fopen(tempPath.string().c_str(), "wb");
+    if (saveFile == nullptr) {
+        RW_ERROR("Failed to open " << tempPath.string() << " for writing");
+        return false;
+    }
+    const bool written = std::fwrite(snapshot.data(), snapshot.size(), 1,
+                                     saveFile) == 1;
+    if (std::fclose(saveFile) != 0 || !written) {
+        RW_ERROR("Failed to write " << tempPath.string());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        RW_ERROR("Failed to replace " << file << ": " << ec.message());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool SaveGame::writeGame(GameState& state, const std::string& file) {
+    return writeSnapshot(snapshotGame(state), file);
+}
+
+std::future<bool> SaveGame::writeGameAsync(GameState& state,
+                                           const std::string& file) {
+    return std::async(std::launch::async,
+                      [snapshot = snapshotGame(state), file]() mutable {
+                          RW_PROFILE_THREAD("Save");
+                          return writeSnapshot(std::move(snapshot), file);
+                      });
 }
 
 #define READ_VALUE(var)                                                   \
@@ -519,7 +1423,7 @@ bool readBlock(std::FILE* str, T& out) {
 #define CHECK_SIG(expected)                                               \
     {                                                                     \
         char signature[4];                                                \
-        if (fread(signature, sizeof(char), 4, loadFile) != 4) {           \
+        if (!loadFile.read(signature, sizeof(signature))) {               \
             RW_ERROR("Failed to read signature");                         \
             return false;                                                 \
         }                                                                 \
@@ -528,17 +1432,33 @@ bool readBlock(std::FILE* str, T& out) {
             return false;                                                 \
         }                                                                 \
     }
-#define BLOCK_HEADER(sizevar)             \
-    fseek(loadFile, nextBlock, SEEK_SET); \
-    READ_SIZE(sizevar)                    \
+#define KEEP_BLOCK(block, sizevar)                            \
+    {                                                         \
+        auto& kept = state.unparsedSaveBlocks[block];         \
+        kept.resize(sizevar);                                 \
+        if (!loadFile.peek(kept.data(), kept.size())) {       \
+            RW_ERROR(file << ": Failed to keep block " #block); \
+            return false;                                     \
+        }                                                     \
+    }
+#define BLOCK_HEADER(sizevar)                      \
+    if (!loadFile.seek(nextBlock)) {               \
+        RW_ERROR(file << ": Truncated save file"); \
+        return false;                              \
+    }                                              \
+    READ_SIZE(sizevar)                             \
     nextBlock += sizeof(sizevar) + sizevar;
 
 bool SaveGame::loadGame(GameState& state, const std::string& file) {
-    std::FILE* loadFile = std::fopen(file.c_str(), "rb");
-    if (loadFile == nullptr) {
+    RW_PROFILE_SCOPE(__func__);
+
+    // Map the whole file once and parse it in place
+    MappedFile mapped;
+    if (!mapped.open(file)) {
         RW_ERROR("Failed to open save file");
         return false;
     }
+    BlockReader loadFile(mapped.data(), mapped.size());
 
     BlockSize nextBlock = 0;
 
@@ -560,8 +1480,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     READ_SIZE(scriptVarCount)
     RW_ASSERT(scriptVarCount == state.script->getFile().getGlobalsSize());
 
-    if (fread(state.script->getGlobals(), sizeof(SCMByte), scriptVarCount,
-              loadFile) != scriptVarCount) {
+    if (!loadFile.read(state.script->getGlobals(), scriptVarCount)) {
         RW_ERROR("Failed to read script memory");
         return false;
     }
@@ -665,13 +1584,11 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     READ_VALUE(vehicleCount)
     READ_VALUE(boatCount)
 
+#define READ_VEHICLE_FIELD(field) READ_VALUE(veh.field)
     std::vector<Block3Vehicle> vehicles(vehicleCount);
     for (size_t v = 0; v < vehicleCount; ++v) {
         Block3Vehicle& veh = vehicles[v];
-        READ_VALUE(veh.unknown1)
-        READ_VALUE(veh.modelId)
-        READ_VALUE(veh.unknown2)
-        READ_VALUE(veh.state)
+        VEHICLE_FIELDS(READ_VEHICLE_FIELD)
 #ifdef RW_DEBUG
         std::cout << " v " << veh.modelId << " " << veh.state.position.x << " "
                   << veh.state.position.y << " " << veh.state.position.z
@@ -681,16 +1598,14 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     std::vector<Block3Boat> boats(boatCount);
     for (size_t v = 0; v < boatCount; ++v) {
         Block3Boat& veh = boats[v];
-        READ_VALUE(veh.unknown1)
-        READ_VALUE(veh.modelId)
-        READ_VALUE(veh.unknown2)
-        READ_VALUE(veh.state)
+        VEHICLE_FIELDS(READ_VEHICLE_FIELD)
 #ifdef RW_DEBUG
         std::cout << " b " << veh.modelId << " " << veh.state.position.x << " "
                   << veh.state.position.y << " " << veh.state.position.z
                   << '\n';
 #endif
     }
+#undef READ_VEHICLE_FIELD
 
     // Block 4
     BlockSize objectsBlockSize;
@@ -701,24 +1616,13 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     BlockDword objectCount;
     READ_VALUE(objectCount);
 
+#define READ_OBJECT_FIELD(field) READ_VALUE(obj.field)
     std::vector<Block4Object> objects(objectCount);
     for (size_t o = 0; o < objectCount; ++o) {
         Block4Object& obj = objects[o];
-        READ_VALUE(obj.modelId)
-        READ_VALUE(obj.reference)
-        READ_VALUE(obj.position)
-        READ_VALUE(obj.rotation)
-        READ_VALUE(obj.unknown1)
-        READ_VALUE(obj.unknown2)
-        READ_VALUE(obj.unknown3)
-        READ_VALUE(obj.unknown4)
-        READ_VALUE(obj.unknown5)
-        READ_VALUE(obj.unknown6)
-        READ_VALUE(obj.unknown7)
-        READ_VALUE(obj.unknown8)
-        READ_VALUE(obj.unknown9)
-        READ_VALUE(obj.unknown10)
+        OBJECT_FIELDS(READ_OBJECT_FIELD)
     }
+#undef READ_OBJECT_FIELD
 
     for (size_t o = 0; o < objectCount; ++o) {
         auto& obj = objects[o];
@@ -732,6 +1636,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
             glm::vec3(obj.rotation[6], obj.rotation[7], obj.rotation[8]));
         glm::mat3 m = glm::mat3(right, forward, -down);
         inst->setRotation(glm::normalize(static_cast<glm::quat>(m)));
+        inst->setLifetime(GameObject::MissionLifetime);
     }
 
 #ifdef RW_DEBUG
@@ -760,6 +1665,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     // Block 5
     BlockSize pathBlockSize;
     BLOCK_HEADER(pathBlockSize)
+    KEEP_BLOCK(5, pathBlockSize)
     BlockDword pathDataSize;
     READ_VALUE(pathDataSize)
 
@@ -773,6 +1679,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     // Block 6
     BlockSize craneBlockSize;
     BLOCK_HEADER(craneBlockSize)
+    KEEP_BLOCK(6, craneBlockSize)
     BlockDword craneDataSize;
     READ_VALUE(craneDataSize)
 
@@ -888,49 +1795,30 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     READ_VALUE(zoneDataSize)
 
     Block11Data zoneData;
+#define READ_ZONE_FIELD(field) READ_VALUE(zone.field)
+#define READ_ZONE_INFO_FIELD(field) READ_VALUE(info.field)
     READ_VALUE(zoneData.currentZone);
     READ_VALUE(zoneData.currentLevel);
     READ_VALUE(zoneData.findIndex);
     READ_VALUE(zoneData.align);
     for (auto &zone : zoneData.navZones) {
-        READ_VALUE(zone.name);
-        READ_VALUE(zone.coordA);
-        READ_VALUE(zone.coordB);
-        READ_VALUE(zone.type);
-        READ_VALUE(zone.level);
-        READ_VALUE(zone.dayZoneInfo);
-        READ_VALUE(zone.nightZoneInfo);
-        READ_VALUE(zone.childZone);
-        READ_VALUE(zone.parentZone);
-        READ_VALUE(zone.siblingZone);
+        ZONE_FIELDS(READ_ZONE_FIELD)
     }
     for (auto &info : zoneData.dayNightInfo) {
-        READ_VALUE(info.density)
-        READ_VALUE(info.unknown1)
-        READ_VALUE(info.peddensity)
-        READ_VALUE(info.copdensity)
-        READ_VALUE(info.gangpeddensity)
-        READ_VALUE(info.pedgroup);
+        ZONE_INFO_FIELDS(READ_ZONE_INFO_FIELD)
     }
     READ_VALUE(zoneData.numNavZones);
     READ_VALUE(zoneData.numZoneInfos);
     for (auto &zone : zoneData.mapZones) {
-        READ_VALUE(zone.name);
-        READ_VALUE(zone.coordA);
-        READ_VALUE(zone.coordB);
-        READ_VALUE(zone.type);
-        READ_VALUE(zone.level);
-        READ_VALUE(zone.dayZoneInfo);
-        READ_VALUE(zone.nightZoneInfo);
-        READ_VALUE(zone.childZone);
-        READ_VALUE(zone.parentZone);
-        READ_VALUE(zone.siblingZone);
+        ZONE_FIELDS(READ_ZONE_FIELD)
     }
     for (auto &audioZone : zoneData.audioZones) {
         READ_VALUE(audioZone);
     }
     READ_VALUE(zoneData.numMapZones);
     READ_VALUE(zoneData.numAudioZones);
+#undef READ_ZONE_INFO_FIELD
+#undef READ_ZONE_FIELD
 
 #ifdef RW_DEBUG
     std::cout << "zones: " << zoneData.numNavZones << " "
@@ -994,6 +1882,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     // Block 12
     BlockSize gangBlockSize;
     BLOCK_HEADER(gangBlockSize)
+    KEEP_BLOCK(12, gangBlockSize)
     BlockDword gangDataSize;
     READ_VALUE(gangDataSize)
     CHECK_SIG("GNG")
@@ -1078,19 +1967,9 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     BLOCK_HEADER(playerInfoBlockSize)
     BlockDword playerInfoDataSize;
     READ_VALUE(playerInfoDataSize)
-    READ_VALUE(state.playerInfo.money)
-    READ_VALUE(state.playerInfo.unknown1)
-    READ_VALUE(state.playerInfo.unknown2)
-    READ_VALUE(state.playerInfo.unknown3)
-    READ_VALUE(state.playerInfo.unknown4)
-    READ_VALUE(state.playerInfo.displayedMoney)
-    READ_VALUE(state.playerInfo.hiddenPackagesCollected)
-    READ_VALUE(state.playerInfo.hiddenPackageCount)
-    READ_VALUE(state.playerInfo.neverTired)
-    READ_VALUE(state.playerInfo.fastReload)
-    READ_VALUE(state.playerInfo.thaneOfLibertyCity)
-    READ_VALUE(state.playerInfo.singlePayerHealthcare)
-    READ_VALUE(state.playerInfo.unknown5)
+#define READ_PLAYER_INFO_FIELD(field) READ_VALUE(state.playerInfo.field)
+    PLAYER_INFO_FIELDS(READ_PLAYER_INFO_FIELD)
+#undef READ_PLAYER_INFO_FIELD
 
 #ifdef RW_DEBUG
     std::cout << "Player money: " << state.playerInfo.money << " ("
@@ -1103,57 +1982,9 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     BlockDword statsDataSize;
     READ_VALUE(statsDataSize)
 
-    READ_VALUE(state.gameStats.playerKills);
-    READ_VALUE(state.gameStats.otherKills);
-    READ_VALUE(state.gameStats.carsExploded);
-    READ_VALUE(state.gameStats.shotsHit);
-    READ_VALUE(state.gameStats.pedTypesKilled);
-    READ_VALUE(state.gameStats.helicoptersDestroyed);
-    READ_VALUE(state.gameStats.playerProgress);
-    READ_VALUE(state.gameStats.explosiveKgsUsed);
-    READ_VALUE(state.gameStats.bulletsFired);
-    READ_VALUE(state.gameStats.bulletsHit);
-    READ_VALUE(state.gameStats.carsCrushed);
-    READ_VALUE(state.gameStats.headshots);
-    READ_VALUE(state.gameStats.timesBusted);
-    READ_VALUE(state.gameStats.timesHospital);
-    READ_VALUE(state.gameStats.daysPassed);
-    READ_VALUE(state.gameStats.mmRainfall);
-    READ_VALUE(state.gameStats.insaneJumpMaxDistance);
-    READ_VALUE(state.gameStats.insaneJumpMaxHeight);
-    READ_VALUE(state.gameStats.insaneJumpMaxFlips);
-    READ_VALUE(state.gameStats.insaneJumpMaxRotation);
-    READ_VALUE(state.gameStats.bestStunt);
-    READ_VALUE(state.gameStats.uniqueStuntsFound);
-    READ_VALUE(state.gameStats.uniqueStuntsTotal);
-    READ_VALUE(state.gameStats.missionAttempts);
-    READ_VALUE(state.gameStats.missionsPassed);
-    READ_VALUE(state.gameStats.passengersDroppedOff);
-    READ_VALUE(state.gameStats.taxiRevenue);
-    READ_VALUE(state.gameStats.portlandPassed);
-    READ_VALUE(state.gameStats.stauntonPassed);
-    READ_VALUE(state.gameStats.shoresidePassed);
-    READ_VALUE(state.gameStats.bestTurismoTime);
-    READ_VALUE(state.gameStats.distanceWalked);
-    READ_VALUE(state.gameStats.distanceDriven);
-    READ_VALUE(state.gameStats.patriotPlaygroundTime);
-    READ_VALUE(state.gameStats.aRideInTheParkTime);
-    READ_VALUE(state.gameStats.grippedTime);
-    READ_VALUE(state.gameStats.multistoryMayhemTime);
-    READ_VALUE(state.gameStats.peopleSaved);
-    READ_VALUE(state.gameStats.criminalsKilled);
-    READ_VALUE(state.gameStats.highestParamedicLevel);
-    READ_VALUE(state.gameStats.firesExtinguished);
-    READ_VALUE(state.gameStats.longestDodoFlight);
-    READ_VALUE(state.gameStats.bombDefusalTime);
-    READ_VALUE(state.gameStats.rampagesPassed);
-    READ_VALUE(state.gameStats.totalRampages);
-    READ_VALUE(state.gameStats.totalMissions);
-    READ_VALUE(state.gameStats.fastestTime);
-    READ_VALUE(state.gameStats.highestScore);
-    READ_VALUE(state.gameStats.peopleKilledSinceCheckpoint);
-    READ_VALUE(state.gameStats.peopleKilledSinceLastBustedOrWasted);
-    READ_VALUE(state.gameStats.lastMissionGXT);
+#define READ_GAME_STATS_FIELD(field) READ_VALUE(state.gameStats.field)
+    GAME_STATS_FIELDS(READ_GAME_STATS_FIELD)
+#undef READ_GAME_STATS_FIELD
 
 #ifdef RW_DEBUG
     std::cout << "Player kills: " << state.gameStats.playerKills << '\n';
@@ -1164,6 +1995,7 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     // Block 18
     BlockSize streamingBlockSize;
     BLOCK_HEADER(streamingBlockSize);
+    KEEP_BLOCK(18, streamingBlockSize)
     BlockDword streamingDataSize;
     READ_VALUE(streamingDataSize);
 
@@ -1267,6 +2099,34 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
                                   glm::vec3(garage.x2, garage.y2, garage.z2),
                                   static_cast<GarageType>(garage.type));
     }
+
+    // Script globals and blips refer to vehicles and pickups by handle, so
+    // they keep the handles they were saved with. The garage cars come after
+    // them and take whatever handles are left.
+    const auto restoredID = [&](const GameWorld::ObjectPool& pool,
+                                GameObjectID handle) -> GameObjectID {
+        if (handle != 0 && pool.find(handle) != nullptr) {
+            RW_ERROR(file << ": Handle " << handle << " is used twice");
+            return 0;
+        }
+        return handle;
+    };
+    for (const auto& veh : vehicles) {
+        auto vehicle = state.world->createVehicle(
+            veh.modelId, veh.state.position, getVehicleRotation(veh.state),
+            restoredID(state.world->vehiclePool, veh.handle));
+        if (vehicle) {
+            vehicle->setLifetime(GameObject::MissionLifetime);
+        }
+    }
+    for (const auto& veh : boats) {
+        auto vehicle = state.world->createVehicle(
+            veh.modelId, veh.state.position, getVehicleRotation(veh.state),
+            restoredID(state.world->vehiclePool, veh.handle));
+        if (vehicle) {
+            vehicle->setLifetime(GameObject::MissionLifetime);
+        }
+    }
     for (auto &c : garageData.cars) {
         if (c.modelId == 0) continue;
         auto& car = c;
@@ -1280,6 +2140,49 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
         vehicle->setSecondaryColour(car.colorBG);
     }
 
+    for (const auto& pickup : pickupData.pickups) {
+        if (pickup.type == 0) {
+            continue;
+        }
+        state.world->createPickup(
+            pickup.position, pickup.modelId, pickup.type,
+            restoredID(state.world->pickupPool, pickup.objectRef));
+    }
+
+    state.radarBlips.clear();
+    for (int b = 0; b < kNrOfBlips; ++b) {
+        const auto& in = radarData.blips[b];
+        if (in.type == BlipData::None) {
+            continue;
+        }
+        BlipData blip;
+        blip.id = b;
+        blip.type = static_cast<BlipData::BlipType>(in.type);
+        blip.target = in.entityHandle;
+        blip.coord = in.position;
+        blip.colour = in.color;
+        blip.brightness = in.brightness;
+        blip.size = in.scale;
+        blip.display = static_cast<BlipData::DisplayMode>(in.display);
+        blip.texture = script::getBlipSprite(in.sprite);
+        state.radarBlips[b] = blip;
+    }
+
+    auto& pedrels = state.world->data->pedrels;
+    const auto numPedTypes =
+        std::min<size_t>(pedrels.size(), pedTypeData.types.size());
+    for (size_t t = 0; t < numPedTypes; ++t) {
+        const auto& in = pedTypeData.types[t];
+        pedrels[t].id_ = in.bitstring_;
+        pedrels[t].a_ = in.unknown2;
+        pedrels[t].b_ = in.unknown3;
+        pedrels[t].c_ = in.unknown4;
+        pedrels[t].d_ = in.fleedistance;
+        pedrels[t].e_ = in.headingchangerate;
+        pedrels[t].threatflags_ = in.threatflags_;
+        pedrels[t].avoidflags_ = in.avoidflags_;
+    }
+
     for (unsigned g = 0; g < carGenerators.size(); ++g) {
         auto& gen = carGenerators[g];
         state.vehicleGenerators.emplace_back(
@@ -1295,29 +2198,29 @@ bool SaveGame::loadGame(GameState& state, const std::string& file) {
     state.importExportShoreside = garageData.bfImportExportShoreside;
     state.importExportUnused = garageData.bfImportExportUnused;
 
-    std::fclose(loadFile);
-
     return true;
 }
 
 bool SaveGame::getSaveInfo(const std::string& file, BasicState* basicState) {
     std::FILE* loadFile = std::fopen(file.c_str(), "rb");
-
-    SaveGameInfo info;
-    info.savePath = file;
-
-    // BLOCK 0
-    BlockDword blockSize;
-    if (fread(&blockSize, sizeof(BlockDword), 1, loadFile) == 0) {
+    if (loadFile == nullptr) {
         return false;
     }
 
-    // Read block 0 into state
-    if (fread(basicState, sizeof(BasicState), 1, loadFile) == 0) {
+    // BLOCK 0, the size followed by the basic state, in a single read
+    struct {
+        BlockDword blockSize;
+        BasicState basic;
+    } header;
+    static_assert(sizeof(header) == sizeof(BlockDword) + sizeof(BasicState),
+                  "Block 0 header must not be padded");
+    const bool read = std::fread(&header, sizeof(header), 1, loadFile) == 1;
+    std::fclose(loadFile);
+
+    if (!read) {
         return false;
     }
-
-    std::fclose(loadFile);
+    *basicState = header.basic;
 
     return true;
 }
@@ -1345,7 +2248,7 @@ char* readUserPath() {
 }
 #endif
 
-std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo() {
+std::filesystem::path SaveGame::getSaveDirectory() {
 #ifdef RW_WINDOWS
     auto homedir = readUserPath(); // already includes MyDocuments/Documents
 #else
@@ -1359,18 +2262,17 @@ std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo() {
 
     std::filesystem::path gamePath(homedir);
     gamePath /= gameDir;
+    return gamePath;
+}
 
-    if (!std::filesystem::exists(gamePath) || !std::filesystem::is_directory(gamePath)) return {};
-
-    std::vector<SaveGameInfo> infos;
-    for (const std::filesystem::path& save_path : std::filesystem::directory_iterator(gamePath)) {
-        if (save_path.extension() == ".b") {
-            infos.emplace_back(
-                SaveGameInfo{save_path.string(), false, BasicState()});
-            infos.back().valid =
-                getSaveInfo(infos.back().savePath, &infos.back().basicState);
-        }
+std::vector<SaveGameInfo> SaveGame::getAllSaveGameInfo() {
+    const auto gamePath = getSaveDirectory();
+    if (gamePath.empty()) {
+        return {};
     }
 
-    return infos;
+    SaveGameIndex index(gamePath);
+    index.refresh();
+    index.wait();
+    return index.getSaves();
 }
@@ -1,6 +1,9 @@
 #ifndef _RWENGINE_SAVEGAME_HPP_
 #define _RWENGINE_SAVEGAME_HPP_
 
+#include <cstdint>
+#include <filesystem>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -17,11 +20,35 @@ struct SaveGameInfo {
  */
 class SaveGame {
 public:
+    /**
+     * Serialises the game state into memory, in a format that closely
+     * approximates the format used in GTA III.
+     *
+     * This must run on the simulation thread, but does no file IO so that it
+     * can be used for autosaves without stalling the frame.
+     */
+    static std::vector<std::uint8_t> snapshotGame(GameState& state);
+
+    /**
+     * Appends the checksum to a snapshot and writes it to file, replacing any
+     * existing save only once the new one is complete.
+     * @return status, false if the file could not be written.
+     */
+    static bool writeSnapshot(std::vector<std::uint8_t> snapshot,
+                              const std::string& file);
+
     /**
      * Writes the entire game state to a file format that closely approximates
      * the format used in GTA III
      */
-    static void writeGame(GameState& state, const std::string& file);
+    static bool writeGame(GameState& state, const std::string& file);
+
+    /**
+     * Snapshots the game state immediately and writes it to file on a
+     * background thread.
+     */
+    static std::future<bool> writeGameAsync(GameState& state,
+                                            const std::string& file);
 
     /**
      * Loads an entire Game State from a file, using a format similar to the
@@ -35,8 +62,17 @@ public:
 
     static bool getSaveInfo(const std::string& file, BasicState* outState);
 
+    /**
+     * Returns the directory the game's save files are kept in, or an empty
+     * path if the user's home directory can't be determined.
+     */
+    static std::filesystem::path getSaveDirectory();
+
     /**
      * Returns save game information for all found saves
+     *
+     * This blocks until the save directory has been scanned, see
+     * SaveGameIndex for a listing that doesn't wait on the disk.
      */
     static std::vector<SaveGameInfo> getAllSaveGameInfo();
 };
@@ -0,0 +1,239 @@
+#include "engine/SaveGameIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <rw/debug.hpp>
+
+#include "core/Profiler.hpp"
+
+namespace {
+constexpr char kIndexMagic[4] = {'R', 'W', 'S', 'I'};
+constexpr std::uint32_t kIndexVersion = 1;
+
+static_assert(std::is_trivially_copyable<BasicState>::value,
+              "BasicState is stored in the index as raw bytes");
+
+template <class T>
+bool readValue(std::FILE* file, T& value) {
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+template <class T>
+bool writeValue(std::FILE* file, const T& value) {
+    return std::fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+bool sameFile(const SaveGameIndex::Entry& a, const SaveGameIndex::Entry& b) {
+    return a.info.savePath == b.info.savePath && a.fileSize == b.fileSize &&
+           a.modifiedTime == b.modifiedTime && a.info.valid == b.info.valid;
+}
+}  // namespace
+
+SaveGameIndex::SaveGameIndex(std::filesystem::path directory)
+    : directory(std::move(directory)) {
+    // An empty path would put the index in the working directory
+    if (this->directory.empty()) {
+        return;
+    }
+    if (!readIndex(entries)) {
+        entries.clear();
+    }
+}
+
+SaveGameIndex::~SaveGameIndex() {
+    wait();
+}
+
+std::vector<SaveGameInfo> SaveGameIndex::getSaves() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SaveGameInfo> saves;
+    saves.reserve(entries.size());
+    for (const auto& entry : entries) {
+        saves.push_back(entry.info);
+    }
+    return saves;
+}
+
+void SaveGameIndex::refresh() {
+    if (directory.empty()) {
+        return;
+    }
+    if (pending.valid() && pending.wait_for(std::chrono::seconds(0)) !=
+                               std::future_status::ready) {
+        return;
+    }
+
+    std::vector<Entry> known;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        known = entries;
+    }
+    pending = std::async(std::launch::async,
+                         [this, known = std::move(known)]() mutable {
+                             RW_PROFILE_THREAD("SaveIndex");
+                             scan(std::move(known));
+                         });
+}
+
+void SaveGameIndex::wait() {
+    if (pending.valid()) {
+        pending.get();
+    }
+}
+
+bool SaveGameIndex::pollChanged() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::exchange(changed, false);
+}
+
+void SaveGameIndex::scan(std::vector<Entry> known) {
+    RW_PROFILE_SCOPE(__func__);
+
+    std::map<std::string, const Entry*> byPath;
+    for (const auto& entry : known) {
+        byPath[entry.info.savePath] = &entry;
+    }
+
+    std::vector<Entry> found;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        const auto& path = it->path();
+        if (path.extension() != ".b") {
+            continue;
+        }
+
+        std::error_code statEc;
+        const auto size = std::filesystem::file_size(path, statEc);
+        const auto mtime = std::filesystem::last_write_time(path, statEc);
+        if (statEc) {
+            continue;
+        }
+
+        Entry entry{SaveGameInfo{path.string(), false, BasicState()}, size,
+                    static_cast<std::int64_t>(
+                        mtime.time_since_epoch().count())};
+
+        // Only saves that changed since they were indexed are opened
+        auto cached = byPath.find(entry.info.savePath);
+        if (cached != byPath.end() && cached->second->fileSize == size &&
+            cached->second->modifiedTime == entry.modifiedTime) {
+            entry.info = cached->second->info;
+        } else {
+            entry.info.valid = SaveGame::getSaveInfo(entry.info.savePath,
+                                                     &entry.info.basicState);
+        }
+        found.push_back(std::move(entry));
+    }
+
+    std::sort(found.begin(), found.end(), [](const Entry& a, const Entry& b) {
+        return a.info.savePath < b.info.savePath;
+    });
+
+    if (found.size() == known.size() &&
+        std::equal(found.begin(), found.end(), known.begin(), sameFile)) {
+        return;
+    }
+
+    if (std::filesystem::is_directory(directory, ec)) {
+        writeIndex(found);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    entries = std::move(found);
+    changed = true;
+}
+
+bool SaveGameIndex::readIndex(std::vector<Entry>& out) const {
+    const auto path = directory / kIndexFileName;
+    std::FILE* file = std::fopen(path.string().c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    bool ok = std::fread(magic, sizeof(magic), 1, file) == 1 &&
+              std::memcmp(magic, kIndexMagic, sizeof(magic)) == 0 &&
+              readValue(file, version) && version == kIndexVersion &&
+              readValue(file, count);
+
+    for (std::uint32_t i = 0; ok && i < count; ++i) {
+        std::uint16_t nameLength = 0;
+        std::string name;
+        std::uint64_t fileSize = 0;
+        std::int64_t modifiedTime = 0;
+        std::uint8_t valid = 0;
+        BasicState basic;
+
+        ok = readValue(file, nameLength);
+        if (ok) {
+            name.resize(nameLength);
+            ok = std::fread(name.data(), 1, nameLength, file) == nameLength;
+        }
+        ok = ok && readValue(file, fileSize) &&
+             readValue(file, modifiedTime) && readValue(file, valid) &&
+             readValue(file, basic);
+        if (ok) {
+            out.push_back({SaveGameInfo{(directory / name).string(),
+                                        valid != 0, basic},
+                           fileSize, modifiedTime});
+        }
+    }
+
+    std::fclose(file);
+    if (!ok) {
+        RW_MESSAGE("Ignoring invalid save index " << path.string());
+    }
+    return ok;
+}
+
+bool SaveGameIndex::writeIndex(const std::vector<Entry>& in) const {
+    RW_PROFILE_SCOPE(__func__);
+    const auto path = directory / kIndexFileName;
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    std::FILE* file = std::fopen(tempPath.string().c_str(), "wb");
+    if (file == nullptr) {
+        RW_ERROR("Failed to open " << tempPath.string());
+        return false;
+    }
+
+    const auto count = static_cast<std::uint32_t>(in.size());
+    bool ok = std::fwrite(kIndexMagic, sizeof(kIndexMagic), 1, file) == 1 &&
+              writeValue(file, kIndexVersion) && writeValue(file, count);
+    for (const auto& entry : in) {
+        // Only the file name is stored so the directory can be moved
+        const auto name =
+            std::filesystem::path(entry.info.savePath).filename().string();
+        const auto nameLength = static_cast<std::uint16_t>(name.size());
+        const std::uint64_t fileSize = entry.fileSize;
+        const std::uint8_t valid = entry.info.valid ? 1 : 0;
+        ok = ok && writeValue(file, nameLength) &&
+             std::fwrite(name.data(), 1, nameLength, file) == nameLength &&
+             writeValue(file, fileSize) &&
+             writeValue(file, entry.modifiedTime) && writeValue(file, valid) &&
+             writeValue(file, entry.info.basicState);
+    }
+    ok = std::fclose(file) == 0 && ok;
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(tempPath, path, ec);
+    }
+    if (!ok || ec) {
+        RW_ERROR("Failed to write save index " << path.string());
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
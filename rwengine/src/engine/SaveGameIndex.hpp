@@ -0,0 +1,82 @@
+#ifndef _RWENGINE_SAVEGAMEINDEX_HPP_
+#define _RWENGINE_SAVEGAMEINDEX_HPP_
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <engine/SaveGame.hpp>
+
+/**
+ * @brief Cached listing of the save slots in a directory
+ *
+ * The parsed header of every save is kept in a sidecar index file next to
+ * the saves, keyed by the save's file name, size and modification time.
+ * Constructing the index only reads that file, so the slots known from the
+ * last run are available immediately.
+ *
+ * refresh() rescans the directory on a background thread, only parsing saves
+ * that were added or changed since they were indexed, and rewrites the index
+ * file when anything changed.
+ *
+ * An index without a directory, e.g. when the save directory couldn't be
+ * determined, stays empty and never touches the disk.
+ */
+class SaveGameIndex {
+public:
+    static constexpr char const* kIndexFileName = "saves.idx";
+
+    struct Entry {
+        SaveGameInfo info;
+        std::uintmax_t fileSize;
+        std::int64_t modifiedTime;
+    };
+
+    SaveGameIndex(std::filesystem::path directory);
+    ~SaveGameIndex();
+
+    SaveGameIndex(const SaveGameIndex&) = delete;
+    SaveGameIndex& operator=(const SaveGameIndex&) = delete;
+
+    /**
+     * Returns the slots as of the last completed refresh, sorted by path
+     */
+    std::vector<SaveGameInfo> getSaves() const;
+
+    /**
+     * Starts rescanning the directory in the background, unless a rescan is
+     * already running
+     */
+    void refresh();
+
+    /// Blocks until any running refresh has finished
+    void wait();
+
+    /**
+     * Returns true once for each completed refresh that changed the slots
+     */
+    bool pollChanged();
+
+    const std::filesystem::path& getDirectory() const {
+        return directory;
+    }
+
+private:
+    std::filesystem::path directory;
+
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    bool changed = false;
+
+    std::future<void> pending;
+
+    void scan(std::vector<Entry> known);
+
+    bool readIndex(std::vector<Entry>& out) const;
+    bool writeIndex(const std::vector<Entry>& in) const;
+};
+
+#endif
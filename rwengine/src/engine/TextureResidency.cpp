@@ -0,0 +1,142 @@
+#include "engine/TextureResidency.hpp"
+
+#include <rw/debug.hpp>
+
+TextureResidency::TextureResidency()
+    : self(std::make_shared<TextureResidency*>(this)) {
+}
+
+TextureResidency::SlotID TextureResidency::internSlot(const std::string& name) {
+    auto it = slotNames.find(name);
+    if (it != slotNames.end()) {
+        return it->second;
+    }
+    const auto id = static_cast<SlotID>(slots.size());
+    slots.emplace_back();
+    slots.back().name = name;
+    slotNames.emplace(name, id);
+    return id;
+}
+
+TextureResidency::TextureID TextureResidency::internTexture(
+    const std::string& name) {
+    const auto id = static_cast<TextureID>(textureNames.size());
+    return textureNames.emplace(name, id).first->second;
+}
+
+TextureResidency::SlotID TextureResidency::findSlot(
+    const std::string& name) const {
+    auto it = slotNames.find(name);
+    return it != slotNames.end() ? it->second : kInvalid;
+}
+
+TextureResidency::TextureID TextureResidency::findTexture(
+    const std::string& name) const {
+    auto it = textureNames.find(name);
+    return it != textureNames.end() ? it->second : kInvalid;
+}
+
+bool TextureResidency::isResident(SlotID slot) const {
+    return slot < slots.size() && slots[slot].resident;
+}
+
+void TextureResidency::insert(SlotID slot, TextureArchive archive) {
+    RW_ASSERT(slot < slots.size());
+    auto& s = slots[slot];
+    for (auto& [name, texture] : archive) {
+        s.size += texture->getMemorySize();
+        residentSize += texture->getMemorySize();
+        auto& entry = s.textures[internTexture(name)];
+        if (entry) {
+            s.size -= entry->getMemorySize();
+            residentSize -= entry->getMemorySize();
+        }
+        entry = std::move(texture);
+    }
+    s.resident = true;
+    s.lastUsed = ++useClock;
+}
+
+TextureData* TextureResidency::find(SlotID slot, TextureID texture) const {
+    if (slot >= slots.size()) {
+        return nullptr;
+    }
+    const auto& textures = slots[slot].textures;
+    auto it = textures.find(texture);
+    return it != textures.end() ? it->second.get() : nullptr;
+}
+
+void TextureResidency::setPinned(SlotID slot, bool pinned) {
+    RW_ASSERT(slot < slots.size());
+    slots[slot].pinned = pinned;
+}
+
+void TextureResidency::touch(SlotID slot) {
+    RW_ASSERT(slot < slots.size());
+    slots[slot].lastUsed = ++useClock;
+}
+
+std::shared_ptr<void> TextureResidency::acquire(SlotID slot) {
+    RW_ASSERT(slot < slots.size());
+    auto& s = slots[slot];
+    s.references++;
+    s.managed = true;
+    s.lastUsed = ++useClock;
+
+    std::weak_ptr<TextureResidency*> owner = self;
+    return std::shared_ptr<void>(nullptr, [owner, slot](void*) {
+        if (auto residency = owner.lock()) {
+            (*residency)->release(slot);
+        }
+    });
+}
+
+void TextureResidency::release(SlotID slot) {
+    auto& s = slots[slot];
+    RW_CHECK(s.references > 0, "Texture slot released too often");
+    s.references--;
+    s.lastUsed = ++useClock;
+}
+
+int TextureResidency::getReferenceCount(SlotID slot) const {
+    return slot < slots.size() ? slots[slot].references : 0;
+}
+
+std::size_t TextureResidency::getResidentCount() const {
+    std::size_t count = 0;
+    for (const auto& slot : slots) {
+        count += slot.resident ? 1 : 0;
+    }
+    return count;
+}
+
+void TextureResidency::evict(Slot& slot) {
+    residentSize -= slot.size;
+    slot.size = 0;
+    slot.textures.clear();
+    slot.resident = false;
+}
+
+std::size_t TextureResidency::enforceBudget(SlotID keep) {
+    std::size_t evicted = 0;
+    while (budget != 0 && residentSize > budget) {
+        Slot* oldest = nullptr;
+        for (SlotID id = 0; id < slots.size(); ++id) {
+            auto& slot = slots[id];
+            if (id == keep || !slot.resident || !slot.managed ||
+                slot.pinned || slot.references > 0) {
+                continue;
+            }
+            if (!oldest || slot.lastUsed < oldest->lastUsed) {
+                oldest = &slot;
+            }
+        }
+        if (!oldest) {
+            // Everything left is in use
+            break;
+        }
+        evict(*oldest);
+        evicted++;
+    }
+    return evicted;
+}
@@ -0,0 +1,124 @@
+#ifndef _RWENGINE_TEXTURERESIDENCY_HPP_
+#define _RWENGINE_TEXTURERESIDENCY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gl/TextureData.hpp>
+
+/**
+ * @brief Owns the loaded texture slots and decides which stay resident
+ *
+ * Slot and texture names are interned once, lookups with the IDs only index
+ * a vector and hash an integer.
+ *
+ * Models hold a reference to the slot their materials were resolved from
+ * for as long as their geometry lives. Once every reference to a slot is
+ * released it may be evicted, least recently used first, whenever the
+ * resident textures exceed the budget. Slots that were never referenced by
+ * a model are never evicted, neither are pinned slots. Slots that are
+ * looked up by name at any time (HUD, fonts, radar, ...) must be pinned, as
+ * a model may resolve its materials from them too.
+ */
+class TextureResidency {
+public:
+    using SlotID = std::uint32_t;
+    using TextureID = std::uint32_t;
+
+    static constexpr std::uint32_t kInvalid = ~0u;
+
+    TextureResidency();
+
+    TextureResidency(const TextureResidency&) = delete;
+    TextureResidency& operator=(const TextureResidency&) = delete;
+
+    /// Returns the ID for the name, allocating one the first time
+    SlotID internSlot(const std::string& name);
+    TextureID internTexture(const std::string& name);
+
+    /// Returns kInvalid for names that were never interned
+    SlotID findSlot(const std::string& name) const;
+    TextureID findTexture(const std::string& name) const;
+
+    bool isResident(SlotID slot) const;
+
+    /**
+     * Adds the textures of the archive to the slot, replacing textures with
+     * the same name, and makes the slot resident
+     */
+    void insert(SlotID slot, TextureArchive archive);
+
+    /// Returns nullptr if the slot isn't resident or lacks the texture
+    TextureData* find(SlotID slot, TextureID texture) const;
+
+    /// Pinned slots are never evicted
+    void setPinned(SlotID slot, bool pinned);
+
+    /// Marks the slot as the most recently used one
+    void touch(SlotID slot);
+
+    /**
+     * Keeps the slot resident for as long as the returned handle or any of
+     * its copies live. Handles may outlive the residency.
+     */
+    std::shared_ptr<void> acquire(SlotID slot);
+
+    int getReferenceCount(SlotID slot) const;
+
+    /// Video memory the resident textures may use, 0 for no limit
+    void setBudget(std::size_t bytes) {
+        budget = bytes;
+    }
+
+    std::size_t getBudget() const {
+        return budget;
+    }
+
+    /// Video memory used by resident textures
+    std::size_t getResidentSize() const {
+        return residentSize;
+    }
+
+    std::size_t getResidentCount() const;
+
+    /**
+     * Evicts released slots, least recently used first, until the resident
+     * textures fit the budget again
+     * @param keep a slot that must stay resident, e.g. the one just loaded
+     * @return the number of slots evicted
+     */
+    std::size_t enforceBudget(SlotID keep = kInvalid);
+
+private:
+    struct Slot {
+        std::string name;
+        std::unordered_map<TextureID, std::unique_ptr<TextureData>> textures;
+        std::size_t size = 0;
+        std::uint64_t lastUsed = 0;
+        int references = 0;
+        bool resident = false;
+        bool pinned = false;
+        /// Has been referenced by a model, so nothing looks it up by name
+        bool managed = false;
+    };
+
+    void release(SlotID slot);
+    void evict(Slot& slot);
+
+    std::unordered_map<std::string, SlotID> slotNames;
+    std::unordered_map<std::string, TextureID> textureNames;
+    std::vector<Slot> slots;
+
+    std::uint64_t useClock = 0;
+    std::size_t residentSize = 0;
+    std::size_t budget = 0;
+
+    /// Lets handles find out whether the residency still exists
+    std::shared_ptr<TextureResidency*> self;
+};
+
+#endif
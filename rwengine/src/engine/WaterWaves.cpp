@@ -0,0 +1,88 @@
+#include "engine/WaterWaves.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <rw/types.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RW_WAVES_SSE
+#endif
+
+namespace {
+// 2 pi split in two, the first part has few enough bits that multiples of
+// it are exact for any time the game reaches
+constexpr float kTwoPiHigh = 6.28125f;
+constexpr float kTwoPiLow = 1.9353071795864769e-3f;
+constexpr float kInvTwoPi = 0.15915494309189535f;
+constexpr float kPi = 3.14159265358979324f;
+
+// Taylor series of sin, accurate to 1e-7 over [-pi/2, pi/2]
+constexpr float kSin3 = -1.f / 6.f;
+constexpr float kSin5 = 1.f / 120.f;
+constexpr float kSin7 = -1.f / 5040.f;
+constexpr float kSin9 = 1.f / 362880.f;
+constexpr float kSin11 = -1.f / 39916800.f;
+
+float sine(float v) {
+    const auto k = std::nearbyint(v * kInvTwoPi);
+    auto r = (v - k * kTwoPiHigh) - k * kTwoPiLow;
+    // Reflect [pi/2, pi] and [-pi, -pi/2] into [-pi/2, pi/2]
+    r = std::min(r, kPi - r);
+    r = std::max(r, -kPi - r);
+    const auto r2 = r * r;
+    auto p = kSin11;
+    p = p * r2 + kSin9;
+    p = p * r2 + kSin7;
+    p = p * r2 + kSin5;
+    p = p * r2 + kSin3;
+    return r + r * r2 * p;
+}
+}  // namespace
+
+namespace WaterWaves {
+
+float heightAt(float time, float x, float y) {
+    return (1.f + sine(time + (x + y) * WATER_SCALE)) * WATER_HEIGHT;
+}
+
+void heightsAt(float time, const float* x, const float* y, std::size_t count,
+               float* heights) {
+    std::size_t i = 0;
+#if defined(RW_WAVES_SSE)
+    const auto t = _mm_set1_ps(time);
+    const auto scale = _mm_set1_ps(WATER_SCALE);
+    const auto pi = _mm_set1_ps(kPi);
+    const auto negPi = _mm_set1_ps(-kPi);
+    const auto one = _mm_set1_ps(1.f);
+    const auto height = _mm_set1_ps(WATER_HEIGHT);
+    for (; i + 4 <= count; i += 4) {
+        const auto v = _mm_add_ps(
+            t, _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)),
+                          scale));
+        // Rounds to nearest even, as nearbyint does by default
+        const auto k = _mm_cvtepi32_ps(
+            _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(kInvTwoPi))));
+        auto r = _mm_sub_ps(
+            _mm_sub_ps(v, _mm_mul_ps(k, _mm_set1_ps(kTwoPiHigh))),
+            _mm_mul_ps(k, _mm_set1_ps(kTwoPiLow)));
+        r = _mm_min_ps(r, _mm_sub_ps(pi, r));
+        r = _mm_max_ps(r, _mm_sub_ps(negPi, r));
+        const auto r2 = _mm_mul_ps(r, r);
+        auto p = _mm_set1_ps(kSin11);
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(kSin9));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(kSin7));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(kSin5));
+        p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(kSin3));
+        const auto s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), p));
+        _mm_storeu_ps(heights + i, _mm_mul_ps(_mm_add_ps(one, s), height));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        heights[i] = heightAt(time, x[i], y[i]);
+    }
+}
+
+}  // namespace WaterWaves
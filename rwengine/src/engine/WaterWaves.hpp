@@ -0,0 +1,34 @@
+#ifndef _RWENGINE_WATERWAVES_HPP_
+#define _RWENGINE_WATERWAVES_HPP_
+
+#include <cstddef>
+
+/**
+ * The wave function shared by the water surface and buoyancy.
+ *
+ * Waves raise the still water height by between 0 and 2 * WATER_HEIGHT.
+ * Both CPU versions evaluate the sine with the same polynomial, so a batch
+ * gives the same heights as querying each point on its own.
+ */
+namespace WaterWaves {
+
+/// Height of the waves at x, y
+float heightAt(float time, float x, float y);
+
+/**
+ * Evaluates the waves for count points stored as separate coordinate
+ * arrays, several at a time where the target has SSE
+ */
+void heightsAt(float time, const float* x, const float* y, std::size_t count,
+               float* heights);
+
+}  // namespace WaterWaves
+
+/// GLSL version for shaders displacing the surface, params holds
+/// WATER_SCALE and WATER_HEIGHT
+#define RW_WATER_WAVE_GLSL                                                \
+    "float waveHeight(vec2 xy, float time, vec2 params) {\n"              \
+    "    return (1.0 + sin(time + (xy.x + xy.y) * params.x)) * params.y;\n" \
+    "}\n"
+
+#endif
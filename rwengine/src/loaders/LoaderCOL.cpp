@@ -118,6 +118,7 @@ bool LoaderCOL::load(const std::string& path) {
             t.surface = readSurface();
         }
 
+        model->memory.set(model->calculateMemorySize());
         collisions.emplace_back(std::move(model));
     }
 
@@ -6,6 +6,8 @@
 #include <cctype>
 #include <memory>
 
+#include "data/AnimationClip.hpp"
+
 bool findKeyframes(float t, AnimationBone* bone, AnimationKeyframe& f1,
                    AnimationKeyframe& f2, float& alpha) {
     for (size_t f = 0; f < bone->frames.size(); ++f) {
@@ -58,6 +60,17 @@ AnimationKeyframe AnimationBone::getKeyframe(float time) {
     return frames.back();
 }
 
+void Animation::compile() {
+    if (clip) {
+        return;
+    }
+    clip = std::make_shared<AnimationClip>();
+    for (const auto& [name, bone] : bones) {
+        clip->addChannel(name, bone.type, bone.frames);
+    }
+    bones.clear();
+}
+
 bool LoaderIFP::loadFromMemory(char* data) {
     size_t data_offs = 0;
     size_t* dataI = &data_offs;
@@ -80,7 +93,8 @@ bool LoaderIFP::loadFromMemory(char* data) {
         DGAN* animroot = read<DGAN>(data, dataI);
         std::string infoname = readString(data, dataI);
 
-        animation->bones.reserve(animroot->info.entries);
+        // Bones go straight into the clip, which keeps them in file order
+        animation->clip = std::make_shared<AnimationClip>();
 
         for (auto c = 0u; c < animroot->info.entries; ++c) {
             size_t start = data_offs;
@@ -137,7 +151,8 @@ bool LoaderIFP::loadFromMemory(char* data) {
             std::transform(framename.begin(), framename.end(),
                            framename.begin(), ::tolower);
 
-            animation->bones.emplace(framename, std::move(boneData));
+            animation->clip->addChannel(framename, boneData.type,
+                                        boneData.frames);
         }
 
         data_offs = animstart + animroot->base.size;
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -12,6 +13,8 @@
 
 #include <rw/forward.hpp>
 
+class AnimationClip;
+
 struct AnimationKeyframe {
     glm::quat rotation{1.0f,0.0f,0.0f,0.0f};
     glm::vec3 position{};
@@ -63,15 +66,31 @@ struct AnimationBone {
 /**
  * @brief Animation data object, stores bones.
  *
+ * Animations are sampled through their AnimationClip. LoaderIFP builds the
+ * clip directly, animations put together from bones are compiled into one
+ * the first time it's needed.
+ *
  * @todo break out into Animation.hpp
  */
 struct Animation {
     std::string name;
+    /// Keyframes not compiled yet, compile() moves them into the clip
     std::unordered_map<std::string, AnimationBone> bones;
+    std::shared_ptr<AnimationClip> clip;
 
     ~Animation() = default;
 
     float duration;
+
+    /// Builds the clip from bones, unless there is one already
+    void compile();
+
+    const AnimationClip& getClip() {
+        if (!clip) {
+            compile();
+        }
+        return *clip;
+    }
 };
 
 class LoaderIFP {
@@ -23,6 +23,7 @@
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
+#include "data/AnimationClip.hpp"
 #include "loaders/LoaderIFP.hpp"
 #include "objects/VehicleObject.hpp"
 
@@ -245,9 +246,9 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
     if (movementAnimation != animations->animation(AnimCycle::Idle) &&
         !modelroot->getChildren().empty()) {
         const auto& root = modelroot->getChildren()[0];
-        auto it = movementAnimation->bones.find(root->getName());
-        if (it != movementAnimation->bones.end()) {
-            auto& rootBone = it->second;
+        const auto& clip = movementAnimation->getClip();
+        const auto rootChannel = clip.findChannel(root->getName());
+        if (rootChannel != AnimationClip::kNoChannel) {
             float step = dt;
             RW_CHECK(
                 animator->getAnimation(AnimIndexMovement),
@@ -260,19 +261,16 @@ glm::vec3 CharacterObject::updateMovementAnimation(float dt) {
             // Handle any remaining transformation before the end of the
             // keyframes
             if ((animTime + step) > duration) {
-                glm::vec3 a =
-                    rootBone.getInterpolatedKeyframe(animTime).position;
-                glm::vec3 b =
-                    rootBone.getInterpolatedKeyframe(duration).position;
+                glm::vec3 a = clip.sample(rootChannel, animTime).position;
+                glm::vec3 b = clip.sample(rootChannel, duration).position;
                 glm::vec3 d = (b - a);
                 animTranslate.y += d.y;
                 step -= (duration - animTime);
                 animTime = 0.f;
             }
 
-            glm::vec3 a = rootBone.getInterpolatedKeyframe(animTime).position;
-            glm::vec3 b =
-                rootBone.getInterpolatedKeyframe(animTime + step).position;
+            glm::vec3 a = clip.sample(rootChannel, animTime).position;
+            glm::vec3 b = clip.sample(rootChannel, animTime + step).position;
             glm::vec3 d = (b - a);
             animTranslate.y += d.y;
 
@@ -96,6 +96,7 @@ void InstanceObject::tickPhysics(float dt) {
                         (WATER_WORLD_SIZE / WATER_HQ_DATA_SIZE));
         float vH = ws.z;  // - _collisionHeight/2.f;
         float wH = 0.f;
+        const float wave = engine->data->getWaveHeightAt(ws);
 
         if (wX >= 0 && wX < WATER_HQ_DATA_SIZE && wY >= 0 &&
             wY < WATER_HQ_DATA_SIZE) {
@@ -103,7 +104,7 @@ void InstanceObject::tickPhysics(float dt) {
             int hI = engine->data->realWater[i];
             if (hI < NO_WATER_INDEX) {
                 wH = engine->data->waterHeights[hI];
-                wH += engine->data->getWaveHeightAt(ws);
+                wH += wave;
                 inWater = vH <= wH;
             } else {
                 inWater = false;
@@ -122,8 +123,7 @@ void InstanceObject::tickPhysics(float dt) {
             if (wi != NO_WATER_INDEX) {
                 float h = engine->data->waterHeights[wi] + oZ;
 
-                // Calculate wave height
-                h += engine->data->getWaveHeightAt(ws);
+                h += wave;
 
                 if (ws.z <= h) {
                     float x = (h - ws.z);
@@ -64,19 +64,10 @@ void ProjectileObject::explode() {
         const float damageSize = 5.f;
         const float damage = static_cast<float>(_info.weapon->damage);
 
-        for (auto& o : engine->allObjects) {
-            if (o == this) continue;
-            switch (o->type()) {
-                case GameObject::Instance:
-                case GameObject::Vehicle:
-                case GameObject::Character:
-                    break;
-                default:
-                    continue;
-            }
-
+        std::vector<GameObject*> nearby;
+        engine->gatherObjectsNear(getPosition(), damageSize, nearby);
+        for (auto& o : nearby) {
             float d = glm::distance(getPosition(), o->getPosition());
-            if (d > damageSize) continue;
 
             o->takeDamage({DamageInfo::DamageType::Explosion,
                            getPosition(), getPosition(),
@@ -1,6 +1,7 @@
 #include "objects/VehicleObject.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
@@ -572,10 +573,18 @@ void VehicleObject::tickPhysics(float dt) {
             vLeft = getRotation() * vLeft;
 
             // This function will try to keep v* at the water level.
-            applyWaterFloat(vFwd);
-            applyWaterFloat(vBack);
-            applyWaterFloat(vRt);
-            applyWaterFloat(vLeft);
+            const std::array<glm::vec3, 4> floatPoints{{vFwd, vBack, vRt,
+                                                        vLeft}};
+            std::array<float, 4> floatX, floatY, waves;
+            for (auto point = 0u; point < floatPoints.size(); ++point) {
+                floatX[point] = ws.x + floatPoints[point].x;
+                floatY[point] = ws.y + floatPoints[point].y;
+            }
+            engine->data->getWaveHeightsAt(floatX.data(), floatY.data(),
+                                           waves.size(), waves.data());
+            for (auto point = 0u; point < floatPoints.size(); ++point) {
+                applyWaterFloat(floatPoints[point], waves[point]);
+            }
         } else {
             if (isBoat) {
                 collision->getBulletBody()->setDamping(0.1f, 0.8f);
@@ -796,14 +805,11 @@ void VehicleObject::setPartState(VehicleObject::Part* part,
     }
 }
 
-void VehicleObject::applyWaterFloat(const glm::vec3& relPt) {
+void VehicleObject::applyWaterFloat(const glm::vec3& relPt, float wave) {
     auto ws = getPosition() + relPt;
     auto wi = engine->data->getWaterIndexAt(ws);
     if (wi != NO_WATER_INDEX) {
-        float h = engine->data->waterHeights[wi];
-
-        // Calculate wave height
-        h += engine->data->getWaveHeightAt(ws);
+        float h = engine->data->waterHeights[wi] + wave;
 
         if (ws.z <= h) {
             float x = (h - ws.z);
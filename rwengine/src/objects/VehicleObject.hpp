@@ -206,7 +206,9 @@ public:
 
     Part* getPart(const std::string& name);
 
-    void applyWaterFloat(const glm::vec3& relPt);
+    /// Pushes the vehicle up at relPt if it's below the water, wave being
+    /// the wave height there
+    void applyWaterFloat(const glm::vec3& relPt, float wave);
 
     void setPrimaryColour(uint8_t color);
     void setSecondaryColour(uint8_t color);
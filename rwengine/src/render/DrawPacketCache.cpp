@@ -0,0 +1,84 @@
+#include "render/DrawPacketCache.hpp"
+
+#include <algorithm>
+
+#include <data/Clump.hpp>
+#include <gl/TextureData.hpp>
+
+const DrawPacketCache::Packets& DrawPacketCache::get(
+    const GeometryPtr& geometry) {
+    auto& entry = entries[geometry.get()];
+    const bool current = !entry.owner.owner_before(geometry) &&
+                         !geometry.owner_before(entry.owner);
+    if (!current) {
+        entry.owner = geometry;
+        derive(*geometry, entry.packets);
+
+        // References to the entries survive erasing others
+        if (entries.size() >= pruneSize) {
+            prune();
+            pruneSize = std::max(pruneSize, entries.size() * 2);
+        }
+    }
+    return entry.packets;
+}
+
+void DrawPacketCache::prune() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.owner.expired()) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DrawPacketCache::derive(const Geometry& geometry, Packets& packets) {
+    packets.clear();
+    packets.reserve(geometry.subgeom.size());
+    for (const auto& subgeom : geometry.subgeom) {
+        Packet packet;
+        auto& dp = packet.parameters;
+
+        dp.colour = {255, 255, 255, 255};
+        dp.count = subgeom.numIndices;
+        dp.start = subgeom.start;
+        dp.textures = {{0}};
+        dp.visibility = 1.f;
+
+        bool colourTransparent = false;
+        if (geometry.materials.size() > subgeom.material) {
+            const auto& mat = geometry.materials[subgeom.material];
+
+            if (!mat.textures.empty()) {
+                auto tex = mat.textures[0].texture;
+                if (tex) {
+                    packet.textureTransparent = tex->isTransparent();
+                    dp.textures = {{tex->getName()}};
+                }
+            }
+
+            if ((geometry.flags & RW::BSGeometry::ModuleMaterialColor) ==
+                RW::BSGeometry::ModuleMaterialColor) {
+                dp.colour = mat.colour;
+                if (dp.colour.r == 60 && dp.colour.g == 255 &&
+                    dp.colour.b == 0) {
+                    packet.colourKey = Packet::PrimaryKey;
+                } else if (dp.colour.r == 255 && dp.colour.g == 0 &&
+                           dp.colour.b == 175) {
+                    packet.colourKey = Packet::SecondaryKey;
+                }
+            }
+
+            colourTransparent = dp.colour.a < 255;
+
+            dp.diffuse = mat.diffuseIntensity;
+            dp.ambient = mat.ambientIntensity;
+        }
+
+        dp.blendMode = packet.textureTransparent || colourTransparent
+                           ? BlendMode::BLEND_ALPHA
+                           : BlendMode::BLEND_NONE;
+        packets.push_back(packet);
+    }
+}
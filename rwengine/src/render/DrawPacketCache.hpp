@@ -0,0 +1,63 @@
+#ifndef _RWENGINE_DRAWPACKETCACHE_HPP_
+#define _RWENGINE_DRAWPACKETCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <rw/forward.hpp>
+
+#include "render/OpenGLRenderer.hpp"
+
+/**
+ * @brief Draw parameters worked out once per geometry
+ *
+ * Deriving the DrawParameters of a subgeometry means reading its material,
+ * checking the texture for transparency and looking for the vehicle colour
+ * keys. None of that changes while the geometry lives, so the result is
+ * kept and shared by every object drawing the geometry. A model or LOD
+ * change simply selects another geometry. What does depend on the object
+ * (vehicle colours, depth writes of instances) is patched in when drawing,
+ * along with the transform and depth.
+ *
+ * Entries are keyed by address and also remember their geometry, so one
+ * allocated where a destroyed geometry used to be isn't mistaken for it.
+ */
+class DrawPacketCache {
+public:
+    struct Packet {
+        enum ColourKey : std::uint8_t { NoKey, PrimaryKey, SecondaryKey };
+
+        Renderer::DrawParameters parameters;
+        /// Vehicles replace the material colour with one of theirs
+        ColourKey colourKey = NoKey;
+        /// Transparent regardless of the material colour
+        bool textureTransparent = false;
+    };
+    using Packets = std::vector<Packet>;
+
+    /// Returns a packet for each subgeometry, deriving them the first time
+    const Packets& get(const GeometryPtr& geometry);
+
+    std::size_t size() const {
+        return entries.size();
+    }
+
+    /// Drops the packets of geometry that no longer exists
+    void prune();
+
+    static void derive(const Geometry& geometry, Packets& packets);
+
+private:
+    struct Entry {
+        std::weak_ptr<Geometry> owner;
+        Packets packets;
+    };
+
+    std::unordered_map<const Geometry*, Entry> entries;
+    std::size_t pruneSize = 1024;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <glm/gtc/constants.hpp>
@@ -11,6 +12,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include <data/Clump.hpp>
 #include <gl/TextureData.hpp>
 #include <rw/types.hpp>
 
@@ -21,29 +23,23 @@
 #include "engine/GameWorld.hpp"
 #include "loaders/WeatherLoader.hpp"
 #include "objects/GameObject.hpp"
+#include "objects/InstanceObject.hpp"
 #include "render/ObjectRenderer.hpp"
 #include "render/GameShaders.hpp"
 #include "render/VisualFX.hpp"
 
 constexpr size_t skydomeSegments = 8, skydomeRows = 10;
 
-/// @todo collapse all of these into "VertPNC" etc.
-struct ParticleVert {
-    static const AttributeList vertex_attributes() {
-        return {{ATRS_Position, 2, sizeof(ParticleVert), 0ul},
-                {ATRS_TexCoord, 2, sizeof(ParticleVert), 2ul * sizeof(float)},
-                {ATRS_Colour, 3, sizeof(ParticleVert), 4ul * sizeof(float)}};
-    }
-
-    float x, y;
-    float u, v;
-    float r, g, b;
-};
-
 GameRenderer::GameRenderer(Logger* log, GameData* _data)
+    : GameRenderer(log, _data, std::make_unique<OpenGLRenderer>()) {
+}
+
+GameRenderer::GameRenderer(Logger* log, GameData* _data,
+                           std::unique_ptr<Renderer> _renderer)
     : data(_data)
     , logger(log)
-    , map(*renderer, _data)
+    , renderer(std::move(_renderer))
+    , map(*renderer, sprites, _data)
     , water(*this)
     , text(*this) {
     logger->info("Renderer", renderer->getIDString());
@@ -56,23 +52,31 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
     renderer->setProgramBlockBinding(worldProg.get(), "SceneData", 1);
     renderer->setProgramBlockBinding(worldProg.get(), "ObjectData", 2);
 
-    particleProg =
-        renderer->createShader(GameShaders::WorldObject::VertexShader,
-                               GameShaders::Particle::FragmentShader);
-
-    renderer->setUniformTexture(particleProg.get(), "texture", 0);
-    renderer->setProgramBlockBinding(particleProg.get(), "SceneData", 1);
-    renderer->setProgramBlockBinding(particleProg.get(), "ObjectData", 2);
-
     skyProg = renderer->createShader(GameShaders::Sky::VertexShader,
                                      GameShaders::Sky::FragmentShader);
 
     renderer->setProgramBlockBinding(skyProg.get(), "SceneData", 1);
+    skyTopColour = Renderer::getUniform<glm::vec4>(skyProg.get(), "TopColor");
+    skyBottomColour =
+        Renderer::getUniform<glm::vec4>(skyProg.get(), "BottomColor");
 
     postProg =
         renderer->createShader(GameShaders::DefaultPostProcess::VertexShader,
                                GameShaders::DefaultPostProcess::FragmentShader);
 
+    ssRectProg =
+        renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
+                               GameShaders::ScreenSpaceRect::FragmentShader);
+    renderer->setUniformTexture(ssRectProg.get(), "tex", 0);
+    ssRectColour = Renderer::getUniform<glm::vec4>(ssRectProg.get(), "colour");
+    ssRectSize = Renderer::getUniform<glm::vec2>(ssRectProg.get(), "size");
+    ssRectOffset = Renderer::getUniform<glm::vec2>(ssRectProg.get(), "offset");
+
+    // Without a context only the draws themselves are issued
+    if (!renderer->hasContext()) {
+        return;
+    }
+
     glGenVertexArrays(1, &vao);
 
     glGenFramebuffers(1, &framebufferName);
@@ -147,29 +151,22 @@ GameRenderer::GameRenderer(Logger* log, GameData* _data)
 
     glBindVertexArray(0);
 
-    particleGeom.uploadVertices<ParticleVert>(
-        {{0.5f, 0.5f, 1.f, 1.f, 1.f, 1.f, 1.f},
-         {-0.5f, 0.5f, 0.f, 1.f, 1.f, 1.f, 1.f},
-         {0.5f, -0.5f, 1.f, 0.f, 1.f, 1.f, 1.f},
-         {-0.5f, -0.5f, 0.f, 0.f, 1.f, 1.f, 1.f}});
-    particleDraw.addGeometry(&particleGeom);
-    particleDraw.setFaceType(GL_TRIANGLE_STRIP);
-
     ssRectGeom.uploadVertices<VertexP2>({{-1.f, -1.f}, {1.f, -1.f}, {-1.f, 1.f}, {1.f, 1.f}});
     ssRectDraw.addGeometry(&ssRectGeom);
     ssRectDraw.setFaceType(GL_TRIANGLE_STRIP);
-
-    ssRectProg =
-        renderer->createShader(GameShaders::ScreenSpaceRect::VertexShader,
-                               GameShaders::ScreenSpaceRect::FragmentShader);
-    renderer->setUniform(ssRectProg.get(), "texture", 0);
 }
 
 GameRenderer::~GameRenderer() {
-    glDeleteFramebuffers(1, &framebufferName);
+    if (framebufferName != 0) {
+        glDeleteFramebuffers(1, &framebufferName);
+    }
 }
 
 void GameRenderer::setupRender() {
+    if (!renderer->hasContext()) {
+        return;
+    }
+
     // Set the viewport
     const glm::ivec2& vp = getRenderer().getViewport();
     glViewport(0, 0, vp.x, vp.y);
@@ -189,7 +186,10 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
     setupRender();
 
-    glBindVertexArray(vao);
+    const bool hasContext = renderer->hasContext();
+    if (hasContext) {
+        glBindVertexArray(vao);
+    }
 
     float tod = world->getHour() + world->getMinute() / 60.f;
 
@@ -234,10 +234,12 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     }
 
     culled = 0;
+    occluded = 0;
 
     renderer->pushDebugGroup("Water");
 
-    water.render(*this, world);
+    water.render(*this, world,
+                 (cullOverride ? cullingCamera : _camera).frustum);
 
     profWater = renderer->popDebugGroup();
 
@@ -245,16 +247,17 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
 
     renderer->pushDebugGroup("Sky");
 
-    glBindVertexArray(vao);
+    if (hasContext) {
+        glBindVertexArray(vao);
+    }
 
     Renderer::DrawParameters dp;
     dp.start = 0;
     dp.count = skydomeSegments * skydomeRows * 6;
 
     renderer->useProgram(skyProg.get());
-    renderer->setUniform(skyProg.get(), "TopColor",
-                         glm::vec4{weather.skyTopColor, 1.f});
-    renderer->setUniform(skyProg.get(), "BottomColor",
+    renderer->setUniform(skyTopColour, glm::vec4{weather.skyTopColor, 1.f});
+    renderer->setUniform(skyBottomColour,
                          glm::vec4{weather.skyBottomColor, 1.f});
 
     renderer->draw(glm::mat4(1.0f), &skyDbuff, dp);
@@ -265,7 +268,9 @@ void GameRenderer::renderWorld(GameWorld* world, const ViewCamera& camera,
     renderEffects(world);
     profEffects = renderer->popDebugGroup();
 
-    glDisable(GL_DEPTH_TEST);
+    if (hasContext) {
+        glDisable(GL_DEPTH_TEST);
+    }
 
     GLuint splashTexName = 0;
     const auto fc = world->state->fadeColour;
@@ -298,6 +303,7 @@ void GameRenderer::renderObjects(const GameWorld *world) {
 
     renderer->useProgram(worldProg.get());
     RenderList renderList = createObjectRenderList(world);
+    RW_TELEMETRY_COUNT(ObjectsCulled, culled);
 
     renderer->pushDebugGroup("Objects");
     renderer->pushDebugGroup("RenderList");
@@ -307,21 +313,129 @@ void GameRenderer::renderObjects(const GameWorld *world) {
     profObjects = renderer->popDebugGroup();
 }
 
+void GameRenderer::cullOccludedInstances(const ViewCamera &camera) {
+    RW_PROFILE_SCOPE(__func__);
+    // Only buildings close enough to hide much are drawn as occluders
+    constexpr float kOccluderDistance = 300.f;
+    constexpr float kMinOccluderRadius = 20.f;
+    constexpr std::size_t kMaxOccluders = 64;
+    constexpr auto kSeeThrough = SimpleModelInfo::DRAW_LAST |
+                                 SimpleModelInfo::ADDITIVE |
+                                 SimpleModelInfo::NO_ZBUFFER_WRITE;
+
+    struct Occluder {
+        float distance;
+        Geometry *geometry;
+        InstanceObject *instance;
+    };
+    std::vector<Occluder> occluders;
+    for (auto i : visibleInstances) {
+        auto instance = staticBounds.getInstance(i);
+        auto modelinfo = instance->getModelInfo<SimpleModelInfo>();
+        if (!instance->getAtomic() || !instance->isVisible() ||
+            (modelinfo->flags & kSeeThrough) != 0) {
+            continue;
+        }
+        // Big buildings are large by definition, up close the detailed
+        // buildings that replace them are drawn if they are large enough
+        if (!modelinfo->isBigBuilding() &&
+            (!staticBounds.hasBounds(i) ||
+             staticBounds.getBounds(i).radius < kMinOccluderRadius)) {
+            continue;
+        }
+        const auto distance =
+            glm::distance(instance->getPosition(), camera.position);
+        if (distance >= kOccluderDistance) {
+            continue;
+        }
+        // Only what ObjectRenderer::renderInstance draws may hide anything,
+        // a LOD replaced by its detailed model needn't fill the same space
+        const auto lodDistance = distance / ObjectRenderer::kDrawDistanceFactor;
+        if (lodDistance > modelinfo->getLargestLodDistance() ||
+            ObjectRenderer::isReplacedByDetail(*modelinfo, lodDistance)) {
+            continue;
+        }
+        // The same atomic ObjectRenderer::renderInstance picks
+        auto atomic = modelinfo->getDistanceAtomic(
+            lodDistance / ObjectRenderer::kDrawDistanceFactor);
+        if (!atomic) {
+            continue;
+        }
+        const auto &geometry = atomic->getGeometry();
+        if (!geometry || geometry->positions.empty()) {
+            continue;
+        }
+        occluders.push_back({distance, geometry.get(), instance});
+    }
+    if (occluders.empty()) {
+        return;
+    }
+
+    const auto count = std::min(occluders.size(), kMaxOccluders);
+    std::partial_sort(occluders.begin(), occluders.begin() + count,
+                      occluders.end(), [](const auto &a, const auto &b) {
+                          return a.distance < b.distance;
+                      });
+
+    occlusion.begin(camera.frustum.projection() * camera.getView());
+    for (std::size_t o = 0; o < count; ++o) {
+        const auto &frame = occluders[o].instance->getAtomic()->getFrame();
+        occlusion.drawOccluder(*occluders[o].geometry,
+                               frame->getWorldTransform());
+    }
+    occlusion.finish();
+
+    const auto hidden = [&](std::uint32_t i) {
+        if (!staticBounds.hasBounds(i)) {
+            return false;
+        }
+        const auto &bounds = staticBounds.getBounds(i);
+        return occlusion.isOccluded(bounds.center, bounds.radius);
+    };
+    const auto end = std::remove_if(visibleInstances.begin(),
+                                    visibleInstances.end(), hidden);
+    occluded += static_cast<size_t>(visibleInstances.end() - end);
+    visibleInstances.erase(end, visibleInstances.end());
+}
+
 RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
     RW_PROFILE_SCOPE(__func__);
+    FrameTimings::Scope timing(frameTimings, FrameTimings::RenderList);
     // This is sequential at the moment, it should be easy to make it
     // run in parallel with a good threading system.
     RenderList renderList;
     // Naive optimisation, assume 50% hitrate
     renderList.reserve(static_cast<size_t>(world->allObjects.size() * 0.5f));
 
-    ObjectRenderer objectRenderer(_renderWorld,
-                                  (cullOverride ? cullingCamera : _camera),
-                                  _renderAlpha);
+    const auto& camera = cullOverride ? cullingCamera : _camera;
+    ObjectRenderer objectRenderer(_renderWorld, camera, _renderAlpha,
+                                  &drawPackets);
+
+    // Static instances are culled a subtree at a time first, the survivors
+    // still go through the per instance and per atomic checks
+    staticBounds.update(world->instanceIndex);
+    visibleInstances.clear();
+    objectRenderer.culled += staticBounds.cull(
+        camera, _renderWorld->getHour(), visibleInstances);
+    if (occlusionCulling) {
+        cullOccludedInstances(camera);
+        objectRenderer.culled += occluded;
+    }
+    for (auto i : visibleInstances) {
+        objectRenderer.buildRenderList(staticBounds.getInstance(i),
+                                       renderList);
+    }
+    for (auto instance : world->instanceIndex.getMovable()) {
+        objectRenderer.buildRenderList(instance, renderList);
+    }
 
-    // World Objects
-    for (auto object : world->allObjects) {
-        objectRenderer.buildRenderList(object, renderList);
+    // Everything else
+    for (const auto* pool :
+         {&world->pedestrianPool, &world->vehiclePool, &world->pickupPool,
+          &world->cutscenePool, &world->projectilePool}) {
+        for (const auto& p : pool->objects) {
+            objectRenderer.buildRenderList(p.second.get(), renderList);
+        }
     }
 
     // Area indicators
@@ -369,19 +483,22 @@ RenderList GameRenderer::createObjectRenderList(const GameWorld *world) {
     }
     culled += objectRenderer.culled;
 
-    RW_PROFILE_SCOPE("sortRenderList");
-    // Also parallelizable
-    // Earlier position in the array means earlier object's rendering
-    // Transparent objects should be sorted and rendered after opaque
-    sort(renderList.begin(), renderList.end(),
-         [](const Renderer::RenderInstruction &a,
-            const Renderer::RenderInstruction &b) {
-             if (a.drawInfo.blendMode == BlendMode::BLEND_NONE && b.drawInfo.blendMode != BlendMode::BLEND_NONE)
-                 return true;
-             if (a.drawInfo.blendMode != BlendMode::BLEND_NONE && b.drawInfo.blendMode == BlendMode::BLEND_NONE)
-                 return false;
-             return (a.sortKey > b.sortKey);
-         });
+    {
+        RW_PROFILE_SCOPE("sortRenderList");
+        FrameTimings::Scope sortTiming(frameTimings, FrameTimings::Sort);
+        // Also parallelizable
+        // Earlier position in the array means earlier object's rendering
+        // Transparent objects should be sorted and rendered after opaque
+        sort(renderList.begin(), renderList.end(),
+             [](const Renderer::RenderInstruction &a,
+                const Renderer::RenderInstruction &b) {
+                 if (a.drawInfo.blendMode == BlendMode::BLEND_NONE && b.drawInfo.blendMode != BlendMode::BLEND_NONE)
+                     return true;
+                 if (a.drawInfo.blendMode != BlendMode::BLEND_NONE && b.drawInfo.blendMode == BlendMode::BLEND_NONE)
+                     return false;
+                 return (a.sortKey > b.sortKey);
+             });
+    }
 
     return renderList;
 }
@@ -406,9 +523,9 @@ void GameRenderer::renderSplash(GameWorld* world, GLuint splashTexName, glm::u16
     glm::vec4 fadeNormed(fc.r / 255.f, fc.g / 255.f, fc.b / 255.f, a);
 
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", fadeNormed);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 0.f});
+    renderer->setUniform(ssRectColour, fadeNormed);
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, 1.f});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 0.f});
 
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
@@ -420,10 +537,15 @@ void GameRenderer::renderSplash(GameWorld* world, GLuint splashTexName, glm::u16
 }
 
 void GameRenderer::renderPostProcess() {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glStencilMask(0xFF);
-    glClearStencil(0x00);
-    glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    // Any 2D drawing queued so far belongs to the framebuffer being resolved
+    sprites.flush();
+
+    if (renderer->hasContext()) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glStencilMask(0xFF);
+        glClearStencil(0x00);
+        glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    }
 
     renderer->useProgram(postProg.get());
 
@@ -437,60 +559,16 @@ void GameRenderer::renderPostProcess() {
 }
 
 void GameRenderer::renderEffects(GameWorld* world) {
-    renderer->useProgram(particleProg.get());
-
-    auto cpos = _camera.position;
     auto cfwd = glm::normalize(glm::inverse(_camera.rotation) *
                                glm::vec3(0.f, 1.f, 0.f));
 
-    auto& effects = world->effects;
-
-    std::sort(effects.begin(), effects.end(),
-              [&](const auto& a, const auto& b) {
-                  return glm::distance(a->position, cpos) >
-                         glm::distance(b->position, cpos);
-              });
-
-    for (auto& fx : effects) {
+    for (auto& fx : world->effects) {
         // Other effects not implemented yet
         if (fx->getType() != Particle) continue;
-        auto particle = static_cast<ParticleFX*>(fx.get());
-
-        auto& p = particle->position;
-
-        // Figure the direction to the camera center.
-        auto amp = cpos - p;
-        glm::vec3 ptc = particle->up;
-
-        if (particle->orientation == ParticleFX::UpCamera) {
-            ptc = glm::normalize(amp - (glm::dot(amp, cfwd)) * cfwd);
-        } else if (particle->orientation == ParticleFX::Camera) {
-            ptc = amp;
-        }
-
-        ptc = glm::normalize(ptc);
-
-        glm::mat4 transformMat(1.f);
-
-        glm::mat4 lookMat = glm::lookAt(
-            glm::vec3(0.0f,0.0f,0.0f),
-            ptc,
-            glm::vec3(0.0f,0.0f,1.0f));
-
-        transformMat = glm::scale(glm::translate(transformMat,p),
-            glm::vec3(particle->size,1.0f)) * glm::inverse(lookMat);
-
-        Renderer::DrawParameters dp;
-        dp.textures = {{particle->texture->getName()}};
-        dp.ambient = 1.f;
-        dp.colour = glm::u8vec4(particle->colour * 255.f);
-        dp.start = 0;
-        dp.count = 4;
-        dp.blendMode = BlendMode::BLEND_ADDITIVE;
-        dp.diffuse = 1.f;
-
-        renderer->drawArrays(transformMat, &particleDraw, dp);
+        particles.add(static_cast<const ParticleFX&>(*fx));
     }
+
+    particles.draw(_camera.position, cfwd);
 }
 
 void GameRenderer::drawTexture(TextureData* texture, glm::vec4 extents) {
@@ -501,46 +579,20 @@ void GameRenderer::drawColour(const glm::vec4& colour, glm::vec4 extents) {
     drawRect(colour, nullptr, extents);
 }
 
-void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture, glm::vec4& extents) {
+void GameRenderer::drawRect(const glm::vec4& colour, TextureData* texture,
+                            const glm::vec4& extents) {
     // Extents arrive in the same logical (window-point) space as the 2D
-    // projection (see setLogicalSize). Normalise by the logical size so the
-    // result lands in NDC consistently with HUD/menu/text drawn through
-    // projection2D. rwviewer never calls setLogicalSize, so fall back to the
-    // physical viewport there (its callers pass physical coords).
-    const glm::ivec2 ref = (logicalSize.x > 0 && logicalSize.y > 0)
-                               ? logicalSize
-                               : renderer->getViewport();
-    // Move into NDC
-    extents.x /= ref.x;
-    extents.y /= ref.y;
-    extents.z /= ref.x;
-    extents.w /= ref.y;
-    extents.x += extents.z / 2.f;
-    extents.y += extents.w / 2.f;
-    extents.x -= .5f;
-    extents.y -= .5f;
-    extents *= glm::vec4(2.f, -2.f, 1.f, 1.f);
-
-    renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", colour);
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{extents.z, extents.w});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{extents.x, extents.y});
-
-    Renderer::DrawParameters wdp;
-    wdp.depthMode = DepthMode::OFF;
-    wdp.blendMode = BlendMode::BLEND_ALPHA;
-    wdp.count = ssRectGeom.getCount();
-    wdp.textures = {{texture ? texture->getName() : 0}};
-
-    renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
+    // projection (see setLogicalSize), which the sprite batch draws with.
+    sprites.addRect(texture ? texture->getName() : 0, extents,
+                    {0.f, 0.f, 1.f, 1.f}, colour);
 }
 
 void GameRenderer::renderLetterbox() {
     constexpr float cinematicExperienceSize = 0.15f;
     renderer->useProgram(ssRectProg.get());
-    renderer->setUniform(ssRectProg.get(), "colour", glm::vec4{0.f, 0.f, 0.f, 1.f});
-    renderer->setUniform(ssRectProg.get(), "size", glm::vec2{1.f, cinematicExperienceSize});
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectColour, glm::vec4{0.f, 0.f, 0.f, 1.f});
+    renderer->setUniform(ssRectSize, glm::vec2{1.f, cinematicExperienceSize});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f,-1.f * (1.f - cinematicExperienceSize)});
     Renderer::DrawParameters wdp;
     wdp.depthMode = DepthMode::OFF;
     wdp.blendMode = BlendMode::BLEND_NONE;
@@ -548,7 +600,7 @@ void GameRenderer::renderLetterbox() {
     wdp.textures = {{0}};
 
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
-    renderer->setUniform(ssRectProg.get(), "offset", glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
+    renderer->setUniform(ssRectOffset, glm::vec2{0.f, 1.f * (1.f - cinematicExperienceSize)});
     renderer->drawArrays(glm::mat4(1.0f), &ssRectDraw, wdp);
 }
 
@@ -556,6 +608,9 @@ void GameRenderer::setViewport(int w, int h) {
     auto& lastViewport = renderer->getViewport();
     if (lastViewport.x != w || lastViewport.y != h) {
         renderer->setViewport({w, h});
+        if (!renderer->hasContext()) {
+            return;
+        }
 
         glBindTexture(GL_TEXTURE_2D, fbTextures[0]);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB,
@@ -2,15 +2,24 @@
 #define _RWENGINE_GAMERENDERER_HPP_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
 
 #include <rw/forward.hpp>
 
+#include <core/FrameTimings.hpp>
+
+#include <render/DrawPacketCache.hpp>
 #include <render/OpenGLRenderer.hpp>
 #include <render/MapRenderer.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/ParticleBatch.hpp>
+#include <render/SpriteBatch.hpp>
+#include <render/StaticInstanceBounds.hpp>
 #include <render/TextRenderer.hpp>
 #include <render/ViewCamera.hpp>
 #include <render/WaterRenderer.hpp>
@@ -18,6 +27,7 @@
 class Logger;
 class GameData;
 class GameWorld;
+class InstanceObject;
 class TextureData;
 
 /**
@@ -34,14 +44,17 @@ class GameRenderer {
     Logger* logger;
 
     /** The low-level drawing interface to use */
-    std::unique_ptr<Renderer> renderer = std::make_unique<OpenGLRenderer>();
+    std::unique_ptr<Renderer> renderer;
+
+    /** Queued 2D quads for the HUD, text and map blips */
+    SpriteBatch sprites{*renderer};
 
     // Temporary variables used during rendering
     float _renderAlpha{0.f};
     GameWorld* _renderWorld = nullptr;
 
     /** Internal non-descript VAOs */
-    GLuint vao;
+    GLuint vao = 0;
 
     /** Camera values passed to renderWorld() */
     ViewCamera _camera;
@@ -51,28 +64,54 @@ class GameRenderer {
     /** Number of culling events */
     size_t culled;
 
-    GLuint framebufferName;
-    GLuint fbTextures[2];
-    GLuint fbRenderBuffers[1];
+    /** Draw parameters of the geometry drawn by the ObjectRenderer */
+    DrawPacketCache drawPackets;
+
+    /** Culls the static instances before building the render list */
+    StaticInstanceBounds staticBounds;
+    std::vector<std::uint32_t> visibleInstances;
+
+    /** Big buildings hide the static instances behind them */
+    OcclusionBuffer occlusion;
+    bool occlusionCulling = true;
+    /** Number of instances hidden by occluders, included in culled */
+    size_t occluded = 0;
+
+    GLuint framebufferName = 0;
+    GLuint fbTextures[2]{};
+    GLuint fbRenderBuffers[1]{};
     std::unique_ptr<Renderer::ShaderProgram> postProg;
 
-    GeometryBuffer particleGeom;
-    DrawBuffer particleDraw;
+    /** Effects drawn by renderEffects */
+    ParticleBatch particles{*renderer};
 
     GeometryBuffer ssRectGeom;
     DrawBuffer ssRectDraw;
 
 public:
     GameRenderer(Logger* log, GameData* data);
+
+    /**
+     * Draws through the given renderer. GPU resources are only created when
+     * it has a context, so a NullRenderer can be used to run the culling,
+     * sorting and batching paths without one.
+     */
+    GameRenderer(Logger* log, GameData* data,
+                 std::unique_ptr<Renderer> renderer);
     ~GameRenderer();
 
     std::unique_ptr<Renderer::ShaderProgram> worldProg;
     std::unique_ptr<Renderer::ShaderProgram> skyProg;
-    std::unique_ptr<Renderer::ShaderProgram> particleProg;
 
     std::unique_ptr<Renderer::ShaderProgram> ssRectProg;
 
-    GLuint skydomeIBO;
+    Renderer::Uniform<glm::vec4> skyTopColour;
+    Renderer::Uniform<glm::vec4> skyBottomColour;
+    Renderer::Uniform<glm::vec4> ssRectColour;
+    Renderer::Uniform<glm::vec2> ssRectSize;
+    Renderer::Uniform<glm::vec2> ssRectOffset;
+
+    GLuint skydomeIBO = 0;
 
     DrawBuffer skyDbuff;
     GeometryBuffer skyGbuff;
@@ -85,6 +124,14 @@ public:
         return culled;
     }
 
+    size_t getOccludedCount() const {
+        return occluded;
+    }
+
+    void setOcclusionCulling(bool enabled) {
+        occlusionCulling = enabled;
+    }
+
     /**
      * Renders the world using the parameters of the passed Camera.
      * Note: The camera's near and far planes are overriden by weather effects.
@@ -103,10 +150,21 @@ public:
 
     /**
      * @brief Draws a texture on the screen
+     *
+     * 2D drawing is queued on the sprite batch and drawn by flush2D().
      */
     void drawTexture(TextureData* texture, glm::vec4 extents);
     void drawColour(const glm::vec4& colour, glm::vec4 extents);
 
+    SpriteBatch& getSpriteBatch() {
+        return sprites;
+    }
+
+    /** Draws all queued 2D quads, call once the 2D layer is complete */
+    void flush2D() {
+        sprites.flush();
+    }
+
     /** Render full screen splash / fade */
     void renderSplash(GameWorld* world, GLuint tex, glm::u16vec3 fc);
 
@@ -142,6 +200,9 @@ public:
     WaterRenderer water;
     TextRenderer text;
 
+    /// CPU timings for render list building and sorting, may be null
+    FrameTimings* frameTimings = nullptr;
+
     // Profiling data
     Renderer::ProfileInfo profObjects;
     Renderer::ProfileInfo profSky;
@@ -171,12 +232,16 @@ private:
         return specialmodels_[usage];
     }
 
-    void drawRect(const glm::vec4& colour, TextureData* texture, glm::vec4& extents);
+    void drawRect(const glm::vec4& colour, TextureData* texture,
+                  const glm::vec4& extents);
 
     void renderObjects(const GameWorld *world);
 
     RenderList createObjectRenderList(const GameWorld *world);
 
+    /// Removes the visible static instances hidden behind big buildings
+    void cullOccludedInstances(const ViewCamera& camera);
+
     /// Logical (window-point) 2D size; see setLogicalSize.
     glm::ivec2 logicalSize{};
 };
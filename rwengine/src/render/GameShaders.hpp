@@ -1,6 +1,8 @@
 #ifndef _RWENGINE_GAMESHADERS_HPP_
 #define _RWENGINE_GAMESHADERS_HPP_
 
+#include "engine/WaterWaves.hpp"
+
 /**
  * @brief collection of shaders to make managing them a little easier.
  */
@@ -33,7 +35,7 @@ struct WaterHQ {
             uniform float time;
             uniform vec2 waveParams;
             uniform sampler2D data;
-
+)" RW_WATER_WAVE_GLSL R"(
             vec3 waterNormal = vec3(0.0, 0.0, 1.0);
 
             vec3 planeIntercept( vec3 start, vec3 dir, float height ) {
@@ -60,7 +62,10 @@ struct WaterHQ {
 
                 vec3 ws = planeIntercept( campos.xyz, ray, plane );
 
-                ws.z = ws.z + (-1.0+(sin(time + (ws.x + ws.y) * waveParams.x)) * waveParams.y);
+                // The data holds the mask height, WATER_HEIGHT above the
+                // still water
+                ws.z = ws.z - waveParams.y +
+                       waveHeight(ws.xy, time, waveParams);
                 TexCoords = ws.xy / 5.0;
                 gl_Position = vp * vec4(ws, 1.0);
             })";
@@ -242,17 +247,24 @@ struct WorldObject {
             })";
 };
 
-/** @brief Particle effect shaders, uses WorldObject::VertexShader */
+/**
+ * @brief Instanced particle shaders, see ParticleBatch
+ *
+ * Each instance is a unit quad turned to face the camera according to its
+ * orientation and scaled along its own axes.
+ */
 struct Particle {
-    static constexpr char const* FragmentShader =
+    static constexpr char const* VertexShader =
         R"(
             #version 330
 
-            in vec3 Normal;
-            in vec2 TexCoords;
-            in vec4 Colour;
-            uniform sampler2D tex;
-            out vec4 outColour;
+            layout(location = 0) in vec2 position;
+            layout(location = 2) in vec4 colour;
+            layout(location = 4) in vec4 instancePosition;
+            layout(location = 5) in vec3 instanceUp;
+            layout(location = 6) in vec2 instanceSize;
+            out vec2 TexCoords;
+            out vec4 Colour;
 
             layout(std140) uniform SceneData {
                 mat4 projection;
@@ -265,13 +277,46 @@ struct Particle {
                 float fogEnd;
             };
 
-            layout(std140) uniform ObjectData {
-                mat4 model;
-                vec4 colour;
-                float diffusefac;
-                float ambientfac;
-                float visibility;
-            };
+            uniform vec3 cameraForward;
+
+            // Matches ParticleFX::Orientation
+            #define ORIENTATION_CAMERA 1
+            #define ORIENTATION_UP_CAMERA 2
+
+            void main() {
+                vec3 centre = instancePosition.xyz;
+                int orientation = int(instancePosition.w + 0.5);
+
+                vec3 toCamera = campos.xyz - centre;
+                vec3 facing = instanceUp;
+                if (orientation == ORIENTATION_CAMERA) {
+                    facing = toCamera;
+                } else if (orientation == ORIENTATION_UP_CAMERA) {
+                    facing = toCamera - dot(toCamera, cameraForward) * cameraForward;
+                }
+                facing = normalize(facing);
+
+                // The basis of lookAt(0, facing, +Z), falling back to +X
+                // when looking straight up or down
+                vec3 right = cross(facing, vec3(0.0, 0.0, 1.0));
+                right = dot(right, right) > 1e-6 ? normalize(right) : vec3(1.0, 0.0, 0.0);
+                vec3 up = cross(right, facing);
+
+                vec2 corner = position * instanceSize;
+                vec3 worldspace = centre + right * corner.x + up * corner.y;
+
+                TexCoords = position + vec2(0.5);
+                Colour = colour;
+                gl_Position = projection * view * vec4(worldspace, 1.0);
+            })";
+    static constexpr char const* FragmentShader =
+        R"(
+            #version 330
+
+            in vec2 TexCoords;
+            in vec4 Colour;
+            uniform sampler2D tex;
+            out vec4 outColour;
 
             #define ALPHA_DISCARD_THRESHOLD 0.01
 
@@ -279,10 +324,7 @@ struct Particle {
                 vec4 c = texture(tex, TexCoords);
                 c.a = clamp(0, length(c.rgb/length(vec3(1,1,1))), 1);
                 if(c.a <= ALPHA_DISCARD_THRESHOLD) discard;
-                float fogZ = (gl_FragCoord.z / gl_FragCoord.w);
-                float fogfac = clamp( (fogStart-fogZ)/(fogEnd-fogStart), 0.0, 1.0 );
-                vec4 tint = vec4(colour.rgb, visibility);
-                outColour = c * tint;
+                outColour = c * vec4(Colour.rgb, 1.0);
             })";
 };
 
@@ -1,5 +1,6 @@
 #include "render/MapRenderer.hpp"
 
+#include <array>
 #include <cstdint>
 #include <cmath>
 #include <vector>
@@ -11,10 +12,12 @@
 #include <gl/gl_core_3_3.h>
 #include <gl/TextureData.hpp>
 
+#include "core/Profiler.hpp"
 #include "engine/GameData.hpp"
 #include "engine/GameState.hpp"
 #include "engine/GameWorld.hpp"
 #include "objects/GameObject.hpp"
+#include "render/SpriteBatch.hpp"
 
 namespace {
 constexpr char const* MapVertexShader = R"(
@@ -38,21 +41,51 @@ constexpr char const* MapFragmentShader = R"(
 
 in vec2 TexCoord;
 uniform vec4 colour;
+uniform float texScale;
 uniform sampler2D spriteTexture;
 out vec4 outColour;
 
 void main() {
-    vec4 c = texture(spriteTexture, TexCoord*0.99);
+    vec4 c = texture(spriteTexture, TexCoord*texScale);
     outColour = vec4(colour.rgb + c.rgb, colour.a * c.a);
 })";
+
+constexpr float kSpriteTexScale = 0.99f;
+constexpr int kRadarTilesPerLine = 8;
 }  // namespace
 
-MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
-    : data(_data), renderer(renderer) {
+MapRenderer::MapRenderer(Renderer &renderer, SpriteBatch& sprites,
+                         GameData* _data)
+    : data(_data), renderer(renderer), sprites(sprites) {
+    if (data) {
+        for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+            std::string num = (m < 10 ? "0" : "");
+            std::string name = "radar" + num + std::to_string(m);
+            radarTiles[m].slot = data->textureSlots.internSlot(name);
+            radarTiles[m].texture = data->textureSlots.internTexture(name);
+        }
+    }
+
+    rectProg = renderer.createShader(MapVertexShader, MapFragmentShader);
+    projUniform = Renderer::getUniform<glm::mat4>(rectProg.get(), "proj");
+    viewUniform = Renderer::getUniform<glm::mat4>(rectProg.get(), "view");
+    modelUniform = Renderer::getUniform<glm::mat4>(rectProg.get(), "model");
+    colourUniform = Renderer::getUniform<glm::vec4>(rectProg.get(), "colour");
+    texScaleUniform = Renderer::getUniform<float>(rectProg.get(), "texScale");
+
+    renderer.setUniform(colourUniform, glm::vec4(1.f));
+    // Keeps sprites from sampling the opposite edge
+    renderer.setUniform(texScaleUniform, kSpriteTexScale);
+
+    rect.setFaceType(GL_TRIANGLE_FAN);
+    circle.setFaceType(GL_TRIANGLE_FAN);
+    if (!renderer.hasContext()) {
+        return;
+    }
+
     rectGeom.uploadVertices<VertexP2>(
         {{-.5f, -.5f}, {.5f, -.5f}, {.5f, .5f}, {-.5f, .5f}});
     rect.addGeometry(&rectGeom);
-    rect.setFaceType(GL_TRIANGLE_FAN);
 
     std::vector<VertexP2> circleVerts;
     circleVerts.emplace_back(0.f, 0.f);
@@ -63,104 +96,193 @@ MapRenderer::MapRenderer(Renderer &renderer, GameData* _data)
     }
     circleGeom.uploadVertices(circleVerts);
     circle.addGeometry(&circleGeom);
-    circle.setFaceType(GL_TRIANGLE_FAN);
+}
 
-    rectProg = renderer.createShader(MapVertexShader, MapFragmentShader);
+MapRenderer::~MapRenderer() = default;
+
+#define GAME_MAP_SIZE 4000
 
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(1.f));
+void MapRenderer::bakeRadarAtlas(GameWorld* world) {
+    std::array<TextureData*, MAP_BLOCK_SIZE> tiles{};
+    glm::ivec2 tileSize{0};
+    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+        tiles[m] = world->data->findSlotTexture(radarTiles[m].slot,
+                                                radarTiles[m].texture);
+        if (tiles[m]) {
+            tileSize = glm::max(tileSize, tiles[m]->getSize());
+        }
+    }
+    if (tileSize.x == 0) {
+        // Not loaded yet
+        return;
+    }
+    RW_PROFILE_SCOPE(__func__);
+
+    const auto atlasSize = tileSize * kRadarTilesPerLine;
+    GLuint name = 0;
+    glGenTextures(1, &name);
+    glBindTexture(GL_TEXTURE_2D, name);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasSize.x, atlasSize.y, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                    GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4]{};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, name, 0);
+    glViewport(0, 0, atlasSize.x, atlasSize.y);
+    // The missing 64th tile stays transparent
+    glClearColor(0.f, 0.f, 0.f, 0.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Each tile is copied into its cell as it used to be drawn, the atlas
+    // keeps its alpha for blending when drawn
+    Renderer::DrawParameters dp{};
+    dp.count = 4;
+    dp.blendMode = BlendMode::BLEND_NONE;
+    dp.depthWrite = false;
+    renderer.setUniform(projUniform, glm::mat4(1.0f));
+    renderer.setUniform(viewUniform, glm::mat4(1.0f));
+    renderer.setUniform(colourUniform, glm::vec4(0.f, 0.f, 0.f, 1.f));
+    const float cell = 2.f / kRadarTilesPerLine;
+    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+        if (!tiles[m]) {
+            continue;
+        }
+        const glm::vec2 corner(m % kRadarTilesPerLine,
+                               m / kRadarTilesPerLine);
+        glm::mat4 model{1.0f};
+        model = glm::translate(
+            model, glm::vec3(corner * cell + (cell / 2.f - 1.f), 0.f));
+        model = glm::scale(model, glm::vec3(cell, cell, 1.f));
+        renderer.setUniform(modelUniform, model);
+        dp.textures = {{tiles[m]->getName()}};
+        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, name);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2],
+               previousViewport[3]);
+    glDeleteFramebuffers(1, &framebuffer);
+    renderer.invalidate();
+
+    radarAtlas = TextureData::create(name, atlasSize, true);
+    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+        radarBaked[m] = tiles[m] != nullptr;
+    }
 }
 
-#define GAME_MAP_SIZE 4000
+bool MapRenderer::hasNewRadarTiles(GameWorld* world) const {
+    if (radarBaked.all()) {
+        return false;
+    }
+    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
+        if (!radarBaked[m] &&
+            world->data->findSlotTexture(radarTiles[m].slot,
+                                         radarTiles[m].texture)) {
+            return true;
+        }
+    }
+    return false;
+}
 
 void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
+    // The tiles are drawn directly, so anything queued must go beneath them
+    sprites.flush();
+
     renderer.pushDebugGroup("Map");
     renderer.useProgram(rectProg.get());
 
+    // Stencil and blend state below bypass the renderer
+    const bool hasContext = renderer.hasContext();
+    if (hasContext && (!radarAtlas || hasNewRadarTiles(world))) {
+        bakeRadarAtlas(world);
+    }
+
     Renderer::DrawParameters dp { };
     dp.start = 0;
     dp.blendMode = BlendMode::BLEND_ALPHA;
     dp.depthWrite = false;
 
-    // World out the number of units per tile
     glm::vec2 worldSize(GAME_MAP_SIZE);
-    const int mapBlockLine = 8;
-    glm::vec2 tileSize = worldSize / static_cast<float>(mapBlockLine);
     // Determine the scale to show the right number of world units on the screen
     float worldScale = mi.screenSize / mi.worldSize;
 
     auto proj = renderer.get2DProjection();
-    glm::mat4 view{1.0f}, model{1.0f};
-    renderer.setUniform(rectProg.get(), "proj", proj);
-    renderer.setUniform(rectProg.get(), "model", glm::mat4(1.0f));
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.f, 0.f, 0.f, 1.f));
+    glm::mat4 view{1.0f};
+    renderer.setUniform(projUniform, proj);
+    renderer.setUniform(modelUniform, glm::mat4(1.0f));
+    renderer.setUniform(colourUniform, glm::vec4(0.f, 0.f, 0.f, 1.f));
 
     view = glm::translate(view, glm::vec3(mi.screenPosition, 0.f));
 
     if (mi.clipToSize) {
         glm::mat4 circleView = glm::scale(view, glm::vec3(mi.screenSize));
-        renderer.setUniform(rectProg.get(), "view", circleView);
+        renderer.setUniform(viewUniform, circleView);
         dp.count = 182;
-        glEnable(GL_STENCIL_TEST);
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-        glStencilMask(0xFF);
-        glColorMask(0x00, 0x00, 0x00, 0x00);
+        if (hasContext) {
+            glEnable(GL_STENCIL_TEST);
+            glStencilFunc(GL_ALWAYS, 1, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+            glStencilMask(0xFF);
+            glColorMask(0x00, 0x00, 0x00, 0x00);
+        }
         renderer.drawArrays(glm::mat4(1.0f), &circle, dp);
-        glColorMask(0xFF, 0xFF, 0xFF, 0xFF);
-        glStencilFunc(GL_EQUAL, 1, 0xFF);
+        if (hasContext) {
+            glColorMask(0xFF, 0xFF, 0xFF, 0xFF);
+            glStencilFunc(GL_EQUAL, 1, 0xFF);
+        }
     }
 
     view = glm::scale(view, glm::vec3(worldScale));
     view = glm::rotate(view, mi.rotation, glm::vec3(0.f, 0.f, 1.f));
     view = glm::translate(
         view, glm::vec3(glm::vec2(-1.f, 1.f) * mi.worldCenter, 0.f));
-    renderer.setUniform(rectProg.get(), "view", view);
-
-    // radar00 = -x, +y
-    // incrementing in X, then Y
-
-    int initX = -(mapBlockLine / 2);
-    int initY = -(mapBlockLine / 2);
-
-    for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
-        std::string num = (m < 10 ? "0" : "");
-        std::string name = "radar" + num + std::to_string(m);
-        auto texturePtr = world->data->findSlotTexture(name, name);
-        dp.textures = {{texturePtr->getName()}};
-
-        dp.count = 4;
-
-        int mX = initX + (m % mapBlockLine);
-        int mY = initY + (m / mapBlockLine);
-
-        auto tc = glm::vec2(mX, mY) * tileSize + glm::vec2(tileSize / 2.f);
-
-        glm::mat4 tilemodel = model;
-        tilemodel = glm::translate(tilemodel, glm::vec3(tc, 0.f));
-        tilemodel = glm::scale(tilemodel, glm::vec3(tileSize, 1.f));
+    renderer.setUniform(viewUniform, view);
 
-        renderer.setUniform(rectProg.get(), "model", tilemodel);
-
-        renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
-    }
+    // The whole map is one quad, radar00 at -x, +y
+    dp.textures = {{radarAtlas ? radarAtlas->getName() : 0}};
+    dp.count = 4;
+    renderer.setUniform(modelUniform,
+                        glm::scale(glm::mat4(1.0f), glm::vec3(worldSize, 1.f)));
+    renderer.setUniform(texScaleUniform, 1.f);
+    renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
+    renderer.setUniform(texScaleUniform, kSpriteTexScale);
 
     // From here on out we will work in screenspace
-    renderer.setUniform(rectProg.get(), "view", glm::mat4(1.0f));
+    renderer.setUniform(viewUniform, glm::mat4(1.0f));
 
     if (mi.clipToSize) {
-        glDisable(GL_STENCIL_TEST);
-        // We only need the outer ring if we're clipping.
-        glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
+        if (hasContext) {
+            glDisable(GL_STENCIL_TEST);
+            // We only need the outer ring if we're clipping.
+            glBlendFuncSeparate(GL_DST_COLOR, GL_ZERO, GL_ONE, GL_ZERO);
+        }
         auto radarDiscTexPtr = data->findSlotTexture("hud", "radardisc");
         dp.textures = {{radarDiscTexPtr->getName()}};
 
         glm::mat4 model{1.0f};
         model = glm::translate(model, glm::vec3(mi.screenPosition, 0.0f));
         model = glm::scale(model, glm::vec3(mi.screenSize * 1.07f));
-        renderer.setUniform(rectProg.get(), "model", model);
+        renderer.setUniform(modelUniform, model);
         renderer.drawArrays(glm::mat4(1.0f), &rect, dp);
-        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
-                            GL_ZERO);
+        if (hasContext) {
+            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                                GL_ZERO);
+        }
     }
 
     // Draw the player blip
@@ -241,9 +363,9 @@ void MapRenderer::draw(GameWorld* world, const MapInfo& mi) {
     renderer.popDebugGroup();
 }
 
-void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                              const MapInfo& mi, const std::string& texture,
-                              glm::vec4 colour, float size, float heading) {
+glm::vec2 MapRenderer::blipPosition(const glm::vec2& coord,
+                                    const glm::mat4& view,
+                                    const MapInfo& mi) const {
     glm::vec2 adjustedCoord = coord;
     if (mi.clipToSize) {
         float maxDist = mi.worldSize / 2.f;
@@ -254,40 +376,46 @@ void MapRenderer::prepareBlip(const glm::vec2& coord, const glm::mat4& view,
         }
     }
 
-    glm::vec3 viewPos(
+    return glm::vec2(
         view * glm::vec4(glm::vec2(1.f, -1.f) * adjustedCoord, 0.f, 1.f));
-    glm::mat4 model{1.0f};
-    model = glm::translate(model, viewPos);
-    model = glm::scale(model, glm::vec3(size));
-    model = glm::rotate(model, heading, glm::vec3(0.f, 0.f, 1.f));
-    renderer.setUniform(rectProg.get(), "model", model);
+}
+
+void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
+                           const MapInfo& mi, const std::string& texture,
+                           glm::vec4 colour, float size, float heading) {
+    const glm::vec2 viewPos = blipPosition(coord, view, mi);
+    const float c = glm::cos(heading) * size;
+    const float s = glm::sin(heading) * size;
+    auto corner = [&](float x, float y) {
+        return viewPos + glm::vec2(c * x - s * y, s * x + c * y);
+    };
 
     GLuint tex = 0;
     if (!texture.empty()) {
         auto spriteTexPtr = data->findSlotTexture("hud", texture);
         tex = spriteTexPtr->getName();
     }
-    renderer.setUniform(rectProg.get(), "colour", colour);
-
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-}
 
-void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
-                           const MapInfo& mi, const std::string& texture,
-                           glm::vec4 colour, float size, float heading) {
-    prepareBlip(coord, view, mi, texture, colour, size, heading);
-    glBindVertexArray(rect.getVAOName());
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    sprites.addQuad(tex,
+                    {{corner(-.5f, -.5f), corner(.5f, -.5f), corner(.5f, .5f),
+                      corner(-.5f, .5f)}},
+                    {0.f, 0.f, .99f, .99f}, colour);
 }
 
 void MapRenderer::drawBlip(const glm::vec2& coord, const glm::mat4& view,
                            const MapInfo& mi, glm::vec4 colour, float size) {
     drawBlip(coord, view, mi, "", colour, size);
-    // Draw outline
-    renderer.setUniform(rectProg.get(), "colour", glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+
+    // Draw outline, one unit wide along the inside of the blip's edges
+    const glm::vec2 viewPos = blipPosition(coord, view, mi);
+    const glm::vec4 black(0.f, 0.f, 0.f, 1.f);
+    const glm::vec2 tl = viewPos - glm::vec2(size / 2.f);
+    const glm::vec4 uv(0.f, 0.f, 1.f, 1.f);
+    sprites.addRect(0, {tl.x, tl.y, size, 1.f}, uv, black);
+    sprites.addRect(0, {tl.x, tl.y + size - 1.f, size, 1.f}, uv, black);
+    sprites.addRect(0, {tl.x, tl.y + 1.f, 1.f, size - 2.f}, uv, black);
+    sprites.addRect(0, {tl.x + size - 1.f, tl.y + 1.f, 1.f, size - 2.f}, uv,
+                    black);
 }
 
 void MapRenderer::scaleHUD(const float scale) {
@@ -1,21 +1,30 @@
 #ifndef _RWENGINE_MAPRENDERER_HPP_
 #define _RWENGINE_MAPRENDERER_HPP_
 
+#include <array>
+#include <bitset>
 #include <memory>
 #include <string>
 
 #include <gl/DrawBuffer.hpp>
 #include <gl/GeometryBuffer.hpp>
 
+#include "engine/TextureResidency.hpp"
 #include "render/OpenGLRenderer.hpp"
 
 class GameData;
 class GameWorld;
+class SpriteBatch;
+class TextureData;
 
 #define MAP_BLOCK_SIZE 63
 
 /**
  * Utility class for rendering the world map, in the menu and radar.
+ *
+ * The radar tiles are baked into an atlas the first time the map is drawn,
+ * and again whenever a tile that was missing has loaded since. The map itself
+ * takes a single draw and the blips are queued on the sprite batch.
  */
 class MapRenderer {
 public:
@@ -34,7 +43,8 @@ public:
         bool clipToSize = true;
     };
 
-    MapRenderer(Renderer& renderer, GameData* data);
+    MapRenderer(Renderer& renderer, SpriteBatch& sprites, GameData* data);
+    ~MapRenderer();
 
     void draw(GameWorld* world, const MapInfo& mi);
     void scaleHUD(const float scale);
@@ -42,6 +52,20 @@ public:
 private:
     GameData* data;
     Renderer& renderer;
+    /// Blips are queued here, on top of the directly drawn tiles
+    SpriteBatch& sprites;
+
+    /// Interned names of the radarNN tiles, each in a slot of its own
+    struct RadarTile {
+        TextureResidency::SlotID slot = TextureResidency::kInvalid;
+        TextureResidency::TextureID texture = TextureResidency::kInvalid;
+    };
+    std::array<RadarTile, MAP_BLOCK_SIZE> radarTiles{};
+
+    /// The radar tiles baked into one texture, so the map is a single quad
+    std::unique_ptr<TextureData> radarAtlas;
+    /// Tiles that were loaded when radarAtlas was baked
+    std::bitset<MAP_BLOCK_SIZE> radarBaked;
 
     GeometryBuffer rectGeom;
     DrawBuffer rect;
@@ -54,10 +78,20 @@ private:
     float hudScale = 1.f;
 
     std::unique_ptr<Renderer::ShaderProgram> rectProg;
-
-    void prepareBlip(const glm::vec2& coord, const glm::mat4& view,
-                     const MapInfo& mi, const std::string& texture,
-                     glm::vec4 colour, float size, float heading);
+    Renderer::Uniform<glm::mat4> projUniform;
+    Renderer::Uniform<glm::mat4> viewUniform;
+    Renderer::Uniform<glm::mat4> modelUniform;
+    Renderer::Uniform<glm::vec4> colourUniform;
+    Renderer::Uniform<float> texScaleUniform;
+
+    /// Draws the radar tiles into radarAtlas, once they are loaded
+    void bakeRadarAtlas(GameWorld* world);
+    /// True if a tile missing from radarAtlas can now be found
+    bool hasNewRadarTiles(GameWorld* world) const;
+
+    /// Screen position of a blip, pulled onto the edge of a clipped map
+    glm::vec2 blipPosition(const glm::vec2& coord, const glm::mat4& view,
+                           const MapInfo& mi) const;
     void drawBlip(const glm::vec2& coord, const glm::mat4& view,
                   const MapInfo& mi, const std::string& texture,
                   glm::vec4 colour, float size, float heading = 0.0f);
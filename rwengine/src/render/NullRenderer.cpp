@@ -0,0 +1,244 @@
+#include "render/NullRenderer.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include <core/Profiler.hpp>
+#include <gl/DrawBuffer.hpp>
+#include <rw/debug.hpp>
+
+namespace {
+GLuint64 now() {
+    return static_cast<GLuint64>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+}  // namespace
+
+NullRenderer::NullRenderer() {
+    swap();
+}
+
+std::string NullRenderer::getIDString() const {
+    return "Null Renderer";
+}
+
+std::unique_ptr<Renderer::ShaderProgram> NullRenderer::createShader(
+    const std::string& vert, const std::string& frag) {
+    RW_UNUSED(vert);
+    RW_UNUSED(frag);
+    return std::make_unique<NullShaderProgram>();
+}
+
+void NullRenderer::setProgramBlockBinding(Renderer::ShaderProgram* p,
+                                          const std::string& name,
+                                          GLint point) {
+    RW_UNUSED(p);
+    RW_UNUSED(name);
+    RW_UNUSED(point);
+}
+
+void NullRenderer::setUniform(const Uniform<GLint>& u, GLint i) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &i, sizeof(i))) {
+        stateChanges.uniforms++;
+    }
+}
+
+void NullRenderer::setUniform(const Uniform<glm::mat4>& u, const glm::mat4& m) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &m, sizeof(m))) {
+        stateChanges.uniforms++;
+    }
+}
+
+void NullRenderer::setUniform(const Uniform<glm::vec4>& u, const glm::vec4& v) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &v, sizeof(v))) {
+        stateChanges.uniforms++;
+    }
+}
+
+void NullRenderer::setUniform(const Uniform<glm::vec3>& u, const glm::vec3& v) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &v, sizeof(v))) {
+        stateChanges.uniforms++;
+    }
+}
+
+void NullRenderer::setUniform(const Uniform<glm::vec2>& u, const glm::vec2& v) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &v, sizeof(v))) {
+        stateChanges.uniforms++;
+    }
+}
+
+void NullRenderer::setUniform(const Uniform<float>& u, float f) {
+    useProgram(u.program);
+    if (u.program->updateUniform(u.slot, &f, sizeof(f))) {
+        stateChanges.uniforms++;
+    }
+}
+
+GLint NullRenderer::NullShaderProgram::locateUniform(
+    const std::string& name) {
+    RW_UNUSED(name);
+    return 0;
+}
+
+void NullRenderer::useProgram(Renderer::ShaderProgram* p) {
+    if (p != currentProgram) {
+        currentProgram = p;
+        stateChanges.programs++;
+    }
+}
+
+void NullRenderer::clear(const glm::vec4& colour, bool clearColour,
+                         bool clearDepth) {
+    RW_UNUSED(colour);
+    RW_UNUSED(clearColour);
+    RW_UNUSED(clearDepth);
+}
+
+void NullRenderer::setSceneParameters(const Renderer::SceneUniformData& data) {
+    if (sceneDataValid &&
+        std::memcmp(&data, &lastSceneData, sizeof(data)) == 0) {
+        return;
+    }
+    stateChanges.uploads++;
+    lastSceneData = data;
+    sceneDataValid = true;
+}
+
+void NullRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
+                                const Renderer::DrawParameters& p,
+                                bool indexed, std::size_t instances) {
+    ProfileInfo* group =
+        currentDebugDepth > 0 ? &profileInfo[currentDebugDepth - 1] : nullptr;
+
+    if (draw->getVertexArray() != currentDbuff) {
+        currentDbuff = draw->getVertexArray();
+        bufferCounter++;
+        if (group) group->buffers++;
+    }
+
+    for (std::size_t u = 0; u < p.textures.size(); ++u) {
+        if (currentTextures[u] != p.textures[u]) {
+            currentTextures[u] = p.textures[u];
+            textureCounter++;
+            if (group) group->textures++;
+        }
+    }
+
+    if (p.blendMode != blendMode) {
+        blendMode = p.blendMode;
+        stateChanges.blend++;
+    }
+    if (p.depthMode != depthMode || p.depthWrite != depthWriteEnabled) {
+        depthMode = p.depthMode;
+        depthWriteEnabled = p.depthWrite;
+        stateChanges.depth++;
+    }
+
+    // Object data is only uploaded when it differs from the last draw's
+    const ObjectUniformData objectData{
+        model,
+        glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f, p.colour.b / 255.f,
+                  p.colour.a / 255.f),
+        1.f, 1.f, p.visibility};
+    if (!objectDataValid ||
+        std::memcmp(&objectData, &lastObjectData, sizeof(objectData)) != 0) {
+        lastObjectData = objectData;
+        objectDataValid = true;
+        stateChanges.uploads++;
+        if (group) group->uploads++;
+    }
+
+    drawCounter++;
+    primitiveCounter += p.count * instances;
+    if (group) {
+        group->draws++;
+        group->primitives += static_cast<unsigned int>(p.count * instances);
+    }
+
+    if (recording) {
+        drawCalls.push_back(
+            {model, draw, currentProgram, p, indexed, instances});
+    }
+}
+
+void NullRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
+                        const Renderer::DrawParameters& p) {
+    setDrawState(model, draw, p, true);
+}
+
+void NullRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                              const Renderer::DrawParameters& p) {
+    setDrawState(model, draw, p, false);
+}
+
+void NullRenderer::drawArraysInstanced(const glm::mat4& model,
+                                       DrawBuffer* draw,
+                                       const Renderer::DrawParameters& p,
+                                       std::size_t instances) {
+    setDrawState(model, draw, p, false, instances);
+}
+
+void NullRenderer::drawBatched(const RenderList& list) {
+    RW_PROFILE_SCOPE(__func__);
+    if (recording) {
+        drawCalls.reserve(drawCalls.size() + list.size());
+    }
+    for (auto& ri : list) {
+        draw(ri.model, ri.dbuff, ri.drawInfo);
+    }
+}
+
+void NullRenderer::invalidate() {
+    currentDbuff = nullptr;
+    currentProgram = nullptr;
+    currentTextures = {};
+    objectDataValid = false;
+    sceneDataValid = false;
+    blendMode = BlendMode::BLEND_NONE;
+    depthMode = DepthMode::OFF;
+}
+
+void NullRenderer::pushDebugGroup(const std::string& title) {
+    RW_UNUSED(title);
+    RW_ASSERT(currentDebugDepth < MAX_DEBUG_DEPTH);
+    ProfileInfo& prof = profileInfo[currentDebugDepth];
+    prof = ProfileInfo{};
+    prof.timerStart = now();
+    currentDebugDepth++;
+}
+
+const Renderer::ProfileInfo& NullRenderer::popDebugGroup() {
+    // Unbalanced pops happen when a group is ended without being started
+    if (currentDebugDepth == 0) {
+        return profileInfo[0];
+    }
+    currentDebugDepth--;
+
+    ProfileInfo& prof = profileInfo[currentDebugDepth];
+    prof.duration = now() - prof.timerStart;
+
+    // Add counters to the parent group
+    if (currentDebugDepth > 0) {
+        ProfileInfo& p = profileInfo[currentDebugDepth - 1];
+        p.draws += prof.draws;
+        p.buffers += prof.buffers;
+        p.primitives += prof.primitives;
+        p.textures += prof.textures;
+        p.uploads += prof.uploads;
+    }
+
+    return prof;
+}
+
+void NullRenderer::reset() {
+    drawCalls.clear();
+    stateChanges = {};
+    primitiveCounter = 0;
+}
@@ -0,0 +1,148 @@
+#ifndef _RWENGINE_NULLRENDERER_HPP_
+#define _RWENGINE_NULLRENDERER_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <render/OpenGLRenderer.hpp>
+
+/**
+ * @brief Renderer that needs no GL context
+ *
+ * Draws are counted the way OpenGLRenderer counts them: buffer and texture
+ * counters only move when the bound state would actually change, so the
+ * numbers match what the GL backend would issue for the same calls. Draws can
+ * also be recorded so tests can inspect the submitted order and state.
+ *
+ * Used to profile culling, sorting and batching on machines without a GPU,
+ * and to assert draw call budgets in tests. GameRenderer skips its own GL
+ * work when running on top of it (see Renderer::hasContext).
+ */
+class NullRenderer final : public Renderer {
+public:
+    class NullShaderProgram final : public ShaderProgram {
+    public:
+        ~NullShaderProgram() override = default;
+
+    protected:
+        GLint locateUniform(const std::string& name) override;
+    };
+
+    struct DrawCall {
+        glm::mat4 model;
+        DrawBuffer* dbuff;
+        ShaderProgram* program;
+        DrawParameters params;
+        /// False for drawArrays
+        bool indexed;
+        std::size_t instances;
+    };
+
+    /// State changes that OpenGLRenderer would have made
+    struct StateChanges {
+        std::size_t programs{};
+        std::size_t blend{};
+        std::size_t depth{};
+        std::size_t uniforms{};
+        std::size_t uploads{};
+    };
+
+    NullRenderer();
+
+    ~NullRenderer() override = default;
+
+    std::string getIDString() const override;
+
+    bool hasContext() const override {
+        return false;
+    }
+
+    std::unique_ptr<ShaderProgram> createShader(const std::string& vert,
+                                const std::string& frag) override;
+    void setProgramBlockBinding(ShaderProgram* p, const std::string& name,
+                                GLint point) override;
+    using Renderer::setUniform;
+    void setUniform(const Uniform<GLint>& u, GLint i) override;
+    void setUniform(const Uniform<glm::mat4>& u, const glm::mat4& m) override;
+    void setUniform(const Uniform<glm::vec4>& u, const glm::vec4& v) override;
+    void setUniform(const Uniform<glm::vec3>& u, const glm::vec3& v) override;
+    void setUniform(const Uniform<glm::vec2>& u, const glm::vec2& v) override;
+    void setUniform(const Uniform<float>& u, float f) override;
+    void useProgram(ShaderProgram* p) override;
+
+    void clear(const glm::vec4& colour, bool clearColour = true,
+               bool clearDepth = true) override;
+
+    void setSceneParameters(const SceneUniformData& data) override;
+
+    void draw(const glm::mat4& model, DrawBuffer* draw,
+              const DrawParameters& p) override;
+    void drawArrays(const glm::mat4& model, DrawBuffer* draw,
+                    const DrawParameters& p) override;
+    void drawArraysInstanced(const glm::mat4& model, DrawBuffer* draw,
+                             const DrawParameters& p,
+                             std::size_t instances) override;
+
+    void drawBatched(const RenderList& list) override;
+
+    void invalidate() override;
+
+    void pushDebugGroup(const std::string& title) override;
+
+    const ProfileInfo& popDebugGroup() override;
+
+    /**
+     * Keep a copy of every draw in getDrawCalls(). Off by default, counting
+     * alone is enough for profiling.
+     */
+    void setRecording(bool enable) {
+        recording = enable;
+    }
+
+    const std::vector<DrawCall>& getDrawCalls() const {
+        return drawCalls;
+    }
+
+    const StateChanges& getStateChanges() const {
+        return stateChanges;
+    }
+
+    /// Number of primitives (indices or vertices) submitted
+    std::size_t getPrimitiveCount() const {
+        return primitiveCounter;
+    }
+
+    /**
+     * Clears recorded draws and the counters not covered by swap(), call
+     * alongside swap() at the end of each frame.
+     */
+    void reset();
+
+private:
+    void setDrawState(const glm::mat4& model, DrawBuffer* draw,
+                      const DrawParameters& p, bool indexed,
+                      std::size_t instances = 1);
+
+    bool recording = false;
+    std::vector<DrawCall> drawCalls;
+    StateChanges stateChanges;
+    std::size_t primitiveCounter = 0;
+
+    // State Cache, mirrors OpenGLRenderer
+    const DrawBuffer* currentDbuff = nullptr;
+    ShaderProgram* currentProgram = nullptr;
+    BlendMode blendMode = BlendMode::BLEND_NONE;
+    DepthMode depthMode = DepthMode::OFF;
+    bool depthWriteEnabled = false;
+    Textures currentTextures{};
+    ObjectUniformData lastObjectData{};
+    bool objectDataValid = false;
+    bool sceneDataValid = false;
+
+    ProfileInfo profileInfo[MAX_DEBUG_DEPTH];
+    int currentDebugDepth = 0;
+};
+
+#endif
@@ -26,10 +26,11 @@
 #include <rw_mingw.hpp>
 #endif
 
-constexpr float kDrawDistanceFactor = 1.5f;
-constexpr float kVehicleDrawDistanceFactor = kDrawDistanceFactor;
+constexpr float kVehicleDrawDistanceFactor =
+    ObjectRenderer::kDrawDistanceFactor;
 #if 0  // There's no distance based culling for these types of objects yet
-constexpr float kPedestrianDrawDistanceFactor = kDrawDistanceFactor;
+constexpr float kPedestrianDrawDistanceFactor =
+    ObjectRenderer::kDrawDistanceFactor;
 #endif
 constexpr float kMagicLODDistance = 330.f;
 constexpr float kVehicleLODDistance = 70.f;
@@ -40,71 +41,40 @@ RenderKey createKey(float normalizedDepth, Renderer::Textures& textures) {
             uint8_t(0xFF & (!textures.empty() ? textures[0] : 0)));
 }
 
-void ObjectRenderer::renderGeometry(Geometry* geom,
+void ObjectRenderer::renderGeometry(const GeometryPtr& geom,
                                     const glm::mat4& modelMatrix,
                                     GameObject* object, RenderList& outList) {
-    for (SubGeometry& subgeom : geom->subgeom) {
-        bool isTransparent = false;
-
-        Renderer::DrawParameters dp;
-
-        dp.colour = {255, 255, 255, 255};
-        dp.count = subgeom.numIndices;
-        dp.start = subgeom.start;
-        dp.textures = {{0}};
-        dp.visibility = 1.f;
-
-        if (object && object->type() == GameObject::Instance) {
-            auto modelinfo = object->getModelInfo<SimpleModelInfo>();
-            dp.depthWrite =
-                !(modelinfo->flags & SimpleModelInfo::NO_ZBUFFER_WRITE);
-        }
-
-        if (geom->materials.size() > subgeom.material) {
-            Geometry::Material& mat = geom->materials[subgeom.material];
-
-            if (!mat.textures.empty()) {
-                auto tex = mat.textures[0].texture;
-                if (tex) {
-                    if (tex->isTransparent()) {
-                        isTransparent = true;
-                    }
-                    dp.textures = {{tex->getName()}};
-                }
-            }
-
-            if ((geom->flags & RW::BSGeometry::ModuleMaterialColor) ==
-                RW::BSGeometry::ModuleMaterialColor) {
-                dp.colour = mat.colour;
-
-                if (object && object->type() == GameObject::Vehicle) {
-                    auto vehicle = static_cast<VehicleObject*>(object);
-                    if (dp.colour.r == 60 && dp.colour.g == 255 &&
-                        dp.colour.b == 0) {
-                        dp.colour = glm::u8vec4(vehicle->colourPrimary, 255);
-                    } else if (dp.colour.r == 255 && dp.colour.g == 0 &&
-                               dp.colour.b == 175) {
-                        dp.colour = glm::u8vec4(vehicle->colourSecondary, 255);
-                    }
-                }
-            }
-
-            dp.visibility = 1.f;
-
-            if (dp.colour.a < 255) {
-                isTransparent = true;
-            }
+    const auto& packets = m_packets->get(geom);
+
+    // Patch in what depends on the object
+    bool depthWrite = true;
+    VehicleObject* vehicle = nullptr;
+    if (object && object->type() == GameObject::Instance) {
+        auto modelinfo = object->getModelInfo<SimpleModelInfo>();
+        depthWrite = !(modelinfo->flags & SimpleModelInfo::NO_ZBUFFER_WRITE);
+    } else if (object && object->type() == GameObject::Vehicle) {
+        vehicle = static_cast<VehicleObject*>(object);
+    }
 
-            dp.diffuse = mat.diffuseIntensity;
-            dp.ambient = mat.ambientIntensity;
+    glm::vec3 position(modelMatrix[3]);
+    float distance = glm::length(m_camera.position - position);
+    float depth = (distance - m_camera.frustum.near) /
+                  (m_camera.frustum.far - m_camera.frustum.near);
+
+    for (const auto& packet : packets) {
+        auto dp = packet.parameters;
+        dp.depthWrite = depthWrite;
+
+        if (vehicle && packet.colourKey != DrawPacketCache::Packet::NoKey) {
+            dp.colour = glm::u8vec4(
+                packet.colourKey == DrawPacketCache::Packet::PrimaryKey
+                    ? vehicle->colourPrimary
+                    : vehicle->colourSecondary,
+                255);
+            dp.blendMode = packet.textureTransparent ? BlendMode::BLEND_ALPHA
+                                                     : BlendMode::BLEND_NONE;
         }
 
-        dp.blendMode = isTransparent ? BlendMode::BLEND_ALPHA : BlendMode::BLEND_NONE;
-
-        glm::vec3 position(modelMatrix[3]);
-        float distance = glm::length(m_camera.position - position);
-        float depth = (distance - m_camera.frustum.near) /
-                      (m_camera.frustum.far - m_camera.frustum.near);
         outList.emplace_back(createKey(depth * depth, dp.textures), modelMatrix,
                              &geom->dbuff, dp);
     }
@@ -123,13 +93,13 @@ void ObjectRenderer::renderAtomic(Atomic* atomic,
 
     auto transform = worldtransform * frame->getWorldTransform();
 
-    glm::vec3 boundpos = bounds.center + glm::vec3(transform[3]);
+    glm::vec3 boundpos = glm::vec3(transform * glm::vec4(bounds.center, 1.f));
     if (!m_camera.frustum.intersects(boundpos, bounds.radius)) {
         culled++;
         return;
     }
 
-    renderGeometry(geometry.get(), transform, object, render);
+    renderGeometry(geometry, transform, object, render);
 }
 
 void ObjectRenderer::renderClump(Clump* model, const glm::mat4& worldtransform,
@@ -144,6 +114,17 @@ void ObjectRenderer::renderClump(Clump* model, const glm::mat4& worldtransform,
     }
 }
 
+bool ObjectRenderer::isReplacedByDetail(const SimpleModelInfo& modelinfo,
+                                        float distance) {
+    if (!modelinfo.isBigBuilding() ||
+        distance >= modelinfo.getNearLodDistance() ||
+        distance >= kMagicLODDistance) {
+        return false;
+    }
+    auto related = modelinfo.related();
+    return !related || related->isLoaded();
+}
+
 void ObjectRenderer::renderInstance(InstanceObject* instance,
                                     RenderList& outList) {
     const auto& atomic = instance->getAtomic();
@@ -178,14 +159,9 @@ void ObjectRenderer::renderInstance(InstanceObject* instance,
         return;
     }
 
-    if (modelinfo->isBigBuilding() &&
-        mindist < modelinfo->getNearLodDistance() &&
-        mindist < kMagicLODDistance) {
-        auto related = modelinfo->related();
-        if (!related || related->isLoaded()) {
-            culled++;
-            return;
-        }
+    if (isReplacedByDetail(*modelinfo, mindist)) {
+        culled++;
+        return;
     }
 
     Atomic* distanceatomic =
@@ -3,6 +3,9 @@
 
 #include <cstddef>
 
+#include <rw/forward.hpp>
+
+#include "render/DrawPacketCache.hpp"
 #include "render/OpenGLRenderer.hpp"
 
 class Atomic;
@@ -14,6 +17,7 @@ class GameWorld;
 class InstanceObject;
 class PickupObject;
 class ProjectileObject;
+class SimpleModelInfo;
 class VehicleObject;
 class ViewCamera;
 struct Geometry;
@@ -26,11 +30,27 @@ struct Geometry;
  */
 class ObjectRenderer {
 public:
+    /// Instances are drawn out to their largest LOD distance times this
+    static constexpr float kDrawDistanceFactor = 1.5f;
+
+    /**
+     * Whether a big building is left out because its detailed model is
+     * drawn in its place
+     * @param distance from the camera divided by kDrawDistanceFactor
+     */
+    static bool isReplacedByDetail(const SimpleModelInfo& modelinfo,
+                                   float distance);
+
+    /**
+     * @param packets keeps the draw parameters of geometry between frames,
+     * if null they only live as long as the ObjectRenderer
+     */
     ObjectRenderer(GameWorld* world, const ViewCamera& camera,
-                   float renderAlpha)
+                   float renderAlpha, DrawPacketCache* packets = nullptr)
         : m_world(world)
         , m_camera(camera)
-        , m_renderAlpha(renderAlpha) {
+        , m_renderAlpha(renderAlpha)
+        , m_packets(packets ? packets : &m_ownPackets) {
     }
 
     /**
@@ -41,7 +61,7 @@ public:
     size_t culled = 0;
     void buildRenderList(GameObject* object, RenderList& outList);
 
-    void renderGeometry(Geometry* geom, const glm::mat4& modelMatrix,
+    void renderGeometry(const GeometryPtr& geom, const glm::mat4& modelMatrix,
                         GameObject* object, RenderList& outList);
 
     /**
@@ -64,6 +84,8 @@ private:
     GameWorld* m_world;
     const ViewCamera& m_camera;
     float m_renderAlpha;
+    DrawPacketCache m_ownPackets;
+    DrawPacketCache* m_packets;
 
     void renderInstance(InstanceObject* instance, RenderList& outList);
     void renderCharacter(CharacterObject* pedestrian, RenderList& outList);
@@ -0,0 +1,286 @@
+#include "render/OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include <data/Clump.hpp>
+
+#include "core/Profiler.hpp"
+
+namespace {
+/// Anything closer to the camera than this is treated as unoccluded
+constexpr float kNearDepth = 0.1f;
+
+constexpr float kFar = std::numeric_limits<float>::infinity();
+
+float edge(const glm::vec2& a, const glm::vec2& b, const glm::vec2& p) {
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+}  // namespace
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) {
+    while (true) {
+        levels.push_back({width, height,
+                          std::vector<float>(static_cast<std::size_t>(
+                              width * height), kFar)});
+        if (width == 1 && height == 1) {
+            break;
+        }
+        width = std::max(1, (width + 1) / 2);
+        height = std::max(1, (height + 1) / 2);
+    }
+}
+
+void OcclusionBuffer::begin(const glm::mat4& vp) {
+    viewProjection = vp;
+    triangles = 0;
+    for (auto& level : levels) {
+        std::fill(level.depth.begin(), level.depth.end(), kFar);
+    }
+}
+
+void OcclusionBuffer::drawOccluder(const Geometry& geometry,
+                                   const glm::mat4& model) {
+    if (geometry.positions.empty()) {
+        return;
+    }
+    const bool strip = geometry.facetype == Geometry::TriangleStrip;
+    // Subgeometries split the mesh by material, their seams are inside it
+    edges.clear();
+    for (const auto& subgeom : geometry.subgeom) {
+        collectEdges(subgeom.indices.data(), subgeom.indices.size(), strip);
+    }
+    std::sort(edges.begin(), edges.end());
+    for (const auto& subgeom : geometry.subgeom) {
+        rasterize(geometry.positions.data(), subgeom.indices.data(),
+                  subgeom.indices.size(), strip, model);
+    }
+}
+
+void OcclusionBuffer::drawTriangles(const glm::vec3* positions,
+                                    const std::uint32_t* indices,
+                                    std::size_t count, bool strip,
+                                    const glm::mat4& model) {
+    edges.clear();
+    collectEdges(indices, count, strip);
+    std::sort(edges.begin(), edges.end());
+    rasterize(positions, indices, count, strip, model);
+}
+
+template <class Function>
+void OcclusionBuffer::forEachTriangle(const std::uint32_t* indices,
+                                      std::size_t count, bool strip,
+                                      Function&& function) {
+    if (strip) {
+        for (std::size_t i = 2; i < count; ++i) {
+            const auto a = indices[i - 2];
+            const auto b = indices[i - 1];
+            const auto c = indices[i];
+            // Strips are stitched together with degenerate triangles
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            function(a, b, c);
+        }
+    } else {
+        for (std::size_t i = 0; i + 2 < count; i += 3) {
+            function(indices[i], indices[i + 1], indices[i + 2]);
+        }
+    }
+}
+
+namespace {
+std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b) {
+    return (std::uint64_t{std::min(a, b)} << 32) | std::max(a, b);
+}
+}  // namespace
+
+void OcclusionBuffer::collectEdges(const std::uint32_t* indices,
+                                   std::size_t count, bool strip) {
+    forEachTriangle(indices, count, strip,
+                    [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                        edges.push_back(edgeKey(a, b));
+                        edges.push_back(edgeKey(b, c));
+                        edges.push_back(edgeKey(c, a));
+                    });
+}
+
+void OcclusionBuffer::rasterize(const glm::vec3* positions,
+                                const std::uint32_t* indices,
+                                std::size_t count, bool strip,
+                                const glm::mat4& model) {
+    const auto mvp = viewProjection * model;
+    const auto project = [&](std::uint32_t index) {
+        return mvp * glm::vec4(positions[index], 1.f);
+    };
+    // Edges found more than once are shared with another triangle
+    const auto shared = [&](std::uint32_t a, std::uint32_t b) {
+        const auto range =
+            std::equal_range(edges.begin(), edges.end(), edgeKey(a, b));
+        return range.second - range.first > 1;
+    };
+
+    forEachTriangle(indices, count, strip,
+                    [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                        drawTriangle(project(a), project(b), project(c),
+                                     {shared(b, c), shared(c, a),
+                                      shared(a, b)});
+                    });
+}
+
+void OcclusionBuffer::drawTriangle(const glm::vec4& a, const glm::vec4& b,
+                                   const glm::vec4& c,
+                                   std::array<bool, 3> inner) {
+    if (a.w < kNearDepth || b.w < kNearDepth || c.w < kNearDepth) {
+        return;
+    }
+
+    auto& level = levels[0];
+    const auto size = glm::vec2(level.width, level.height);
+    const auto toScreen = [&](const glm::vec4& p) {
+        return (glm::vec2(p) / p.w * 0.5f + 0.5f) * size;
+    };
+    const auto sa = toScreen(a);
+    auto sb = toScreen(b);
+    auto sc = toScreen(c);
+
+    auto area = edge(sa, sb, sc);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    // Both windings are drawn, buildings aren't always closed
+    if (area < 0.f) {
+        std::swap(sb, sc);
+        std::swap(inner[1], inner[2]);
+    }
+
+    const auto lo = glm::max(glm::ceil(glm::min(sa, glm::min(sb, sc)) - 0.5f),
+                             glm::vec2(0.f));
+    const auto hi = glm::min(glm::floor(glm::max(sa, glm::max(sb, sc)) - 0.5f),
+                             size - 1.f);
+    if (lo.x > hi.x || lo.y > hi.y) {
+        return;
+    }
+
+    // A texel is only written when the occluder covers all of it. Across an
+    // edge the occluder's other triangles take over, so those are tested at
+    // the texel's centre like a normal rasterizer would. The occluder ends
+    // at the other edges, which must hold all four corners of the texel.
+    const std::array<std::pair<glm::vec2, glm::vec2>, 3> sides{
+        {{sb, sc}, {sc, sa}, {sa, sb}}};
+    const auto covered = [&](const glm::vec2& texel) {
+        for (std::size_t e = 0; e < sides.size(); ++e) {
+            const auto& [from, to] = sides[e];
+            if (inner[e]) {
+                if (edge(from, to, texel + 0.5f) < 0.f) {
+                    return false;
+                }
+                continue;
+            }
+            for (const auto& corner :
+                 {glm::vec2(0.f, 0.f), glm::vec2(1.f, 0.f),
+                  glm::vec2(0.f, 1.f), glm::vec2(1.f, 1.f)}) {
+                if (edge(from, to, texel + corner) < 0.f) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    const auto depth = std::max(a.w, std::max(b.w, c.w));
+    for (auto y = static_cast<int>(lo.y); y <= static_cast<int>(hi.y); ++y) {
+        auto* row = &level.depth[static_cast<std::size_t>(y * level.width)];
+        for (auto x = static_cast<int>(lo.x); x <= static_cast<int>(hi.x);
+             ++x) {
+            if (covered(glm::vec2(x, y))) {
+                row[x] = std::min(row[x], depth);
+            }
+        }
+    }
+    triangles++;
+}
+
+void OcclusionBuffer::finish() {
+    RW_PROFILE_SCOPE("buildOcclusionPyramid");
+    for (std::size_t l = 1; l < levels.size(); ++l) {
+        const auto& below = levels[l - 1];
+        auto& level = levels[l];
+        for (auto y = 0; y < level.height; ++y) {
+            const auto y0 = std::min(y * 2, below.height - 1);
+            const auto y1 = std::min(y * 2 + 1, below.height - 1);
+            for (auto x = 0; x < level.width; ++x) {
+                const auto x0 = std::min(x * 2, below.width - 1);
+                const auto x1 = std::min(x * 2 + 1, below.width - 1);
+                const auto at = [&](int bx, int by) {
+                    return below.depth[static_cast<std::size_t>(
+                        by * below.width + bx)];
+                };
+                level.depth[static_cast<std::size_t>(y * level.width + x)] =
+                    std::max(std::max(at(x0, y0), at(x1, y0)),
+                             std::max(at(x0, y1), at(x1, y1)));
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const glm::vec3& center, float radius) const {
+    // Project the corners of the box around the sphere
+    glm::vec2 lo(kFar);
+    glm::vec2 hi(-kFar);
+    float nearest = kFar;
+    for (auto corner = 0; corner < 8; ++corner) {
+        const glm::vec3 offset((corner & 1) ? radius : -radius,
+                               (corner & 2) ? radius : -radius,
+                               (corner & 4) ? radius : -radius);
+        const auto p = viewProjection * glm::vec4(center + offset, 1.f);
+        if (p.w < kNearDepth) {
+            return false;
+        }
+        const auto screen = glm::vec2(p) / p.w;
+        lo = glm::min(lo, screen);
+        hi = glm::max(hi, screen);
+        nearest = std::min(nearest, p.w);
+    }
+
+    const auto& base = levels[0];
+    const auto size = glm::vec2(base.width, base.height);
+    const auto screenLo = glm::max(glm::floor((lo * 0.5f + 0.5f) * size),
+                                   glm::vec2(0.f));
+    const auto screenHi = glm::min(glm::floor((hi * 0.5f + 0.5f) * size),
+                                   size - 1.f);
+    if (screenLo.x > screenHi.x || screenLo.y > screenHi.y) {
+        // Off screen, that's for the frustum culling to decide
+        return false;
+    }
+
+    auto x0 = static_cast<int>(screenLo.x);
+    auto y0 = static_cast<int>(screenLo.y);
+    auto x1 = static_cast<int>(screenHi.x);
+    auto y1 = static_cast<int>(screenHi.y);
+    std::size_t l = 0;
+    while ((x1 - x0 > 1 || y1 - y0 > 1) && l + 1 < levels.size()) {
+        x0 /= 2;
+        y0 /= 2;
+        x1 /= 2;
+        y1 /= 2;
+        l++;
+    }
+
+    const auto& level = levels[l];
+    for (auto y = y0; y <= y1; ++y) {
+        for (auto x = x0; x <= x1; ++x) {
+            const auto depth =
+                level.depth[static_cast<std::size_t>(y * level.width + x)];
+            if (nearest <= depth) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
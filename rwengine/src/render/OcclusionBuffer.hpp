@@ -0,0 +1,87 @@
+#ifndef _RWENGINE_OCCLUSIONBUFFER_HPP_
+#define _RWENGINE_OCCLUSIONBUFFER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+struct Geometry;
+
+/**
+ * @brief Low resolution depth buffer for occlusion culling
+ *
+ * Large occluders are rasterized in software into a small depth buffer,
+ * which is then reduced into a pyramid holding the farthest depth of each
+ * 2x2 block of the level below. Bounds are tested by projecting them to a
+ * screen rectangle and reading the pyramid level where that rectangle
+ * covers no more than 2x2 texels, so a test costs the same whatever its
+ * size on screen.
+ *
+ * Depth is the distance along the view direction. Each triangle is written
+ * at the depth of its farthest vertex and triangles crossing the near
+ * plane are left out, so occluders are never closer than they really are.
+ * Only texels an occluder covers entirely are written, edges it shares
+ * between its own triangles are rasterized normally so that its inside
+ * stays solid.
+ */
+class OcclusionBuffer {
+public:
+    OcclusionBuffer(int width = 256, int height = 128);
+
+    /// Clears the buffer for a frame seen through viewProjection
+    void begin(const glm::mat4& viewProjection);
+
+    /// Draws the triangles of the geometry's subgeometries, the geometry
+    /// must have kept its positions
+    void drawOccluder(const Geometry& geometry, const glm::mat4& model);
+
+    /**
+     * Draws indexed triangles
+     * @param strip whether the indices form a triangle strip
+     */
+    void drawTriangles(const glm::vec3* positions, const std::uint32_t* indices,
+                       std::size_t count, bool strip, const glm::mat4& model);
+
+    /// Builds the depth pyramid, call once the occluders are drawn
+    void finish();
+
+    /// Whether the sphere is entirely hidden behind the occluders
+    bool isOccluded(const glm::vec3& center, float radius) const;
+
+    std::size_t getTriangleCount() const {
+        return triangles;
+    }
+
+private:
+    struct Level {
+        int width;
+        int height;
+        std::vector<float> depth;
+    };
+
+    template <class Function>
+    static void forEachTriangle(const std::uint32_t* indices,
+                                std::size_t count, bool strip,
+                                Function&& function);
+    void collectEdges(const std::uint32_t* indices, std::size_t count,
+                      bool strip);
+    void rasterize(const glm::vec3* positions, const std::uint32_t* indices,
+                   std::size_t count, bool strip, const glm::mat4& model);
+    /// @param inner whether each edge, opposite a, b and c, is shared with
+    /// another triangle of the occluder
+    void drawTriangle(const glm::vec4& a, const glm::vec4& b,
+                      const glm::vec4& c, std::array<bool, 3> inner);
+
+    glm::mat4 viewProjection{1.f};
+    /// Level 0 is the full resolution buffer
+    std::vector<Level> levels;
+    std::size_t triangles = 0;
+    /// Sorted edges of the occluder being drawn, as vertex index pairs
+    std::vector<std::uint64_t> edges;
+};
+
+#endif
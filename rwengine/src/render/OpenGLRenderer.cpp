@@ -130,9 +130,11 @@ const Renderer::SceneUniformData& Renderer::getSceneData() const {
 }
 
 void OpenGLRenderer::useDrawBuffer(DrawBuffer* dbuff) {
-    if (dbuff != currentDbuff) {
-        glBindVertexArray(dbuff->getVAOName());
-        currentDbuff = dbuff;
+    // Buffers sharing a vertex array don't need a rebind
+    auto vertexArray = dbuff->getVertexArray();
+    if (vertexArray != currentDbuff) {
+        glBindVertexArray(vertexArray->getVAOName());
+        currentDbuff = vertexArray;
         bufferCounter++;
 #ifdef RW_GRAPHICS_STATS
         if (currentDebugDepth > 0) {
@@ -249,50 +251,54 @@ void OpenGLRenderer::setProgramBlockBinding(Renderer::ShaderProgram* p,
     glUniformBlockBinding(glsh->getName(), ubi, point);
 }
 
-void OpenGLRenderer::setUniformTexture(Renderer::ShaderProgram* p,
-                                       const std::string& name, GLint tex) {
-    useProgram(p);
-
-    glUniform1i(currentProgram->getUniformLocation(name), tex);
+void OpenGLRenderer::setUniform(const Uniform<GLint>& u, GLint i) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &i, sizeof(i))) {
+        glUniform1i(currentProgram->getUniformLocation(u.slot), i);
+    }
 }
 
-void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
-                                const std::string& name, const glm::mat4& m) {
-    useProgram(p);
-
-    glUniformMatrix4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                       GL_FALSE, glm::value_ptr(m));
+void OpenGLRenderer::setUniform(const Uniform<glm::mat4>& u,
+                                const glm::mat4& m) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &m, sizeof(m))) {
+        glUniformMatrix4fv(currentProgram->getUniformLocation(u.slot), 1,
+                           GL_FALSE, glm::value_ptr(m));
+    }
 }
 
-void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
-                                const std::string& name, const glm::vec4& m) {
-    useProgram(p);
-
-    glUniform4fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+void OpenGLRenderer::setUniform(const Uniform<glm::vec4>& u,
+                                const glm::vec4& v) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &v, sizeof(v))) {
+        glUniform4fv(currentProgram->getUniformLocation(u.slot), 1,
+                     glm::value_ptr(v));
+    }
 }
 
-void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
-                                const std::string& name, const glm::vec3& m) {
-    useProgram(p);
-
-    glUniform3fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+void OpenGLRenderer::setUniform(const Uniform<glm::vec3>& u,
+                                const glm::vec3& v) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &v, sizeof(v))) {
+        glUniform3fv(currentProgram->getUniformLocation(u.slot), 1,
+                     glm::value_ptr(v));
+    }
 }
 
-void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
-                                const std::string& name, const glm::vec2& m) {
-    useProgram(p);
-
-    glUniform2fv(currentProgram->getUniformLocation(name.c_str()), 1,
-                 glm::value_ptr(m));
+void OpenGLRenderer::setUniform(const Uniform<glm::vec2>& u,
+                                const glm::vec2& v) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &v, sizeof(v))) {
+        glUniform2fv(currentProgram->getUniformLocation(u.slot), 1,
+                     glm::value_ptr(v));
+    }
 }
 
-void OpenGLRenderer::setUniform(Renderer::ShaderProgram* p,
-                                const std::string& name, float f) {
-    useProgram(p);
-
-    glUniform1fv(currentProgram->getUniformLocation(name.c_str()), 1, &f);
+void OpenGLRenderer::setUniform(const Uniform<float>& u, float f) {
+    useProgram(u.program);
+    if (currentProgram->updateUniform(u.slot, &f, sizeof(f))) {
+        glUniform1f(currentProgram->getUniformLocation(u.slot), f);
+    }
 }
 
 void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
@@ -317,8 +323,14 @@ void OpenGLRenderer::clear(const glm::vec4& colour, bool clearColour,
 
 void OpenGLRenderer::setSceneParameters(
     const Renderer::SceneUniformData& data) {
+    // Views drawn several times a frame (HUD, menus) pass the same scene
+    if (sceneDataValid &&
+        std::memcmp(&data, &lastSceneData, sizeof(data)) == 0) {
+        return;
+    }
     uploadUBO(UBOScene, data);
     lastSceneData = data;
+    sceneDataValid = true;
 }
 
 void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
@@ -337,7 +349,13 @@ void OpenGLRenderer::setDrawState(const glm::mat4& model, DrawBuffer* draw,
                              glm::vec4(p.colour.r / 255.f, p.colour.g / 255.f,
                                        p.colour.b / 255.f, p.colour.a / 255.f),
                              1.f, 1.f, p.visibility};
-    uploadUBO(UBOObject, objectData);
+    // The bound entry still holds the previous draw's data
+    if (!objectDataValid ||
+        std::memcmp(&objectData, &lastObjectData, sizeof(objectData)) != 0) {
+        uploadUBO(UBOObject, objectData);
+        lastObjectData = objectData;
+        objectDataValid = true;
+    }
 
     drawCounter++;
 #ifdef RW_GRAPHICS_STATS
@@ -352,16 +370,38 @@ void OpenGLRenderer::draw(const glm::mat4& model, DrawBuffer* draw,
                           const Renderer::DrawParameters& p) {
     setDrawState(model, draw, p);
 
-    glDrawElements(draw->getFaceType(), static_cast<GLsizei>(p.count),
-                   GL_UNSIGNED_INT,
-                   reinterpret_cast<void*>(sizeof(RenderIndex) * p.start));
+    glDrawElementsBaseVertex(
+        draw->getFaceType(), static_cast<GLsizei>(p.count), GL_UNSIGNED_INT,
+        reinterpret_cast<void*>(sizeof(RenderIndex) *
+                                (draw->getBaseIndex() + p.start)),
+        draw->getBaseVertex());
 }
 
 void OpenGLRenderer::drawArrays(const glm::mat4& model, DrawBuffer* draw,
                                 const Renderer::DrawParameters& p) {
     setDrawState(model, draw, p);
 
-    glDrawArrays(draw->getFaceType(), static_cast<GLint>(p.start), static_cast<GLsizei>(p.count));
+    glDrawArrays(draw->getFaceType(),
+                 draw->getBaseVertex() + static_cast<GLint>(p.start),
+                 static_cast<GLsizei>(p.count));
+}
+
+void OpenGLRenderer::drawArraysInstanced(const glm::mat4& model,
+                                         DrawBuffer* draw,
+                                         const Renderer::DrawParameters& p,
+                                         std::size_t instances) {
+    setDrawState(model, draw, p);
+#ifdef RW_GRAPHICS_STATS
+    if (currentDebugDepth > 0) {
+        profileInfo[currentDebugDepth - 1].primitives +=
+            p.count * (instances - 1);
+    }
+#endif
+
+    glDrawArraysInstanced(draw->getFaceType(),
+                          draw->getBaseVertex() + static_cast<GLint>(p.start),
+                          static_cast<GLsizei>(p.count),
+                          static_cast<GLsizei>(instances));
 }
 
 void OpenGLRenderer::drawBatched(const RenderList& list) {
@@ -420,6 +460,8 @@ void OpenGLRenderer::invalidate() {
     currentProgram = nullptr;
     currentTextures.clear();
     currentUBO = 0;
+    objectDataValid = false;
+    sceneDataValid = false;
     setBlend(BlendMode::BLEND_NONE);
     setDepthMode(DepthMode::OFF);
 }
@@ -530,14 +572,32 @@ const Renderer::ProfileInfo& OpenGLRenderer::popDebugGroup() {
 
 Renderer::ShaderProgram::~ShaderProgram() = default;
 
-GLint OpenGLRenderer::OpenGLShaderProgram::getUniformLocation(const std::string &name) {
-    auto c = uniforms.find(name.c_str());
-    GLint loc = -1;
-    if (c == uniforms.end()) {
-        loc = glGetUniformLocation(program, name.c_str());
-        uniforms[name] = loc;
-    } else {
-        loc = c->second;
+std::int32_t Renderer::ShaderProgram::getUniformSlot(const std::string& name) {
+    auto it = uniformNames.find(name);
+    if (it != uniformNames.end()) {
+        return it->second;
+    }
+    const auto slot = static_cast<std::int32_t>(uniformSlots.size());
+    uniformSlots.push_back({locateUniform(name), 0, {}});
+    uniformNames.emplace(name, slot);
+    return slot;
+}
+
+bool Renderer::ShaderProgram::updateUniform(std::int32_t slot,
+                                            const void* value,
+                                            std::size_t size) {
+    auto& uniform = uniformSlots[static_cast<std::size_t>(slot)];
+    RW_ASSERT(size <= sizeof(uniform.value));
+    if (uniform.size == size &&
+        std::memcmp(uniform.value.data(), value, size) == 0) {
+        return false;
     }
-    return loc;
+    uniform.size = size;
+    std::memcpy(uniform.value.data(), value, size);
+    return true;
+}
+
+GLint OpenGLRenderer::OpenGLShaderProgram::locateUniform(
+    const std::string& name) {
+    return glGetUniformLocation(program, name.c_str());
 }
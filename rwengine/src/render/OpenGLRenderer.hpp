@@ -153,12 +153,63 @@ public:
         // This just provides an opaque handle for external users.
         public:
             virtual ~ShaderProgram() = 0;
+
+            /// Index of the named uniform, assigned on first use
+            std::int32_t getUniformSlot(const std::string& name);
+
+            GLint getUniformLocation(std::int32_t slot) const {
+                return uniformSlots[static_cast<std::size_t>(slot)].location;
+            }
+
+            /**
+             * Remembers the value of the uniform
+             * @return false if it already held the value, so the upload can
+             * be skipped
+             */
+            bool updateUniform(std::int32_t slot, const void* value,
+                               std::size_t size);
+
+        protected:
+            virtual GLint locateUniform(const std::string& name) = 0;
+
+        private:
+            struct UniformSlot {
+                GLint location;
+                std::size_t size;
+                /// Large enough for a mat4
+                std::array<float, 16> value;
+            };
+
+            std::map<std::string, std::int32_t> uniformNames;
+            std::vector<UniformSlot> uniformSlots;
     };
 
+    /**
+     * A uniform of a program, resolved once by getUniform so that setting
+     * it needs no name lookup
+     */
+    template <class T>
+    struct Uniform {
+        ShaderProgram* program = nullptr;
+        std::int32_t slot = -1;
+    };
+
+    template <class T>
+    static Uniform<T> getUniform(ShaderProgram* p, const std::string& name) {
+        return {p, p->getUniformSlot(name)};
+    }
+
     virtual ~Renderer() = default;
 
     virtual std::string getIDString() const = 0;
 
+    /**
+     * Whether GL objects may be created and GL state touched directly.
+     * Renderers without a context only accept draws through this interface,
+     * so callers must skip their own buffer, texture and framebuffer work.
+     */
+    virtual bool hasContext() const = 0;
+
     virtual std::unique_ptr<ShaderProgram> createShader(const std::string& vert,
                                         const std::string& frag) = 0;
 
@@ -168,18 +219,31 @@ public:
     virtual void setProgramBlockBinding(ShaderProgram* p,
                                         const std::string& name,
                                         GLint point) = 0;
-    virtual void setUniformTexture(ShaderProgram* p, const std::string& name,
-                                   GLint tex) = 0;
-    virtual void setUniform(ShaderProgram* p, const std::string& name,
+
+    /**
+     * Set uniforms through handles from getUniform. Uploads are skipped
+     * when the program already holds the value.
+     */
+    virtual void setUniform(const Uniform<GLint>& u, GLint i) = 0;
+    virtual void setUniform(const Uniform<glm::mat4>& u,
                             const glm::mat4& m) = 0;
-    virtual void setUniform(ShaderProgram* p, const std::string& name,
+    virtual void setUniform(const Uniform<glm::vec4>& u,
                             const glm::vec4& v) = 0;
-    virtual void setUniform(ShaderProgram* p, const std::string& name,
+    virtual void setUniform(const Uniform<glm::vec3>& u,
                             const glm::vec3& v) = 0;
-    virtual void setUniform(ShaderProgram* p, const std::string& name,
+    virtual void setUniform(const Uniform<glm::vec2>& u,
                             const glm::vec2& v) = 0;
-    virtual void setUniform(ShaderProgram* p, const std::string& name,
-                            float f) = 0;
+    virtual void setUniform(const Uniform<float>& u, float f) = 0;
+
+    /// Set a uniform by name, prefer handles for anything set every frame
+    void setUniformTexture(ShaderProgram* p, const std::string& name,
+                           GLint tex) {
+        setUniform(getUniform<GLint>(p, name), tex);
+    }
+    template <class T>
+    void setUniform(ShaderProgram* p, const std::string& name, const T& v) {
+        setUniform(getUniform<T>(p, name), v);
+    }
 
     virtual void clear(const glm::vec4& colour, bool clearColour = true,
                        bool clearDepth = true) = 0;
@@ -190,6 +254,13 @@ public:
                       const DrawParameters& p) = 0;
     virtual void drawArrays(const glm::mat4& model, DrawBuffer* draw,
                             const DrawParameters& p) = 0;
+    /**
+     * Draws p.count vertices once per instance, the draw buffer supplies
+     * the per instance attributes (see AttributeIndex::divisor)
+     */
+    virtual void drawArraysInstanced(const glm::mat4& model, DrawBuffer* draw,
+                                     const DrawParameters& p,
+                                     std::size_t instances) = 0;
 
     virtual void drawBatched(const RenderList& list) = 0;
 
@@ -269,7 +340,6 @@ class OpenGLRenderer final : public Renderer {
 public:
     class OpenGLShaderProgram final : public ShaderProgram {
         GLuint program;
-        std::map<std::string, GLint> uniforms;
 
     public:
         OpenGLShaderProgram(GLuint p) : program(p) {
@@ -283,7 +353,8 @@ public:
             return program;
         }
 
-        GLint getUniformLocation(const std::string& name);
+    protected:
+        GLint locateUniform(const std::string& name) override;
     };
 
     OpenGLRenderer();
@@ -292,22 +363,21 @@ public:
 
     std::string getIDString() const override;
 
+    bool hasContext() const override {
+        return true;
+    }
+
     std::unique_ptr<ShaderProgram> createShader(const std::string& vert,
                                 const std::string& frag) override;
     void setProgramBlockBinding(ShaderProgram* p, const std::string& name,
                                 GLint point) override;
-    void setUniformTexture(ShaderProgram* p, const std::string& name,
-                           GLint tex) override;
-    void setUniform(ShaderProgram* p, const std::string& name,
-                    const glm::mat4& m) override;
-    void setUniform(ShaderProgram* p, const std::string& name,
-                    const glm::vec4& m) override;
-    void setUniform(ShaderProgram* p, const std::string& name,
-                    const glm::vec3& m) override;
-    void setUniform(ShaderProgram* p, const std::string& name,
-                    const glm::vec2& m) override;
-    void setUniform(ShaderProgram* p, const std::string& name,
-                    float f) override;
+    using Renderer::setUniform;
+    void setUniform(const Uniform<GLint>& u, GLint i) override;
+    void setUniform(const Uniform<glm::mat4>& u, const glm::mat4& m) override;
+    void setUniform(const Uniform<glm::vec4>& u, const glm::vec4& v) override;
+    void setUniform(const Uniform<glm::vec3>& u, const glm::vec3& v) override;
+    void setUniform(const Uniform<glm::vec2>& u, const glm::vec2& v) override;
+    void setUniform(const Uniform<float>& u, float f) override;
     void useProgram(ShaderProgram* p) override;
 
     void clear(const glm::vec4& colour, bool clearColour = true,
@@ -322,6 +392,9 @@ public:
               const DrawParameters& p) override;
     void drawArrays(const glm::mat4& model, DrawBuffer* draw,
                     const DrawParameters& p) override;
+    void drawArraysInstanced(const glm::mat4& model, DrawBuffer* draw,
+                             const DrawParameters& p,
+                             std::size_t instances) override;
 
     void drawBatched(const RenderList& list) override;
 
@@ -349,7 +422,7 @@ private:
     Buffer UBOScene {};
 
     // State Cache
-    DrawBuffer* currentDbuff = nullptr;
+    const DrawBuffer* currentDbuff = nullptr;
     OpenGLShaderProgram* currentProgram = nullptr;
     BlendMode blendMode = BlendMode::BLEND_NONE;
     DepthMode depthMode = DepthMode::OFF;
@@ -357,6 +430,10 @@ private:
     GLuint currentUBO = 0;
     GLuint currentUnit = 0;
     std::map<GLuint, GLuint> currentTextures;
+    /// Uniform block contents as last uploaded
+    ObjectUniformData lastObjectData{};
+    bool objectDataValid = false;
+    bool sceneDataValid = false;
 
     // Set state
     void setBlend(BlendMode mode);
@@ -0,0 +1,208 @@
+#include "render/ParticleBatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <gl/TextureData.hpp>
+
+#include "core/Profiler.hpp"
+#include "render/GameShaders.hpp"
+#include "render/VisualFX.hpp"
+
+static_assert(sizeof(ParticleBatch::Instance) == 40,
+              "Particle instances should be tightly packed");
+
+ParticleBatch::ParticleBatch(Renderer& renderer) : renderer(renderer) {
+    program = renderer.createShader(GameShaders::Particle::VertexShader,
+                                    GameShaders::Particle::FragmentShader);
+    renderer.setUniformTexture(program.get(), "tex", 0);
+    renderer.setProgramBlockBinding(program.get(), "SceneData", 1);
+    cameraForwardUniform =
+        Renderer::getUniform<glm::vec3>(program.get(), "cameraForward");
+
+    if (!renderer.hasContext()) {
+        return;
+    }
+
+    cornerBuffer.uploadVertices<VertexP2>(
+        {{0.5f, 0.5f}, {-0.5f, 0.5f}, {0.5f, -0.5f}, {-0.5f, -0.5f}});
+}
+
+std::uint32_t ParticleBatch::findGroup(GLuint texture, BlendMode blendMode) {
+    // Scenes rarely use more than a handful of particle textures
+    for (auto g = groups.size(); g-- > 0;) {
+        if (groups[g].texture == texture && groups[g].blendMode == blendMode) {
+            groups[g].count++;
+            return static_cast<std::uint32_t>(g);
+        }
+    }
+    groups.push_back({texture, blendMode, 1, 0});
+    return static_cast<std::uint32_t>(groups.size() - 1);
+}
+
+void ParticleBatch::add(const ParticleFX& particle) {
+    if (particle.texture == nullptr) {
+        return;
+    }
+    positions.push_back(particle.position);
+    ups.push_back(particle.up);
+    sizes.push_back(particle.size);
+    colours.emplace_back(glm::clamp(particle.colour, 0.f, 1.f) * 255.f);
+    orientations.push_back(static_cast<std::uint8_t>(particle.orientation));
+    particleGroups.push_back(
+        findGroup(particle.texture->getName(), BlendMode::BLEND_ADDITIVE));
+}
+
+std::uint32_t ParticleBatch::depthKey(float distance2) {
+    // Non negative floats order the same as their bit patterns
+    std::uint32_t bits;
+    std::memcpy(&bits, &distance2, sizeof(bits));
+    return ~bits;
+}
+
+void ParticleBatch::radixSort(const std::vector<std::uint64_t>& keys,
+                              std::vector<std::uint32_t>& order,
+                              std::vector<std::uint32_t>& scratch) {
+    constexpr std::size_t kDigits = sizeof(std::uint64_t);
+    const auto count = keys.size();
+    order.resize(count);
+    scratch.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    if (count < 2) {
+        return;
+    }
+
+    // The digit counts don't depend on the order, gather them all at once
+    std::array<std::array<std::uint32_t, 256>, kDigits> histograms{};
+    for (const auto key : keys) {
+        for (std::size_t d = 0; d < kDigits; ++d) {
+            histograms[d][(key >> (d * 8)) & 0xFF]++;
+        }
+    }
+
+    for (std::size_t d = 0; d < kDigits; ++d) {
+        auto& offsets = histograms[d];
+        const auto shift = d * 8;
+        if (offsets[(keys[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+        std::uint32_t sum = 0;
+        for (auto& offset : offsets) {
+            const auto digitCount = offset;
+            offset = sum;
+            sum += digitCount;
+        }
+        for (const auto index : order) {
+            scratch[offsets[(keys[index] >> shift) & 0xFF]++] = index;
+        }
+        order.swap(scratch);
+    }
+}
+
+void ParticleBatch::draw(const glm::vec3& cameraPosition,
+                         const glm::vec3& cameraForward) {
+    if (positions.empty()) {
+        groups.clear();
+        return;
+    }
+    RW_PROFILE_SCOPE("drawParticles");
+
+    const auto count = positions.size();
+    keys.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto offset = positions[i] - cameraPosition;
+        keys[i] = (static_cast<std::uint64_t>(particleGroups[i]) << 32) |
+                  depthKey(glm::dot(offset, offset));
+    }
+    radixSort(keys, order, scratch);
+
+    std::uint32_t first = 0;
+    for (auto& group : groups) {
+        group.first = first;
+        first += group.count;
+    }
+
+    const bool hasContext = renderer.hasContext();
+    while (groupBuffers.size() < groups.size()) {
+        auto buffer = std::make_unique<DrawBuffer>();
+        buffer->setFaceType(GL_TRIANGLE_STRIP);
+        if (hasContext) {
+            buffer->addGeometry(&cornerBuffer);
+        }
+        groupBuffers.push_back(std::move(buffer));
+    }
+
+    // Without a context the draws are still issued so that they are counted
+    if (hasContext) {
+        upload();
+    }
+
+    renderer.useProgram(program.get());
+    renderer.setUniform(cameraForwardUniform, cameraForward);
+
+    Renderer::DrawParameters dp;
+    dp.start = 0;
+    dp.count = 4;
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const auto& group = groups[g];
+        dp.textures = {{group.texture}};
+        dp.blendMode = group.blendMode;
+        renderer.drawArraysInstanced(glm::mat4(1.0f), groupBuffers[g].get(),
+                                     dp, group.count);
+    }
+
+    positions.clear();
+    ups.clear();
+    sizes.clear();
+    colours.clear();
+    orientations.clear();
+    particleGroups.clear();
+    groups.clear();
+}
+
+void ParticleBatch::upload() {
+    const auto count = order.size();
+    instances.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto p = order[i];
+        instances[i] = {glm::vec4(positions[p], orientations[p]), ups[p],
+                        sizes[p], colours[p]};
+    }
+
+    const auto bytes = static_cast<GLsizeiptr>(sizeof(Instance) * count);
+    if (count > instanceCapacity) {
+        instanceCapacity = std::max(count, instanceCapacity * 2);
+        instanceBuffer.uploadVertices(
+            static_cast<GLsizei>(instanceCapacity),
+            static_cast<GLsizeiptr>(sizeof(Instance) * instanceCapacity),
+            nullptr);
+    } else {
+        // Orphan the storage rather than wait on last frame's draws
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.getVBOName());
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            static_cast<GLsizeiptr>(sizeof(Instance) * instanceCapacity),
+            nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+    const auto attributes = Instance::vertex_attributes();
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        const auto offset = sizeof(Instance) * groups[g].first;
+        auto groupAttributes = attributes;
+        for (auto& attribute : groupAttributes) {
+            attribute.offset += offset;
+        }
+        groupBuffers[g]->setVertexBuffer(instanceBuffer.getVBOName(),
+                                         groupAttributes);
+    }
+
+    // The vertex array bindings above bypass the renderer's state cache
+    renderer.invalidate();
+}
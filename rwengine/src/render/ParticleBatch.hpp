@@ -0,0 +1,140 @@
+#ifndef _RWENGINE_PARTICLEBATCH_HPP_
+#define _RWENGINE_PARTICLEBATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/gtc/type_precision.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+#include <render/OpenGLRenderer.hpp>
+
+struct ParticleFX;
+
+/**
+ * @brief Draws the particles of a frame with instancing
+ *
+ * Particles are queued into per attribute arrays, sorted back to front by a
+ * radix sort on precomputed keys and drawn with one instanced draw per
+ * texture and blend mode. The billboard orientation is worked out in the
+ * vertex shader, so a particle costs one 40 byte instance on the CPU side.
+ *
+ * Particles are sorted back to front within their group, the groups are
+ * drawn in the order their first particle was queued. That only matters
+ * once particles stop using additive blending.
+ */
+class ParticleBatch {
+public:
+    /// Per instance data as uploaded to the GPU
+    struct Instance {
+        /// Position, w holds the ParticleFX::Orientation
+        glm::vec4 position;
+        /// Facing direction of Free particles
+        glm::vec3 up;
+        glm::vec2 size;
+        glm::u8vec4 colour;
+
+        static const AttributeList vertex_attributes() {
+            return {
+                {ATRS_Instance0, 4, sizeof(Instance), 0ul, GL_FLOAT, 1},
+                {ATRS_Instance1, 3, sizeof(Instance), sizeof(glm::vec4),
+                 GL_FLOAT, 1},
+                {ATRS_Instance2, 2, sizeof(Instance),
+                 sizeof(glm::vec4) + sizeof(glm::vec3), GL_FLOAT, 1},
+                {ATRS_Colour, 4, sizeof(Instance),
+                 sizeof(glm::vec4) + sizeof(glm::vec3) + sizeof(glm::vec2),
+                 GL_UNSIGNED_BYTE, 1},
+            };
+        }
+    };
+
+    explicit ParticleBatch(Renderer& renderer);
+
+    ParticleBatch(const ParticleBatch&) = delete;
+    ParticleBatch& operator=(const ParticleBatch&) = delete;
+
+    /// Queues the particle for the next draw, untextured ones are skipped
+    void add(const ParticleFX& particle);
+
+    /**
+     * Draws and clears the queued particles. The scene parameters must be
+     * set for the camera at cameraPosition.
+     * @param cameraForward view direction used by UpCamera particles
+     */
+    void draw(const glm::vec3& cameraPosition, const glm::vec3& cameraForward);
+
+    std::size_t getQueuedCount() const {
+        return positions.size();
+    }
+
+    /// Texture and blend groups of the queued particles, one draw each
+    std::size_t getGroupCount() const {
+        return groups.size();
+    }
+
+    /// Sorts ascending before farther distances, for back to front drawing
+    static std::uint32_t depthKey(float distance2);
+
+    /**
+     * Orders keys ascending with a stable least significant digit radix
+     * sort, skipping bytes that are the same for every key
+     * @param order receives the indices into keys in sorted order
+     * @param scratch temporary storage, kept to avoid reallocating
+     */
+    static void radixSort(const std::vector<std::uint64_t>& keys,
+                          std::vector<std::uint32_t>& order,
+                          std::vector<std::uint32_t>& scratch);
+
+private:
+    struct Group {
+        GLuint texture;
+        BlendMode blendMode;
+        std::uint32_t count;
+        /// First instance of the group once sorted
+        std::uint32_t first;
+    };
+
+    /// Writes the sorted instances and points each group's vertex array at
+    /// its part of them
+    void upload();
+
+    std::uint32_t findGroup(GLuint texture, BlendMode blendMode);
+
+    Renderer& renderer;
+    std::unique_ptr<Renderer::ShaderProgram> program;
+    Renderer::Uniform<glm::vec3> cameraForwardUniform;
+
+    // Queued particles
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> ups;
+    std::vector<glm::vec2> sizes;
+    std::vector<glm::u8vec4> colours;
+    std::vector<std::uint8_t> orientations;
+    std::vector<std::uint32_t> particleGroups;
+
+    std::vector<Group> groups;
+
+    // Sorting
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> scratch;
+    std::vector<Instance> instances;
+
+    /// The corners of the unit quad each instance is drawn as
+    GeometryBuffer cornerBuffer;
+    GeometryBuffer instanceBuffer;
+    std::size_t instanceCapacity = 0;
+    /// GL 3.3 has no base instance, so each group gets a vertex array with
+    /// the instance attributes offset to its first instance
+    std::vector<std::unique_ptr<DrawBuffer>> groupBuffers;
+};
+
+#endif
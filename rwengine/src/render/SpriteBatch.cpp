@@ -0,0 +1,219 @@
+#include "render/SpriteBatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <rw/debug.hpp>
+
+#include "core/Profiler.hpp"
+
+namespace {
+constexpr char const* SpriteVertexShader = R"(
+#version 330
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in float mode;
+layout(location = 2) in vec4 colour;
+layout(location = 3) in vec2 texcoord;
+out vec2 TexCoord;
+out vec4 Colour;
+out float Mode;
+
+uniform mat4 proj;
+
+void main() {
+    gl_Position = proj * vec4(position, 0.0, 1.0);
+    TexCoord = texcoord;
+    Colour = colour;
+    Mode = mode;
+})";
+
+constexpr char const* SpriteFragmentShader = R"(
+#version 330
+
+in vec2 TexCoord;
+in vec4 Colour;
+in float Mode;
+uniform sampler2D spriteTexture;
+out vec4 outColour;
+
+void main() {
+    vec4 c = texture(spriteTexture, TexCoord);
+    // Glyph textures only carry coverage in alpha
+    outColour = vec4(Colour.rgb + c.rgb * (1.0 - Mode), Colour.a * c.a);
+})";
+
+bool overlaps(const glm::vec4& a, const glm::vec4& b) {
+    return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+}
+}  // namespace
+
+SpriteBatch::SpriteBatch(Renderer& renderer) : renderer(renderer) {
+    program = renderer.createShader(SpriteVertexShader, SpriteFragmentShader);
+    renderer.setUniformTexture(program.get(), "spriteTexture", 0);
+    projUniform = Renderer::getUniform<glm::mat4>(program.get(), "proj");
+
+    quads.reserve(kMaxQuads);
+    quadRuns.reserve(kMaxQuads);
+
+    db.setFaceType(GL_TRIANGLES);
+    if (!renderer.hasContext()) {
+        return;
+    }
+
+    gb.uploadVertices(0, sizeof(Quad) * kMaxQuads * kBufferBatches, nullptr);
+    gb.getDataAttributes() = Vertex::vertex_attributes();
+    db.addGeometry(&gb);
+
+    const std::uint8_t black[4] = {0, 0, 0, 255};
+    glGenTextures(1, &blankTexture);
+    glBindTexture(GL_TEXTURE_2D, blankTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, black);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    // The VAO and texture bindings above bypass the renderer's state cache
+    renderer.invalidate();
+}
+
+SpriteBatch::~SpriteBatch() {
+    if (blankTexture != 0) {
+        glDeleteTextures(1, &blankTexture);
+    }
+}
+
+void SpriteBatch::addRect(GLuint texture, const glm::vec4& extents,
+                          const glm::vec4& uv, const glm::vec4& colour,
+                          Mode mode) {
+    addQuad(texture,
+            {{{extents.x, extents.y},
+              {extents.x + extents.z, extents.y},
+              {extents.x + extents.z, extents.y + extents.w},
+              {extents.x, extents.y + extents.w}}},
+            uv, colour, mode);
+}
+
+void SpriteBatch::addQuad(GLuint texture,
+                          const std::array<glm::vec2, 4>& corners,
+                          const glm::vec4& uv, const glm::vec4& colour,
+                          Mode mode) {
+    if (quads.size() >= kMaxQuads) {
+        flush();
+    }
+
+    if (texture == 0) {
+        texture = blankTexture;
+    }
+
+    const glm::u8vec4 c(glm::clamp(colour, 0.f, 1.f) * 255.f + 0.5f);
+    const auto m = static_cast<std::uint8_t>(mode);
+    const Vertex tl{corners[0], {uv.x, uv.y}, c, m, {}};
+    const Vertex tr{corners[1], {uv.z, uv.y}, c, m, {}};
+    const Vertex br{corners[2], {uv.z, uv.w}, c, m, {}};
+    const Vertex bl{corners[3], {uv.x, uv.w}, c, m, {}};
+    quads.push_back({{bl, br, tl, tr, tl, br}});
+
+    glm::vec2 lo = corners[0], hi = corners[0];
+    for (const auto& p : corners) {
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+    quadRuns.push_back(findRun(texture, glm::vec4(lo, hi)));
+}
+
+std::uint32_t SpriteBatch::findRun(GLuint texture, const glm::vec4& bounds) {
+    const auto last = runs.size();
+    const auto first = last > kRunSearchDepth ? last - kRunSearchDepth : 0;
+    for (auto r = last; r-- > first;) {
+        auto& run = runs[r];
+        if (run.texture == texture) {
+            run.count++;
+            run.bounds.x = std::min(run.bounds.x, bounds.x);
+            run.bounds.y = std::min(run.bounds.y, bounds.y);
+            run.bounds.z = std::max(run.bounds.z, bounds.z);
+            run.bounds.w = std::max(run.bounds.w, bounds.w);
+            return static_cast<std::uint32_t>(r);
+        }
+        // Anything drawn by this run must stay beneath the new quad
+        if (overlaps(run.bounds, bounds)) {
+            break;
+        }
+    }
+    runs.push_back({texture, 1, bounds});
+    return static_cast<std::uint32_t>(runs.size() - 1);
+}
+
+void SpriteBatch::flush() {
+    if (quads.empty()) {
+        return;
+    }
+    RW_PROFILE_SCOPE(__func__);
+    renderer.pushDebugGroup("Sprites");
+
+    const auto count = quads.size();
+    const bool orphan = writeOffset + count > kMaxQuads * kBufferBatches;
+    if (orphan) {
+        writeOffset = 0;
+    }
+
+    // Without a context the runs are still drawn so that they are counted
+    if (!renderer.hasContext() || upload(orphan)) {
+        renderer.useProgram(program.get());
+        renderer.setUniform(projUniform, renderer.get2DProjection());
+
+        Renderer::DrawParameters dp;
+        dp.blendMode = BlendMode::BLEND_ALPHA;
+        dp.depthMode = DepthMode::OFF;
+        dp.depthWrite = false;
+        std::size_t first = writeOffset;
+        for (const auto& run : runs) {
+            dp.start = first * 6;
+            dp.count = run.count * 6;
+            dp.textures = {{run.texture}};
+            renderer.drawArrays(glm::mat4(1.0f), &db, dp);
+            first += run.count;
+        }
+        writeOffset += count;
+    }
+
+    quads.clear();
+    quadRuns.clear();
+    runs.clear();
+
+    renderer.popDebugGroup();
+}
+
+bool SpriteBatch::upload(bool orphan) {
+    const auto count = quads.size();
+    glBindBuffer(GL_ARRAY_BUFFER, gb.getVBOName());
+    if (orphan) {
+        // Orphan the storage rather than wait on draws still reading it
+        glBufferData(GL_ARRAY_BUFFER, sizeof(Quad) * kMaxQuads * kBufferBatches,
+                     nullptr, GL_STREAM_DRAW);
+    }
+
+    void* mapped = glMapBufferRange(
+        GL_ARRAY_BUFFER, static_cast<GLintptr>(sizeof(Quad) * writeOffset),
+        static_cast<GLsizeiptr>(sizeof(Quad) * count),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+            GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped == nullptr) {
+        RW_ERROR("Failed to map sprite buffer");
+        return false;
+    }
+
+    // Scatter each quad straight into its run's slice of the buffer
+    runCursor.resize(runs.size());
+    std::uint32_t start = 0;
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        runCursor[r] = start;
+        start += runs[r].count;
+    }
+    auto dst = static_cast<Quad*>(mapped);
+    for (std::size_t q = 0; q < count; ++q) {
+        std::memcpy(&dst[runCursor[quadRuns[q]]++], &quads[q], sizeof(Quad));
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    return true;
+}
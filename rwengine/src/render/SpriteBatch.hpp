@@ -0,0 +1,140 @@
+#ifndef _RWENGINE_SPRITEBATCH_HPP_
+#define _RWENGINE_SPRITEBATCH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <gl/DrawBuffer.hpp>
+#include <gl/GeometryBuffer.hpp>
+#include <gl/gl_core_3_3.h>
+
+#include <render/OpenGLRenderer.hpp>
+
+/**
+ * @brief Accumulates 2D quads (HUD sprites, glyphs, blips) for a frame
+ *
+ * Quads are given in the 2D projection space (see
+ * Renderer::get2DProjection) and are drawn with alpha blending and no depth
+ * test. Consecutive quads are grouped into runs by texture; a quad may also
+ * join an earlier run with the same texture as long as it doesn't overlap
+ * anything queued after that run, so the painter's order is preserved while
+ * keeping the number of draws close to one per texture.
+ *
+ * Everything queued is drawn by flush(), which must be called before any
+ * other drawing that should appear above the queued quads, and at the end of
+ * the frame.
+ */
+class SpriteBatch {
+public:
+    /// How the texture sample is combined with the quad colour
+    enum class Mode : std::uint8_t {
+        /// RGBA sprite, tinted additively: rgb = colour + texel.rgb
+        Sprite = 0,
+        /// Alpha-only glyph, coloured by the quad: rgb = colour
+        Glyph = 255
+    };
+
+    struct Vertex {
+        glm::vec2 position;
+        glm::vec2 texcoord;
+        glm::u8vec4 colour;
+        std::uint8_t mode;
+        std::uint8_t padding[3];
+
+        static const AttributeList vertex_attributes() {
+            return {
+                {ATRS_Position, 2, sizeof(Vertex), 0ul},
+                {ATRS_TexCoord, 2, sizeof(Vertex), sizeof(glm::vec2)},
+                {ATRS_Colour, 4, sizeof(Vertex), sizeof(glm::vec2) * 2,
+                 GL_UNSIGNED_BYTE},
+                // The mode shares the normal slot; 2D quads have no normals
+                {ATRS_Normal, 1, sizeof(Vertex),
+                 sizeof(glm::vec2) * 2 + sizeof(glm::u8vec4),
+                 GL_UNSIGNED_BYTE},
+            };
+        }
+    };
+
+    /// Quads held before an implicit flush
+    static constexpr std::size_t kMaxQuads = 2048;
+    /// Batches that fit in the streaming buffer before it is orphaned
+    static constexpr std::size_t kBufferBatches = 4;
+    /// How many earlier runs are searched for a matching texture
+    static constexpr std::size_t kRunSearchDepth = 8;
+
+    SpriteBatch(Renderer& renderer);
+    ~SpriteBatch();
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    /**
+     * Queues an axis aligned quad
+     * @param texture GL texture name, 0 for an untextured quad
+     * @param extents x, y, width, height
+     * @param uv texture rectangle as s0, t0, s1, t1
+     */
+    void addRect(GLuint texture, const glm::vec4& extents,
+                 const glm::vec4& uv, const glm::vec4& colour,
+                 Mode mode = Mode::Sprite);
+
+    /**
+     * Queues an arbitrary quad
+     * @param corners top-left, top-right, bottom-right, bottom-left
+     * @param uv texture rectangle mapped onto the corners as for addRect
+     */
+    void addQuad(GLuint texture, const std::array<glm::vec2, 4>& corners,
+                 const glm::vec4& uv, const glm::vec4& colour,
+                 Mode mode = Mode::Sprite);
+
+    /// Draws and clears all queued quads
+    void flush();
+
+    std::size_t getQueuedCount() const {
+        return quads.size();
+    }
+
+    std::size_t getRunCount() const {
+        return runs.size();
+    }
+
+private:
+    using Quad = std::array<Vertex, 6>;
+
+    struct Run {
+        GLuint texture;
+        std::uint32_t count;
+        /// Union of the quads in the run: min x, min y, max x, max y
+        glm::vec4 bounds;
+    };
+
+    Renderer& renderer;
+    std::unique_ptr<Renderer::ShaderProgram> program;
+    Renderer::Uniform<glm::mat4> projUniform;
+
+    GeometryBuffer gb;
+    DrawBuffer db;
+    /// Quad offset of the next write into the streaming buffer
+    std::size_t writeOffset = 0;
+
+    /// 1x1 opaque black texture standing in for "no texture"
+    GLuint blankTexture = 0;
+
+    std::vector<Quad> quads;
+    /// Run each of quads belongs to
+    std::vector<std::uint32_t> quadRuns;
+    std::vector<Run> runs;
+    std::vector<std::uint32_t> runCursor;
+
+    std::uint32_t findRun(GLuint texture, const glm::vec4& bounds);
+
+    /// Writes the queued quads at writeOffset, grouped by run
+    bool upload(bool orphan);
+};
+
+#endif
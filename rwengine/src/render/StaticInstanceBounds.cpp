@@ -0,0 +1,258 @@
+#include "render/StaticInstanceBounds.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include <glm/glm.hpp>
+
+#include <data/Clump.hpp>
+
+#include "core/Profiler.hpp"
+#include "engine/InstanceIndex.hpp"
+#include "objects/InstanceObject.hpp"
+#include "render/ObjectRenderer.hpp"
+#include "render/ViewCamera.hpp"
+
+namespace {
+/// Mirrors the TOBJ check in ObjectRenderer::renderInstance
+std::uint32_t visibleHours(const SimpleModelInfo& modelinfo) {
+    std::uint32_t hours = 0;
+    for (auto hour = 0; hour < 24; ++hour) {
+        const bool hidden =
+            modelinfo.timeOff < modelinfo.timeOn
+                ? hour >= modelinfo.timeOff && hour < modelinfo.timeOn
+                : hour >= modelinfo.timeOff || hour < modelinfo.timeOn;
+        if (!hidden) {
+            hours |= 1u << hour;
+        }
+    }
+    return hours;
+}
+}  // namespace
+
+bool StaticInstanceBounds::computeBounds(const InstanceObject* object,
+                                         Bounds& bounds) {
+    const auto modelinfo = object->getModelInfo<SimpleModelInfo>();
+
+    // Grow a sphere around the first atomic's until it holds the others
+    bool found = false;
+    glm::vec3 center{};
+    float r = 0.f;
+    for (auto a = 0; a < modelinfo->getNumAtomics(); ++a) {
+        const auto atomic = modelinfo->getAtomic(a);
+        if (!atomic || !atomic->getGeometry()) {
+            continue;
+        }
+        const auto& geometryBounds = atomic->getGeometry()->geometryBounds;
+        if (!found) {
+            center = geometryBounds.center;
+            r = geometryBounds.radius;
+            found = true;
+            continue;
+        }
+        r = std::max(r, glm::distance(center, geometryBounds.center) +
+                            geometryBounds.radius);
+    }
+    if (!found) {
+        return false;
+    }
+
+    bounds.position = object->getPosition();
+    bounds.center = object->getRotation() * center + bounds.position;
+    bounds.radius = r;
+    bounds.drawDistance = modelinfo->getLargestLodDistance() *
+                          ObjectRenderer::kDrawDistanceFactor;
+    bounds.hours = visibleHours(*modelinfo);
+    return true;
+}
+
+void StaticInstanceBounds::update(const InstanceIndex& index) {
+    if (index.getGeneration() == generation) {
+        Bounds b;
+        const auto loaded =
+            std::any_of(objects.begin() + static_cast<std::ptrdiff_t>(
+                                              bounds.size()),
+                        objects.end(), [&](const InstanceObject* object) {
+                            return computeBounds(object, b);
+                        });
+        if (!loaded) {
+            return;
+        }
+    }
+    RW_PROFILE_SCOPE("buildStaticBounds");
+    generation = index.getGeneration();
+
+    std::vector<InstanceObject*> instances;
+    index.gatherStatic(instances);
+
+    std::vector<InstanceObject*> withBounds;
+    std::vector<InstanceObject*> pending;
+    std::vector<Bounds> entries;
+    withBounds.reserve(instances.size());
+    entries.reserve(instances.size());
+    for (auto instance : instances) {
+        Bounds b;
+        if (computeBounds(instance, b)) {
+            withBounds.push_back(instance);
+            entries.push_back(b);
+        } else {
+            pending.push_back(instance);
+        }
+    }
+
+    build(withBounds, entries);
+    objects.insert(objects.end(), pending.begin(), pending.end());
+}
+
+void StaticInstanceBounds::build(const std::vector<InstanceObject*>& instances,
+                                 const std::vector<Bounds>& entries) {
+    const auto count = static_cast<std::uint32_t>(entries.size());
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0u);
+
+    nodes.clear();
+    if (count > 0) {
+        buildNode(entries, 0, count);
+    }
+
+    objects.resize(count);
+    bounds.resize(count);
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    radius.resize(count);
+    inside.resize(std::min(count, kLeafSize));
+    for (std::uint32_t i = 0; i < count; ++i) {
+        objects[i] = instances[order[i]];
+        bounds[i] = entries[order[i]];
+        x[i] = bounds[i].center.x;
+        y[i] = bounds[i].center.y;
+        z[i] = bounds[i].center.z;
+        radius[i] = bounds[i].radius;
+    }
+}
+
+std::uint32_t StaticInstanceBounds::buildNode(
+    const std::vector<Bounds>& entries, std::uint32_t first,
+    std::uint32_t count) {
+    const auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    const auto begin = order.begin() + first;
+    const auto end = begin + count;
+
+    Node node{};
+    node.first = first;
+    node.count = count;
+    node.min = node.max = entries[*begin].position;
+    auto sphereMin = entries[*begin].center - entries[*begin].radius;
+    auto sphereMax = entries[*begin].center + entries[*begin].radius;
+    for (auto it = begin; it != end; ++it) {
+        const auto& entry = entries[*it];
+        node.min = glm::min(node.min, entry.position);
+        node.max = glm::max(node.max, entry.position);
+        sphereMin = glm::min(sphereMin, entry.center - entry.radius);
+        sphereMax = glm::max(sphereMax, entry.center + entry.radius);
+        node.drawDistance = std::max(node.drawDistance, entry.drawDistance);
+        node.hours |= entry.hours;
+    }
+    node.center = (sphereMin + sphereMax) * 0.5f;
+    for (auto it = begin; it != end; ++it) {
+        const auto& entry = entries[*it];
+        node.radius =
+            std::max(node.radius,
+                     glm::distance(node.center, entry.center) + entry.radius);
+    }
+
+    if (count > kLeafSize) {
+        // Split at the median along the longest side
+        const auto extent = node.max - node.min;
+        const auto axis =
+            extent.x > extent.y ? (extent.x > extent.z ? 0 : 2)
+                                : (extent.y > extent.z ? 1 : 2);
+        const auto half = count / 2;
+        std::nth_element(begin, begin + half, end,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return entries[a].position[axis] <
+                                    entries[b].position[axis];
+                         });
+        buildNode(entries, first, half);
+        node.right = buildNode(entries, first + half, count - half);
+    }
+
+    nodes[index] = node;
+    return index;
+}
+
+std::size_t StaticInstanceBounds::cull(const ViewCamera& camera, int hour,
+                                       std::vector<std::uint32_t>& visible) {
+    RW_PROFILE_SCOPE(__func__);
+    const auto& frustum = camera.frustum;
+    const auto hourBit = hour >= 0 && hour < 24 ? 1u << hour : ~0u;
+
+    std::size_t culled = 0;
+    const auto accept = [&](const Node& node) {
+        for (auto i = node.first; i < node.first + node.count; ++i) {
+            visible.push_back(i);
+        }
+    };
+
+    stack.clear();
+    if (!nodes.empty()) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        const auto& node = nodes[index];
+
+        const auto nearest = glm::clamp(camera.position, node.min, node.max);
+        const auto offset = nearest - camera.position;
+        if ((node.hours & hourBit) == 0 ||
+            glm::dot(offset, offset) > node.drawDistance * node.drawDistance) {
+            culled += node.count;
+            continue;
+        }
+
+        bool outside = false;
+        bool cut = false;
+        for (const auto& plane : frustum.planes) {
+            const auto d = glm::dot(plane.normal, node.center) + plane.distance;
+            if (d < -node.radius) {
+                outside = true;
+                break;
+            }
+            cut |= d < node.radius;
+        }
+        if (outside) {
+            culled += node.count;
+            continue;
+        }
+        if (!cut) {
+            accept(node);
+            continue;
+        }
+
+        if (node.right != 0) {
+            stack.push_back(node.right);
+            stack.push_back(index + 1);
+            continue;
+        }
+
+        frustum.intersects(x.data() + node.first, y.data() + node.first,
+                           z.data() + node.first, radius.data() + node.first,
+                           node.count, inside.data());
+        for (std::uint32_t i = 0; i < node.count; ++i) {
+            if (inside[i]) {
+                visible.push_back(node.first + i);
+            } else {
+                culled++;
+            }
+        }
+    }
+
+    for (auto i = bounds.size(); i < objects.size(); ++i) {
+        visible.push_back(static_cast<std::uint32_t>(i));
+    }
+    return culled;
+}
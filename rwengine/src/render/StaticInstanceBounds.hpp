@@ -0,0 +1,138 @@
+#ifndef _RWENGINE_STATICINSTANCEBOUNDS_HPP_
+#define _RWENGINE_STATICINSTANCEBOUNDS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+class InstanceIndex;
+class InstanceObject;
+class ViewCamera;
+
+/**
+ * @brief Bounding volume hierarchy over the static instances
+ *
+ * Static instances never move, so their world space bounds are worked out
+ * once and sorted into a tree whose nodes hold what their subtree needs to
+ * be drawn at all: a sphere around the instances, the box their positions
+ * span, the furthest draw distance and the hours any of them is shown in.
+ * Subtrees outside the frustum, beyond their draw distance or hidden at the
+ * current hour are rejected as a whole and subtrees entirely inside the
+ * frustum are accepted without further tests, so the work done per frame
+ * follows what is visible rather than the size of the map. Only the leaves
+ * the frustum cuts are tested instance by instance, several at a time.
+ *
+ * The tree is rebuilt whenever the instance index changes, which after the
+ * map is loaded is rare.
+ *
+ * Each sphere encloses every LOD atomic of the instance's model, so the
+ * culling stays valid whichever atomic ends up being drawn. The bound
+ * centre is rotated and moved with the instance, models are rarely centred
+ * on their origin.
+ */
+class StaticInstanceBounds {
+public:
+    struct Bounds {
+        glm::vec3 center;
+        float radius;
+        /// The instance position, draw distances are measured from it
+        glm::vec3 position;
+        float drawDistance;
+        /// Bit n is set if the instance is shown during hour n
+        std::uint32_t hours;
+    };
+
+    /// Instances per leaf
+    static constexpr std::uint32_t kLeafSize = 16;
+
+    /**
+     * Rebuilds the tree if index changed since the last call, or once the
+     * model of an instance without bounds has loaded
+     */
+    void update(const InstanceIndex& index);
+
+    /**
+     * Builds the tree over bounds, objects[i] being the instance of
+     * bounds[i]. Instances are renumbered in the process.
+     */
+    void build(const std::vector<InstanceObject*>& objects,
+               const std::vector<Bounds>& bounds);
+
+    /**
+     * Appends the number of every instance that may be visible to visible
+     * @return the number of instances culled
+     */
+    std::size_t cull(const ViewCamera& camera, int hour,
+                     std::vector<std::uint32_t>& visible);
+
+    InstanceObject* getInstance(std::uint32_t i) const {
+        return objects[i];
+    }
+
+    bool hasBounds(std::uint32_t i) const {
+        return i < bounds.size();
+    }
+
+    /// Only valid if hasBounds(i)
+    const Bounds& getBounds(std::uint32_t i) const {
+        return bounds[i];
+    }
+
+    std::size_t getInstanceCount() const {
+        return objects.size();
+    }
+
+    std::size_t getNodeCount() const {
+        return nodes.size();
+    }
+
+    /// Instances whose model wasn't loaded yet, these are never culled
+    std::size_t getPendingCount() const {
+        return objects.size() - bounds.size();
+    }
+
+    /// Works out the bounds of a static instance, false if its model has
+    /// no geometry yet
+    static bool computeBounds(const InstanceObject* object, Bounds& bounds);
+
+private:
+    struct Node {
+        /// Encloses the spheres of the subtree
+        glm::vec3 center;
+        float radius;
+        /// Span of the instance positions
+        glm::vec3 min;
+        glm::vec3 max;
+        float drawDistance;
+        std::uint32_t hours;
+        std::uint32_t first;
+        std::uint32_t count;
+        /// The second child, 0 for leaves. The first follows its parent.
+        std::uint32_t right;
+    };
+
+    std::uint32_t buildNode(const std::vector<Bounds>& entries,
+                            std::uint32_t first, std::uint32_t count);
+
+    std::uint64_t generation = 0;
+
+    std::vector<Node> nodes;
+    /// In tree order, followed by those with pending bounds
+    std::vector<InstanceObject*> objects;
+    std::vector<Bounds> bounds;
+
+    // Leaf spheres packed for ViewFrustum
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> radius;
+
+    // Scratch
+    std::vector<std::uint32_t> order;
+    std::vector<std::uint32_t> stack;
+    std::vector<std::uint8_t> inside;
+};
+
+#endif
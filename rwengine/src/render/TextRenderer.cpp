@@ -20,38 +20,6 @@ unsigned charToIndex(std::uint16_t g) {
     return g - 32;
 }
 
-constexpr char const *TextVertexShader = R"(
-#version 330
-
-layout(location = 0) in vec2 position;
-layout(location = 3) in vec2 texcoord;
-layout(location = 2) in vec3 colour;
-out vec2 TexCoord;
-out vec3 Colour;
-
-uniform mat4 proj;
-uniform vec2 alignment;
-
-void main() {
-    gl_Position = proj * vec4(alignment + position, 0.0, 1.0);
-    TexCoord = texcoord;
-    Colour = colour;
-})";
-
-constexpr char const *TextFragmentShader = R"(
-#version 330
-
-in vec2 TexCoord;
-in vec3 Colour;
-uniform vec4 colour;
-uniform sampler2D fontTexture;
-out vec4 outColour;
-
-void main() {
-    float a = texture(fontTexture, TexCoord).a;
-    outColour = vec4(Colour, a);
-})";
-
 constexpr size_t GLYPHS_NB = 193;
 using FontWidthLut = std::array<std::uint8_t, GLYPHS_NB>;
 
@@ -116,30 +84,9 @@ glm::vec4 indexToTexCoord(size_t index, const glm::u32vec2 &textureSize,
     return glm::vec4(s, t, p, q);
 }
 
-struct TextVertex {
-    glm::vec2 position;
-    glm::vec2 texcoord;
-    glm::vec3 colour;
-
-    TextVertex(glm::vec2 _position, glm::vec2 _texcoord, glm::vec3 _colour)
-        : position(_position), texcoord(_texcoord), colour(_colour) {
-    }
-
-    TextVertex() = default;
-
-    static const AttributeList vertex_attributes() {
-        return {
-            {ATRS_Position, 2, sizeof(TextVertex), 0ul},
-            {ATRS_TexCoord, 2, sizeof(TextVertex), 0ul + sizeof(glm::vec2)},
-            {ATRS_Colour, 3, sizeof(TextVertex), 0ul + sizeof(glm::vec2) * 2},
-        };
-    }
-};
 }  // namespace
 
 TextRenderer::TextRenderer(GameRenderer &renderer) : renderer(renderer) {
-    textShader = renderer.getRenderer().createShader(TextVertexShader,
-                                                     TextFragmentShader);
 }
 
 void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
@@ -175,6 +122,9 @@ void TextRenderer::setFontTexture(font_t font, const std::string& textureName) {
         glyphOffset,
         monoWidth
     };
+    const auto& slots = renderer.getData().textureSlots;
+    fonts[font].slot = slots.findSlot("fonts");
+    fonts[font].texture = slots.findTexture(textureName);
 }
 
 void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
@@ -182,9 +132,6 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
     if (ti.text.empty() || ti.text[0] == '*')
         return;
 
-    renderer.getRenderer().pushDebugGroup("Text");
-    renderer.getRenderer().useProgram(textShader.get());
-
     glm::vec2 coord(0.f, 0.f);
     glm::vec2 alignment = ti.screenPosition;
     // We should track real size not just chars.
@@ -194,7 +141,7 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
 
     glm::vec3 colour = glm::vec3(ti.baseColour) * (1 / 255.f);
     glm::vec4 colourBG = glm::vec4(ti.backgroundColour) * (1 / 255.f);
-    std::vector<TextVertex> geo;
+    glyphs.clear();
 
     float maxWidth = 0.f;
     float maxHeight = ss.y;
@@ -307,13 +254,7 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
         }
         maxWidth = std::max(coord.x, maxWidth);
 
-        geo.emplace_back(glm::vec2{p.x, p.y + ss.y}, glm::vec2{tex.x, tex.w}, colour);
-        geo.emplace_back(glm::vec2{p.x + ss.x, p.y + ss.y}, glm::vec2{tex.z, tex.w}, colour);
-        geo.emplace_back(glm::vec2{p.x, p.y}, glm::vec2{tex.x, tex.y}, colour);
-
-        geo.emplace_back(glm::vec2{p.x + ss.x, p.y}, glm::vec2{tex.z, tex.y}, colour);
-        geo.emplace_back(glm::vec2{p.x, p.y}, glm::vec2{tex.x, tex.y}, colour);
-        geo.emplace_back(glm::vec2{p.x + ss.x, p.y + ss.y}, glm::vec2{tex.z, tex.w}, colour);
+        glyphs.push_back({glm::vec4(p, ss), tex, colour});
     }
 
     if (ti.align == TextInfo::TextAlignment::Right) {
@@ -331,24 +272,13 @@ void TextRenderer::renderText(const TextRenderer::TextInfo& ti,
                                 glm::vec2(maxWidth, maxHeight) + (ss / 2.f)));
     }
 
-    renderer.getRenderer().setUniform(
-        textShader.get(), "proj", renderer.getRenderer().get2DProjection());
-    renderer.getRenderer().setUniformTexture(textShader.get(), "fontTexture", 0);
-    renderer.getRenderer().setUniform(textShader.get(), "alignment", alignment);
-
-    gb.uploadVertices(geo);
-    db.addGeometry(&gb);
-    db.setFaceType(GL_TRIANGLES);
-
-    Renderer::DrawParameters dp;
-    dp.start = 0;
-    dp.blendMode = BlendMode::BLEND_ALPHA;
-    dp.count = gb.getCount();
-    auto fTexturePtr = renderer.getData().findSlotTexture("fonts", fontMetaData.textureName);
-    dp.textures = {{fTexturePtr->getName()}};
-    dp.depthMode = DepthMode::OFF;
-
-    renderer.getRenderer().drawArrays(glm::mat4(1.0f), &db, dp);
-
-    renderer.getRenderer().popDebugGroup();
+    // Glyphs are queued after the background so they land on top of it
+    auto fTexturePtr = renderer.getData().findSlotTexture(
+        fontMetaData.slot, fontMetaData.texture);
+    auto& sprites = renderer.getSpriteBatch();
+    for (const auto& g : glyphs) {
+        sprites.addRect(fTexturePtr->getName(),
+                        g.extents + glm::vec4(alignment, 0.f, 0.f), g.uv,
+                        glm::vec4(g.colour, 1.f), SpriteBatch::Mode::Glyph);
+    }
 }
@@ -4,11 +4,9 @@
 #include <array>
 #include <memory>
 #include <string>
-#include <array>
-
-#include <gl/DrawBuffer.hpp>
-#include <gl/GeometryBuffer.hpp>
+#include <vector>
 
+#include <engine/TextureResidency.hpp>
 #include <fonts/GameTexts.hpp>
 #include <render/OpenGLRenderer.hpp>
 
@@ -16,8 +14,8 @@ class GameRenderer;
 /**
  * @brief Handles rendering of bitmap font textures.
  *
- * In future, strings textures might be cached to improve performance, but
- * for now, we just render each glyph on it's own quad
+ * Each glyph is queued as a quad on the GameRenderer's SpriteBatch, so any
+ * number of strings in the same font are drawn together.
  */
 class TextRenderer {
 public:
@@ -83,14 +81,23 @@ private:
         glm::u32vec2 textureSize;
         glm::u8vec2 glyphOffset;
         std::uint8_t monoWidth;
+        /// Interned "fonts" slot and texture name
+        TextureResidency::SlotID slot = TextureResidency::kInvalid;
+        TextureResidency::TextureID texture = TextureResidency::kInvalid;
     };
 
     std::array<FontMetaData, FONTS_COUNT> fonts;
 
+    /// Glyph laid out by renderText before the line alignment is known
+    struct GlyphQuad {
+        glm::vec4 extents;
+        glm::vec4 uv;
+        glm::vec3 colour;
+    };
+
     GameRenderer& renderer;
-    std::unique_ptr<Renderer::ShaderProgram> textShader;
 
-    GeometryBuffer gb;
-    DrawBuffer db;
+    /// Reused between calls to avoid reallocating per string
+    std::vector<GlyphQuad> glyphs;
 };
 #endif
@@ -3,6 +3,13 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RW_FRUSTUM_SSE
+#endif
+
 glm::mat4 ViewFrustum::projection() const {
     return glm::perspective(fov / aspectRatio, aspectRatio, near, far);
 }
@@ -33,3 +40,64 @@ bool ViewFrustum::intersects(glm::vec3 center, float radius) const {
 
     return result;
 }
+
+void ViewFrustum::intersects(const float* x, const float* y, const float* z,
+                             const float* radius, std::size_t count,
+                             std::uint8_t* visible) const {
+    std::size_t i = 0;
+
+    // A sphere is rejected once it is entirely behind any plane. The
+    // comparison is "not less than" so NaNs are kept, like intersects() does.
+#if defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        const auto sx = _mm256_loadu_ps(x + i);
+        const auto sy = _mm256_loadu_ps(y + i);
+        const auto sz = _mm256_loadu_ps(z + i);
+        const auto nr = _mm256_sub_ps(_mm256_setzero_ps(),
+                                      _mm256_loadu_ps(radius + i));
+        auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            auto d = _mm256_mul_ps(sx, _mm256_set1_ps(plane.normal.x));
+            d = _mm256_add_ps(
+                d, _mm256_mul_ps(sy, _mm256_set1_ps(plane.normal.y)));
+            d = _mm256_add_ps(
+                d, _mm256_mul_ps(sz, _mm256_set1_ps(plane.normal.z)));
+            d = _mm256_add_ps(d, _mm256_set1_ps(plane.distance));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, nr, _CMP_NLT_UQ));
+        }
+        const auto mask = _mm256_movemask_ps(inside);
+        for (auto j = 0; j < 8; ++j) {
+            visible[i + j] = static_cast<std::uint8_t>((mask >> j) & 1);
+        }
+    }
+#elif defined(RW_FRUSTUM_SSE)
+    for (; i + 4 <= count; i += 4) {
+        const auto sx = _mm_loadu_ps(x + i);
+        const auto sy = _mm_loadu_ps(y + i);
+        const auto sz = _mm_loadu_ps(z + i);
+        const auto nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            auto d = _mm_mul_ps(sx, _mm_set1_ps(plane.normal.x));
+            d = _mm_add_ps(d, _mm_mul_ps(sy, _mm_set1_ps(plane.normal.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(sz, _mm_set1_ps(plane.normal.z)));
+            d = _mm_add_ps(d, _mm_set1_ps(plane.distance));
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(d, nr));
+        }
+        const auto mask = _mm_movemask_ps(inside);
+        for (auto j = 0; j < 4; ++j) {
+            visible[i + j] = static_cast<std::uint8_t>((mask >> j) & 1);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        bool inside = true;
+        for (const auto& plane : planes) {
+            const auto d = plane.normal.x * x[i] + plane.normal.y * y[i] +
+                           plane.normal.z * z[i] + plane.distance;
+            inside &= !(d < -radius[i]);
+        }
+        visible[i] = inside ? 1 : 0;
+    }
+}
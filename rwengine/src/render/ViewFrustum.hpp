@@ -1,6 +1,9 @@
 #ifndef _RWENGINE_VIEWFRUSTUM_HPP_
 #define _RWENGINE_VIEWFRUSTUM_HPP_
 
+#include <cstddef>
+#include <cstdint>
+
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
@@ -32,6 +35,16 @@ public:
     void update(const glm::mat4& proj);
 
     bool intersects(glm::vec3 center, float radius) const;
+
+    /**
+     * Tests count spheres stored as separate coordinate arrays, several at a
+     * time where the target has SSE or AVX
+     * @param visible set to 1 for spheres that intersects() would accept and
+     * 0 for the others
+     */
+    void intersects(const float* x, const float* y, const float* z,
+                    const float* radius, std::size_t count,
+                    std::uint8_t* visible) const;
 };
 
 #endif
@@ -1,6 +1,9 @@
 #include "render/WaterRenderer.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <utility>
 
 #include <glm/glm.hpp>
 
@@ -12,8 +15,10 @@
 #include "render/GameRenderer.hpp"
 #include "render/GameShaders.hpp"
 #include "render/OpenGLRenderer.hpp"
+#include "render/ViewFrustum.hpp"
 
-WaterRenderer::WaterRenderer(GameRenderer &renderer) {
+WaterRenderer::WaterRenderer(GameRenderer &renderer)
+    : hasContext(renderer.getRenderer().hasContext()) {
     maskDraw.setFaceType(GL_TRIANGLES);
     gridDraw.setFaceType(GL_TRIANGLES);
 
@@ -27,6 +32,15 @@ WaterRenderer::WaterRenderer(GameRenderer &renderer) {
     renderer.getRenderer().setProgramBlockBinding(maskProg.get(), "SceneData", 1);
 
     renderer.getRenderer().setUniformTexture(waterProg.get(), "data", 1);
+    timeUniform = Renderer::getUniform<float>(waterProg.get(), "time");
+    waveParamsUniform =
+        Renderer::getUniform<glm::vec2>(waterProg.get(), "waveParams");
+    inverseVPUniform =
+        Renderer::getUniform<glm::mat4>(waterProg.get(), "inverseVP");
+
+    if (!hasContext) {
+        return;
+    }
 
     // Generate grid mesh
     int gridres = 60;
@@ -63,30 +77,55 @@ void WaterRenderer::setWaterTable(const float* waterHeights, const unsigned int
     glm::vec2 wO{-WATER_WORLD_SIZE / 2.f, -WATER_WORLD_SIZE / 2.f};
 
     std::vector<glm::vec3> vertexData;
-
-    for (auto x = 0u; x < edgeNum; x++) {
-        int xi = x * WATER_HQ_DATA_SIZE;
-        for (auto y = 0u; y < edgeNum; y++) {
-            if (tiles[xi + y] >= nHeights) continue;
-
-            // Tiles with the magic value contain no water.
-            if (tiles[xi + y] >= NO_WATER_INDEX) continue;
-            float h = waterHeights[tiles[xi + y]];
-            float hMax = h + WATER_HEIGHT;
-            glm::vec2 tMin(wO + glm::vec2(x, y) * tileSize);
-            glm::vec2 tMax(wO + glm::vec2(x + 1, y + 1) * tileSize);
-
-            // Build geometry
-            vertexData.emplace_back(tMax.x, tMax.y, hMax);
-            vertexData.emplace_back(tMax.x, tMin.y, hMax);
-            vertexData.emplace_back(tMin.x, tMin.y, hMax);
-
-            vertexData.emplace_back(tMin.x, tMin.y, hMax);
-            vertexData.emplace_back(tMin.x, tMax.y, hMax);
-            vertexData.emplace_back(tMax.x, tMax.y, hMax);
+    chunks.clear();
+
+    for (auto cx = 0u; cx < edgeNum; cx += kChunkTiles) {
+        for (auto cy = 0u; cy < edgeNum; cy += kChunkTiles) {
+            const auto first = vertexData.size();
+            glm::vec3 cMin{std::numeric_limits<float>::max()};
+            glm::vec3 cMax{std::numeric_limits<float>::lowest()};
+
+            for (auto x = cx; x < std::min(cx + kChunkTiles, edgeNum); x++) {
+                int xi = x * WATER_HQ_DATA_SIZE;
+                for (auto y = cy; y < std::min(cy + kChunkTiles, edgeNum);
+                     y++) {
+                    if (tiles[xi + y] >= nHeights) continue;
+
+                    // Tiles with the magic value contain no water.
+                    if (tiles[xi + y] >= NO_WATER_INDEX) continue;
+                    float h = waterHeights[tiles[xi + y]];
+                    float hMax = h + WATER_HEIGHT;
+                    glm::vec2 tMin(wO + glm::vec2(x, y) * tileSize);
+                    glm::vec2 tMax(wO + glm::vec2(x + 1, y + 1) * tileSize);
+
+                    // Build geometry
+                    vertexData.emplace_back(tMax.x, tMax.y, hMax);
+                    vertexData.emplace_back(tMax.x, tMin.y, hMax);
+                    vertexData.emplace_back(tMin.x, tMin.y, hMax);
+
+                    vertexData.emplace_back(tMin.x, tMin.y, hMax);
+                    vertexData.emplace_back(tMin.x, tMax.y, hMax);
+                    vertexData.emplace_back(tMax.x, tMax.y, hMax);
+
+                    // The waves span twice WATER_HEIGHT above the water
+                    cMin = glm::min(cMin, glm::vec3(tMin, h));
+                    cMax = glm::max(cMax,
+                                    glm::vec3(tMax, h + 2.f * WATER_HEIGHT));
+                }
+            }
+
+            if (vertexData.size() > first) {
+                chunks.push_back({(cMin + cMax) * 0.5f,
+                                  glm::distance(cMin, cMax) * 0.5f, first,
+                                  vertexData.size() - first});
+            }
         }
     }
 
+    if (!hasContext) {
+        return;
+    }
+
     maskGeom.uploadVertices(static_cast<GLsizei>(vertexData.size()),
                             sizeof(glm::vec3) * vertexData.size(),
                             vertexData.data());
@@ -99,9 +138,29 @@ void WaterRenderer::setDataTexture(GLuint fbBinding, GLuint dataTex) {
     dataTexture = dataTex;
 }
 
-void WaterRenderer::render(GameRenderer &renderer, GameWorld* world) {
+void WaterRenderer::render(GameRenderer &renderer, GameWorld* world,
+                           const ViewFrustum& frustum) {
     auto& r = renderer.getRenderer();
 
+    // Adjacent visible chunks are drawn together
+    std::vector<std::pair<std::size_t, std::size_t>> runs;
+    visibleChunks = 0;
+    for (const auto& chunk : chunks) {
+        if (!frustum.intersects(chunk.center, chunk.radius)) {
+            continue;
+        }
+        visibleChunks++;
+        if (!runs.empty() &&
+            runs.back().first + runs.back().second == chunk.first) {
+            runs.back().second += chunk.count;
+        } else {
+            runs.emplace_back(chunk.first, chunk.count);
+        }
+    }
+    if (runs.empty()) {
+        return;
+    }
+
     auto waterTexPtr = world->data->findSlotTexture("particle", "water_old");
     RW_CHECK(waterTexPtr != nullptr, "Water texture is null");
     if (waterTexPtr == nullptr) {
@@ -110,47 +169,57 @@ void WaterRenderer::render(GameRenderer &renderer, GameWorld* world) {
     }
 
     Renderer::DrawParameters wdp;
-    wdp.start = 0;
-    wdp.count = maskGeom.getCount();
     wdp.textures = {{0}};
     glm::mat4 m(1.0);
 
-    glEnable(GL_STENCIL_TEST);
-    glDisable(GL_DEPTH_TEST);
+    GLenum buffers[] = {GL_COLOR_ATTACHMENT1};
+    if (hasContext) {
+        glEnable(GL_STENCIL_TEST);
+        glDisable(GL_DEPTH_TEST);
 
-    glStencilFunc(GL_ALWAYS, 1, 0xFF);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
-    glStencilMask(0xFF);
+        glStencilFunc(GL_ALWAYS, 1, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        glStencilMask(0xFF);
 
-    GLenum buffers[] = {GL_COLOR_ATTACHMENT1};
-    glDrawBuffers(1, buffers);
-    glClear(GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+        glDrawBuffers(1, buffers);
+        glClear(GL_STENCIL_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+    }
 
     r.useProgram(maskProg.get());
 
-    r.drawArrays(m, &maskDraw, wdp);
+    for (const auto& run : runs) {
+        wdp.start = run.first;
+        wdp.count = run.second;
+        r.drawArrays(m, &maskDraw, wdp);
+    }
 
-    glStencilFunc(GL_EQUAL, 1, 0xFF);
-    glStencilMask(0x00);
-    glDisable(GL_DEPTH_TEST);
+    if (hasContext) {
+        glStencilFunc(GL_EQUAL, 1, 0xFF);
+        glStencilMask(0x00);
+        glDisable(GL_DEPTH_TEST);
+    }
 
     r.useProgram(waterProg.get());
 
-    buffers[0] = GL_COLOR_ATTACHMENT0;
-    glDrawBuffers(1, buffers);
+    if (hasContext) {
+        buffers[0] = GL_COLOR_ATTACHMENT0;
+        glDrawBuffers(1, buffers);
+    }
 
-    r.setUniform(waterProg.get(), "time", world->getGameTime());
-    r.setUniform(waterProg.get(), "waveParams",
-                  glm::vec2(WATER_SCALE, WATER_HEIGHT));
+    r.setUniform(timeUniform, world->getGameTime());
+    r.setUniform(waveParamsUniform, glm::vec2(WATER_SCALE, WATER_HEIGHT));
     auto ivp =
         glm::inverse(r.getSceneData().projection * r.getSceneData().view);
-    r.setUniform(waterProg.get(), "inverseVP", ivp);
+    r.setUniform(inverseVPUniform, ivp);
 
+    wdp.start = 0;
     wdp.count = gridGeom.getCount();
     wdp.textures = {{waterTexPtr->getName(), dataTexture}};
 
     r.drawArrays(m, &gridDraw, wdp);
 
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_DEPTH_TEST);
+    if (hasContext) {
+        glDisable(GL_STENCIL_TEST);
+        glEnable(GL_DEPTH_TEST);
+    }
 }
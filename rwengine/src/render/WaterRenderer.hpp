@@ -1,6 +1,7 @@
 #ifndef _RWENGINE_WATERRENDERER_HPP_
 #define _RWENGINE_WATERRENDERER_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -12,9 +13,15 @@
 
 class GameRenderer;
 class GameWorld;
+class ViewFrustum;
 
 /**
  * Implements the rendering routines for drawing the sea water.
+ *
+ * The water tiles are grouped into square chunks whose triangles are stored
+ * contiguously in the mask geometry, so only the chunks inside the frustum
+ * are drawn into the stencil mask and the projected grid is skipped when
+ * none are.
  */
 class WaterRenderer {
 public:
@@ -36,23 +43,53 @@ public:
 
     /**
      * Render the water using the currently active render state
+     * @param frustum the chunks outside it are skipped
      */
-    void render(GameRenderer& renderer, GameWorld* world);
+    void render(GameRenderer& renderer, GameWorld* world,
+                const ViewFrustum& frustum);
+
+    /// Water tiles along each side of a chunk
+    static constexpr unsigned int kChunkTiles = 16;
+
+    std::size_t getChunkCount() const {
+        return chunks.size();
+    }
+
+    /// Chunks drawn by the last render call
+    std::size_t getVisibleChunkCount() const {
+        return visibleChunks;
+    }
 
 private:
+    struct Chunk {
+        /// Encloses the chunk's tiles and the waves above them
+        glm::vec3 center;
+        float radius;
+        /// Range of the chunk's vertices in the mask geometry
+        std::size_t first;
+        std::size_t count;
+    };
+
     std::unique_ptr<Renderer::ShaderProgram> waterProg = nullptr;
     std::unique_ptr<Renderer::ShaderProgram> maskProg = nullptr;
+    Renderer::Uniform<float> timeUniform;
+    Renderer::Uniform<glm::vec2> waveParamsUniform;
+    Renderer::Uniform<glm::mat4> inverseVPUniform;
 
     DrawBuffer maskDraw{};
     GeometryBuffer maskGeom{};
 
-    std::vector<int> maskSizes;
+    std::vector<Chunk> chunks;
+    std::size_t visibleChunks = 0;
 
     DrawBuffer gridDraw{};
     GeometryBuffer gridGeom{};
 
     GLuint fbOutput{};
     GLuint dataTexture{};
+
+    /// Geometry is only uploaded when the renderer has a GL context
+    bool hasContext = true;
 };
 
 #endif
@@ -1,5 +1,8 @@
 #include "script/ScriptMachine.hpp"
 
+#include <iterator>
+#include <string>
+
 #include "engine/GameWorld.hpp"
 #include "script/SCMFile.hpp"
 #include "script/ScriptFunctions.hpp"
@@ -31,9 +34,22 @@ constexpr char const* sprite_names[] = {
 }  // namespace
 
 const char* script::getBlipSprite(ScriptRadarSprite sprite) {
+    if (sprite < 0 ||
+        static_cast<std::size_t>(sprite) >= std::size(sprite_names)) {
+        return sprite_names[0];
+    }
     return sprite_names[sprite];
 }
 
+ScriptRadarSprite script::findBlipSprite(const std::string& texture) {
+    for (auto s = 1u; s < std::size(sprite_names); ++s) {
+        if (texture == sprite_names[s]) {
+            return static_cast<ScriptRadarSprite>(s);
+        }
+    }
+    return 0;
+}
+
 ScriptModel script::getModel(const ScriptArguments& args, ScriptModel model) {
     if (model < 0) {
         /// @todo verify that this is how the game uses negative models
@@ -168,6 +168,9 @@ inline BlipData& createBlip(const ScriptArguments& args, const ScriptVec3& coord
 
 const char* getBlipSprite(ScriptRadarSprite sprite);
 
+/// The sprite whose texture is named texture, 0 if there is none
+ScriptRadarSprite findBlipSprite(const std::string& texture);
+
 inline BlipData& createBlipSprite(const ScriptArguments& args, const ScriptVec3& coord,
                                   BlipData::BlipType type, int sprite) {
     auto& data = script::createBlip(args, coord, type);
@@ -48,6 +48,7 @@ void ScriptMachine::executeThread(SCMThread& t, int msPassed) {
         opcode = opcode & ~SCM_NEGATE_CONDITIONAL_MASK;
 
         ++opcodeCallCounts[opcode];
+        RW_TELEMETRY_COUNT(ScriptOps, 1);
 
         ScriptFunctionMeta* foundcode;
         if (!module->findOpcode(opcode, &foundcode)) {
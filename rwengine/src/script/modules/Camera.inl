@@ -283,6 +283,7 @@ void opcode_02e6(const ScriptArguments& args, const ScriptObject object,
     std::string animName = arg2;
     std::transform(animName.begin(), animName.end(), animName.begin(),
                    ::tolower);
+    args.getWorld()->finishLoadingCutscene();
     auto anim = args.getWorld()->data->animationsCutscene.at(animName);
     if (anim) {
         cutscene->animator->playAnimation(AnimIndexMovement, anim, 1.f, false);
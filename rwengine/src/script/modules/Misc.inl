@@ -101,8 +101,7 @@ void opcode_018c(const ScriptArguments& args, ScriptVec3 coord, const ScriptSoun
     @arg sound 
 */
 void opcode_018e(const ScriptArguments& args, const ScriptSound sound) {
-    RW_UNUSED(args);
-    sound->stop();
+    args.getWorld()->sound.stopSound(*sound);
 }
 
 /**
@@ -298,18 +297,20 @@ void opcode_03b6(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloa
     std::transform(newmodel.begin(), newmodel.end(), newmodel.begin(), ::tolower);
     std::transform(oldmodel.begin(), oldmodel.end(), oldmodel.begin(), ::tolower);
 
-    auto newobjectid = args.getWorld()->data->findModelObject(newmodel);
-    auto nobj = args.getWorld()->data->findModelInfo<SimpleModelInfo>(newobjectid);
-
-    for(auto& p : args.getWorld()->instancePool.objects) {
-        auto o = p.second.get();
-    	if( !o->getClump() ) continue;
-    	if( o->getModelInfo<BaseModelInfo>()->name != oldmodel ) continue;
-    	float d = glm::distance(coord, o->getPosition());
-    	if( d < radius ) {
-    		InstanceObject* inst = static_cast<InstanceObject*>(o);
-    		inst->changeModel(nobj);
-    	}
+    auto world = args.getWorld();
+    auto oldobjectid = world->data->findModelObject(oldmodel);
+    auto newobjectid = world->data->findModelObject(newmodel);
+    auto nobj = world->data->findModelInfo<SimpleModelInfo>(newobjectid);
+
+    std::vector<InstanceObject*> instances;
+    world->instanceIndex.gatherModel(oldobjectid, instances);
+    for (auto inst : instances) {
+        if (!inst->getClump()) continue;
+        float d = glm::distance(coord, inst->getPosition());
+        if (d < radius) {
+            inst->changeModel(nobj);
+            world->instanceIndex.updateModel(inst, oldobjectid);
+        }
     }
 }
 
@@ -385,8 +386,8 @@ bool opcode_03d2(const ScriptArguments& args) {
     opcode 03d8
 */
 void opcode_03d8(const ScriptArguments& args) {
-    RW_UNIMPLEMENTED_OPCODE(0x03d8);
-    RW_UNUSED(args);
+    // There is no save screen yet, save points write the autosave instead
+    args.getState()->saveRequested = true;
 }
 
 /**
@@ -591,6 +591,7 @@ void opcode_0107(const ScriptArguments& args, const ScriptModel model, ScriptVec
     coord = script::getGround(args, coord);
     object = args.getWorld()->createInstance(script::getModel(args, model), coord);
     object->setStatic(true);
+    object->setLifetime(GameObject::MissionLifetime);
 }
 
 /**
@@ -1159,17 +1160,10 @@ void opcode_020c(const ScriptArguments& args, ScriptVec3 coord, const ScriptExpl
     const float damageSize = 5.f;
     const float damage = 100.f;
 
-    for (auto& o : world->allObjects) {
-        switch (o->type()) {
-            case GameObject::Instance:
-            case GameObject::Vehicle:
-            case GameObject::Character:
-                break;
-            default:
-                continue;
-        }
+    std::vector<GameObject*> nearby;
+    world->gatherObjectsNear(coord, damageSize, nearby);
+    for (auto& o : nearby) {
         float d = glm::distance(coord, o->getPosition());
-        if (d > damageSize) continue;
         o->takeDamage({GameObject::DamageInfo::DamageType::Explosion,
                        coord, coord, damage / glm::max(d, 1.f), 0.f});
     }
@@ -1253,6 +1247,7 @@ void opcode_029b(const ScriptArguments& args, const ScriptModel model, ScriptVec
     coord = script::getGround(args, coord);
     object = args.getWorld()->createInstance(script::getModel(args, model), coord);
     object->setStatic(true);
+    object->setLifetime(GameObject::MissionLifetime);
 }
 
 /**
@@ -1910,21 +1905,15 @@ void opcode_035d(const ScriptArguments& args, const ScriptObject object) {
     @arg visible Boolean true/false
 */
 void opcode_0363(const ScriptArguments& args, ScriptVec3 coord, const ScriptFloat radius, const ScriptModel model, const ScriptBoolean visible) {
-    auto& models = args.getVM()->getFile().getModels();
-    auto& modelName = models[-model];
+    // Only instances with the correct model id are considered
+    std::vector<InstanceObject*> instances;
+    args.getWorld()->instanceIndex.gatherModel(
+        static_cast<ModelID>(script::getModel(args, model)), instances);
 
     // Attempt to find the closest object
     InstanceObject* closestObject = nullptr;
     float closestDistance = radius;
-    for(auto& i : args.getWorld()->instancePool.objects) {
-        InstanceObject* object = static_cast<InstanceObject*>(i.second.get());
-
-    	// Check if this instance has the correct model id, early out if it isn't
-    	auto modelinfo = object->getModelInfo<BaseModelInfo>();
-    	if (!boost::iequals(modelinfo->name, modelName)) {
-    		continue;
-    	}
-
+    for (auto object : instances) {
     	// Calculate distance and check if this is the new closest object
     	// @todo will this somehow respect the objects centre of mass / bounding box or something?
     	float distance = glm::length(object->position - coord);
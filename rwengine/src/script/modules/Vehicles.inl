@@ -288,18 +288,11 @@ void opcode_020b(const ScriptArguments& args, const ScriptVehicle vehicle) {
     const float damageSize = 5.f;
     const float damage = 100.f;
     auto self = vehicle.get();
-    for (auto& o : world->allObjects) {
+    std::vector<GameObject*> nearby;
+    world->gatherObjectsNear(pos, damageSize, nearby);
+    for (auto& o : nearby) {
         if (o == self) continue;
-        switch (o->type()) {
-            case GameObject::Instance:
-            case GameObject::Vehicle:
-            case GameObject::Character:
-                break;
-            default:
-                continue;
-        }
         float d = glm::distance(pos, o->getPosition());
-        if (d > damageSize) continue;
         o->takeDamage({GameObject::DamageInfo::DamageType::Explosion,
                        pos, pos, damage / glm::max(d, 1.f), 0.f});
     }
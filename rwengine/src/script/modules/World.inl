@@ -336,8 +336,7 @@ void opcode_03a5(const ScriptArguments& args, const ScriptGarage garage, const S
 */
 void opcode_03d7(const ScriptArguments& args, ScriptVec3 coord) {
     auto world = args.getWorld();
-    auto& wav = world->sound.getSoundRef(world->missionAudio);
-    wav.setPosition(coord);
+    world->sound.setSoundPosition(world->missionAudio, coord);
 }
 
 /**
@@ -1,6 +1,7 @@
 ﻿#include "GameBase.hpp"
 
 #include <core/Logger.hpp>
+#include <gl/NullContext.hpp>
 #include <rw/debug.hpp>
 #include "GitSHA1.h"
 
@@ -20,10 +21,22 @@ GameBase::GameBase(Logger &inlog, const std::optional<RWArgConfigLayer> &args) :
     bool fullscreen = config.fullscreen();
     size_t w = config.width(), h = config.height();
 
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0)
+    const bool headless = args.has_value() && args->headless;
+
+    // Headless runs have no display, only events and timers are needed
+    const Uint32 subsystems =
+        headless ? SDL_INIT_EVENTS | SDL_INIT_TIMER
+                 : SDL_INIT_VIDEO | SDL_INIT_TIMER;
+    if (SDL_Init(subsystems) < 0)
         throw std::runtime_error("Failed to initialize SDL2!");
 
-    window.create(kWindowTitle + " [" + kBuildStr + "]", w, h, fullscreen);
+    if (headless) {
+        loadNullGLFunctions();
+        window.createHeadless(w, h);
+    } else {
+        window.create(kWindowTitle + " [" + kBuildStr + "]", w, h,
+                      fullscreen);
+    }
 
     SET_RW_ABORT_CB([this]() {window.showCursor();},
             [this]() {window.hideCursor();});
@@ -60,7 +60,15 @@ void GameWindow::create(const std::string& title, size_t w, size_t h,
     SDL_ShowWindow(window);
 }
 
+void GameWindow::createHeadless(size_t w, size_t h) {
+    headlessSize = glm::ivec2(static_cast<int>(w), static_cast<int>(h));
+    headless = true;
+}
+
 void GameWindow::close() {
+    if (!window) {
+        return;
+    }
     SDL_GL_DeleteContext(glcontext);
     SDL_FreeSurface(icon);
     SDL_DestroyWindow(window);
@@ -77,6 +85,9 @@ void GameWindow::hideCursor() {
 }
 
 glm::ivec2 GameWindow::getSize() const {
+    if (!window) {
+        return headlessSize;
+    }
     int x, y;
     SDL_GL_GetDrawableSize(window, &x, &y);
 
@@ -84,6 +95,9 @@ glm::ivec2 GameWindow::getSize() const {
 }
 
 glm::ivec2 GameWindow::getLogicalSize() const {
+    if (!window) {
+        return headlessSize;
+    }
     int x, y;
     SDL_GetWindowSize(window, &x, &y);
 
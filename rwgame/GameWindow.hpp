@@ -13,10 +13,21 @@ class GameWindow {
     SDL_Window* window = nullptr;
     SDL_Surface* icon = nullptr;
     SDL_GLContext glcontext{nullptr};
+    glm::ivec2 headlessSize{};
+    bool headless = false;
 public:
     GameWindow() = default;
 
     void create(const std::string& title, size_t w, size_t h, bool fullscreen);
+
+    /// Set up without a window or GL context, only the size is kept so the
+    /// renderer can still lay out the frame. See loadNullGLFunctions().
+    void createHeadless(size_t w, size_t h);
+
+    bool isHeadless() const {
+        return headless;
+    }
+
     void close();
 
     void showCursor();
@@ -34,7 +45,9 @@ public:
     glm::ivec2 getLogicalSize() const;
 
     void swap() const {
-        SDL_GL_SwapWindow(window);
+        if (window) {
+            SDL_GL_SwapWindow(window);
+        }
     }
 
     bool isOpen() const {
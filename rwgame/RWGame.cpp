@@ -16,6 +16,7 @@
 #include <engine/Payphone.hpp>
 #include <engine/SaveGame.hpp>
 #include <objects/GameObject.hpp>
+#include <render/NullRenderer.hpp>
 
 #include <script/SCMFile.hpp>
 
@@ -26,6 +27,7 @@
 #include <objects/VehicleObject.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <iomanip>
@@ -48,6 +50,16 @@ static constexpr std::array<
                     {GameRenderer::Arrow, "arrow.dff", ""}}};
 
 constexpr float kMaxPhysicsSubSteps = 2;
+
+constexpr char kAutosaveFile[] = "GTA3sf8.b";
+
+std::unique_ptr<Renderer> createRenderer(const GameWindow& window) {
+    // Without a context draws are only counted, for headless benchmarks
+    if (window.isHeadless()) {
+        return std::make_unique<NullRenderer>();
+    }
+    return std::make_unique<OpenGLRenderer>();
+}
 }  // namespace
 
 #define MOUSE_SENSITIVITY_SCALE 2.5f
@@ -55,8 +67,9 @@ constexpr float kMaxPhysicsSubSteps = 2;
 RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     : GameBase(log, args)
     , data(&log, config.gamedataPath())
-    , renderer(&log, &data)
-    , imgui(*this) {
+    , renderer(&log, &data, createRenderer(window))
+    , imgui(*this)
+    , saveIndex(SaveGame::getSaveDirectory()) {
     RW_PROFILE_THREAD("Main");
     RW_TIMELINE_ENTER("Startup", MP_YELLOW);
 
@@ -65,14 +78,33 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     bool test = false;
     std::optional<std::string> startSave;
     std::optional<std::string> benchFile;
+    std::optional<std::string> benchReport;
+    bool transcodeTextures = false;
     if (args.has_value()) {
         newgame = args->newGame;
         test = args->test;
         startSave = args->loadGamePath;
         benchFile = args->benchmarkPath;
+        benchReport = args->benchmarkReport;
+        transcodeTextures = args->transcodeTextures;
+    }
+
+    // Benchmarks advance one simulation step per frame so runs are comparable
+    fixedTimestep = benchFile.has_value();
+    renderer.frameTimings = &frameTimings;
+
+    if (!window.isHeadless()) {
+        imgui.init();
     }
 
-    imgui.init();
+    // Look for changed saves while the game data loads
+    saveIndex.refresh();
+
+    if (config.textureCache() || transcodeTextures) {
+        data.setTextureCacheDirectory(TextureCache::defaultDirectory());
+    }
+    data.textureSlots.setBudget(
+        static_cast<std::size_t>(std::max(config.textureBudget(), 0)) << 20);
 
     log.info("Game", "Game directory: " + config.gamedataPath());
     if (!data.load()) {
@@ -80,6 +112,12 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
                                  config.gamedataPath());
     }
 
+    if (transcodeTextures) {
+        auto stored = data.transcodeTextures();
+        log.info("Game", "Transcoded " + std::to_string(stored) +
+                             " texture archives");
+    }
+
     for (const auto& [specialModel, fileName, name] : kSpecialModels) {
         auto model = data.loadClump(fileName, name);
         renderer.setSpecialModel(specialModel, model);
@@ -106,15 +144,18 @@ RWGame::RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args)
     getRenderer().water.setWaterTable(data.waterHeights, 48, data.realWater,
                                       128 * 128);
 
+    // The map looks the radar tiles up by name, they must never be evicted
     for (int m = 0; m < MAP_BLOCK_SIZE; ++m) {
         std::ostringstream oss;
-        oss << "radar" << std::setw(2) << std::setfill('0') << m << ".txd";
-        data.loadTXD(oss.str());
+        oss << "radar" << std::setw(2) << std::setfill('0') << m;
+        data.loadTXD(oss.str() + ".txd");
+        data.textureSlots.setPinned(data.textureSlots.findSlot(oss.str()),
+                                    true);
     }
 
     stateManager.enter<LoadingState>(this, [=]() {
         if (benchFile.has_value()) {
-            stateManager.enter<BenchmarkState>(this, *benchFile);
+            stateManager.enter<BenchmarkState>(this, *benchFile, benchReport);
         } else if (test) {
             stateManager.enter<IngameState>(this, true, "test");
         } else if (newgame) {
@@ -146,6 +187,8 @@ void RWGame::newGame() {
     // Destroy the current world and start over
     world = std::make_unique<GameWorld>(&log, &data);
     world->dynamicsWorld->setDebugDrawer(&debug);
+    world->sound.setStreamingChunkSize(
+        static_cast<unsigned int>(std::max(config.audioChunkSize(), 0)));
 
     // Associate the new world with the new state and vice versa
     state.world = world.get();
@@ -188,7 +231,25 @@ bool RWGame::hitWorldRay(const glm::vec3 &start, const glm::vec3 &direction, glm
 }
 
 void RWGame::saveGame(const std::string& savename) {
-    RW_UNUSED(savename);
+    if (pendingSave.valid() && pendingSave.wait_for(std::chrono::seconds(0)) !=
+                                   std::future_status::ready) {
+        log.warning("Game", "Already saving, skipped save to " + savename);
+        return;
+    }
+
+    log.info("Game", "Saving game " + savename);
+
+    // The state is copied out now, only the file IO happens in the background
+    pendingSave = SaveGame::writeGameAsync(state, savename);
+}
+
+void RWGame::autosave() {
+    const auto saveDir = SaveGame::getSaveDirectory();
+    if (saveDir.empty()) {
+        log.warning("Game", "No save directory, skipped autosave");
+        return;
+    }
+    saveGame((saveDir / kAutosaveFile).string());
 }
 
 void RWGame::loadGame(const std::string& savename) {
@@ -425,6 +486,9 @@ int RWGame::run() {
         RW_PROFILE_FRAME_BOUNDARY();
         RW_PROFILE_SCOPE("Main Loop");
 
+        const auto frameStart = chrono::steady_clock::now();
+        frameTimings.reset();
+
         running = updateInput();
 
         auto currentFrame = chrono::steady_clock::now();
@@ -432,6 +496,10 @@ int RWGame::run() {
             chrono::duration<float>(currentFrame - lastFrame).count();
         lastFrame = currentFrame;
 
+        if (fixedTimestep) {
+            frameTime = deltaTime;
+        }
+
         if (!world->isPaused()) {
             accumulatedTime += frameTime;
 
@@ -445,8 +513,16 @@ int RWGame::run() {
 
         render(1, frameTime);
 
+        frameTimings.draws = getRenderer().getRenderer().getDrawCount();
+        frameTimings.occluded = getRenderer().getOccludedCount();
+        RW_TELEMETRY_COUNT(Draws, frameTimings.draws);
         getWindow().swap();
 
+        frameTimings.frameMs = chrono::duration<double, std::milli>(
+                                   chrono::steady_clock::now() - frameStart)
+                                   .count();
+        lastFrameTimings = frameTimings;
+
         // Make sure the topmost state is the correct state
         stateManager.updateStack();
     }
@@ -458,6 +534,7 @@ int RWGame::run() {
 
 float RWGame::tickWorld(const float deltaTime, float accumulatedTime) {
     RW_PROFILE_SCOPEC(__func__, MP_GREEN);
+    FrameTimings::Scope timing(&frameTimings, FrameTimings::Simulation);
     auto deltaTimeWithTimeScale =
             deltaTime * world->state->basic.timeScale;
 
@@ -530,6 +607,19 @@ void RWGame::tick(float dt) {
     RW_PROFILE_SCOPE(__func__);
     State* currState = stateManager.states.back().get();
 
+    if (pendingSave.valid() && pendingSave.wait_for(std::chrono::seconds(0)) ==
+                                   std::future_status::ready) {
+        if (!pendingSave.get()) {
+            log.error("Game", "Failed to save game");
+        }
+        saveIndex.refresh();
+    }
+
+    if (state.saveRequested) {
+        state.saveRequested = false;
+        autosave();
+    }
+
     static float clockAccumulator = 0.f;
     static float scriptTimerAccumulator = 0.f;
     static ScriptInt beepTime = std::numeric_limits<ScriptInt>::max();
@@ -584,6 +674,8 @@ void RWGame::tick(float dt) {
         state.text.tick(dt);
 
         if (vm) {
+            FrameTimings::Scope scriptTiming(&frameTimings,
+                                             FrameTimings::Script);
             try {
                 vm->execute(dt);
             } catch (SCMException& ex) {
@@ -614,6 +706,7 @@ void RWGame::tickObjects(float dt) const {
     {
         RW_PROFILE_SCOPEC("allObjects", MP_HOTPINK1);
         RW_PROFILE_COUNTER_SET("tickObjects/allObjects", world->allObjects.size());
+        RW_TELEMETRY_COUNT(ObjectsTicked, world->allObjects.size());
         for (auto &object : world->allObjects) {
             object->tick(dt);
         }
@@ -638,6 +731,7 @@ void RWGame::tickObjects(float dt) const {
 
 void RWGame::render(float alpha, float time) {
     RW_PROFILE_SCOPEC(__func__, MP_CORNFLOWERBLUE);
+    FrameTimings::Scope timing(&frameTimings, FrameTimings::Submit);
     RW_UNUSED(time);
 
     lastDraws = getRenderer().getRenderer().getDrawCount();
@@ -671,8 +765,10 @@ void RWGame::render(float alpha, float time) {
 
     world->sound.updateListenerTransform(viewCam);
 
-    glEnable(GL_DEPTH_TEST);
-    glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+    if (renderer.getRenderer().hasContext()) {
+        glEnable(GL_DEPTH_TEST);
+        glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+    }
 
     renderer.getRenderer().pushDebugGroup("World");
 
@@ -689,6 +785,9 @@ void RWGame::render(float alpha, float time) {
         stateManager.draw(renderer);
     }
 
+    // HUD, menus and text are queued during the frame and drawn together
+    renderer.flush2D();
+
     imgui.endFrame(viewCam);
 }
 
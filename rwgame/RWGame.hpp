@@ -8,9 +8,11 @@
 #include "StateManager.hpp"
 #include "game.hpp"
 
+#include <core/FrameTimings.hpp>
 #include <engine/GameData.hpp>
 #include <engine/GameState.hpp>
 #include <engine/GameWorld.hpp>
+#include <engine/SaveGameIndex.hpp>
 #include <render/DebugDraw.hpp>
 #include <render/GameRenderer.hpp>
 #include <script/SCMFile.hpp>
@@ -20,6 +22,7 @@
 #include <SDL_events.h>
 
 #include <chrono>
+#include <future>
 
 class RWGame final : public GameBase {
 public:
@@ -55,6 +58,15 @@ private:
 
     std::string cheatInputWindow = std::string(32, ' ');
 
+    /// Save being written in the background by saveGame()
+    std::future<bool> pendingSave;
+    SaveGameIndex saveIndex;
+
+    /// Step the simulation once per frame instead of following the clock
+    bool fixedTimestep = false;
+    FrameTimings frameTimings;
+    FrameTimings lastFrameTimings;
+
 public:
     RWGame(Logger& log, const std::optional<RWArgConfigLayer> &args);
     ~RWGame() override;
@@ -94,6 +106,17 @@ public:
         return hudDrawer;
     }
 
+    SaveGameIndex& getSaveIndex() {
+        return saveIndex;
+    }
+
+    /**
+     * CPU timings of the last completed frame
+     */
+    const FrameTimings& getLastFrameTimings() const {
+        return lastFrameTimings;
+    }
+
     DebugViewMode getDebugViewMode() const {
         return debugview_;
     }
@@ -114,6 +137,9 @@ public:
     void saveGame(const std::string& savename);
     void loadGame(const std::string& savename);
 
+    /// Saves to the autosave slot, as the scripts' save points request
+    void autosave();
+
 private:
     void tick(float dt);
     void render(float alpha, float dt);
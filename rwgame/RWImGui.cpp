@@ -53,8 +53,9 @@ void WindowDebugStats(RWGame& game) {
                 time_max);
     ImGui::Text("Timescale %.2f",
                 static_cast<double>(world->state->basic.timeScale));
-    ImGui::Text("%i Drawn %lu Culled", renderer.getRenderer().getDrawCount(),
-                renderer.getCulledCount());
+    ImGui::Text("%i Drawn %lu Culled (%lu Occluded)",
+                renderer.getRenderer().getDrawCount(),
+                renderer.getCulledCount(), renderer.getOccludedCount());
     ImGui::Text("%i Textures %i Buffers",
                 renderer.getRenderer().getTextureCount(),
                 renderer.getRenderer().getBufferCount());
@@ -186,6 +187,9 @@ void RWImGui::startFrame() {
 }
 
 void RWImGui::endFrame(const ViewCamera& camera) {
+    if (!_context) {
+        return;
+    }
     switch (_game.getDebugViewMode()) {
         case RWGame::DebugViewMode::General:
             WindowDebugStats(_game);
@@ -1,6 +1,7 @@
 #define SDL_MAIN_HANDLED
 
 #include <iostream>
+#include <string_view>
 
 #include "RWGame.hpp"
 #include <SDL.h>
@@ -17,6 +18,22 @@ int main(int argc, const char* argv[]) {
     // Initialize tracing / debugging utils.
     RW_init_trace_opts((RW_TRACE_KIND) 0xFFFFFF);
 
+    // Messages and traces are written out on the logger's own thread, so
+    // tracing doesn't stall the threads that produce it
+    logger.setAsync(true);
+    RW_set_trace_sink([&logger](const char* line) {
+        std::string_view message(line);
+        if (!message.empty() && message.back() == '\n') {
+            message.remove_suffix(1);
+        }
+        logger.verbose("Trace", message);
+    });
+    struct TraceSinkReset {
+        ~TraceSinkReset() {
+            RW_set_trace_sink(nullptr);
+        }
+    } traceSinkReset;
+
     RWArgumentParser argParser;
     auto argLayerOpt = argParser.parseArguments(argc, argv);
     if (!argLayerOpt.has_value()) {
@@ -1,14 +1,126 @@
 #include "BenchmarkState.hpp"
 #include <engine/GameState.hpp>
+#include "GitSHA1.h"
 #include "RWGame.hpp"
+#include "game.hpp"
 
+#include <gl/gl_core_3_3.h>
 #include <glm/gtc/quaternion.hpp>
+#include <rw/accounting.hpp>
+#include <rw/debug.hpp>
 
+#include <SDL_cpuinfo.h>
+#include <SDL_platform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <numeric>
+
+#ifdef RW_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+/// Frames slower than this are counted as hitches
+constexpr double kHitchMs = 1000.0 / 30.0;
+/// Frames slower than this multiple of the median are counted as spikes
+constexpr double kSpikeFactor = 2.0;
+
+struct Summary {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Summary summarise(std::vector<double> values) {
+    Summary s;
+    if (values.empty()) {
+        return s;
+    }
+    std::sort(values.begin(), values.end());
+    const auto percentile = [&](double q) {
+        const auto rank = static_cast<std::size_t>(
+            std::ceil(q * static_cast<double>(values.size())));
+        return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+    };
+    s.mean = std::accumulate(values.begin(), values.end(), 0.0) /
+             static_cast<double>(values.size());
+    s.p50 = percentile(0.50);
+    s.p95 = percentile(0.95);
+    s.p99 = percentile(0.99);
+    s.max = values.back();
+    return s;
+}
+
+std::uint64_t peakResidentBytes() {
+#ifdef RW_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                             sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef RW_OSX
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    // Reported in kilobytes everywhere but macOS
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+std::string jsonString(const std::string& str) {
+    std::string out = "\"";
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    out += c;
+                }
+                break;
+        }
+    }
+    return out + "\"";
+}
+
+std::string glString(GLenum name) {
+    const auto str = glGetString(name);
+    return str ? reinterpret_cast<const char*>(str) : "";
+}
 
-BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile)
-    : State(game), benchfile(benchfile) {
+void writeSummary(std::ostream& os, const Summary& s) {
+    os << "{\"mean\": " << s.mean << ", \"p50\": " << s.p50
+       << ", \"p95\": " << s.p95 << ", \"p99\": " << s.p99
+       << ", \"max\": " << s.max << "}";
+}
+}  // namespace
+
+BenchmarkState::BenchmarkState(RWGame* game, const std::string& benchfile,
+                               const std::optional<std::string>& reportfile)
+    : State(game), benchfile(benchfile), reportfile(reportfile) {
 }
 
 void BenchmarkState::enter() {
@@ -56,43 +168,153 @@ void BenchmarkState::enter() {
         track.push_back(point);
     }
 
+    // One sample per frame at the fixed timestep
+    frames.reserve(static_cast<std::size_t>(duration / GAME_TIMESTEP) + 1);
+
     std::cout << "Loaded " << track.size() << " points" << '\n';
 }
 
 void BenchmarkState::exit() {
+    // Measured on the wall clock, the track itself runs at the fixed timestep
+    std::vector<double> frameMs;
+    frameMs.reserve(frames.size());
+    for (const auto& f : frames) {
+        frameMs.push_back(f.frameMs);
+    }
+    const auto frameSummary = summarise(frameMs);
+    const auto fps = frameSummary.mean > 0.0 ? 1000.0 / frameSummary.mean
+                                             : 0.0;
+
     std::cout << "Results =============\n"
               << "Benchmark: " << benchfile << "\n"
               << "Frames: " << frameCounter << "\n"
               << "Duration: " << duration << " seconds\n"
               << "Avg frametime: " << std::setprecision(3)
-              << (duration / frameCounter) << " (" << (frameCounter / duration)
-              << " fps)" << '\n';
+              << frameSummary.mean << " ms (" << fps << " fps)" << '\n'
+              << "Frame time p50/p95/p99/max: " << frameSummary.p50 << " / "
+              << frameSummary.p95 << " / " << frameSummary.p99 << " / "
+              << frameSummary.max << " ms\n";
+
+    std::vector<double> draws;
+    std::vector<double> occluded;
+    for (const auto& f : frames) {
+        draws.push_back(static_cast<double>(f.draws));
+        occluded.push_back(static_cast<double>(f.occluded));
+    }
+    std::cout << "Avg draws: " << summarise(draws).mean
+              << ", occluded instances: " << summarise(occluded).mean << '\n';
+
+    if (reportfile) {
+        writeReport(*reportfile);
+    }
+}
+
+void BenchmarkState::writeReport(const std::string& path) const {
+    std::ofstream report(path);
+    if (!report) {
+        RW_ERROR("Failed to open benchmark report " << path);
+        return;
+    }
+
+    std::vector<double> values(frames.size());
+    const auto summariseBy = [&](auto&& get) {
+        std::transform(frames.begin(), frames.end(), values.begin(), get);
+        return summarise(values);
+    };
+
+    const auto frame =
+        summariseBy([](const FrameTimings& f) { return f.frameMs; });
+    const auto hitches = std::count_if(
+        frames.begin(), frames.end(),
+        [](const FrameTimings& f) { return f.frameMs > kHitchMs; });
+    const auto spikes = std::count_if(
+        frames.begin(), frames.end(), [&](const FrameTimings& f) {
+            return f.frameMs > frame.p50 * kSpikeFactor;
+        });
+
+    report << std::fixed << std::setprecision(3);
+    report << "{\n"
+           << "  \"benchmark\": " << jsonString(benchfile) << ",\n"
+           << "  \"commit\": " << jsonString(kGitSHA1Hash) << ",\n"
+           << "  \"machine\": {\"platform\": " << jsonString(SDL_GetPlatform())
+           << ", \"cpus\": " << SDL_GetCPUCount()
+           << ", \"ramMB\": " << SDL_GetSystemRAM()
+           << ", \"renderer\": "
+           << jsonString(game->getRenderer().getRenderer().getIDString())
+           << ", \"glRenderer\": " << jsonString(glString(GL_RENDERER))
+           << ", \"glVersion\": " << jsonString(glString(GL_VERSION))
+           << "},\n"
+           << "  \"timestep\": " << GAME_TIMESTEP << ",\n"
+           << "  \"frames\": " << frames.size() << ",\n"
+           << "  \"frameMs\": ";
+    writeSummary(report, frame);
+    report << ",\n  \"sectionMs\": {";
+    for (std::size_t s = 0; s < FrameTimings::SectionCount; ++s) {
+        report << (s ? ",\n    " : "\n    ")
+               << jsonString(FrameTimings::kSectionNames[s]) << ": ";
+        writeSummary(report, summariseBy([s](const FrameTimings& f) {
+                         return f.ms[s];
+                     }));
+    }
+    report << "\n  },\n"
+           << "  \"draws\": ";
+    writeSummary(report, summariseBy([](const FrameTimings& f) {
+                     return static_cast<double>(f.draws);
+                 }));
+    report << ",\n  \"occluded\": ";
+    writeSummary(report, summariseBy([](const FrameTimings& f) {
+                     return static_cast<double>(f.occluded);
+                 }));
+    report << ",\n"
+           << "  \"hitches\": {\"overMs\": " << kHitchMs
+           << ", \"count\": " << hitches
+           << ", \"overMedianFactor\": " << kSpikeFactor
+           << ", \"spikes\": " << spikes << "},\n"
+           << "  \"peakResidentBytes\": " << peakResidentBytes() << ",\n"
+           << "  \"memoryBytes\": {";
+    for (std::size_t c = 0; c < MemoryAccounting::kCategoryCount; ++c) {
+        const auto totals =
+            MemoryAccounting::get(static_cast<MemoryCategory>(c));
+        report << (c ? ",\n    " : "\n    ")
+               << jsonString(MemoryAccounting::kCategoryNames[c])
+               << ": {\"live\": " << totals.live
+               << ", \"peak\": " << totals.peak
+               << ", \"allocations\": " << totals.allocations << "}";
+    }
+    report << "\n  }\n"
+           << "}\n";
+
+    std::cout << "Wrote benchmark report to " << path << '\n';
 }
 
 void BenchmarkState::tick(float dt) {
     if (!track.empty()) {
-        TrackPoint& a = track.front();
-        TrackPoint& b = track.back();
-        for (TrackPoint& p : track) {
+        const TrackPoint* a = &track.front();
+        const TrackPoint* b = &track.back();
+        for (const TrackPoint& p : track) {
             if (benchmarkTime < p.time) {
-                b = p;
+                b = &p;
                 break;
             }
-            a = p;
+            a = &p;
         }
         if (benchmarkTime > duration) {
             done();
         }
-        if (b.time != a.time) {
-            float alpha = (benchmarkTime - a.time) / (b.time - a.time);
-            trackCam.position = glm::mix(a.position, b.position, alpha);
-            trackCam.rotation = glm::slerp(a.angle, b.angle, alpha);
+        if (b->time != a->time) {
+            float alpha = (benchmarkTime - a->time) / (b->time - a->time);
+            trackCam.position = glm::mix(a->position, b->position, alpha);
+            trackCam.rotation = glm::slerp(a->angle, b->angle, alpha);
         }
         benchmarkTime += dt;
     }
 }
 
 void BenchmarkState::draw(GameRenderer& r) {
+    // The previous frame has finished, including its buffer swap
+    if (frameCounter > 0) {
+        frames.push_back(game->getLastFrameTimings());
+    }
     frameCounter++;
     State::draw(r);
 }
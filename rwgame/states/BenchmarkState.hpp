@@ -3,11 +3,13 @@
 
 #include "State.hpp"
 
+#include <core/FrameTimings.hpp>
 #include <render/ViewCamera.hpp>
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -22,13 +24,20 @@ class BenchmarkState final : public State {
     ViewCamera trackCam;
 
     std::string benchfile;
+    std::optional<std::string> reportfile;
 
     float benchmarkTime{0.f};
     float duration{0.f};
     uint32_t frameCounter{0};
 
+    /// Timings of every frame drawn while running the track
+    std::vector<FrameTimings> frames;
+
+    void writeReport(const std::string& path) const;
+
 public:
-    BenchmarkState(RWGame* game, const std::string& benchfile);
+    BenchmarkState(RWGame* game, const std::string& benchfile,
+                   const std::optional<std::string>& reportfile = std::nullopt);
 
     void enter() override;
 
@@ -4,6 +4,8 @@
 #include "RWGame.hpp"
 
 #include <ai/PlayerController.hpp>
+#include <core/Logger.hpp>
+#include <core/Telemetry.hpp>
 #include <data/WeaponData.hpp>
 #include <engine/GameState.hpp>
 #include <objects/CharacterObject.hpp>
@@ -13,9 +15,12 @@
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <rw/accounting.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <imgui.h>
 
@@ -71,6 +76,10 @@ void DebugState::drawDebugMenu() {
             game->getRenderer().setCullOverride(true, _debugCam);
         }
 
+        if (ImGui::MenuItem("Quick Save")) {
+            game->autosave();
+        }
+
         ImGui::EndMenu();
     }
 
@@ -104,6 +113,16 @@ void DebugState::drawDebugMenu() {
         ImGui::EndMenu();
     }
 
+    if (ImGui::BeginMenu("Telemetry")) {
+        drawTelemetryMenu();
+        ImGui::EndMenu();
+    }
+
+    if (ImGui::BeginMenu("Memory")) {
+        drawMemoryMenu();
+        ImGui::EndMenu();
+    }
+
     ImGui::End();
 }
 
@@ -245,6 +264,74 @@ void DebugState::drawWeatherMenu() {
     }
 }
 
+void DebugState::drawTelemetryMenu() {
+    auto& telemetry = Telemetry::get();
+
+    bool recording = telemetry.isEnabled();
+    if (ImGui::Checkbox("Record Scopes", &recording)) {
+        telemetry.setEnabled(recording);
+    }
+
+    const auto frames = telemetry.getFrames();
+    if (!frames.empty()) {
+        std::vector<float> times;
+        times.reserve(frames.size());
+        for (const auto& frame : frames) {
+            times.push_back(static_cast<float>(frame.ms()));
+        }
+        const auto worst = *std::max_element(times.begin(), times.end());
+        ImGui::PlotLines("Frame (ms)", times.data(),
+                         static_cast<int>(times.size()), 0, nullptr, 0.f,
+                         std::max(worst, 33.3f), ImVec2(300.f, 60.f));
+        ImGui::Text("Last %zu frames, worst %.2f ms", frames.size(), worst);
+
+        const auto& last = frames.back();
+        for (std::size_t c = 0; c < Telemetry::CounterCount; ++c) {
+            ImGui::Text("%s: %lld", Telemetry::kCounterNames[c],
+                        static_cast<long long>(last.counters[c]));
+        }
+    }
+
+    if (ImGui::MenuItem("Write Chrome Trace")) {
+        const std::string path = "openrw-trace.json";
+        auto logger = game->getWorld()->logger;
+        if (telemetry.writeChromeTrace(path)) {
+            logger->info("Telemetry", "Wrote trace to " + path);
+        } else {
+            logger->error("Telemetry", "Failed to write " + path);
+        }
+    }
+    if (ImGui::MenuItem("Clear")) {
+        telemetry.clear();
+    }
+}
+
+void DebugState::drawMemoryMenu() {
+    const auto mib = [](std::int64_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    };
+
+    for (std::size_t c = 0; c < MemoryAccounting::kCategoryCount; ++c) {
+        const auto totals =
+            MemoryAccounting::get(static_cast<MemoryCategory>(c));
+        ImGui::Text("%s: %.2f MiB, peak %.2f MiB, %lld live",
+                    MemoryAccounting::kCategoryNames[c], mib(totals.live),
+                    mib(totals.peak),
+                    static_cast<long long>(totals.allocations));
+    }
+    ImGui::Text("Total: %.2f MiB", mib(MemoryAccounting::live()));
+
+    const auto& slots = game->getGameData().textureSlots;
+    ImGui::Text("Texture slots: %zu resident, %.2f of %.2f MiB",
+                slots.getResidentCount(),
+                mib(static_cast<std::int64_t>(slots.getResidentSize())),
+                mib(static_cast<std::int64_t>(slots.getBudget())));
+
+    if (ImGui::MenuItem("Reset Peaks")) {
+        MemoryAccounting::resetPeaks();
+    }
+}
+
 void DebugState::drawMissionsMenu() {
     static constexpr std::array<char const*, 80> w{{
         "Intro Movie",
@@ -25,6 +25,8 @@ class DebugState final : public State {
     void drawWeaponMenu();
     void drawWeatherMenu();
     void drawMissionsMenu();
+    void drawTelemetryMenu();
+    void drawMemoryMenu();
 
 public:
     DebugState(RWGame* game, const glm::vec3& vp = {},
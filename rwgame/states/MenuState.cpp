@@ -14,6 +14,7 @@ MenuState::MenuState(RWGame* game) : State(game) {
 }
 
 void MenuState::enterMainMenu() {
+    inLoadMenu = false;
     auto& t = game->getGameData().texts;
 
     Menu menu{
@@ -32,9 +33,16 @@ void MenuState::enterMainMenu() {
 }
 
 void MenuState::enterLoadMenu() {
+    // Show the indexed saves now, tick() picks up any changes found later
+    game->getSaveIndex().refresh();
+    inLoadMenu = true;
+    showSaves();
+}
+
+void MenuState::showSaves() {
     Menu menu{{{"BACK", [=] { enterMainMenu(); }}}, glm::vec2(20.f, 30.f)};
 
-    auto saves = SaveGame::getAllSaveGameInfo();
+    auto saves = game->getSaveIndex().getSaves();
     for (SaveGameInfo& save : saves) {
         if (save.valid) {
             std::stringstream ss;
@@ -67,6 +75,10 @@ void MenuState::exit() {
 
 void MenuState::tick(float dt) {
     RW_UNUSED(dt);
+
+    if (game->getSaveIndex().pollChanged() && inLoadMenu) {
+        showSaves();
+    }
 }
 
 void MenuState::handleEvent(const SDL_Event& e) {
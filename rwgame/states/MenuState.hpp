@@ -17,6 +17,12 @@ public:
     virtual void enterLoadMenu();
 
     void handleEvent(const SDL_Event& event) override;
+
+private:
+    void showSaves();
+
+    /// Rebuild the load menu when the save index changes
+    bool inLoadMenu = false;
 };
 
 #endif  // MENUSTATE_HPP
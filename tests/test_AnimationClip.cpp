@@ -0,0 +1,100 @@
+#include <boost/test/unit_test.hpp>
+#include <data/AnimationClip.hpp>
+#include <loaders/LoaderIFP.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+std::vector<AnimationKeyframe> makeFrames(std::size_t count, float offset) {
+    std::vector<AnimationKeyframe> frames;
+    for (auto k = 0u; k < count; ++k) {
+        const auto time = static_cast<float>(k) * 0.25f;
+        frames.emplace_back(
+            glm::angleAxis(time * 2.f + offset,
+                           glm::normalize(glm::vec3(1.f, 2.f, 3.f))),
+            glm::vec3(offset, time * 3.f, -time), glm::vec3(1.f), time,
+            static_cast<int>(k));
+    }
+    return frames;
+}
+
+/// q and -q are the same rotation
+float rotationError(const glm::quat& a, const glm::quat& b) {
+    return 1.f - std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AnimationClipTests)
+
+BOOST_AUTO_TEST_CASE(test_rotation_packing) {
+    for (auto i = 0; i < 64; ++i) {
+        const auto angle = static_cast<float>(i) * 0.7f;
+        const auto axis = glm::normalize(
+            glm::vec3(std::sin(angle), std::cos(angle * 3.f), 0.5f));
+        const auto q = glm::angleAxis(angle, axis);
+        const auto unpacked =
+            AnimationClip::unpackRotation(AnimationClip::packRotation(q));
+        BOOST_CHECK_SMALL(rotationError(q, unpacked), 1e-5f);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sample_matches_bone) {
+    const auto frames = makeFrames(9, 1.f);
+    AnimationBone bone("bone", 0, 0, 2.f, AnimationBone::RT0, frames);
+
+    AnimationClip clip;
+    clip.addChannel("bone", AnimationBone::RT0, frames);
+    BOOST_REQUIRE_EQUAL(clip.getChannelCount(), 1u);
+
+    // Forwards, then jumping back, through the same cursor
+    std::uint32_t cursor = 0;
+    for (auto pass = 0; pass < 2; ++pass) {
+        for (auto t = 0.f; t < 2.5f; t += 0.05f) {
+            const auto expected = bone.getInterpolatedKeyframe(t);
+            const auto sampled = clip.sample(0, t, cursor);
+            BOOST_CHECK_SMALL(rotationError(expected.rotation,
+                                            sampled.rotation),
+                              1e-5f);
+            BOOST_CHECK_SMALL(glm::distance(expected.position,
+                                            sampled.position),
+                              1e-3f);
+            BOOST_CHECK_EQUAL(expected.id, sampled.id);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_channels_share_times) {
+    AnimationClip clip;
+    clip.addChannel("a", AnimationBone::RT0, makeFrames(32, 0.f));
+    const auto single = clip.getMemorySize();
+    clip.addChannel("b", AnimationBone::R00, makeFrames(32, 0.5f));
+    clip.addChannel("empty", AnimationBone::R00, {});
+
+    BOOST_CHECK_EQUAL(clip.getChannelCount(), 2u);
+    BOOST_CHECK_EQUAL(clip.findChannel("b"), 1u);
+    BOOST_CHECK_EQUAL(clip.findChannel("empty"), AnimationClip::kNoChannel);
+    BOOST_CHECK_EQUAL(clip.getKeyCount(1), 32u);
+    // A keyframe takes 48 bytes as an AnimationKeyframe
+    BOOST_CHECK_LT(clip.getMemorySize(), single + 32 * 48 / 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_compile_moves_bones) {
+    Animation animation;
+    animation.duration = 2.f;
+    animation.bones.emplace(
+        "bone", AnimationBone("bone", 0, 0, 2.f, AnimationBone::RT0,
+                              makeFrames(9, 0.f)));
+
+    const auto& clip = animation.getClip();
+    BOOST_CHECK(animation.bones.empty());
+    BOOST_REQUIRE_EQUAL(clip.getChannelCount(), 1u);
+    BOOST_CHECK_EQUAL(clip.getChannelName(0), "bone");
+    BOOST_CHECK_SMALL(clip.sample(0, 1.f).position.y - 3.f, 1e-3f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
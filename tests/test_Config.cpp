@@ -643,6 +643,15 @@ BOOST_AUTO_TEST_CASE(test_argParser_string) {
         BOOST_REQUIRE(optLayer->benchmarkPath.has_value());
         BOOST_CHECK_EQUAL(*optLayer->benchmarkPath, path);
     }
+    {
+        const auto path = "/some/report.json";
+        const char *args[] = {"", "--benchmark-report", path, "--headless"};
+        auto optLayer = argParser.parseArguments(4, args);
+        BOOST_REQUIRE(optLayer.has_value());
+        BOOST_REQUIRE(optLayer->benchmarkReport.has_value());
+        BOOST_CHECK_EQUAL(*optLayer->benchmarkReport, path);
+        BOOST_CHECK(optLayer->headless);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(test_argParser_int) {
@@ -0,0 +1,114 @@
+#include <boost/test/unit_test.hpp>
+#include <engine/CutscenePrefetch.hpp>
+#include <platform/FileIndex.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+struct PrefetchFixture {
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "openrw_test_prefetch";
+    FileIndex index;
+
+    PrefetchFixture() {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir / "anim");
+        // A zoom and a rotation key, no positions or targets
+        write("anim/test.dat", "1\n2.5,70.0,\n;\n1\n4.0,10.0,\n;\n0\n;\n0\n");
+        write("model.dff", "model data");
+        write("model.txd", "texture data");
+        index.indexTree(dir);
+    }
+
+    ~PrefetchFixture() {
+        std::filesystem::remove_all(dir);
+    }
+
+    void write(const std::string& name, const std::string& contents) {
+        std::ofstream file(dir / name, std::ios::binary);
+        file << contents;
+    }
+};
+
+std::string contents(const FileContentsInfo& file) {
+    return {file.data.get(), file.length};
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(CutscenePrefetchTests, PrefetchFixture)
+
+BOOST_AUTO_TEST_CASE(test_take_cutscene) {
+    CutscenePrefetch prefetch(index);
+    prefetch.prefetchCutscene("TEST", nullptr);
+
+    // Only the name that was prefetched is handed out
+    BOOST_CHECK(!prefetch.takeCutscene("other"));
+
+    auto cutscene = prefetch.takeCutscene("test");
+    BOOST_REQUIRE(cutscene);
+    BOOST_CHECK_EQUAL(cutscene->name, "TEST");
+    BOOST_CHECK_EQUAL(cutscene->tracks.zoom.size(), 1u);
+    BOOST_CHECK_EQUAL(cutscene->tracks.rotation.size(), 1u);
+    BOOST_CHECK_EQUAL(cutscene->tracks.duration, 4.f);
+    BOOST_CHECK(cutscene->animations.empty());
+    BOOST_CHECK(cutscene->audioName.empty());
+    BOOST_CHECK(!cutscene->audio);
+
+    // Taking it hands it over
+    BOOST_CHECK(!prefetch.takeCutscene("test"));
+}
+
+BOOST_AUTO_TEST_CASE(test_prefetch_replaces_cutscene) {
+    CutscenePrefetch prefetch(index);
+    prefetch.prefetchCutscene("test", nullptr);
+    prefetch.prefetchCutscene("missing", nullptr);
+
+    BOOST_CHECK(!prefetch.takeCutscene("test"));
+
+    // Files that don't exist leave the defaults
+    auto cutscene = prefetch.takeCutscene("missing");
+    BOOST_REQUIRE(cutscene);
+    BOOST_CHECK(cutscene->tracks.zoom.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_take_file) {
+    CutscenePrefetch prefetch(index);
+    prefetch.prefetchFile("model.dff");
+    prefetch.prefetchFile("MODEL.TXD");
+    // Prefetching twice reads once
+    prefetch.prefetchFile("model.dff");
+
+    BOOST_CHECK_EQUAL(contents(prefetch.takeFile("model.txd")),
+                      "texture data");
+    BOOST_CHECK_EQUAL(contents(prefetch.takeFile("model.dff")), "model data");
+
+    // Each file is handed over once
+    BOOST_CHECK(!prefetch.takeFile("model.dff").data);
+    BOOST_CHECK(!prefetch.takeFile("model.col").data);
+}
+
+BOOST_AUTO_TEST_CASE(test_drop_file) {
+    CutscenePrefetch prefetch(index);
+    prefetch.prefetchFile("model.dff");
+    prefetch.prefetchFile("model.txd");
+    prefetch.dropFile("model.dff");
+    // Dropping a file that wasn't prefetched does nothing
+    prefetch.dropFile("model.col");
+
+    BOOST_CHECK(!prefetch.takeFile("model.dff").data);
+    BOOST_CHECK_EQUAL(contents(prefetch.takeFile("model.txd")),
+                      "texture data");
+}
+
+BOOST_AUTO_TEST_CASE(test_missing_file) {
+    CutscenePrefetch prefetch(index);
+    prefetch.prefetchFile("missing.dff");
+
+    auto file = prefetch.takeFile("missing.dff");
+    BOOST_CHECK(!file.data);
+    BOOST_CHECK_EQUAL(file.length, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
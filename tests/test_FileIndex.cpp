@@ -3,6 +3,11 @@
 #include <platform/FileIndex.hpp>
 #include "test_Globals.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
 BOOST_AUTO_TEST_SUITE(FileIndexTests)
 
 BOOST_AUTO_TEST_CASE(test_normalizeName) {
@@ -21,6 +26,34 @@ BOOST_AUTO_TEST_CASE(test_normalizeName) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_fileStamp) {
+    const auto dir = std::filesystem::temp_directory_path() / "rwtests_stamp";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "Archive.TXD") << "first";
+
+    FileIndex index;
+    index.indexTree(dir);
+    BOOST_CHECK(!index.fileStamp("missing.txd"));
+
+    const auto before = index.fileStamp("archive.txd");
+    BOOST_REQUIRE(before);
+    BOOST_CHECK_EQUAL(before->size, 5u);
+
+    // Rewritten in place, so the stamp changes without reindexing
+    std::ofstream(dir / "Archive.TXD") << "second";
+    std::filesystem::last_write_time(
+        dir / "Archive.TXD",
+        std::filesystem::file_time_type::clock::now() + std::chrono::hours(1));
+    const auto after = index.fileStamp("archive.txd");
+    BOOST_REQUIRE(after);
+    BOOST_CHECK_EQUAL(after->source, before->source);
+    BOOST_CHECK_EQUAL(after->size, 6u);
+    BOOST_CHECK_NE(after->modified, before->modified);
+
+    std::filesystem::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_CASE(test_indexTree, DATA_TEST_PREDICATE) {
     FileIndex index;
     index.indexTree(Global::getGamePath());
@@ -70,4 +103,19 @@ BOOST_AUTO_TEST_CASE(test_indexArchive, DATA_TEST_PREDICATE) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_findFilesWithExtension, DATA_TEST_PREDICATE) {
+    FileIndex index;
+    index.indexTree(Global::getGamePath());
+    index.indexArchive("models/gta3.img");
+
+    auto files = index.findFilesWithExtension(".txd");
+    BOOST_CHECK(std::is_sorted(files.begin(), files.end()));
+    BOOST_CHECK(std::find(files.begin(), files.end(), "particle.txd") !=
+                files.end());
+    BOOST_CHECK(std::find(files.begin(), files.end(), "landstal.txd") !=
+                files.end());
+    BOOST_CHECK(std::find(files.begin(), files.end(), "models/particle.txd") ==
+                files.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,9 @@
 #include <objects/InstanceObject.hpp>
 #include "test_Globals.hpp"
 
+#include <algorithm>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(GameWorldTests, DATA_TEST_PREDICATE)
 
 BOOST_AUTO_TEST_CASE(test_gameobject_id) {
@@ -15,6 +18,39 @@ BOOST_AUTO_TEST_CASE(test_gameobject_id) {
     BOOST_CHECK_NE(object1->getGameObjectID(), object2->getGameObjectID());
 }
 
+BOOST_AUTO_TEST_CASE(test_instance_index) {
+    auto& gw = *Global::get().e;
+
+    const glm::vec3 centre(1500.f, 1500.f, 0.f);
+    auto placed = gw.createInstance(1337, centre + glm::vec3(2.f, 0.f, 0.f),
+                                    glm::quat{1.f, 0.f, 0.f, 0.f}, true);
+    auto created = gw.createInstance(1337, centre + glm::vec3(0.f, 3.f, 0.f));
+    auto far = gw.createInstance(1337, centre + glm::vec3(40.f, 0.f, 0.f),
+                                 glm::quat{1.f, 0.f, 0.f, 0.f}, true);
+    BOOST_REQUIRE(placed && created && far);
+
+    std::vector<GameObject*> nearby;
+    gw.gatherObjectsNear(centre, 5.f, nearby);
+    auto found = [&](GameObject* o) {
+        return std::find(nearby.begin(), nearby.end(), o) != nearby.end();
+    };
+    BOOST_CHECK(found(placed));
+    BOOST_CHECK(found(created));
+    BOOST_CHECK(!found(far));
+
+    std::vector<InstanceObject*> models;
+    gw.instanceIndex.gatherModel(1337, models);
+    BOOST_CHECK(std::find(models.begin(), models.end(), far) != models.end());
+
+    gw.destroyObject(placed);
+    nearby.clear();
+    gw.gatherObjectsNear(centre, 5.f, nearby);
+    BOOST_CHECK(!found(placed));
+
+    gw.destroyObject(created);
+    gw.destroyObject(far);
+}
+
 BOOST_AUTO_TEST_CASE(test_offsetgametime) {
     auto& gw = *Global::get().e;
     gw.state = new GameState();
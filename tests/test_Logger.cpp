@@ -1,5 +1,12 @@
 #include <boost/test/unit_test.hpp>
 #include <core/Logger.hpp>
+#include <rw/debug.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
 
 class CallbackReceiver : public Logger::MessageReceiver {
 public:
@@ -33,4 +40,130 @@ BOOST_AUTO_TEST_CASE(test_receiver) {
     BOOST_CHECK_EQUAL(lastMessage.message, "Test");
 }
 
+BOOST_AUTO_TEST_CASE(test_async_delivery) {
+    Logger log;
+
+    std::vector<std::string> messages;
+    std::thread::id deliveryThread;
+    CallbackReceiver receiver([&](const Logger::LogMessage& m) {
+        messages.push_back(m.message);
+        deliveryThread = std::this_thread::get_id();
+    });
+    log.addReceiver(&receiver);
+
+    log.setAsync(true);
+    BOOST_CHECK(log.isAsync());
+    for (int i = 0; i < 10; ++i) {
+        log.info("Tests", std::to_string(i));
+    }
+    log.flush();
+
+    BOOST_REQUIRE_EQUAL(messages.size(), 10u);
+    BOOST_CHECK_EQUAL(messages.front(), "0");
+    BOOST_CHECK_EQUAL(messages.back(), "9");
+    BOOST_CHECK(deliveryThread != std::this_thread::get_id());
+
+    log.setAsync(false);
+    log.info("Tests", "sync");
+    BOOST_CHECK_EQUAL(messages.back(), "sync");
+    BOOST_CHECK(deliveryThread == std::this_thread::get_id());
+}
+
+BOOST_AUTO_TEST_CASE(test_async_truncates_long_messages) {
+    Logger log;
+
+    std::string received;
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage& m) { received = m.message; });
+    log.addReceiver(&receiver);
+
+    log.setAsync(true);
+    log.error("Tests", std::string(Logger::kMaxMessageLength + 10, 'x'));
+    log.setAsync(false);
+
+    BOOST_CHECK_EQUAL(received.size(), Logger::kMaxMessageLength);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_receiver_logging) {
+    Logger log;
+
+    std::size_t received = 0;
+    CallbackReceiver receiver([&](const Logger::LogMessage&) {
+        if (received++ > 0) {
+            return;
+        }
+        // More than the queue holds, and nothing drains it while this runs
+        for (std::size_t i = 0; i < Logger::kQueueCapacity * 2; ++i) {
+            log.error("Tests", "from receiver");
+        }
+    });
+    log.addReceiver(&receiver);
+
+    log.setAsync(true);
+    log.info("Tests", "first");
+    log.setAsync(false);
+
+    BOOST_CHECK_EQUAL(received, Logger::kQueueCapacity * 2 + 1);
+    BOOST_CHECK_EQUAL(log.getDroppedCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_stop_keeps_messages) {
+    Logger log;
+
+    std::atomic<std::size_t> received{0};
+    CallbackReceiver receiver(
+        [&](const Logger::LogMessage&) { received++; });
+    log.addReceiver(&receiver);
+
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kMessages = 2000;
+    std::atomic<bool> start{false};
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            while (!start) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < kMessages; ++i) {
+                log.error("Tests", "message");
+            }
+        });
+    }
+
+    // Messages queued as the logger stops must still be delivered
+    start = true;
+    for (int i = 0; i < 50; ++i) {
+        log.setAsync(i % 2 == 0);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    log.setAsync(false);
+
+    BOOST_CHECK_EQUAL(received.load(), kThreads * kMessages);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_ring_dump) {
+    std::vector<std::string> traced;
+    RW_set_trace_sink([&](const char* line) { traced.emplace_back(line); });
+    RW_TRACE(true, (TFile, "ring test %d\n", 42));
+    RW_set_trace_sink(nullptr);
+
+    BOOST_REQUIRE_EQUAL(traced.size(), 1u);
+    BOOST_CHECK_EQUAL(traced[0], "ring test 42\n");
+
+    auto file = std::tmpfile();
+    BOOST_REQUIRE(file != nullptr);
+    RW_dump_trace_ring(file);
+    std::rewind(file);
+    std::string dump;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), file)) {
+        dump += buffer;
+    }
+    std::fclose(file);
+
+    BOOST_CHECK_NE(dump.find("ring test 42\n"), std::string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
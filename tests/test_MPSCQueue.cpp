@@ -0,0 +1,64 @@
+#include <boost/test/unit_test.hpp>
+#include <core/MPSCQueue.hpp>
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(MPSCQueueTests)
+
+BOOST_AUTO_TEST_CASE(test_push_pop_order) {
+    MPSCQueue<int, 4> queue;
+
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK(queue.push(i));
+    }
+    BOOST_CHECK(!queue.push(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(queue.pop(value));
+        BOOST_CHECK_EQUAL(value, i);
+    }
+    BOOST_CHECK(!queue.pop(value));
+
+    // Slots are reused once popped
+    BOOST_CHECK(queue.push(5));
+    BOOST_REQUIRE(queue.pop(value));
+    BOOST_CHECK_EQUAL(value, 5);
+}
+
+BOOST_AUTO_TEST_CASE(test_threaded) {
+    constexpr int kProducers = 4;
+    constexpr int kCount = 50000;
+    MPSCQueue<int, 64> queue;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kCount; ++i) {
+                while (!queue.push(p * kCount + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's values must arrive in the order it pushed them
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    int value = 0;
+    while (received < kProducers * kCount) {
+        if (queue.pop(value)) {
+            const int p = value / kCount;
+            BOOST_REQUIRE_EQUAL(value % kCount, next[p]);
+            ++next[p];
+            ++received;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    BOOST_CHECK(!queue.pop(value));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,60 @@
+#include <boost/test/unit_test.hpp>
+#include <rw/accounting.hpp>
+
+BOOST_AUTO_TEST_SUITE(MemoryAccountingTests)
+
+BOOST_AUTO_TEST_CASE(test_allocation_lifetime) {
+    const auto before = MemoryAccounting::get(MemoryCategory::Models);
+    {
+        MemoryAllocation allocation(MemoryCategory::Models, 100);
+        auto totals = MemoryAccounting::get(MemoryCategory::Models);
+        BOOST_CHECK_EQUAL(totals.live, before.live + 100);
+        BOOST_CHECK_EQUAL(totals.allocations, before.allocations + 1);
+
+        allocation.set(40);
+        totals = MemoryAccounting::get(MemoryCategory::Models);
+        BOOST_CHECK_EQUAL(totals.live, before.live + 40);
+        BOOST_CHECK_GE(totals.peak, before.live + 100);
+
+        allocation.set(0);
+        totals = MemoryAccounting::get(MemoryCategory::Models);
+        BOOST_CHECK_EQUAL(totals.allocations, before.allocations);
+        allocation.set(10);
+    }
+    const auto after = MemoryAccounting::get(MemoryCategory::Models);
+    BOOST_CHECK_EQUAL(after.live, before.live);
+    BOOST_CHECK_EQUAL(after.allocations, before.allocations);
+}
+
+BOOST_AUTO_TEST_CASE(test_allocation_copy) {
+    const auto before = MemoryAccounting::get(MemoryCategory::Objects);
+    {
+        MemoryAllocation a(MemoryCategory::Objects, 64);
+        MemoryAllocation b(a);
+        BOOST_CHECK_EQUAL(b.size(), 64u);
+        BOOST_CHECK_EQUAL(MemoryAccounting::get(MemoryCategory::Objects).live,
+                          before.live + 128);
+
+        MemoryAllocation c(MemoryCategory::Sounds, 8);
+        c = a;
+        BOOST_CHECK(c.getCategory() == MemoryCategory::Objects);
+        BOOST_CHECK_EQUAL(MemoryAccounting::get(MemoryCategory::Objects).live,
+                          before.live + 192);
+    }
+    BOOST_CHECK_EQUAL(MemoryAccounting::get(MemoryCategory::Objects).live,
+                      before.live);
+}
+
+BOOST_AUTO_TEST_CASE(test_reset_peaks) {
+    {
+        MemoryAllocation allocation(MemoryCategory::Collision, 1 << 20);
+    }
+    auto totals = MemoryAccounting::get(MemoryCategory::Collision);
+    BOOST_CHECK_GE(totals.peak, totals.live + (1 << 20));
+
+    MemoryAccounting::resetPeaks();
+    totals = MemoryAccounting::get(MemoryCategory::Collision);
+    BOOST_CHECK_EQUAL(totals.peak, totals.live);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
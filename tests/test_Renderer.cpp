@@ -1,5 +1,23 @@
 #include <boost/test/unit_test.hpp>
+#include <data/Clump.hpp>
+#include <render/DrawPacketCache.hpp>
 #include <render/GameRenderer.hpp>
+#include <render/MapRenderer.hpp>
+#include <render/NullRenderer.hpp>
+#include <render/OcclusionBuffer.hpp>
+#include <render/ParticleBatch.hpp>
+#include <render/SpriteBatch.hpp>
+#include <render/StaticInstanceBounds.hpp>
+#include <render/ViewCamera.hpp>
+#include <render/VisualFX.hpp>
+#include "test_Globals.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(RendererTests)
 
@@ -23,4 +41,424 @@ BOOST_AUTO_TEST_CASE(frustum_test_visible) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(frustum_test_batch_matches_single) {
+    ViewFrustum f(0.1f, 100.f, glm::half_pi<float>(), 1.f);
+    f.update(f.projection());
+
+    // Not a multiple of the vector width, so the scalar tail runs too
+    constexpr std::size_t count = 45;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coord(-30.f, 30.f);
+    std::uniform_real_distribution<float> size(0.f, 5.f);
+    std::vector<float> x(count), y(count), z(count), r(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        z[i] = coord(rng);
+        r[i] = size(rng);
+    }
+    r[3] = std::numeric_limits<float>::infinity();
+
+    std::vector<std::uint8_t> visible(count, 2);
+    f.intersects(x.data(), y.data(), z.data(), r.data(), count,
+                 visible.data());
+    for (std::size_t i = 0; i < count; ++i) {
+        BOOST_CHECK_EQUAL(visible[i] == 1,
+                          f.intersects({x[i], y[i], z[i]}, r[i]));
+        BOOST_CHECK_LE(visible[i], 1);
+    }
+    BOOST_CHECK_EQUAL(visible[3], 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_static_bounds_cull) {
+    ViewCamera camera({0.f, 0.f, 0.f});
+    camera.frustum.far = 500.f;
+    camera.frustum.update(camera.frustum.projection() * camera.getView());
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(-1000.f, 1000.f);
+    std::uniform_real_distribution<float> size(0.5f, 20.f);
+    std::vector<StaticInstanceBounds::Bounds> bounds(2000);
+    for (auto& b : bounds) {
+        b.position = {coord(rng), coord(rng), coord(rng) * 0.05f};
+        b.center = b.position + glm::vec3(0.f, 0.f, 1.f);
+        b.radius = size(rng);
+        b.drawDistance = size(rng) * 25.f;
+        b.hours = rng() % 4 == 0 ? 0x00FF00u : ~0u;
+    }
+    std::vector<InstanceObject*> objects(bounds.size(), nullptr);
+
+    StaticInstanceBounds tree;
+    tree.build(objects, bounds);
+    BOOST_CHECK_EQUAL(tree.getInstanceCount(), bounds.size());
+    BOOST_CHECK_GT(tree.getNodeCount(), 1u);
+
+    const int hour = 2;
+    std::vector<std::uint32_t> visible;
+    const auto culled = tree.cull(camera, hour, visible);
+    BOOST_CHECK_EQUAL(culled + visible.size(), bounds.size());
+
+    // Nothing that would be drawn is culled, nothing outside the frustum
+    // is kept
+    std::vector<bool> kept(bounds.size());
+    for (const auto i : visible) {
+        const auto& b = tree.getBounds(i);
+        BOOST_CHECK(camera.frustum.intersects(b.center, b.radius));
+        kept[i] = true;
+    }
+    for (std::uint32_t i = 0; i < bounds.size(); ++i) {
+        const auto& b = tree.getBounds(i);
+        const bool drawn =
+            (b.hours & (1u << hour)) != 0 &&
+            glm::distance(b.position, camera.position) <= b.drawDistance &&
+            camera.frustum.intersects(b.center, b.radius);
+        if (drawn) {
+            BOOST_CHECK(kept[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_occlusion_buffer) {
+    OcclusionBuffer buffer;
+    // Looking down -z, a 10x10 wall 10 units away
+    buffer.begin(glm::perspective(glm::half_pi<float>(), 2.f, 0.1f, 100.f));
+    const std::vector<glm::vec3> wall{
+        {-5.f, -5.f, -10.f}, {5.f, -5.f, -10.f},
+        {5.f, 5.f, -10.f},   {-5.f, 5.f, -10.f}};
+    const std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+    buffer.drawTriangles(wall.data(), indices.data(), indices.size(), false,
+                         glm::mat4(1.f));
+    buffer.finish();
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2u);
+
+    BOOST_CHECK(buffer.isOccluded({0.f, 0.f, -20.f}, 1.f));
+    BOOST_CHECK(buffer.isOccluded({2.f, -2.f, -40.f}, 4.f));
+    // In front of the wall
+    BOOST_CHECK(!buffer.isOccluded({0.f, 0.f, -5.f}, 1.f));
+    // Poking out from behind it
+    BOOST_CHECK(!buffer.isOccluded({15.f, 0.f, -20.f}, 1.f));
+    BOOST_CHECK(!buffer.isOccluded({0.f, 0.f, -20.f}, 12.f));
+    // Around the camera
+    BOOST_CHECK(!buffer.isOccluded({0.f, 0.f, 0.f}, 1.f));
+
+    // Nothing is hidden once the occluders are cleared
+    buffer.begin(glm::perspective(glm::half_pi<float>(), 2.f, 0.1f, 100.f));
+    buffer.finish();
+    BOOST_CHECK(!buffer.isOccluded({0.f, 0.f, -20.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_occlusion_buffer_partial_texels) {
+    OcclusionBuffer buffer;
+    // The same wall, but its triangles don't share their vertices, so the
+    // diagonal is an outside edge of both and the texels on it are open
+    buffer.begin(glm::perspective(glm::half_pi<float>(), 2.f, 0.1f, 100.f));
+    const std::vector<glm::vec3> wall{
+        {-5.f, -5.f, -10.f}, {5.f, -5.f, -10.f}, {5.f, 5.f, -10.f},
+        {-5.f, -5.f, -10.f}, {5.f, 5.f, -10.f},  {-5.f, 5.f, -10.f}};
+    const std::vector<std::uint32_t> indices{0, 1, 2, 3, 4, 5};
+    buffer.drawTriangles(wall.data(), indices.data(), indices.size(), false,
+                         glm::mat4(1.f));
+    buffer.finish();
+    BOOST_CHECK_EQUAL(buffer.getTriangleCount(), 2u);
+
+    BOOST_CHECK(!buffer.isOccluded({0.f, 0.f, -20.f}, 1.f));
+    // Away from the diagonal they still hide what is behind them
+    BOOST_CHECK(buffer.isOccluded({4.f, -4.f, -20.f}, 1.f));
+}
+
+BOOST_AUTO_TEST_CASE(test_draw_packets_are_cached) {
+    auto geometry = std::make_shared<Geometry>();
+    geometry->flags = RW::BSGeometry::ModuleMaterialColor;
+    for (const auto& colour : {glm::u8vec4(255, 255, 255, 255),
+                               glm::u8vec4(60, 255, 0, 255),
+                               glm::u8vec4(10, 20, 30, 128)}) {
+        Geometry::Material material{};
+        material.colour = colour;
+        geometry->materials.push_back(material);
+        SubGeometry subgeom;
+        subgeom.material = geometry->subgeom.size();
+        subgeom.numIndices = 3;
+        subgeom.start = subgeom.material * 3;
+        geometry->subgeom.push_back(subgeom);
+    }
+
+    DrawPacketCache cache;
+    const auto& packets = cache.get(geometry);
+    BOOST_REQUIRE_EQUAL(packets.size(), 3u);
+    BOOST_CHECK_EQUAL(packets[1].parameters.start, 3u);
+    BOOST_CHECK(packets[0].colourKey == DrawPacketCache::Packet::NoKey);
+    BOOST_CHECK(packets[1].colourKey == DrawPacketCache::Packet::PrimaryKey);
+    BOOST_CHECK(packets[0].parameters.blendMode == BlendMode::BLEND_NONE);
+    BOOST_CHECK(packets[2].parameters.blendMode == BlendMode::BLEND_ALPHA);
+
+    // Later draws reuse the packets
+    BOOST_CHECK_EQUAL(&cache.get(geometry), &packets);
+    BOOST_CHECK_EQUAL(cache.size(), 1u);
+
+    // Packets of destroyed geometry are dropped
+    geometry.reset();
+    cache.prune();
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_null_renderer_counts_state_changes) {
+    NullRenderer renderer;
+    DrawBuffer a, b;
+
+    Renderer::DrawParameters dp;
+    dp.count = 3;
+    dp.textures = {{1}};
+
+    RenderList list;
+    list.emplace_back(0, glm::mat4(1.f), &a, dp);
+    list.emplace_back(0, glm::mat4(1.f), &a, dp);
+    dp.textures = {{2}};
+    list.emplace_back(0, glm::mat4(1.f), &b, dp);
+
+    renderer.drawBatched(list);
+
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 3);
+    BOOST_CHECK_EQUAL(renderer.getBufferCount(), 2);
+    BOOST_CHECK_EQUAL(renderer.getTextureCount(), 2);
+    BOOST_CHECK_EQUAL(renderer.getPrimitiveCount(), 9u);
+    BOOST_CHECK(renderer.getDrawCalls().empty());
+
+    renderer.swap();
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_vertex_array_binds_once) {
+    NullRenderer renderer;
+    DrawBuffer arena, a, b;
+    DrawRange rangeA, rangeB;
+    rangeB.baseVertex = 24;
+    rangeB.baseIndex = 36;
+    a.setSource(&arena, &rangeA);
+    b.setSource(&arena, &rangeB);
+
+    BOOST_CHECK_EQUAL(b.getVertexArray(), &arena);
+    BOOST_CHECK_EQUAL(b.getBaseVertex(), 24);
+    BOOST_CHECK_EQUAL(b.getBaseIndex(), 36u);
+
+    Renderer::DrawParameters dp;
+    dp.count = 3;
+    renderer.draw(glm::mat4(1.f), &a, dp);
+    renderer.draw(glm::mat4(1.f), &b, dp);
+    renderer.draw(glm::mat4(1.f), &a, dp);
+
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 3);
+    BOOST_CHECK_EQUAL(renderer.getBufferCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_null_renderer_records_draws) {
+    NullRenderer renderer;
+    renderer.setRecording(true);
+    DrawBuffer buffer;
+    auto program = renderer.createShader("", "");
+
+    Renderer::DrawParameters dp;
+    dp.count = 4;
+    dp.blendMode = BlendMode::BLEND_ALPHA;
+
+    renderer.useProgram(program.get());
+    renderer.pushDebugGroup("Test");
+    renderer.draw(glm::mat4(1.f), &buffer, dp);
+    renderer.drawArrays(glm::mat4(1.f), &buffer, dp);
+    const auto& prof = renderer.popDebugGroup();
+
+    BOOST_CHECK_EQUAL(prof.draws, 2u);
+    BOOST_CHECK_EQUAL(prof.buffers, 1u);
+    BOOST_CHECK_EQUAL(prof.primitives, 8u);
+
+    const auto& calls = renderer.getDrawCalls();
+    BOOST_REQUIRE_EQUAL(calls.size(), 2u);
+    BOOST_CHECK(calls[0].indexed);
+    BOOST_CHECK(!calls[1].indexed);
+    BOOST_CHECK_EQUAL(calls[0].dbuff, &buffer);
+    BOOST_CHECK_EQUAL(calls[0].program, program.get());
+    BOOST_CHECK(calls[1].params.blendMode == BlendMode::BLEND_ALPHA);
+    BOOST_CHECK_EQUAL(renderer.getStateChanges().blend, 1u);
+
+    renderer.reset();
+    BOOST_CHECK(renderer.getDrawCalls().empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_redundant_uniforms_are_skipped) {
+    NullRenderer renderer;
+    auto program = renderer.createShader("", "");
+    auto other = renderer.createShader("", "");
+
+    auto colour = Renderer::getUniform<glm::vec4>(program.get(), "colour");
+    BOOST_CHECK_EQUAL(
+        Renderer::getUniform<glm::vec4>(program.get(), "colour").slot,
+        colour.slot);
+
+    renderer.setUniform(colour, glm::vec4(1.f));
+    renderer.setUniform(colour, glm::vec4(1.f));
+    // Setting by name shares the cached value
+    renderer.setUniform(program.get(), "colour", glm::vec4(1.f));
+    BOOST_CHECK_EQUAL(renderer.getStateChanges().uniforms, 1u);
+
+    renderer.setUniform(colour, glm::vec4(0.5f));
+    renderer.setUniform(other.get(), "colour", glm::vec4(0.5f));
+    BOOST_CHECK_EQUAL(renderer.getStateChanges().uniforms, 3u);
+
+    // Consecutive draws with the same object data upload it once
+    DrawBuffer buffer;
+    Renderer::DrawParameters dp;
+    dp.count = 4;
+    const auto uploads = renderer.getStateChanges().uploads;
+    renderer.drawArrays(glm::mat4(1.f), &buffer, dp);
+    renderer.drawArrays(glm::mat4(1.f), &buffer, dp);
+    BOOST_CHECK_EQUAL(renderer.getStateChanges().uploads, uploads + 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_sprite_runs_merge) {
+    NullRenderer renderer;
+    renderer.setRecording(true);
+    SpriteBatch batch(renderer);
+
+    const glm::vec4 uv(0.f, 0.f, 1.f, 1.f);
+    const glm::vec4 colour(1.f);
+    // The second quad sits apart from both others, so the third may join
+    // the first quad's run
+    batch.addRect(1, {0.f, 0.f, 10.f, 10.f}, uv, colour);
+    batch.addRect(2, {20.f, 0.f, 10.f, 10.f}, uv, colour);
+    batch.addRect(1, {40.f, 0.f, 10.f, 10.f}, uv, colour);
+
+    BOOST_CHECK_EQUAL(batch.getQueuedCount(), 3u);
+    BOOST_CHECK_EQUAL(batch.getRunCount(), 2u);
+
+    batch.flush();
+
+    const auto& calls = renderer.getDrawCalls();
+    BOOST_REQUIRE_EQUAL(calls.size(), 2u);
+    BOOST_CHECK_EQUAL(renderer.getDrawCount(), 2);
+    BOOST_CHECK_EQUAL(calls[0].params.textures[0], 1u);
+    BOOST_CHECK_EQUAL(calls[0].params.start, 0u);
+    BOOST_CHECK_EQUAL(calls[0].params.count, 12u);
+    BOOST_CHECK_EQUAL(calls[1].params.textures[0], 2u);
+    BOOST_CHECK_EQUAL(calls[1].params.start, 12u);
+    BOOST_CHECK_EQUAL(calls[1].params.count, 6u);
+    BOOST_CHECK(calls[0].params.blendMode == BlendMode::BLEND_ALPHA);
+    BOOST_CHECK_EQUAL(batch.getQueuedCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_sprite_runs_keep_painters_order) {
+    NullRenderer renderer;
+    renderer.setRecording(true);
+    SpriteBatch batch(renderer);
+
+    const glm::vec4 uv(0.f, 0.f, 1.f, 1.f);
+    const glm::vec4 colour(1.f);
+    // Each quad covers the one before it, none may be drawn out of order
+    batch.addRect(1, {0.f, 0.f, 10.f, 10.f}, uv, colour);
+    batch.addRect(2, {5.f, 5.f, 10.f, 10.f}, uv, colour);
+    batch.addRect(1, {10.f, 10.f, 10.f, 10.f}, uv, colour);
+
+    BOOST_CHECK_EQUAL(batch.getRunCount(), 3u);
+
+    batch.flush();
+
+    const auto& calls = renderer.getDrawCalls();
+    BOOST_REQUIRE_EQUAL(calls.size(), 3u);
+    const GLuint expected[] = {1, 2, 1};
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        BOOST_CHECK_EQUAL(calls[i].params.textures[0], expected[i]);
+        BOOST_CHECK_EQUAL(calls[i].params.start, i * 6);
+        BOOST_CHECK_EQUAL(calls[i].params.count, 6u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_particle_radix_sort) {
+    BOOST_CHECK_GT(ParticleBatch::depthKey(1.f), ParticleBatch::depthKey(2.f));
+    BOOST_CHECK_GT(ParticleBatch::depthKey(0.f), ParticleBatch::depthKey(1e-3f));
+
+    std::mt19937 rng(42);
+    std::vector<std::uint64_t> keys(1000);
+    for (auto& key : keys) {
+        // Few groups and repeated depths, so stability matters
+        key = (static_cast<std::uint64_t>(rng() % 3) << 32) | (rng() % 50);
+    }
+
+    std::vector<std::uint32_t> expected(keys.size());
+    std::iota(expected.begin(), expected.end(), 0u);
+    std::stable_sort(expected.begin(), expected.end(),
+                     [&](auto a, auto b) { return keys[a] < keys[b]; });
+
+    std::vector<std::uint32_t> order, scratch;
+    ParticleBatch::radixSort(keys, order, scratch);
+    BOOST_CHECK(order == expected);
+
+    ParticleBatch::radixSort({}, order, scratch);
+    BOOST_CHECK(order.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_particles_draw_per_texture, DATA_TEST_PREDICATE) {
+    NullRenderer renderer;
+    renderer.setRecording(true);
+    ParticleBatch batch(renderer);
+
+    TextureData smoke(1, {8, 8}, false);
+    TextureData fire(2, {8, 8}, false);
+
+    ParticleFX particle;
+    for (int i = 0; i < 3; ++i) {
+        particle.texture = i == 1 ? &fire : &smoke;
+        particle.position = glm::vec3(static_cast<float>(i), 0.f, 0.f);
+        batch.add(particle);
+    }
+    particle.texture = nullptr;
+    batch.add(particle);
+
+    BOOST_CHECK_EQUAL(batch.getQueuedCount(), 3u);
+    BOOST_CHECK_EQUAL(batch.getGroupCount(), 2u);
+
+    batch.draw(glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f));
+
+    const auto& calls = renderer.getDrawCalls();
+    BOOST_REQUIRE_EQUAL(calls.size(), 2u);
+    BOOST_CHECK_EQUAL(calls[0].params.textures[0], 1u);
+    BOOST_CHECK_EQUAL(calls[0].instances, 2u);
+    BOOST_CHECK_EQUAL(calls[1].instances, 1u);
+    BOOST_CHECK(calls[0].params.blendMode == BlendMode::BLEND_ADDITIVE);
+    BOOST_CHECK_EQUAL(renderer.getPrimitiveCount(), 12u);
+    BOOST_CHECK_EQUAL(batch.getQueuedCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_game_renderer_without_context, DATA_TEST_PREDICATE) {
+    auto null = std::make_unique<NullRenderer>();
+    auto& renderer = *null;
+    GameRenderer gameRenderer(&Global::get().log, Global::get().d,
+                              std::move(null));
+    gameRenderer.setViewport(800, 600);
+
+    ViewCamera camera;
+    camera.frustum.far = 1000.f;
+    gameRenderer.renderWorld(Global::get().e, camera, 1.f);
+
+    // At least the sky and the post process pass are drawn
+    BOOST_CHECK_GE(renderer.getDrawCount(), 2);
+    BOOST_CHECK(!gameRenderer.getRenderer().hasContext());
+}
+
+BOOST_AUTO_TEST_CASE(test_radar_is_one_draw, DATA_TEST_PREDICATE) {
+    NullRenderer renderer;
+    renderer.setRecording(true);
+    SpriteBatch sprites(renderer);
+    MapRenderer map(renderer, sprites, Global::get().d);
+
+    MapRenderer::MapInfo mi;
+    mi.worldSize = 500.f;
+    mi.screenSize = 100.f;
+    mi.clipToSize = false;
+    map.draw(Global::get().e, mi);
+
+    // The tiles are a single quad, the blips wait on the sprite batch
+    const auto& calls = renderer.getDrawCalls();
+    BOOST_REQUIRE_EQUAL(calls.size(), 1u);
+    BOOST_CHECK_EQUAL(calls[0].params.count, 4u);
+    BOOST_CHECK_GT(sprites.getQueuedCount(), 0u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,64 @@
+#include <boost/test/unit_test.hpp>
+#include <core/SPSCQueue.hpp>
+
+#include <memory>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(SPSCQueueTests)
+
+BOOST_AUTO_TEST_CASE(test_push_pop_order) {
+    SPSCQueue<int, 4> queue;
+    BOOST_CHECK(queue.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK(queue.push(int(i)));
+    }
+    BOOST_CHECK(!queue.push(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        BOOST_REQUIRE(queue.pop(value));
+        BOOST_CHECK_EQUAL(value, i);
+    }
+    BOOST_CHECK(!queue.pop(value));
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_pop_releases_slot) {
+    SPSCQueue<std::shared_ptr<int>, 2> queue;
+    auto shared = std::make_shared<int>(1);
+
+    BOOST_REQUIRE(queue.push(std::shared_ptr<int>(shared)));
+    BOOST_CHECK_EQUAL(shared.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    BOOST_REQUIRE(queue.pop(out));
+    out.reset();
+    BOOST_CHECK_EQUAL(shared.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_threaded) {
+    constexpr int kCount = 100000;
+    SPSCQueue<int, 64> queue;
+
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            while (!queue.push(int(i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int value = 0;
+    while (expected < kCount) {
+        if (queue.pop(value)) {
+            BOOST_REQUIRE_EQUAL(value, expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,69 +1,216 @@
 #include <boost/test/unit_test.hpp>
 #include <engine/GameState.hpp>
+#include <engine/GameWorld.hpp>
 #include <engine/SaveGame.hpp>
+#include <engine/SaveGameIndex.hpp>
+#include <objects/PickupObject.hpp>
+#include <objects/VehicleObject.hpp>
+#include <script/SCMFile.hpp>
 #include <script/ScriptMachine.hpp>
-
 #include "test_Globals.hpp"
 
-#if 0  // Disabled until we make a start on saving the game
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+// Just the section jumps, which leaves eight bytes of globals
+SCMByte scmData[] = {0x02, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02,
+                     0x00, 0x01, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01,
+                     0x28, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x00};
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(SaveGameTests)
 
-BOOST_AUTO_TEST_CASE(test_write_state)
-{
-	GameState state;
-
-	// Set some test data
-	state.world = nullptr;
-	state.currentProgress = 10;
-	state.maxProgress = 124;
-	state.numMissions = 12;
-	state.numHiddenPackages = 34;
-	state.numHiddenPackagesDiscovered = 11;
-	state.numUniqueJumps = 14;
-	state.numRampages = 7;
-	state.maxWantedLevel = 5;
-	state.currentWeather = 9;
-	state.overrideNextStart = true;
-	state.hour = 13;
-	state.minute = 32;
-
-	// This may break due to cwd issues
-	SaveGame::writeState(state, "test_savestate.sav");
-
-	GameState loaded;
-	loaded.world = nullptr;
-
-	BOOST_REQUIRE( SaveGame::loadState(loaded, "test_savestate.sav") );
-	BOOST_CHECK( loaded.world == nullptr );
-	BOOST_CHECK_EQUAL( loaded.currentProgress, state.currentProgress );
-	BOOST_CHECK_EQUAL( loaded.maxProgress, state.maxProgress );
-	BOOST_CHECK_EQUAL( loaded.numMissions, state.numMissions );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackages, state.numHiddenPackages );
-	BOOST_CHECK_EQUAL( loaded.numHiddenPackagesDiscovered, state.numHiddenPackagesDiscovered );
-	BOOST_CHECK_EQUAL( loaded.numUniqueJumps, state.numUniqueJumps );
-	BOOST_CHECK_EQUAL( loaded.numRampages, state.numRampages );
-	BOOST_CHECK_EQUAL( loaded.maxWantedLevel, state.maxWantedLevel );
-	BOOST_CHECK_EQUAL( loaded.currentWeather, state.currentWeather );
-	BOOST_CHECK_EQUAL( loaded.overrideNextStart, state.overrideNextStart );
-	BOOST_CHECK_EQUAL( loaded.hour, state.hour );
-	BOOST_CHECK_EQUAL( loaded.minute, state.minute );
-	
-	// Check Garage data + garage vehicle restoration
+BOOST_AUTO_TEST_CASE(test_snapshot_blocks) {
+    GameState state;
+
+    auto snapshot = SaveGame::snapshotGame(state);
+
+    // Every block is prefixed by its size, walking them must land on the end
+    size_t offset = 0;
+    int blocks = 0;
+    while (offset + sizeof(uint32_t) <= snapshot.size()) {
+        uint32_t size;
+        std::memcpy(&size, snapshot.data() + offset, sizeof(size));
+        offset += sizeof(size) + size;
+        blocks++;
+    }
+    BOOST_CHECK_EQUAL(offset, snapshot.size());
+    BOOST_CHECK_EQUAL(blocks, 20);
+}
+
+BOOST_AUTO_TEST_CASE(test_write_state) {
+    GameState state;
+    state.basic.gameHour = 13;
+    state.basic.gameMinute = 32;
+    state.gameTime = 12.5f;
+
+    const auto path =
+        std::filesystem::temp_directory_path() / "openrw_test_save.b";
+    BOOST_REQUIRE(SaveGame::writeGameAsync(state, path.string()).get());
+
+    BasicState basic;
+    BOOST_REQUIRE(SaveGame::getSaveInfo(path.string(), &basic));
+    BOOST_CHECK_EQUAL(int(basic.gameHour), 13);
+    BOOST_CHECK_EQUAL(int(basic.gameMinute), 32);
+    BOOST_CHECK_EQUAL(basic.timeMS, 12500u);
+
+    // The file is the snapshot followed by the sum of its bytes
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+    file.close();
+    BOOST_REQUIRE_EQUAL(data.size(),
+                        SaveGame::snapshotGame(state).size() + sizeof(uint32_t));
+    uint32_t sum = 0;
+    for (size_t i = 0; i < data.size() - sizeof(uint32_t); ++i) {
+        sum += data[i];
+    }
+    uint32_t checksum;
+    std::memcpy(&checksum, data.data() + data.size() - sizeof(checksum),
+                sizeof(checksum));
+    BOOST_CHECK_EQUAL(sum, checksum);
+
+    std::filesystem::remove(path);
 }
 
-BOOST_AUTO_TEST_CASE(test_load_game)
-{
-	GameState state;
-	GameWorld world();
-	SCMOpcodes s;
-	auto file = Global::get().d->loadSCM("main.scm");
-	ScriptMachine machine(&state, file, &s);
-	
-	state.world = Global::get().e;
-	state.script = &machine;
-
-	BOOST_REQUIRE( SaveGame::loadGame(state, "GTA3sf1.b") );
+BOOST_AUTO_TEST_CASE(test_save_index) {
+    const auto dir =
+        std::filesystem::temp_directory_path() / "openrw_test_save_index";
+    std::filesystem::remove_all(dir);
+
+    GameState state;
+    state.basic.gameHour = 7;
+    BOOST_REQUIRE(SaveGame::writeGame(state, (dir / "GTA3sf1.b").string()));
+
+    {
+        SaveGameIndex index(dir);
+        BOOST_CHECK(index.getSaves().empty());
+        index.refresh();
+        index.wait();
+        BOOST_CHECK(index.pollChanged());
+        BOOST_CHECK(!index.pollChanged());
+
+        auto saves = index.getSaves();
+        BOOST_REQUIRE_EQUAL(saves.size(), 1u);
+        BOOST_CHECK(saves[0].valid);
+        BOOST_CHECK_EQUAL(int(saves[0].basicState.gameHour), 7);
+    }
+
+    {
+        // The slots are known from the index file before any rescan
+        SaveGameIndex index(dir);
+        auto saves = index.getSaves();
+        BOOST_REQUIRE_EQUAL(saves.size(), 1u);
+        BOOST_CHECK_EQUAL(int(saves[0].basicState.gameHour), 7);
+
+        // Nothing changed on disk, so the rescan reports no change
+        index.refresh();
+        index.wait();
+        BOOST_CHECK(!index.pollChanged());
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(test_save_index_without_directory) {
+    const auto cwd = std::filesystem::current_path();
+    const auto dir =
+        std::filesystem::temp_directory_path() / "openrw_test_save_index_cwd";
+    std::filesystem::remove_all(dir);
+
+    GameState state;
+    BOOST_REQUIRE(SaveGame::writeGame(state, (dir / "GTA3sf1.b").string()));
+    {
+        SaveGameIndex index(dir);
+        index.refresh();
+    }
+
+    // Without a directory the index in the working directory isn't used
+    std::filesystem::current_path(dir);
+    {
+        SaveGameIndex index{std::filesystem::path()};
+        BOOST_CHECK(index.getSaves().empty());
+        index.refresh();
+        index.wait();
+        BOOST_CHECK(!index.pollChanged());
+    }
+    std::filesystem::current_path(cwd);
+
+    std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(test_load_keeps_handles, DATA_TEST_PREDICATE) {
+    SCMFile scm;
+    scm.loadFile(scmData, sizeof(scmData));
+    BOOST_REQUIRE_GE(scm.getGlobalsSize(), sizeof(GameObjectID));
+
+    const auto path =
+        std::filesystem::temp_directory_path() / "openrw_test_handles.b";
+
+    // Handles that a fresh world would not hand out on its own
+    const GameObjectID vehicleHandle = 7;
+    const GameObjectID pickupHandle = 9;
+    {
+        GameState state;
+        GameWorld world(&Global::get().log, Global::get().d);
+        ScriptMachine script(&state, scm, nullptr);
+        state.world = &world;
+        state.script = &script;
+        world.state = &state;
+
+        auto vehicle = world.createVehicle(90u, glm::vec3(10.f, 0.f, 0.f),
+                                           glm::quat{1.f, 0.f, 0.f, 0.f},
+                                           vehicleHandle);
+        BOOST_REQUIRE(vehicle);
+        vehicle->setLifetime(GameObject::MissionLifetime);
+        BOOST_REQUIRE(world.createPickup(glm::vec3(0.f, 10.f, 0.f), 24,
+                                         PickupObject::OnStreet,
+                                         pickupHandle));
+
+        // The scripts and the radar refer to them by handle
+        std::memcpy(script.getGlobals(), &vehicleHandle,
+                    sizeof(vehicleHandle));
+        BlipData blip;
+        blip.id = 0;
+        blip.type = BlipData::Vehicle;
+        blip.target = vehicleHandle;
+        state.radarBlips[0] = blip;
+
+        BOOST_REQUIRE(SaveGame::writeGame(state, path.string()));
+    }
+
+    GameState state;
+    GameWorld world(&Global::get().log, Global::get().d);
+    ScriptMachine script(&state, scm, nullptr);
+    state.world = &world;
+    state.script = &script;
+    world.state = &state;
+
+    BOOST_REQUIRE(SaveGame::loadGame(state, path.string()));
+
+    GameObjectID global;
+    std::memcpy(&global, script.getGlobals(), sizeof(global));
+    BOOST_CHECK_EQUAL(global, vehicleHandle);
+
+    auto vehicle =
+        static_cast<VehicleObject*>(world.vehiclePool.find(vehicleHandle));
+    BOOST_REQUIRE(vehicle);
+    BOOST_CHECK_EQUAL(vehicle->getVehicle()->id(), 90);
+    BOOST_CHECK_EQUAL(vehicle->getLifetime(), GameObject::MissionLifetime);
+    BOOST_CHECK(world.pickupPool.find(pickupHandle));
+
+    BOOST_REQUIRE_EQUAL(state.radarBlips.size(), 1u);
+    BOOST_CHECK_EQUAL(state.radarBlips[0].target, vehicleHandle);
+
+    std::filesystem::remove(path);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
-#endif
@@ -2,10 +2,16 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <audio/PCMCache.hpp>
 #include <audio/Sound.hpp>
 #include <audio/SoundBuffer.hpp>
 #include <audio/SoundManager.hpp>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
 BOOST_AUTO_TEST_SUITE(SoundTests)
 
 struct F {
@@ -79,4 +85,72 @@ BOOST_FIXTURE_TEST_CASE(sound_sets_openal_source_max_distance, F) {
 
     BOOST_REQUIRE(maxDistance == 1000.f);
 }
+BOOST_AUTO_TEST_CASE(pcm_cache_round_trip) {
+    auto dir = std::filesystem::temp_directory_path() / "rwtests_pcmcache";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto source = dir / "source.mp3";
+    std::ofstream(source) << "not really an mp3";
+
+    PCMCache cache(dir / "cache");
+    BOOST_REQUIRE(cache.isEnabled());
+    BOOST_CHECK(!cache.open(source).has_value());
+
+    const int16_t samples[] = {1, -2, 3, -4, 5, -6};
+    BOOST_REQUIRE(cache.store(source, 2, 22050, 7, samples, 6));
+
+    auto entry = cache.open(source);
+    BOOST_REQUIRE(entry.has_value());
+    BOOST_CHECK_EQUAL(entry->header->channels, 2u);
+    BOOST_CHECK_EQUAL(entry->header->sampleRate, 22050u);
+    BOOST_CHECK_EQUAL(entry->header->decodedFrames, 7u);
+    BOOST_REQUIRE_EQUAL(entry->header->sampleCount, 6u);
+    for (int i = 0; i < 6; ++i) {
+        BOOST_CHECK_EQUAL(entry->samples[i], samples[i]);
+    }
+
+    // A different source (here: changed size) must not hit the entry
+    std::ofstream(source, std::ios::app) << " anymore";
+    BOOST_CHECK(!cache.open(source).has_value());
+
+    entry.reset();
+    std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(pcm_cache_evicts_least_recently_used) {
+    auto dir = std::filesystem::temp_directory_path() / "rwtests_pcmevict";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::filesystem::path sources[3];
+    for (int i = 0; i < 3; ++i) {
+        sources[i] = dir / ("source" + std::to_string(i) + ".mp3");
+        std::ofstream(sources[i]) << "source " << i;
+    }
+
+    // Room for two entries of six samples each
+    const int16_t samples[] = {1, -2, 3, -4, 5, -6};
+    const auto entrySize = sizeof(PCMCache::Header) + sizeof(samples);
+    PCMCache cache(dir / "cache", entrySize * 2);
+
+    BOOST_REQUIRE(cache.store(sources[0], 2, 22050, 1, samples, 6));
+    BOOST_REQUIRE(cache.store(sources[1], 2, 22050, 1, samples, 6));
+    const auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(cache.entryPath(sources[0]),
+                                     now - std::chrono::hours(2));
+    std::filesystem::last_write_time(cache.entryPath(sources[1]),
+                                     now - std::chrono::hours(1));
+
+    // Opening the older entry makes the other one the least recently used
+    BOOST_CHECK(cache.open(sources[0]).has_value());
+    BOOST_REQUIRE(cache.store(sources[2], 2, 22050, 1, samples, 6));
+
+    BOOST_CHECK(cache.open(sources[0]).has_value());
+    BOOST_CHECK(!cache.open(sources[1]).has_value());
+    BOOST_CHECK(cache.open(sources[2]).has_value());
+
+    std::filesystem::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
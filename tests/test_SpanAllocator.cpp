@@ -0,0 +1,58 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/SpanAllocator.hpp>
+
+BOOST_AUTO_TEST_SUITE(SpanAllocatorTests)
+
+BOOST_AUTO_TEST_CASE(test_allocate_until_full) {
+    SpanAllocator spans(10);
+    BOOST_CHECK_EQUAL(spans.allocate(4), 0u);
+    BOOST_CHECK_EQUAL(spans.allocate(4), 4u);
+    BOOST_CHECK_EQUAL(spans.allocate(4), SpanAllocator::kInvalid);
+    BOOST_CHECK_EQUAL(spans.allocate(2), 8u);
+    BOOST_CHECK_EQUAL(spans.getEnd(), 10u);
+
+    spans.setCapacity(20);
+    BOOST_CHECK_EQUAL(spans.allocate(4), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(test_holes_are_reused_and_merged) {
+    SpanAllocator spans(100);
+    const auto a = spans.allocate(10);
+    const auto b = spans.allocate(10);
+    const auto c = spans.allocate(10);
+    spans.allocate(10);
+
+    spans.release(a, 10);
+    spans.release(c, 10);
+    BOOST_CHECK_EQUAL(spans.getHoleSize(), 20u);
+
+    // Releasing b joins all three into one hole
+    spans.release(b, 10);
+    BOOST_CHECK_EQUAL(spans.getHoleSize(), 30u);
+    BOOST_CHECK_EQUAL(spans.allocate(25), 0u);
+    BOOST_CHECK_EQUAL(spans.allocate(5), 25u);
+    BOOST_CHECK_EQUAL(spans.getHoleSize(), 0u);
+    BOOST_CHECK_EQUAL(spans.getEnd(), 40u);
+}
+
+BOOST_AUTO_TEST_CASE(test_release_at_end_shrinks) {
+    SpanAllocator spans(100);
+    const auto a = spans.allocate(10);
+    const auto b = spans.allocate(10);
+    const auto c = spans.allocate(10);
+
+    spans.release(b, 10);
+    spans.release(c, 10);
+    BOOST_CHECK_EQUAL(spans.getEnd(), 10u);
+    BOOST_CHECK_EQUAL(spans.getHoleSize(), 0u);
+
+    spans.release(a, 10);
+    BOOST_CHECK_EQUAL(spans.getEnd(), 0u);
+
+    spans.allocate(10);
+    spans.reset(5);
+    BOOST_CHECK_EQUAL(spans.getEnd(), 5u);
+    BOOST_CHECK_EQUAL(spans.allocate(0), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+#include <boost/test/unit_test.hpp>
+#include <core/Telemetry.hpp>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(TelemetryTests)
+
+BOOST_AUTO_TEST_CASE(test_counters_per_frame) {
+    auto& telemetry = Telemetry::get();
+    telemetry.frameBoundary();
+    telemetry.clear();
+
+    RW_TELEMETRY_COUNT(Draws, 10);
+    RW_TELEMETRY_COUNT(Draws, 5);
+    RW_TELEMETRY_COUNT(ScriptOps, 1);
+    telemetry.frameBoundary();
+    telemetry.frameBoundary();
+
+    const auto frames = telemetry.getFrames();
+    BOOST_REQUIRE_EQUAL(frames.size(), 2u);
+    BOOST_CHECK_EQUAL(frames[0].counters[Telemetry::Draws], 15);
+    BOOST_CHECK_EQUAL(frames[0].counters[Telemetry::ScriptOps], 1);
+    BOOST_CHECK_EQUAL(frames[1].counters[Telemetry::Draws], 0);
+    BOOST_CHECK_LE(frames[0].end, frames[1].start);
+}
+
+BOOST_AUTO_TEST_CASE(test_frame_history_is_bounded) {
+    auto& telemetry = Telemetry::get();
+    telemetry.frameBoundary();
+    telemetry.clear();
+
+    for (std::size_t f = 0; f < Telemetry::kFrameCapacity + 10; ++f) {
+        RW_TELEMETRY_COUNT(Loads, f);
+        telemetry.frameBoundary();
+    }
+
+    const auto frames = telemetry.getFrames();
+    BOOST_REQUIRE_EQUAL(frames.size(), Telemetry::kFrameCapacity);
+    BOOST_CHECK_EQUAL(frames.front().counters[Telemetry::Loads], 10);
+    BOOST_CHECK_EQUAL(frames.back().counters[Telemetry::Loads],
+                      static_cast<std::int64_t>(Telemetry::kFrameCapacity + 9));
+}
+
+BOOST_AUTO_TEST_CASE(test_chrome_trace) {
+    auto& telemetry = Telemetry::get();
+    telemetry.clear();
+
+    std::thread worker([] {
+        Telemetry::get().setThreadName("Worker \"1\"");
+        RW_TELEMETRY_SCOPE("workerScope");
+    });
+    worker.join();
+    {
+        RW_TELEMETRY_SCOPE("mainScope");
+    }
+    telemetry.frameBoundary();
+
+    std::stringstream ss;
+    telemetry.writeChromeTrace(ss);
+    const auto trace = ss.str();
+
+    BOOST_CHECK_EQUAL(trace.find("{\"displayTimeUnit\""), 0u);
+    BOOST_CHECK_NE(trace.find("\"workerScope\""), std::string::npos);
+    BOOST_CHECK_NE(trace.find("\"mainScope\""), std::string::npos);
+    BOOST_CHECK_NE(trace.find("\"Worker \\\"1\\\"\""), std::string::npos);
+    BOOST_CHECK_NE(trace.find("\"ph\": \"C\""), std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_thread_buffers_are_reused) {
+    auto& telemetry = Telemetry::get();
+    const auto tracks = [&telemetry] {
+        std::stringstream ss;
+        telemetry.writeChromeTrace(ss);
+        const auto trace = ss.str();
+        std::size_t count = 0;
+        for (auto pos = trace.find("thread_name"); pos != std::string::npos;
+             pos = trace.find("thread_name", pos + 1)) {
+            count++;
+        }
+        return count;
+    };
+
+    for (std::size_t t = 0; t < Telemetry::kThreadCapacity; ++t) {
+        std::thread([] { RW_TELEMETRY_SCOPE("firstScope"); }).join();
+    }
+    const auto before = tracks();
+    for (std::size_t t = 0; t < Telemetry::kThreadCapacity; ++t) {
+        std::thread([] { RW_TELEMETRY_SCOPE("laterScope"); }).join();
+    }
+    BOOST_CHECK_EQUAL(tracks(), before);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace_while_recording) {
+    auto& telemetry = Telemetry::get();
+    telemetry.clear();
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&stop] {
+        auto& telemetry = Telemetry::get();
+        for (std::uint64_t t = 0; !stop.load(); ++t) {
+            telemetry.record("writerEvent", t, t);
+        }
+    });
+
+    // Events torn by the writer would mix the start of one and the end of
+    // another, every one it records takes no time at all
+    for (int i = 0; i < 20; ++i) {
+        std::stringstream ss;
+        telemetry.writeChromeTrace(ss);
+        std::string line;
+        while (std::getline(ss, line)) {
+            if (line.find("\"writerEvent\"") != std::string::npos) {
+                BOOST_REQUIRE_NE(line.find("\"dur\": 0.000}"),
+                                 std::string::npos);
+            }
+        }
+    }
+    stop = true;
+    writer.join();
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled_scopes_are_not_recorded) {
+    auto& telemetry = Telemetry::get();
+    telemetry.clear();
+    telemetry.setEnabled(false);
+    {
+        RW_TELEMETRY_SCOPE("disabledScope");
+    }
+    telemetry.setEnabled(true);
+
+    std::stringstream ss;
+    telemetry.writeChromeTrace(ss);
+    BOOST_CHECK_EQUAL(ss.str().find("disabledScope"), std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
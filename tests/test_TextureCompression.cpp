@@ -0,0 +1,160 @@
+#include <boost/test/unit_test.hpp>
+#include <gl/TextureCompression.hpp>
+#include <loaders/TextureCache.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace {
+std::vector<std::uint8_t> makeImage(int width, int height) {
+    std::vector<std::uint8_t> rgba(static_cast<std::size_t>(width) * height *
+                                   4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            auto* p = &rgba[(static_cast<std::size_t>(y) * width + x) * 4];
+            p[0] = static_cast<std::uint8_t>(x * 255 / (width - 1));
+            p[1] = static_cast<std::uint8_t>(y * 255 / (height - 1));
+            p[2] = 64;
+            p[3] = x < width / 2 ? 0 : 255;
+        }
+    }
+    return rgba;
+}
+
+int maxError(const std::vector<std::uint8_t>& a,
+             const std::vector<std::uint8_t>& b, int channels) {
+    int error = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (static_cast<int>(i % 4) < channels) {
+            error = std::max(error, std::abs(a[i] - b[i]));
+        }
+    }
+    return error;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureCompressionTests)
+
+BOOST_AUTO_TEST_CASE(test_sizes) {
+    using TextureCompression::Format;
+    BOOST_CHECK_EQUAL(TextureCompression::compressedSize(Format::BC1, 1, 1),
+                      8u);
+    BOOST_CHECK_EQUAL(TextureCompression::compressedSize(Format::BC1, 16, 8),
+                      64u);
+    BOOST_CHECK_EQUAL(TextureCompression::compressedSize(Format::BC3, 5, 5),
+                      64u);
+    BOOST_CHECK_EQUAL(TextureCompression::mipCount(1, 1), 1);
+    BOOST_CHECK_EQUAL(TextureCompression::mipCount(256, 64), 9);
+    BOOST_CHECK_EQUAL(TextureCompression::mipCount(3, 5), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_round_trip) {
+    using TextureCompression::Format;
+    // Not a multiple of the block size, so the edges are partial blocks
+    const int width = 30;
+    const int height = 18;
+    const auto image = makeImage(width, height);
+
+    std::vector<std::uint8_t> blocks(
+        TextureCompression::compressedSize(Format::BC3, width, height));
+    TextureCompression::compress(Format::BC3, image.data(), width, height,
+                                 blocks.data());
+
+    std::vector<std::uint8_t> decoded(image.size());
+    TextureCompression::decompress(Format::BC3, blocks.data(), width, height,
+                                   decoded.data());
+    BOOST_CHECK_LT(maxError(image, decoded, 3), 32);
+    // Two alpha values in a block are stored exactly
+    BOOST_CHECK_EQUAL(maxError(image, decoded, 4), maxError(image, decoded, 3));
+
+    blocks.resize(
+        TextureCompression::compressedSize(Format::BC1, width, height));
+    TextureCompression::compress(Format::BC1, image.data(), width, height,
+                                 blocks.data());
+    TextureCompression::decompress(Format::BC1, blocks.data(), width, height,
+                                   decoded.data());
+    BOOST_CHECK_LT(maxError(image, decoded, 3), 32);
+    for (std::size_t i = 3; i < decoded.size(); i += 4) {
+        BOOST_REQUIRE_EQUAL(decoded[i], 255);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_solid_colour_is_exact) {
+    using TextureCompression::Format;
+    std::vector<std::uint8_t> image(4 * 4 * 4);
+    for (std::size_t i = 0; i < image.size(); i += 4) {
+        image[i + 0] = 255;
+        image[i + 1] = 0;
+        image[i + 2] = 255;
+        image[i + 3] = 128;
+    }
+
+    std::vector<std::uint8_t> blocks(16);
+    TextureCompression::compress(Format::BC3, image.data(), 4, 4,
+                                 blocks.data());
+    std::vector<std::uint8_t> decoded(image.size());
+    TextureCompression::decompress(Format::BC3, blocks.data(), 4, 4,
+                                   decoded.data());
+    BOOST_CHECK(decoded == image);
+}
+
+BOOST_AUTO_TEST_CASE(test_downsample) {
+    const std::vector<std::uint8_t> image{
+        0,   0,   0,   0,   //
+        100, 100, 100, 100, //
+        200, 200, 200, 200, //
+        100, 100, 100, 100, //
+        0,   0,   0,   0,   //
+        0,   0,   0,   0,   //
+    };
+
+    std::vector<std::uint8_t> mip;
+    TextureCompression::downsample(image.data(), 3, 2, mip);
+    // The odd column is dropped
+    BOOST_REQUIRE_EQUAL(mip.size(), 4u);
+    BOOST_CHECK_EQUAL(mip[0], 50);
+
+    std::vector<std::uint8_t> last;
+    TextureCompression::downsample(mip.data(), 1, 1, last);
+    BOOST_CHECK(last == mip);
+}
+
+BOOST_AUTO_TEST_CASE(test_cache_round_trip) {
+    const auto directory =
+        std::filesystem::temp_directory_path() / "rwtests-texture-cache";
+    std::filesystem::remove_all(directory);
+    TextureCache cache(directory);
+
+    const auto key = TextureCache::key("models/gta3.img:test.txd", 4096, 10);
+    BOOST_CHECK(!cache.open(key));
+
+    TextureCache::Texture texture;
+    std::strcpy(texture.header.name, "test");
+    texture.header.format = TextureCompression::Format::BC1;
+    texture.header.width = 4;
+    texture.header.height = 4;
+    texture.header.mipCount = 1;
+    texture.data.assign(8, 0xAB);
+    BOOST_REQUIRE(cache.store(key, {texture}));
+
+    auto entry = cache.open(key);
+    BOOST_REQUIRE(entry);
+    BOOST_REQUIRE_EQUAL(entry->textures.size(), 1u);
+    const auto& view = entry->textures[0];
+    BOOST_CHECK_EQUAL(view.header->name, "test");
+    BOOST_CHECK_EQUAL(view.header->dataSize, 8u);
+    BOOST_CHECK_EQUAL(view.data[7], 0xAB);
+
+    // Any change to the archive misses
+    BOOST_CHECK(
+        !cache.open(TextureCache::key("models/gta3.img:test.txd", 4096, 11)));
+    BOOST_CHECK(
+        !cache.open(TextureCache::key("models/gta3.img:other.txd", 4096, 10)));
+
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+#include <boost/test/unit_test.hpp>
+#include <engine/TextureResidency.hpp>
+#include "test_Globals.hpp"
+
+namespace {
+TextureArchive makeArchive(const std::string& name) {
+    TextureArchive archive;
+    archive[name] = TextureData::create(0, {16, 16}, false);
+    return archive;
+}
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TextureResidencyTests)
+
+BOOST_AUTO_TEST_CASE(test_interning) {
+    TextureResidency residency;
+    const auto a = residency.internSlot("a");
+    BOOST_CHECK_EQUAL(residency.internSlot("a"), a);
+    BOOST_CHECK_NE(residency.internSlot("b"), a);
+    BOOST_CHECK_EQUAL(residency.findSlot("a"), a);
+    BOOST_CHECK_EQUAL(residency.findSlot("c"), TextureResidency::kInvalid);
+
+    const auto t = residency.internTexture("t");
+    BOOST_CHECK_EQUAL(residency.internTexture("t"), t);
+    BOOST_CHECK_EQUAL(residency.findTexture("u"), TextureResidency::kInvalid);
+
+    BOOST_CHECK(!residency.isResident(a));
+    BOOST_CHECK(residency.find(a, t) == nullptr);
+    BOOST_CHECK(residency.find(TextureResidency::kInvalid, t) == nullptr);
+
+    residency.insert(a, {});
+    BOOST_CHECK(residency.isResident(a));
+    BOOST_CHECK_EQUAL(residency.getResidentCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_references) {
+    auto residency = std::make_unique<TextureResidency>();
+    const auto slot = residency->internSlot("slot");
+
+    auto reference = residency->acquire(slot);
+    auto copy = reference;
+    BOOST_CHECK_EQUAL(residency->getReferenceCount(slot), 1);
+
+    auto second = residency->acquire(slot);
+    BOOST_CHECK_EQUAL(residency->getReferenceCount(slot), 2);
+
+    reference.reset();
+    BOOST_CHECK_EQUAL(residency->getReferenceCount(slot), 2);
+    copy.reset();
+    BOOST_CHECK_EQUAL(residency->getReferenceCount(slot), 1);
+
+    // Models may be released after the residency is gone
+    residency.reset();
+    second.reset();
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_eviction, DATA_TEST_PREDICATE) {
+    // Deleting textures needs the GL context
+    Global::get();
+
+    TextureResidency residency;
+    const auto pinned = residency.internSlot("pinned");
+    const auto byName = residency.internSlot("byname");
+    const auto older = residency.internSlot("older");
+    const auto newer = residency.internSlot("newer");
+    const auto used = residency.internSlot("used");
+
+    for (auto slot : {pinned, byName, older, newer, used}) {
+        residency.insert(slot, makeArchive("texture"));
+    }
+    residency.setPinned(pinned, true);
+    residency.acquire(pinned);
+    residency.acquire(older);
+    residency.acquire(newer);
+    auto reference = residency.acquire(used);
+
+    const auto textureSize = TextureData::estimateSize({16, 16});
+    BOOST_CHECK_EQUAL(residency.getResidentSize(), textureSize * 5);
+
+    // Without a budget nothing is evicted
+    BOOST_CHECK_EQUAL(residency.enforceBudget(), 0u);
+
+    residency.setBudget(textureSize * 4);
+    BOOST_CHECK_EQUAL(residency.enforceBudget(), 1u);
+    BOOST_CHECK(!residency.isResident(older));
+    BOOST_CHECK(residency.isResident(newer));
+
+    // Only slots that are released, referenced before and not pinned go
+    residency.setBudget(textureSize);
+    BOOST_CHECK_EQUAL(residency.enforceBudget(), 1u);
+    BOOST_CHECK(!residency.isResident(newer));
+    BOOST_CHECK(residency.isResident(pinned));
+    BOOST_CHECK(residency.isResident(byName));
+    BOOST_CHECK(residency.isResident(used));
+    BOOST_CHECK(residency.find(used, residency.findTexture("texture")));
+    BOOST_CHECK_EQUAL(residency.getResidentSize(), textureSize * 3);
+
+    // Reloading makes the slot resident again
+    residency.insert(older, makeArchive("texture"));
+    BOOST_CHECK_EQUAL(residency.enforceBudget(older), 0u);
+    BOOST_CHECK(residency.isResident(older));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
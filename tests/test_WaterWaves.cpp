@@ -0,0 +1,38 @@
+#include <boost/test/unit_test.hpp>
+#include <engine/WaterWaves.hpp>
+#include <rw/types.hpp>
+
+#include <cmath>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(WaterWavesTests)
+
+BOOST_AUTO_TEST_CASE(test_wave_height) {
+    for (auto time : {0.f, 2.5f, 600.f}) {
+        for (auto x = -2048.f; x < 2048.f; x += 97.f) {
+            const auto y = 1000.f - x * 0.5f;
+            const auto expected =
+                (1.f + std::sin(time + (x + y) * WATER_SCALE)) * WATER_HEIGHT;
+            BOOST_CHECK_SMALL(WaterWaves::heightAt(time, x, y) - expected,
+                              1e-5f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_wave_batch_matches_single) {
+    // An odd count covers both the vector loop and its tail
+    std::vector<float> x, y;
+    for (auto i = 0; i < 103; ++i) {
+        x.push_back(-2000.f + static_cast<float>(i) * 37.f);
+        y.push_back(500.f - static_cast<float>(i) * 11.f);
+    }
+    std::vector<float> heights(x.size());
+    WaterWaves::heightsAt(42.f, x.data(), y.data(), x.size(),
+                          heights.data());
+    for (auto i = 0u; i < x.size(); ++i) {
+        BOOST_CHECK_SMALL(heights[i] - WaterWaves::heightAt(42.f, x[i], y[i]),
+                          1e-6f);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()